@@ -0,0 +1,109 @@
+/*********************                                                        */
+/*! \file OnnxParsingBenchmark.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Measures the time it takes OnnxParser to parse ONNX networks into an
+ ** input query, in milliseconds per parse.
+ **
+ ** Usage: OnnxParsingBenchmark [network files]
+ ** Without network files, a selection of the networks in the resources
+ ** directory is used.
+
+ **/
+
+#include "Error.h"
+#include "InputQuery.h"
+#include "InputQueryBuilder.h"
+#include "List.h"
+#include "MString.h"
+#include "OnnxParser.h"
+#include "TimeUtils.h"
+
+#include <cstdio>
+
+static void benchmark( const String &networkPath )
+{
+    enum {
+        MICROSECONDS_IN_SECOND = 1000000,
+        MICROSECONDS_IN_MILLISECOND = 1000,
+        MINIMUM_NUMBER_OF_PARSES = 3,
+    };
+
+    // Repeat the parsing for at least a second
+    unsigned numberOfParses = 0;
+    unsigned long long elapsedMicroSeconds = 0;
+    unsigned numberOfVariables = 0;
+    unsigned numberOfEquations = 0;
+    while ( numberOfParses < MINIMUM_NUMBER_OF_PARSES ||
+            elapsedMicroSeconds < MICROSECONDS_IN_SECOND )
+    {
+        struct timespec start = TimeUtils::sampleMicro();
+        InputQueryBuilder queryBuilder;
+        OnnxParser::parse( queryBuilder, networkPath, {}, {} );
+        InputQuery query;
+        queryBuilder.generateQuery( query );
+        elapsedMicroSeconds += TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+
+        numberOfVariables = query.getNumberOfVariables();
+        numberOfEquations = query.getEquations().size();
+        ++numberOfParses;
+    }
+
+    printf( "%s: %u variables, %u equations: %.2f milliseconds per parse\n",
+            networkPath.ascii(),
+            numberOfVariables,
+            numberOfEquations,
+            (double)elapsedMicroSeconds / MICROSECONDS_IN_MILLISECOND / numberOfParses );
+}
+
+int main( int argc, char **argv )
+{
+    List<String> networkPaths;
+    for ( int i = 1; i < argc; ++i )
+        networkPaths.append( argv[i] );
+    if ( networkPaths.empty() )
+    {
+        networkPaths.append( RESOURCES_DIR "/onnx/fc2.onnx" );
+        networkPaths.append( RESOURCES_DIR "/onnx/mnist2x10.onnx" );
+        networkPaths.append( RESOURCES_DIR "/onnx/mnist5x20_leaky_relu.onnx" );
+        networkPaths.append( RESOURCES_DIR "/onnx/conv_mp1.onnx" );
+        networkPaths.append( RESOURCES_DIR "/onnx/tanh_test.onnx" );
+    }
+
+    int result = 0;
+    for ( const auto &networkPath : networkPaths )
+    {
+        try
+        {
+            benchmark( networkPath );
+        }
+        catch ( const Error &e )
+        {
+            fprintf( stderr,
+                     "%s: caught a %s error. Code: %u, Errno: %i, Message: %s.\n",
+                     networkPath.ascii(),
+                     e.getErrorClass(),
+                     e.getCode(),
+                     e.getErrno(),
+                     e.getUserMessage() );
+            result = 1;
+        }
+    }
+
+    return result;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C .. "
+// tags-file-name: "../TAGS"
+// c-basic-offset: 4
+// End:
+//
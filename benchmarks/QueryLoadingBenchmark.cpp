@@ -0,0 +1,189 @@
+/*********************                                                        */
+/*! \file QueryLoadingBenchmark.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Compares the time it takes QueryLoader to load a query saved in the text
+ ** and in the binary input query format.
+ **
+ ** Usage: QueryLoadingBenchmark [number of neurons | query file]
+ ** Without a query file, the query of a random sparse ReLU network with the
+ ** given number of neurons (100000 by default) is used. The query is saved
+ ** in both formats in the current directory, and the files are removed
+ ** afterwards.
+
+ **/
+
+#include "Equation.h"
+#include "Error.h"
+#include "IFile.h"
+#include "InputQuery.h"
+#include "MString.h"
+#include "QueryLoader.h"
+#include "ReluConstraint.h"
+#include "TimeUtils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const String TEXT_QUERY_FILE( "QueryLoadingBenchmark.txt" );
+static const String BINARY_QUERY_FILE( "QueryLoadingBenchmark.ipqb" );
+
+/*
+  A ReLU network whose every neuron has ten random predecessors among the
+  inputs and the earlier neurons
+*/
+static void buildQuery( InputQuery &query, unsigned numberOfNeurons )
+{
+    enum {
+        NUMBER_OF_INPUTS = 10,
+        NUMBER_OF_PREDECESSORS = 10,
+    };
+
+    query.setNumberOfVariables( NUMBER_OF_INPUTS + 2 * numberOfNeurons );
+    for ( unsigned i = 0; i < NUMBER_OF_INPUTS; ++i )
+    {
+        query.markInputVariable( i, i );
+        query.setLowerBound( i, -1 );
+        query.setUpperBound( i, 1 );
+    }
+
+    std::mt19937 mt( 1 );
+    std::uniform_real_distribution<double> distribution( -1, 1 );
+    for ( unsigned i = 0; i < numberOfNeurons; ++i )
+    {
+        unsigned b = NUMBER_OF_INPUTS + 2 * i;
+        unsigned f = b + 1;
+
+        // The inputs and the outputs of the earlier ReLUs
+        std::uniform_int_distribution<unsigned> predecessor( 0, NUMBER_OF_INPUTS + i - 1 );
+
+        Equation equation;
+        equation.addAddend( -1, b );
+        for ( unsigned j = 0; j < NUMBER_OF_PREDECESSORS; ++j )
+        {
+            unsigned source = predecessor( mt );
+            if ( source >= NUMBER_OF_INPUTS )
+                source = NUMBER_OF_INPUTS + 2 * ( source - NUMBER_OF_INPUTS ) + 1;
+            equation.addAddend( distribution( mt ), source );
+        }
+        equation.setScalar( -distribution( mt ) );
+        query.addEquation( equation );
+
+        query.addPiecewiseLinearConstraint( new ReluConstraint( b, f ) );
+        query.setLowerBound( f, 0 );
+    }
+    query.markOutputVariable( NUMBER_OF_INPUTS + 2 * numberOfNeurons - 1, 0 );
+}
+
+static unsigned long long fileSize( const String &fileName )
+{
+    struct stat fileStatus;
+    if ( stat( fileName.ascii(), &fileStatus ) != 0 )
+        return 0;
+    return fileStatus.st_size;
+}
+
+/*
+  The average time of loading the file, in milliseconds, over repeated
+  loads for at least a second
+*/
+static double timeLoading( const String &fileName, unsigned &numberOfEquations )
+{
+    enum {
+        MICROSECONDS_IN_SECOND = 1000000,
+        MICROSECONDS_IN_MILLISECOND = 1000,
+    };
+
+    unsigned numberOfLoads = 0;
+    unsigned long long elapsedMicroSeconds = 0;
+    while ( elapsedMicroSeconds < MICROSECONDS_IN_SECOND )
+    {
+        struct timespec start = TimeUtils::sampleMicro();
+        InputQuery query = QueryLoader::loadQuery( fileName );
+        elapsedMicroSeconds += TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+
+        numberOfEquations = query.getEquations().size();
+        ++numberOfLoads;
+    }
+
+    return (double)elapsedMicroSeconds / MICROSECONDS_IN_MILLISECOND / numberOfLoads;
+}
+
+static void benchmark( InputQuery &query )
+{
+    // Saving the text format prints the dimensions of the query
+    query.saveQuery( TEXT_QUERY_FILE );
+    query.saveBinaryQuery( BINARY_QUERY_FILE );
+
+    unsigned textEquations = 0;
+    unsigned binaryEquations = 0;
+    double textMilliseconds = timeLoading( TEXT_QUERY_FILE, textEquations );
+    double binaryMilliseconds = timeLoading( BINARY_QUERY_FILE, binaryEquations );
+
+    printf( "Text format: %llu bytes, %u equations: %.2f milliseconds per load\n",
+            fileSize( TEXT_QUERY_FILE ),
+            textEquations,
+            textMilliseconds );
+    printf( "Binary format: %llu bytes, %u equations: %.2f milliseconds per load\n",
+            fileSize( BINARY_QUERY_FILE ),
+            binaryEquations,
+            binaryMilliseconds );
+}
+
+int main( int argc, char **argv )
+{
+    int result = 0;
+    try
+    {
+        InputQuery query;
+        if ( argc > 1 && IFile::exists( argv[1] ) )
+        {
+            query = QueryLoader::loadQuery( argv[1] );
+        }
+        else
+        {
+            unsigned numberOfNeurons = argc > 1 ? atoi( argv[1] ) : 100000;
+            if ( numberOfNeurons == 0 )
+            {
+                printf( "Usage: %s [number of neurons | query file]\n", argv[0] );
+                return 1;
+            }
+            buildQuery( query, numberOfNeurons );
+        }
+
+        benchmark( query );
+    }
+    catch ( const Error &e )
+    {
+        fprintf( stderr,
+                 "Caught a %s error. Code: %u, Errno: %i, Message: %s.\n",
+                 e.getErrorClass(),
+                 e.getCode(),
+                 e.getErrno(),
+                 e.getUserMessage() );
+        result = 1;
+    }
+
+    unlink( TEXT_QUERY_FILE.ascii() );
+    unlink( BINARY_QUERY_FILE.ascii() );
+
+    return result;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C .. "
+// tags-file-name: "../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,126 @@
+/*********************                                                        */
+/*! \file SimulationBenchmark.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Measures the throughput of NetworkLevelReasoner::simulate, in samples
+ ** per second, on .nnet networks.
+ **
+ ** Usage: SimulationBenchmark [batch size] [network files]
+ ** Without network files, the ACAS Xu and MNIST networks in the resources
+ ** directory are used.
+
+ **/
+
+#include "AcasParser.h"
+#include "Error.h"
+#include "InputQuery.h"
+#include "List.h"
+#include "MString.h"
+#include "TimeUtils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+static void benchmark( const String &networkPath, unsigned batchSize )
+{
+    enum {
+        MICROSECONDS_IN_SECOND = 1000000,
+    };
+
+    InputQuery query;
+    AcasParser( networkPath ).generateQuery( query );
+
+    List<Equation> unhandledEquations;
+    Set<unsigned> varsInUnhandledConstraints;
+    if ( !query.constructNetworkLevelReasoner( unhandledEquations, varsInUnhandledConstraints ) )
+    {
+        printf( "%s: could not construct the network level reasoner\n", networkPath.ascii() );
+        return;
+    }
+    NLR::NetworkLevelReasoner *nlr = query.getNetworkLevelReasoner();
+
+    unsigned numberOfNeurons = 0;
+    for ( unsigned i = 0; i < nlr->getNumberOfLayers(); ++i )
+        numberOfNeurons += nlr->getLayer( i )->getSize();
+
+    unsigned inputSize = nlr->getLayer( 0 )->getSize();
+    Vector<double> batch( batchSize * inputSize );
+    std::mt19937 mt( 1 );
+    std::uniform_real_distribution<double> distribution( -1, 1 );
+    for ( unsigned i = 0; i < batchSize * inputSize; ++i )
+        batch[i] = distribution( mt );
+
+    // Warm up, so that the buffers of the layers are allocated
+    nlr->simulate( batch.data(), batchSize );
+
+    // Repeat the simulation for at least a second
+    unsigned long long samples = 0;
+    unsigned long long elapsedMicroSeconds = 0;
+    struct timespec start = TimeUtils::sampleMicro();
+    while ( elapsedMicroSeconds < MICROSECONDS_IN_SECOND )
+    {
+        nlr->simulate( batch.data(), batchSize );
+        samples += batchSize;
+        elapsedMicroSeconds = TimeUtils::timePassed( start, TimeUtils::sampleMicro() );
+    }
+
+    printf( "%s: %u layers, %u neurons, batches of %u: %.0f samples per second\n",
+            networkPath.ascii(),
+            nlr->getNumberOfLayers(),
+            numberOfNeurons,
+            batchSize,
+            (double)samples * MICROSECONDS_IN_SECOND / elapsedMicroSeconds );
+}
+
+int main( int argc, char **argv )
+{
+    unsigned batchSize = argc > 1 ? atoi( argv[1] ) : 1000;
+    if ( batchSize == 0 )
+    {
+        printf( "Usage: %s [batch size] [network files]\n", argv[0] );
+        return 1;
+    }
+
+    List<String> networkPaths;
+    for ( int i = 2; i < argc; ++i )
+        networkPaths.append( argv[i] );
+    if ( networkPaths.empty() )
+    {
+        networkPaths.append( RESOURCES_DIR "/nnet/acasxu/ACASXU_experimental_v2a_1_1.nnet" );
+        networkPaths.append( RESOURCES_DIR "/nnet/mnist/mnist20x40.nnet" );
+    }
+
+    try
+    {
+        for ( const auto &networkPath : networkPaths )
+            benchmark( networkPath, batchSize );
+    }
+    catch ( const Error &e )
+    {
+        fprintf( stderr,
+                 "Caught a %s error. Code: %u, Errno: %i, Message: %s.\n",
+                 e.getErrorClass(),
+                 e.getCode(),
+                 e.getErrno(),
+                 e.getUserMessage() );
+        return 1;
+    }
+
+    return 0;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C .. "
+// tags-file-name: "../TAGS"
+// c-basic-offset: 4
+// End:
+//
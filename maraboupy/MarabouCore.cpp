@@ -44,6 +44,7 @@
 
 #include <fcntl.h>
 #include <map>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <set>
@@ -556,11 +557,134 @@ calculateBounds( InputQuery &inputQuery, MarabouOptions &options, std::string re
     return std::make_tuple( resultString, ret, retStats );
 }
 
+/*
+  Evaluates the network of an input query on batches of inputs. The network
+  level reasoner is constructed once, and the NumPy buffers are read and
+  written in place whenever the network neurons are in the order of the
+  input and output indices of the query.
+*/
+class NetworkEvaluator
+{
+public:
+    NetworkEvaluator( const InputQuery &inputQuery )
+        : _inputQuery( inputQuery )
+    {
+        List<Equation> unhandledEquations;
+        Set<unsigned> varsInUnhandledConstraints;
+        if ( !_inputQuery.constructNetworkLevelReasoner( unhandledEquations,
+                                                         varsInUnhandledConstraints ) )
+            throw std::runtime_error( "Unable to construct a network from the input query" );
+
+        _inputQuery.getNetworkLevelReasoner()->sparsifyWeights(
+            GlobalConfiguration::NLR_SPARSE_WEIGHTS_MAXIMUM_DENSITY );
+        _nlr = _inputQuery.getNetworkLevelReasoner();
+        const NLR::Layer *inputLayer = _nlr->getLayer( 0 );
+        const NLR::Layer *outputLayer = _nlr->getLayer( _nlr->getNumberOfLayers() - 1 );
+        _inputLayerSize = inputLayer->getSize();
+        _outputLayerSize = outputLayer->getSize();
+
+        _identityInputs = mapVariablesToNeurons( inputLayer, true, _inputNeurons );
+        _identityOutputs = mapVariablesToNeurons( outputLayer, false, _outputNeurons );
+    }
+
+    py::array_t<double>
+    evaluate( py::array_t<double, py::array::c_style | py::array::forcecast> inputs,
+              unsigned numberOfThreads )
+    {
+        if ( inputs.ndim() != 2 || (size_t)inputs.shape( 1 ) != _inputNeurons.size() )
+            throw std::invalid_argument( "Expected an array of shape (N, " +
+                                         std::to_string( _inputNeurons.size() ) + ")" );
+
+        size_t numberOfSamples = inputs.shape( 0 );
+        size_t numberOfInputs = _inputNeurons.size();
+        size_t numberOfOutputs = _outputNeurons.size();
+        py::array_t<double> outputs( { numberOfSamples, numberOfOutputs } );
+        const double *inputData = inputs.data();
+        double *outputData = outputs.mutable_data();
+
+        {
+            py::gil_scoped_release release;
+
+            std::vector<double> layerInputs;
+            if ( !_identityInputs )
+            {
+                layerInputs.assign( numberOfSamples * _inputLayerSize, 0 );
+                for ( size_t j = 0; j < numberOfSamples; ++j )
+                    for ( size_t i = 0; i < numberOfInputs; ++i )
+                        layerInputs[j * _inputLayerSize + _inputNeurons[i]] =
+                            inputData[j * numberOfInputs + i];
+                inputData = layerInputs.data();
+            }
+
+            if ( _identityOutputs )
+            {
+                _nlr->evaluateBatch( inputData, outputData, numberOfSamples, numberOfThreads );
+            }
+            else
+            {
+                std::vector<double> layerOutputs( numberOfSamples * _outputLayerSize );
+                _nlr->evaluateBatch(
+                    inputData, layerOutputs.data(), numberOfSamples, numberOfThreads );
+                for ( size_t j = 0; j < numberOfSamples; ++j )
+                    for ( size_t i = 0; i < numberOfOutputs; ++i )
+                        outputData[j * numberOfOutputs + i] =
+                            layerOutputs[j * _outputLayerSize + _outputNeurons[i]];
+            }
+        }
+        return outputs;
+    }
+
+private:
+    InputQuery _inputQuery;
+    const NLR::NetworkLevelReasoner *_nlr;
+    unsigned _inputLayerSize;
+    unsigned _outputLayerSize;
+    std::vector<unsigned> _inputNeurons;
+    std::vector<unsigned> _outputNeurons;
+    bool _identityInputs;
+    bool _identityOutputs;
+
+    /*
+      Store the neuron of the layer for each input (or output) index of the
+      query, and return true iff index i is neuron i for all indices.
+    */
+    bool mapVariablesToNeurons( const NLR::Layer *layer,
+                                bool inputs,
+                                std::vector<unsigned> &neurons ) const
+    {
+        Map<unsigned, unsigned> variableToNeuron;
+        for ( unsigned i = 0; i < layer->getSize(); ++i )
+            if ( layer->neuronHasVariable( i ) )
+                variableToNeuron[layer->neuronToVariable( i )] = i;
+
+        unsigned count =
+            inputs ? _inputQuery.getNumInputVariables() : _inputQuery.getNumOutputVariables();
+        bool identity = ( count == layer->getSize() );
+        for ( unsigned i = 0; i < count; ++i )
+        {
+            unsigned variable = inputs ? _inputQuery.inputVariableByIndex( i )
+                                       : _inputQuery.outputVariableByIndex( i );
+            if ( !variableToNeuron.exists( variable ) )
+                throw std::runtime_error( "Variable " + std::to_string( variable ) +
+                                          " is not in the " + ( inputs ? "first" : "last" ) +
+                                          " layer of the network" );
+            neurons.push_back( variableToNeuron[variable] );
+            identity = identity && variableToNeuron[variable] == i;
+        }
+        return identity;
+    }
+};
+
 void saveQuery( InputQuery &inputQuery, std::string filename )
 {
     inputQuery.saveQuery( String( filename ) );
 }
 
+void saveBinaryQuery( InputQuery &inputQuery, std::string filename )
+{
+    inputQuery.saveBinaryQuery( String( filename ) );
+}
+
 InputQuery loadQuery( std::string filename )
 {
     return QueryLoader::loadQuery( String( filename ) );
@@ -664,6 +788,18 @@ PYBIND11_MODULE( MarabouCore, m )
            R"pbdoc(
         Serializes the inputQuery in the given filename
 
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query to be saved
+            filename (str): Name of file to save query
+        )pbdoc",
+           py::arg( "inputQuery" ),
+           py::arg( "filename" ) );
+    m.def( "saveBinaryQuery",
+           &saveBinaryQuery,
+           R"pbdoc(
+        Serializes the inputQuery in the given filename in the binary input query format,
+        which loadQuery maps into memory instead of parsing
+
         Args:
             inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query to be saved
             filename (str): Name of file to save query
@@ -673,7 +809,7 @@ PYBIND11_MODULE( MarabouCore, m )
     m.def( "loadQuery",
            &loadQuery,
            R"pbdoc(
-        Loads and returns a serialized InputQuery from the given filename
+        Loads and returns a serialized InputQuery, in the text or the binary format, from the given filename
 
         Args:
             filename (str): Name of file to load into an InputQuery
@@ -846,6 +982,27 @@ PYBIND11_MODULE( MarabouCore, m )
         .def( "markInputVariable", &InputQuery::markInputVariable )
         .def( "markOutputVariable", &InputQuery::markOutputVariable )
         .def( "outputVariableByIndex", &InputQuery::outputVariableByIndex );
+    py::class_<NetworkEvaluator>( m, "NetworkEvaluator", R"pbdoc(
+        Evaluates the network of an input query on batches of concrete inputs
+
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Input query encoding a feed-forward network
+        )pbdoc" )
+        .def( py::init<const InputQuery &>(), py::arg( "inputQuery" ) )
+        .def( "evaluate",
+              &NetworkEvaluator::evaluate,
+              R"pbdoc(
+        Evaluate the network on a batch of inputs, without copying the inputs when they are a C-contiguous float64 array
+
+        Args:
+            inputs (numpy array): Array of shape (N, number of input variables), one row per sample, ordered by input index
+            numberOfThreads (int): Number of threads the batch is split among, defaults to 1
+
+        Returns:
+            (numpy array): Array of shape (N, number of output variables), ordered by output index
+        )pbdoc",
+              py::arg( "inputs" ),
+              py::arg( "numberOfThreads" ) = 1 );
     py::enum_<PiecewiseLinearFunctionType>( m, "PiecewiseLinearFunctionType" )
         .value( "ReLU", PiecewiseLinearFunctionType::RELU )
         .value( "AbsoluteValue", PiecewiseLinearFunctionType::ABSOLUTE_VALUE )
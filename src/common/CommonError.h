@@ -39,6 +39,12 @@ public:
         GUROBI_EXCEPTION = 14,
         DIVISION_BY_ZERO = 15,
         UNEXPECTED_GUROBI_STATUS = 16,
+        INVALID_SOCKET_ADDRESS = 17,
+        SOCKET_CREATION_FAILED = 18,
+        SOCKET_BIND_FAILED = 19,
+        SOCKET_CONNECT_FAILED = 20,
+        SOCKET_ACCEPT_FAILED = 21,
+        SOCKET_SEND_FAILED = 22,
     };
 
     CommonError( CommonError::Code code )
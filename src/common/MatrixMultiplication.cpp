@@ -45,6 +45,29 @@ void matrixMultiplication( const double *matA,
                  matC,
                  columnsB );
 }
+
+void matrixMultiplication( const float *matA,
+                           const float *matB,
+                           float *matC,
+                           unsigned rowsA,
+                           unsigned columnsA,
+                           unsigned columnsB )
+{
+    cblas_sgemm( CblasRowMajor,
+                 CblasNoTrans,
+                 CblasNoTrans,
+                 rowsA,
+                 columnsB,
+                 columnsA,
+                 1,
+                 matA,
+                 columnsA,
+                 matB,
+                 columnsB,
+                 1,
+                 matC,
+                 columnsB );
+}
 #else
 void matrixMultiplication( const double *matA,
                            const double *matB,
@@ -64,4 +87,23 @@ void matrixMultiplication( const double *matA,
         }
     }
 }
+
+void matrixMultiplication( const float *matA,
+                           const float *matB,
+                           float *matC,
+                           unsigned rowsA,
+                           unsigned columnsA,
+                           unsigned columnsB )
+{
+    for ( unsigned i = 0; i < rowsA; ++i )
+    {
+        for ( unsigned j = 0; j < columnsB; ++j )
+        {
+            for ( unsigned k = 0; k < columnsA; ++k )
+            {
+                matC[i * columnsB + j] += matA[i * columnsA + k] * matB[k * columnsB + j];
+            }
+        }
+    }
+}
 #endif
@@ -14,4 +14,14 @@ void matrixMultiplication( const double *matA,
                            unsigned columnsA,
                            unsigned columnsB );
 
+/*
+  The same, in single precision
+*/
+void matrixMultiplication( const float *matA,
+                           const float *matB,
+                           float *matC,
+                           unsigned rowsA,
+                           unsigned columnsA,
+                           unsigned columnsB );
+
 #endif // __MatrixMultiplication_h__
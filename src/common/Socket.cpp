@@ -0,0 +1,305 @@
+/*********************                                                        */
+/*! \file Socket.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "Socket.h"
+
+#include "CommonError.h"
+#include "MStringf.h"
+
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static bool isUnixAddress( const String &address )
+{
+    return address.length() > 5 && address.substring( 0, 5 ) == "unix:";
+}
+
+static void fillUnixAddress( const String &address, struct sockaddr_un &unixAddress )
+{
+    String path = address.substring( 5, address.length() - 5 );
+    if ( path.length() >= sizeof( unixAddress.sun_path ) )
+        throw CommonError( CommonError::INVALID_SOCKET_ADDRESS, address.ascii() );
+
+    memset( &unixAddress, 0, sizeof( unixAddress ) );
+    unixAddress.sun_family = AF_UNIX;
+    strncpy( unixAddress.sun_path, path.ascii(), sizeof( unixAddress.sun_path ) - 1 );
+}
+
+/*
+  Resolve a TCP address of the form <host>:<port> or <port>. The caller
+  frees the result with freeaddrinfo.
+*/
+static struct addrinfo *resolveTcpAddress( const String &address, bool passive )
+{
+    String host;
+    String port = address;
+    size_t separator = address.find( ":" );
+    if ( separator != std::string::npos )
+    {
+        host = address.substring( 0, separator );
+        port = address.substring( separator + 1, address.length() - separator - 1 );
+    }
+
+    if ( port.length() == 0 )
+        throw CommonError( CommonError::INVALID_SOCKET_ADDRESS, address.ascii() );
+
+    struct addrinfo hints;
+    memset( &hints, 0, sizeof( hints ) );
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if ( passive )
+        hints.ai_flags = AI_PASSIVE;
+
+    struct addrinfo *result = NULL;
+    const char *hostName = host.length() > 0 ? host.ascii() : ( passive ? NULL : "localhost" );
+    if ( getaddrinfo( hostName, port.ascii(), &hints, &result ) != 0 || result == NULL )
+        throw CommonError( CommonError::INVALID_SOCKET_ADDRESS, address.ascii() );
+
+    return result;
+}
+
+Socket::Socket( int descriptor )
+    : _descriptor( descriptor )
+{
+}
+
+Socket::~Socket()
+{
+    close();
+}
+
+std::unique_ptr<Socket> Socket::listen( const String &address )
+{
+    enum {
+        BACKLOG = 128,
+    };
+
+    int descriptor = NO_DESCRIPTOR;
+    if ( isUnixAddress( address ) )
+    {
+        struct sockaddr_un unixAddress;
+        fillUnixAddress( address, unixAddress );
+        unlink( unixAddress.sun_path );
+
+        descriptor = socket( AF_UNIX, SOCK_STREAM, 0 );
+        if ( descriptor == NO_DESCRIPTOR )
+            throw CommonError( CommonError::SOCKET_CREATION_FAILED, address.ascii() );
+
+        if ( bind( descriptor, (struct sockaddr *)&unixAddress, sizeof( unixAddress ) ) != 0 )
+        {
+            ::close( descriptor );
+            throw CommonError( CommonError::SOCKET_BIND_FAILED, address.ascii() );
+        }
+    }
+    else
+    {
+        struct addrinfo *addresses = resolveTcpAddress( address, true );
+        for ( struct addrinfo *it = addresses; it != NULL; it = it->ai_next )
+        {
+            descriptor = socket( it->ai_family, it->ai_socktype, it->ai_protocol );
+            if ( descriptor == NO_DESCRIPTOR )
+                continue;
+
+            int reuse = 1;
+            setsockopt( descriptor, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof( reuse ) );
+            if ( bind( descriptor, it->ai_addr, it->ai_addrlen ) == 0 )
+                break;
+
+            ::close( descriptor );
+            descriptor = NO_DESCRIPTOR;
+        }
+        freeaddrinfo( addresses );
+
+        if ( descriptor == NO_DESCRIPTOR )
+            throw CommonError( CommonError::SOCKET_BIND_FAILED, address.ascii() );
+    }
+
+    if ( ::listen( descriptor, BACKLOG ) != 0 )
+    {
+        ::close( descriptor );
+        throw CommonError( CommonError::SOCKET_BIND_FAILED, address.ascii() );
+    }
+
+    return std::unique_ptr<Socket>( new Socket( descriptor ) );
+}
+
+std::unique_ptr<Socket> Socket::connect( const String &address )
+{
+    int descriptor = NO_DESCRIPTOR;
+    if ( isUnixAddress( address ) )
+    {
+        struct sockaddr_un unixAddress;
+        fillUnixAddress( address, unixAddress );
+
+        descriptor = socket( AF_UNIX, SOCK_STREAM, 0 );
+        if ( descriptor == NO_DESCRIPTOR )
+            throw CommonError( CommonError::SOCKET_CREATION_FAILED, address.ascii() );
+
+        if ( ::connect( descriptor, (struct sockaddr *)&unixAddress, sizeof( unixAddress ) ) !=
+             0 )
+        {
+            ::close( descriptor );
+            throw CommonError( CommonError::SOCKET_CONNECT_FAILED, address.ascii() );
+        }
+    }
+    else
+    {
+        struct addrinfo *addresses = resolveTcpAddress( address, false );
+        for ( struct addrinfo *it = addresses; it != NULL; it = it->ai_next )
+        {
+            descriptor = socket( it->ai_family, it->ai_socktype, it->ai_protocol );
+            if ( descriptor == NO_DESCRIPTOR )
+                continue;
+
+            if ( ::connect( descriptor, it->ai_addr, it->ai_addrlen ) == 0 )
+                break;
+
+            ::close( descriptor );
+            descriptor = NO_DESCRIPTOR;
+        }
+        freeaddrinfo( addresses );
+
+        if ( descriptor == NO_DESCRIPTOR )
+            throw CommonError( CommonError::SOCKET_CONNECT_FAILED, address.ascii() );
+    }
+
+    return std::unique_ptr<Socket>( new Socket( descriptor ) );
+}
+
+std::unique_ptr<Socket> Socket::accept()
+{
+    int descriptor = ::accept( _descriptor, NULL, NULL );
+    if ( descriptor == NO_DESCRIPTOR )
+        throw CommonError( CommonError::SOCKET_ACCEPT_FAILED );
+
+    return std::unique_ptr<Socket>( new Socket( descriptor ) );
+}
+
+bool Socket::waitForInput( unsigned timeoutInMilliseconds )
+{
+    if ( !_pendingLines.empty() )
+        return true;
+
+    struct pollfd request;
+    request.fd = _descriptor;
+    request.events = POLLIN;
+    request.revents = 0;
+
+    int result = poll( &request, 1, (int)timeoutInMilliseconds );
+    return result > 0;
+}
+
+void Socket::sendLine( const String &line )
+{
+    std::lock_guard<std::mutex> lock( _sendMutex );
+
+    std::string data = std::string( line.ascii() ) + "\n";
+    size_t sent = 0;
+    while ( sent < data.size() )
+    {
+        ssize_t result =
+            send( _descriptor, data.c_str() + sent, data.size() - sent, MSG_NOSIGNAL );
+        if ( result < 0 )
+        {
+            if ( errno == EINTR )
+                continue;
+            throw CommonError( CommonError::SOCKET_SEND_FAILED );
+        }
+        sent += result;
+    }
+}
+
+bool Socket::receiveLines( List<String> &lines )
+{
+    enum {
+        SIZE_OF_BUFFER = 65536,
+    };
+
+    if ( _pendingLines.empty() )
+    {
+        char buffer[SIZE_OF_BUFFER];
+        ssize_t bytesRead = 0;
+        do
+        {
+            bytesRead = read( _descriptor, buffer, SIZE_OF_BUFFER );
+        }
+        while ( bytesRead < 0 && errno == EINTR );
+
+        if ( bytesRead <= 0 )
+            return false;
+
+        _receiveBuffer.append( buffer, bytesRead );
+        extractLines();
+    }
+
+    lines.append( _pendingLines );
+    _pendingLines.clear();
+    return true;
+}
+
+bool Socket::receiveLine( String &line )
+{
+    while ( _pendingLines.empty() )
+    {
+        List<String> lines;
+        if ( !receiveLines( lines ) )
+            return false;
+        _pendingLines = lines;
+    }
+
+    line = _pendingLines.front();
+    _pendingLines.erase( _pendingLines.begin() );
+    return true;
+}
+
+int Socket::getDescriptor() const
+{
+    return _descriptor;
+}
+
+void Socket::close()
+{
+    if ( _descriptor != NO_DESCRIPTOR )
+    {
+        ::close( _descriptor );
+        _descriptor = NO_DESCRIPTOR;
+    }
+}
+
+void Socket::extractLines()
+{
+    size_t start = 0;
+    size_t end = _receiveBuffer.find( '\n', start );
+    while ( end != std::string::npos )
+    {
+        _pendingLines.append( String( _receiveBuffer.substr( start, end - start ) ) );
+        start = end + 1;
+        end = _receiveBuffer.find( '\n', start );
+    }
+    _receiveBuffer.erase( 0, start );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
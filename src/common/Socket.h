@@ -0,0 +1,114 @@
+/*********************                                                        */
+/*! \file Socket.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A stream socket over which newline-terminated text messages are
+ ** exchanged. Addresses are either "unix:<path>" for Unix domain sockets,
+ ** or "<host>:<port>" (or just "<port>") for TCP sockets.
+
+ **/
+
+#ifndef __Socket_h__
+#define __Socket_h__
+
+#include "List.h"
+#include "MString.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+class Socket
+{
+public:
+    enum {
+        NO_DESCRIPTOR = -1,
+    };
+
+    /*
+      Take ownership of an already connected socket descriptor.
+    */
+    Socket( int descriptor );
+    ~Socket();
+
+    /*
+      Create a socket that listens for connections on the given address.
+      An existing Unix domain socket file at the same path is replaced.
+    */
+    static std::unique_ptr<Socket> listen( const String &address );
+
+    /*
+      Connect to a listening socket at the given address.
+    */
+    static std::unique_ptr<Socket> connect( const String &address );
+
+    /*
+      Accept a pending connection on a listening socket.
+    */
+    std::unique_ptr<Socket> accept();
+
+    /*
+      Return true if a line can be retrieved without blocking, waiting at
+      most the given number of milliseconds for data to arrive.
+    */
+    bool waitForInput( unsigned timeoutInMilliseconds );
+
+    /*
+      Send a line. The line must not contain a newline character. Safe to
+      call concurrently from multiple threads.
+    */
+    void sendLine( const String &line );
+
+    /*
+      Read whatever data is available (blocking if there is none), and
+      append the complete lines received so far. Return false if the peer
+      has closed the connection.
+    */
+    bool receiveLines( List<String> &lines );
+
+    /*
+      Block until a complete line arrives. Return false if the peer closed
+      the connection first.
+    */
+    bool receiveLine( String &line );
+
+    int getDescriptor() const;
+    void close();
+
+private:
+    int _descriptor;
+
+    /*
+      Data received after the last complete line
+    */
+    std::string _receiveBuffer;
+
+    /*
+      Complete lines that were received but not yet retrieved
+    */
+    List<String> _pendingLines;
+
+    std::mutex _sendMutex;
+
+    /*
+      Split the receive buffer into complete lines
+    */
+    void extractLines();
+};
+
+#endif // __Socket_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
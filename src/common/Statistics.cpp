@@ -42,6 +42,7 @@ Statistics::Statistics()
     _unsignedAttributes[TOTAL_NUMBER_OF_VALID_CASE_SPLITS] = 0;
     _unsignedAttributes[NUM_CERTIFIED_LEAVES] = 0;
     _unsignedAttributes[NUM_DELEGATED_LEAVES] = 0;
+    _unsignedAttributes[NUM_ROOT_BOUNDS_ADOPTED] = 0;
 
     _longAttributes[NUM_MAIN_LOOP_ITERATIONS] = 0;
     _longAttributes[NUM_SIMPLEX_STEPS] = 0;
@@ -60,6 +61,7 @@ Statistics::Statistics()
     _longAttributes[NUM_TABLEAU_BOUND_HOPPING] = 0;
     _longAttributes[NUM_TIGHTENED_BOUNDS] = 0;
     _longAttributes[NUM_TIGHTENINGS_FROM_SYMBOLIC_BOUND_TIGHTENING] = 0;
+    _longAttributes[MAX_SYMBOLIC_BOUND_TIGHTENING_MEMORY] = 0;
     _longAttributes[NUM_ROWS_EXAMINED_BY_ROW_TIGHTENER] = 0;
     _longAttributes[NUM_TIGHTENINGS_FROM_ROWS] = 0;
     _longAttributes[NUM_BOUND_TIGHTENINGS_ON_EXPLICIT_BASIS] = 0;
@@ -278,6 +280,8 @@ void Statistics::print()
             getDoubleAttribute( Statistics::CURRENT_DEGRADATION ),
             getDoubleAttribute( Statistics::MAX_DEGRADATION ),
             getUnsignedAttribute( Statistics::NUM_PRECISION_RESTORATIONS ) );
+    printf( "\tRoot bounds adopted from other engines: %u\n",
+            getUnsignedAttribute( Statistics::NUM_ROOT_BOUNDS_ADOPTED ) );
     printf( "\tNumber of simplex pivots we attempted to skip because of instability: %llu.\n"
             "\tUnstable pivots performed anyway: %llu\n",
             getLongAttribute( Statistics::NUM_SIMPLEX_PIVOT_SELECTIONS_IGNORED_FOR_STABILITY ),
@@ -361,6 +365,8 @@ void Statistics::print()
     printf( "\t--- SBT ---\n" );
     printf( "\tNumber of tightened bounds: %llu\n",
             getLongAttribute( Statistics::NUM_TIGHTENINGS_FROM_SYMBOLIC_BOUND_TIGHTENING ) );
+    printf( "\tPeak memory of the symbolic bounds: %llu bytes\n",
+            getLongAttribute( Statistics::MAX_SYMBOLIC_BOUND_TIGHTENING_MEMORY ) );
 
     printf( "\t--- SoI-based local search ---\n" );
     unsigned long long num_proposed_phase_pattern_update =
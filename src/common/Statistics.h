@@ -70,6 +70,10 @@ public:
         // Total number of delegated and certified leaves in the search tree
         NUM_CERTIFIED_LEAVES,
         NUM_DELEGATED_LEAVES,
+
+        // Number of bounds proved at the root by other engines of a
+        // portfolio and adopted by this one
+        NUM_ROOT_BOUNDS_ADOPTED,
     };
 
     enum StatisticsLongAttribute {
@@ -131,6 +135,10 @@ public:
         // The number of bounds tightened via symbolic bound tightening
         NUM_TIGHTENINGS_FROM_SYMBOLIC_BOUND_TIGHTENING,
 
+        // The peak memory, in bytes, of the symbolic bounds kept by symbolic
+        // bound tightening
+        MAX_SYMBOLIC_BOUND_TIGHTENING_MEMORY,
+
         // Number of pivot rows examined by the row tightener, and consequent
         // tightenings proposed.
         NUM_ROWS_EXAMINED_BY_ROW_TIGHTENER,
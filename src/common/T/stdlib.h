@@ -17,6 +17,8 @@
 #ifndef __T__Stdlib_h__
 #define __T__Stdlib_h__
 
+#include "ThreadLocalRandom.h"
+
 #include <cxxtest/Mock.h>
 #include <stdlib.h>
 
@@ -26,9 +28,10 @@ CXXTEST_MOCK_VOID_GLOBAL( free, ( void *ptr ), ( ptr ) );
 
 CXXTEST_MOCK_GLOBAL( void *, realloc, ( void *ptr, size_t size ), ( ptr, size ) );
 
-CXXTEST_MOCK_VOID_GLOBAL( srand, ( unsigned seed ), ( seed ) );
+// Each thread draws from its own generator, see ThreadLocalRandom.h
+CXXTEST_MOCK_VOID( srand, srand, ( unsigned seed ), ThreadLocalRandom::seed, ( seed ) );
 
-CXXTEST_MOCK_GLOBAL( int, rand, (), () );
+CXXTEST_MOCK( rand, int, rand, (), ThreadLocalRandom::rand, () );
 
 #endif // __T__Stdlib_h__
 
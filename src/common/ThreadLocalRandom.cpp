@@ -0,0 +1,39 @@
+/*********************                                                        */
+/*! \file ThreadLocalRandom.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "ThreadLocalRandom.h"
+
+#include <cstdlib>
+#include <random>
+
+static thread_local std::mt19937 generator( 1 );
+
+void ThreadLocalRandom::seed( unsigned seed )
+{
+    generator.seed( seed );
+}
+
+int ThreadLocalRandom::rand()
+{
+    return (int)( generator() % ( (unsigned long long)RAND_MAX + 1 ) );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,46 @@
+/*********************                                                        */
+/*! \file ThreadLocalRandom.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A replacement for rand and srand with a separate state in each thread,
+ ** so that the numbers drawn by a thread depend only on its own seed and
+ ** not on how threads are scheduled. This is the real implementation of
+ ** T::rand and T::srand.
+
+ **/
+
+#ifndef __ThreadLocalRandom_h__
+#define __ThreadLocalRandom_h__
+
+class ThreadLocalRandom
+{
+public:
+    /*
+      Seed the generator of the calling thread. Threads that never call
+      this behave as if seeded with 1, like rand.
+    */
+    static void seed( unsigned seed );
+
+    /*
+      A number between 0 and RAND_MAX drawn from the generator of the
+      calling thread
+    */
+    static int rand();
+};
+
+#endif // __ThreadLocalRandom_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,119 @@
+/*********************                                                        */
+/*! \file ThreadPool.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool( unsigned numberOfThreads )
+    : _task( nullptr )
+    , _numberOfTasks( 0 )
+    , _nextTask( 0 )
+    , _activeWorkers( 0 )
+    , _generation( 0 )
+    , _stop( false )
+{
+    for ( unsigned i = 1; i < numberOfThreads; ++i )
+        _workers.push_back( std::thread( &ThreadPool::workerLoop, this ) );
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _stop = true;
+    }
+    _workAvailable.notify_all();
+    for ( auto &worker : _workers )
+        worker.join();
+}
+
+unsigned ThreadPool::getNumberOfThreads() const
+{
+    return _workers.size() + 1;
+}
+
+void ThreadPool::run( unsigned numberOfTasks, const std::function<void( unsigned )> &task )
+{
+    if ( numberOfTasks == 0 )
+        return;
+
+    std::unique_lock<std::mutex> lock( _mutex );
+    _task = &task;
+    _numberOfTasks = numberOfTasks;
+    _nextTask = 0;
+    _error = nullptr;
+    _activeWorkers = _workers.size();
+    ++_generation;
+    _workAvailable.notify_all();
+
+    runTasks( lock );
+
+    // Wait for the workers to finish their tasks, so that the task can be
+    // safely destroyed once this returns
+    _workDone.wait( lock, [this]() { return _activeWorkers == 0; } );
+    _task = nullptr;
+
+    if ( _error )
+    {
+        std::exception_ptr error = _error;
+        _error = nullptr;
+        std::rethrow_exception( error );
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    unsigned long long generation = 0;
+    std::unique_lock<std::mutex> lock( _mutex );
+    while ( true )
+    {
+        _workAvailable.wait( lock, [&]() { return _stop || _generation != generation; } );
+        if ( _stop )
+            return;
+
+        generation = _generation;
+        runTasks( lock );
+        if ( --_activeWorkers == 0 )
+            _workDone.notify_all();
+    }
+}
+
+void ThreadPool::runTasks( std::unique_lock<std::mutex> &lock )
+{
+    while ( _nextTask < _numberOfTasks && !_error )
+    {
+        unsigned task = _nextTask++;
+        lock.unlock();
+        std::exception_ptr error = nullptr;
+        try
+        {
+            ( *_task )( task );
+        }
+        catch ( ... )
+        {
+            error = std::current_exception();
+        }
+        lock.lock();
+        if ( error && !_error )
+            _error = error;
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
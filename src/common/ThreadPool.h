@@ -0,0 +1,85 @@
+/*********************                                                        */
+/*! \file ThreadPool.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A fixed set of worker threads that run the tasks of a parallel loop
+ ** together with the calling thread. The workers are started once and wait
+ ** for work between loops, so that short loops that run often do not pay
+ ** for creating threads.
+
+ **/
+
+#ifndef __ThreadPool_h__
+#define __ThreadPool_h__
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    /*
+      A pool in which loops run on numberOfThreads threads, the calling
+      thread included
+    */
+    ThreadPool( unsigned numberOfThreads );
+    ~ThreadPool();
+
+    unsigned getNumberOfThreads() const;
+
+    /*
+      Call task( i ) for every i in [0, numberOfTasks), and return when all
+      calls have returned. If a call throws, the remaining tasks are
+      skipped, and the first exception is rethrown in the calling thread.
+      Loops may not be nested.
+    */
+    void run( unsigned numberOfTasks, const std::function<void( unsigned )> &task );
+
+private:
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::condition_variable _workDone;
+
+    /*
+      The current loop. _generation is incremented when a loop starts, and
+      each worker joins every loop once.
+    */
+    const std::function<void( unsigned )> *_task;
+    unsigned _numberOfTasks;
+    unsigned _nextTask;
+    unsigned _activeWorkers;
+    unsigned long long _generation;
+    std::exception_ptr _error;
+    bool _stop;
+
+    void workerLoop();
+
+    /*
+      Run tasks of the current loop until none are left. Called with the
+      lock held, which is released while a task runs.
+    */
+    void runTasks( std::unique_lock<std::mutex> &lock );
+};
+
+#endif // __ThreadPool_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -54,6 +54,22 @@ public:
         TS_ASSERT( matC[4] == 23 );
         TS_ASSERT( matC[5] == 34 );
     }
+
+    void test_single_precision()
+    {
+        float matA[] = { 1, 2, 3, 4, 5, 6 }; // [1,2], [3,4], [5,6]
+        float matB[] = { 1, 2, 3, 4 };       // [1,2], [3,4]
+        float matC[6] = { 1, 0, 0, 0, 0, 0 };
+        matrixMultiplication( matA, matB, matC, 3, 2, 2 );
+
+        // The product is added to matC
+        TS_ASSERT( matC[0] == 8 );
+        TS_ASSERT( matC[1] == 10 );
+        TS_ASSERT( matC[2] == 15 );
+        TS_ASSERT( matC[3] == 22 );
+        TS_ASSERT( matC[4] == 23 );
+        TS_ASSERT( matC[5] == 34 );
+    }
 };
 
 //
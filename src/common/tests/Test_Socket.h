@@ -0,0 +1,99 @@
+/*********************                                                        */
+/*! \file Test_Socket.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "CommonError.h"
+#include "MStringf.h"
+#include "MockErrno.h"
+#include "Socket.h"
+
+#include <cxxtest/TestSuite.h>
+#include <unistd.h>
+
+class SocketTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockErrno *mockErrno;
+    String _address;
+
+    void setUp()
+    {
+        TS_ASSERT( mockErrno = new MockErrno );
+        _address = Stringf( "unix:/tmp/Test_Socket.%u.sock", (unsigned)getpid() );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mockErrno );
+        unlink( _address.substring( 5, _address.length() - 5 ).ascii() );
+    }
+
+    void test_exchange_lines()
+    {
+        std::unique_ptr<Socket> listener;
+        TS_ASSERT_THROWS_NOTHING( listener = Socket::listen( _address ) );
+
+        std::unique_ptr<Socket> client;
+        TS_ASSERT_THROWS_NOTHING( client = Socket::connect( _address ) );
+
+        std::unique_ptr<Socket> server;
+        TS_ASSERT( listener->waitForInput( 1000 ) );
+        TS_ASSERT_THROWS_NOTHING( server = listener->accept() );
+
+        TS_ASSERT( !server->waitForInput( 0 ) );
+
+        client->sendLine( "first line" );
+        client->sendLine( "" );
+        client->sendLine( "third" );
+
+        String line;
+        TS_ASSERT( server->receiveLine( line ) );
+        TS_ASSERT_EQUALS( line, "first line" );
+        TS_ASSERT( server->receiveLine( line ) );
+        TS_ASSERT_EQUALS( line, "" );
+
+        // The remaining line has already been read from the socket
+        TS_ASSERT( server->waitForInput( 0 ) );
+        List<String> lines;
+        TS_ASSERT( server->receiveLines( lines ) );
+        TS_ASSERT_EQUALS( lines, List<String>( { "third" } ) );
+
+        // A long line arrives in several reads
+        String longLine;
+        for ( unsigned i = 0; i < 20000; ++i )
+            longLine += Stringf( "%u ", i );
+        server->sendLine( longLine );
+        TS_ASSERT( client->receiveLine( line ) );
+        TS_ASSERT_EQUALS( line, longLine );
+
+        // Closing one end is observed by the other
+        client->close();
+        lines.clear();
+        TS_ASSERT( !server->receiveLines( lines ) );
+        TS_ASSERT( lines.empty() );
+    }
+
+    void test_connect_failures()
+    {
+        TS_ASSERT_THROWS_EQUALS( Socket::connect( _address ),
+                                 const CommonError &e,
+                                 e.getCode(),
+                                 CommonError::SOCKET_CONNECT_FAILED );
+
+        TS_ASSERT_THROWS_EQUALS( Socket::connect( "localhost:" ),
+                                 const CommonError &e,
+                                 e.getCode(),
+                                 CommonError::INVALID_SOCKET_ADDRESS );
+    }
+};
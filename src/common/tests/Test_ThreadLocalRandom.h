@@ -0,0 +1,85 @@
+/*********************                                                        */
+/*! \file Test_ThreadLocalRandom.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "ThreadLocalRandom.h"
+
+#include <cstdlib>
+#include <cxxtest/TestSuite.h>
+#include <thread>
+#include <vector>
+
+class ThreadLocalRandomTestSuite : public CxxTest::TestSuite
+{
+public:
+    static std::vector<int> draw( unsigned seed, unsigned count )
+    {
+        ThreadLocalRandom::seed( seed );
+        std::vector<int> numbers;
+        for ( unsigned i = 0; i < count; ++i )
+            numbers.push_back( ThreadLocalRandom::rand() );
+        return numbers;
+    }
+
+    void test_same_seed_same_sequence()
+    {
+        std::vector<int> first = draw( 7, 100 );
+        std::vector<int> second = draw( 7, 100 );
+        TS_ASSERT_EQUALS( first, second );
+        TS_ASSERT_DIFFERS( first, draw( 8, 100 ) );
+
+        for ( const auto &number : first )
+        {
+            TS_ASSERT( number >= 0 );
+            TS_ASSERT( number <= RAND_MAX );
+        }
+    }
+
+    void test_threads_do_not_interfere()
+    {
+        std::vector<int> expected = draw( 3, 1000 );
+
+        // Each thread draws from its own generator, regardless of how the
+        // threads interleave
+        std::vector<std::vector<int>> results( 4 );
+        std::vector<std::thread> threads;
+        for ( unsigned i = 0; i < 4; ++i )
+            threads.push_back(
+                std::thread( [&results, i]() { results[i] = draw( 3, 1000 ); } ) );
+        for ( auto &thread : threads )
+            thread.join();
+
+        for ( const auto &result : results )
+            TS_ASSERT_EQUALS( result, expected );
+    }
+
+    void test_unseeded_thread_starts_from_the_default_seed()
+    {
+        std::vector<int> unseeded;
+        std::thread( [&unseeded]() {
+            for ( unsigned i = 0; i < 10; ++i )
+                unseeded.push_back( ThreadLocalRandom::rand() );
+        } ).join();
+
+        TS_ASSERT_EQUALS( unseeded, draw( 1, 10 ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
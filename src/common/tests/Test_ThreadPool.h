@@ -0,0 +1,69 @@
+/*********************                                                        */
+/*! \file Test_ThreadPool.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <cxxtest/TestSuite.h>
+#include <stdexcept>
+#include <vector>
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite
+{
+public:
+    void test_every_task_runs_once()
+    {
+        for ( unsigned numberOfThreads : { 1, 2, 4 } )
+        {
+            ThreadPool pool( numberOfThreads );
+            TS_ASSERT_EQUALS( pool.getNumberOfThreads(), numberOfThreads );
+
+            // The pool is reused across loops of different sizes
+            for ( unsigned numberOfTasks : { 0, 1, 3, 100 } )
+            {
+                std::vector<std::atomic<unsigned>> calls( numberOfTasks );
+                for ( auto &count : calls )
+                    count = 0;
+                pool.run( numberOfTasks, [&]( unsigned i ) { ++calls[i]; } );
+                for ( const auto &count : calls )
+                    TS_ASSERT_EQUALS( count.load(), 1u );
+            }
+        }
+    }
+
+    void test_exceptions_are_rethrown()
+    {
+        ThreadPool pool( 3 );
+        TS_ASSERT_THROWS( pool.run( 10,
+                                    []( unsigned i ) {
+                                        if ( i == 5 )
+                                            throw std::runtime_error( "task failed" );
+                                    } ),
+                          const std::runtime_error & );
+
+        // The pool still works after a failed loop
+        std::atomic<unsigned> sum( 0 );
+        pool.run( 10, [&]( unsigned i ) { sum += i; } );
+        TS_ASSERT_EQUALS( sum.load(), 45u );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
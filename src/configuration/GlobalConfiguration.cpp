@@ -67,6 +67,8 @@ const unsigned GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS =
 const double GlobalConfiguration::COST_FUNCTION_ERROR_THRESHOLD = 0.0000000001;
 
 const unsigned GlobalConfiguration::SIMULATION_RANDOM_SEED = 1;
+const unsigned GlobalConfiguration::NLR_BATCH_EVALUATION_SIZE = 1024;
+const double GlobalConfiguration::NLR_SPARSE_WEIGHTS_MAXIMUM_DENSITY = 0.1;
 
 const bool GlobalConfiguration::USE_HARRIS_RATIO_TEST = true;
 
@@ -74,6 +76,11 @@ const double GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT = 0.0000
 
 const double GlobalConfiguration::SIGMOID_CUTOFF_CONSTANT = 20;
 
+const unsigned GlobalConfiguration::DEEP_POLY_SLOPE_OPTIMIZATION_ITERATIONS = 20;
+const double GlobalConfiguration::DEEP_POLY_SLOPE_OPTIMIZATION_STEP_SIZE = 0.5;
+const double GlobalConfiguration::DEEP_POLY_SLOPE_OPTIMIZATION_STEP_DECAY = 0.9;
+const unsigned GlobalConfiguration::DEEP_POLY_PARALLEL_MINIMUM_BLOCK_SIZE = 16;
+
 const bool GlobalConfiguration::PREPROCESS_INPUT_QUERY = true;
 const bool GlobalConfiguration::PREPROCESSOR_ELIMINATE_VARIABLES = true;
 const bool GlobalConfiguration::PL_CONSTRAINTS_ADD_AUX_EQUATIONS_AFTER_PREPROCESSING = true;
@@ -110,6 +117,11 @@ const unsigned GlobalConfiguration::POLARITY_CANDIDATES_THRESHOLD = 5;
 
 const unsigned GlobalConfiguration::DNC_DEPTH_THRESHOLD = 5;
 
+const unsigned GlobalConfiguration::DNC_HEARTBEAT_INTERVAL_IN_MILLISECONDS = 1000;
+const unsigned GlobalConfiguration::DNC_HEARTBEAT_TIMEOUT_IN_MILLISECONDS = 30000;
+const unsigned GlobalConfiguration::DNC_WORKER_CONNECTION_ATTEMPTS = 30;
+const unsigned GlobalConfiguration::DNC_DETERMINISTIC_ITERATIONS_PER_SECOND = 5000;
+
 const double GlobalConfiguration::MINIMAL_COEFFICIENT_FOR_TIGHTENING = 0.01;
 const double GlobalConfiguration::LEMMA_CERTIFICATION_TOLERANCE = 0.000001;
 const bool GlobalConfiguration::WRITE_JSON_PROOF = false;
@@ -151,6 +151,13 @@ public:
     // Random seed for generating simulation values.
     static const unsigned SIMULATION_RANDOM_SEED;
 
+    // The number of samples a thread evaluates at once when evaluating the network on a batch
+    static const unsigned NLR_BATCH_EVALUATION_SIZE;
+
+    // Weight matrices of the network with at most this fraction of non-zero entries (e.g., those
+    // of convolutions) are stored and multiplied in sparse form
+    static const double NLR_SPARSE_WEIGHTS_MAXIMUM_DENSITY;
+
     // How often should projected steepest edge reset the reference space?
     static const unsigned PSE_ITERATIONS_BEFORE_RESET;
 
@@ -200,6 +207,17 @@ public:
 
     static const double SIGMOID_CUTOFF_CONSTANT;
 
+    // The number of projected gradient ascent steps taken on the lower relaxation slopes when
+    // DeepPoly slope optimization is on, the size of the first step (relative to the largest
+    // gradient entry), and the factor by which each step is smaller than the previous one
+    static const unsigned DEEP_POLY_SLOPE_OPTIMIZATION_ITERATIONS;
+    static const double DEEP_POLY_SLOPE_OPTIMIZATION_STEP_SIZE;
+    static const double DEEP_POLY_SLOPE_OPTIMIZATION_STEP_DECAY;
+
+    // The smallest number of neurons of a layer that parallel DeepPoly
+    // back-substitutes on one thread
+    static const unsigned DEEP_POLY_PARALLEL_MINIMUM_BLOCK_SIZE;
+
     /*
       Constraint fixing heuristics
     */
@@ -237,6 +255,23 @@ public:
      */
     static const unsigned DNC_DEPTH_THRESHOLD;
 
+    /* In distributed DnC mode, workers send a heartbeat to the coordinator at this interval.
+       A worker that is silent for longer than the timeout is considered lost, and its
+       subqueries are reassigned to other workers.
+     */
+    static const unsigned DNC_HEARTBEAT_INTERVAL_IN_MILLISECONDS;
+    static const unsigned DNC_HEARTBEAT_TIMEOUT_IN_MILLISECONDS;
+
+    /* The number of attempts (one per second) a distributed DnC worker makes to connect to
+       the coordinator
+     */
+    static const unsigned DNC_WORKER_CONNECTION_ATTEMPTS;
+
+    /* In deterministic DnC mode, subquery timeouts are converted into budgets of main loop
+       iterations at this rate
+     */
+    static const unsigned DNC_DETERMINISTIC_ITERATIONS_PER_SECOND;
+
     /* Minimal coefficient of a variable in a Tableau row, that is used for bound tightening
      */
     static const double MINIMAL_COEFFICIENT_FOR_TIGHTENING;
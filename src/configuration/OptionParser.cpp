@@ -94,6 +94,19 @@ void OptionParser::initialize()
         boost::program_options::bool_switch( &( ( *_boolOptions )[Options::DNC_MODE] ) )
             ->default_value( ( *_boolOptions )[Options::DNC_MODE] ),
         "Use the split-and-conquer solving mode." )(
+        "dnc-listen",
+        boost::program_options::value<std::string>(
+            &( ( *_stringOptions )[Options::DNC_LISTEN_ADDRESS] ) )
+            ->default_value( ( *_stringOptions )[Options::DNC_LISTEN_ADDRESS] ),
+        "Coordinate a distributed split-and-conquer solve: hand out subqueries to worker "
+        "processes connecting to this address (unix:<path> or [<host>:]<port>). --num-workers "
+        "local worker processes are started as well." )(
+        "dnc-connect",
+        boost::program_options::value<std::string>(
+            &( ( *_stringOptions )[Options::DNC_CONNECT_ADDRESS] ) )
+            ->default_value( ( *_stringOptions )[Options::DNC_CONNECT_ADDRESS] ),
+        "Act as a worker of a distributed split-and-conquer solve, whose coordinator listens on "
+        "this address. The network and property must be the same as the coordinator's." )(
         "seed",
         boost::program_options::value<int>( &( ( *_intOptions )[Options::SEED] ) )
             ->default_value( ( *_intOptions )[Options::SEED] ),
@@ -110,6 +123,11 @@ void OptionParser::initialize()
         boost::program_options::value<std::string>( &( *_stringOptions )[Options::QUERY_DUMP_FILE] )
             ->default_value( ( *_stringOptions )[Options::QUERY_DUMP_FILE] ),
         "Dump the verification query in Marabou's input query format." )(
+        "query-dump-binary",
+        boost::program_options::bool_switch( &( ( *_boolOptions )[Options::QUERY_DUMP_BINARY] ) )
+            ->default_value( ( *_boolOptions )[Options::QUERY_DUMP_BINARY] ),
+        "Dump the query to --query-dump-file in the binary input query format, which "
+        "--input-query loads without parsing." )(
         "summary-file",
         boost::program_options::value<std::string>(
             &( ( *_stringOptions )[Options::SUMMARY_FILE] ) )
@@ -136,7 +154,29 @@ void OptionParser::initialize()
         "prove-unsat",
         boost::program_options::bool_switch( &( ( *_boolOptions )[Options::PRODUCE_PROOFS] ) )
             ->default_value( ( *_boolOptions )[Options::PRODUCE_PROOFS] ),
-        "Produce proofs of UNSAT and check them" )
+        "Produce proofs of UNSAT and check them" )(
+        "checkpoint-file",
+        boost::program_options::value<std::string>(
+            &( ( *_stringOptions )[Options::CHECKPOINT_FILE] ) )
+            ->default_value( ( *_stringOptions )[Options::CHECKPOINT_FILE] ),
+        "Periodically store the solving progress in this file, so that an interrupted solve can "
+        "be continued with --resume." )(
+        "checkpoint-interval",
+        boost::program_options::value<int>( &( ( *_intOptions )[Options::CHECKPOINT_INTERVAL] ) )
+            ->default_value( ( *_intOptions )[Options::CHECKPOINT_INTERVAL] ),
+        "The number of seconds between two checkpoints." )(
+        "resume",
+        boost::program_options::bool_switch( &( ( *_boolOptions )[Options::RESUME] ) )
+            ->default_value( ( *_boolOptions )[Options::RESUME] ),
+        "Continue solving from the checkpoint stored in the checkpoint file, skipping the parts "
+        "of the search space already proved UNSAT." )(
+        "preprocessing-cache",
+        boost::program_options::value<std::string>(
+            &( ( *_stringOptions )[Options::PREPROCESSING_CACHE_DIRECTORY] ) )
+            ->default_value( ( *_stringOptions )[Options::PREPROCESSING_CACHE_DIRECTORY] ),
+        "Cache processed queries in this directory, keyed by the contents of the network and "
+        "property files. Later runs on the same files skip parsing, preprocessing and root bound "
+        "tightening." )
 #ifdef ENABLE_GUROBI
 #endif // ENABLE_GUROBI
         ;
@@ -147,6 +187,24 @@ void OptionParser::initialize()
             &( ( *_stringOptions )[Options::SYMBOLIC_BOUND_TIGHTENING_TYPE] ) )
             ->default_value( ( *_stringOptions )[Options::SYMBOLIC_BOUND_TIGHTENING_TYPE] ),
         "type of bound tightening technique to use: sbt/deeppoly/none." )(
+        "deeppoly-optimize-slopes",
+        boost::program_options::bool_switch(
+            &( ( *_boolOptions )[Options::DEEP_POLY_OPTIMIZE_SLOPES] ) )
+            ->default_value( ( *_boolOptions )[Options::DEEP_POLY_OPTIMIZE_SLOPES] ),
+        "Optimize the lower relaxation slopes of the activation functions in DeepPoly by "
+        "gradient ascent on the output bounds, as in alpha-CROWN." )(
+        "deeppoly-split-multipliers",
+        boost::program_options::bool_switch(
+            &( ( *_boolOptions )[Options::DEEP_POLY_OPTIMIZE_SPLIT_MULTIPLIERS] ) )
+            ->default_value( ( *_boolOptions )[Options::DEEP_POLY_OPTIMIZE_SPLIT_MULTIPLIERS] ),
+        "Add the split constraints of the fixed ReLU neurons to DeepPoly with Lagrange "
+        "multipliers optimized by gradient ascent, as in beta-CROWN." )(
+        "deeppoly-single-precision",
+        boost::program_options::bool_switch(
+            &( ( *_boolOptions )[Options::DEEP_POLY_SINGLE_PRECISION] ) )
+            ->default_value( ( *_boolOptions )[Options::DEEP_POLY_SINGLE_PRECISION] ),
+        "Multiply the symbolic bounds by the dense weights in single precision in DeepPoly. "
+        "The rounding error is added to the bounds, which stay sound." )(
         "branch",
         boost::program_options::value<std::string>(
             &( ( *_stringOptions )[Options::SPLITTING_STRATEGY] ) )
@@ -201,10 +259,28 @@ void OptionParser::initialize()
         boost::program_options::bool_switch( &( ( *_boolOptions )[Options::RESTORE_TREE_STATES] ) )
             ->default_value( ( *_boolOptions )[Options::RESTORE_TREE_STATES] ),
         "(SnC) Restore tree states in SnC mode.\n" )(
+        "deterministic",
+        boost::program_options::bool_switch( &( ( *_boolOptions )[Options::DETERMINISTIC_DNC] ) )
+            ->default_value( ( *_boolOptions )[Options::DETERMINISTIC_DNC] ),
+        "(SnC) Make runs reproducible: subqueries are assigned to workers in a fixed order, "
+        "seeded per subquery, and timed out after a number of main loop iterations instead of "
+        "seconds." )(
+        "expand-input-disjunctions",
+        boost::program_options::bool_switch(
+            &( ( *_boolOptions )[Options::EXPAND_INPUT_DISJUNCTIONS] ) )
+            ->default_value( ( *_boolOptions )[Options::EXPAND_INPUT_DISJUNCTIONS] ),
+        "(SnC) Solve each disjunct of a disjunction over the input variables in a VNN-LIB "
+        "property as a separate subquery, instead of branching over the disjunction. Implies "
+        "--snc." )(
         "blas-threads",
         boost::program_options::value<int>( &( ( *_intOptions )[Options::NUM_BLAS_THREADS] ) )
             ->default_value( ( *_intOptions )[Options::NUM_BLAS_THREADS] ),
         "Number of threads to use for matrix multiplication with OpenBLAS." )(
+        "deeppoly-threads",
+        boost::program_options::value<int>( &( ( *_intOptions )[Options::DEEP_POLY_NUM_THREADS] ) )
+            ->default_value( ( *_intOptions )[Options::DEEP_POLY_NUM_THREADS] ),
+        "Number of threads among which DeepPoly splits the back-substitution of each layer. "
+        "Capped so that the threads of all DnC workers and of OpenBLAS fit on the cores." )(
         "reluplex-split-threshold",
         boost::program_options::value<int>(
             &( ( *_intOptions )[Options::CONSTRAINT_VIOLATION_THRESHOLD] ) )
@@ -225,6 +301,11 @@ void OptionParser::initialize()
         boost::program_options::bool_switch( &( *_boolOptions )[Options::PARALLEL_DEEPSOI] )
             ->default_value( ( *_boolOptions )[Options::PARALLEL_DEEPSOI] ),
         "Use the parallel deep-soi solving mode." )(
+        "portfolio",
+        boost::program_options::bool_switch( &( *_boolOptions )[Options::PORTFOLIO] )
+            ->default_value( ( *_boolOptions )[Options::PORTFOLIO] ),
+        "Run a different solver configuration on each worker, until one of them solves the "
+        "query." )(
         "refined-constraints",
         boost::program_options::value<int>(
             &( ( *_intOptions )[Options::NUM_CONSTRAINTS_TO_REFINE_INC_LIN] ) )
@@ -55,6 +55,14 @@ void Options::initializeDefaultValues()
     _boolOptions[DEBUG_ASSIGNMENT] = false;
     _boolOptions[PRODUCE_PROOFS] = false;
     _boolOptions[DO_NOT_MERGE_CONSECUTIVE_WEIGHTED_SUM_LAYERS] = false;
+    _boolOptions[RESUME] = false;
+    _boolOptions[PORTFOLIO] = false;
+    _boolOptions[DETERMINISTIC_DNC] = false;
+    _boolOptions[DEEP_POLY_OPTIMIZE_SLOPES] = false;
+    _boolOptions[DEEP_POLY_OPTIMIZE_SPLIT_MULTIPLIERS] = false;
+    _boolOptions[DEEP_POLY_SINGLE_PRECISION] = false;
+    _boolOptions[QUERY_DUMP_BINARY] = false;
+    _boolOptions[EXPAND_INPUT_DISJUNCTIONS] = false;
 
     /*
       Int options
@@ -70,7 +78,9 @@ void Options::initializeDefaultValues()
     _intOptions[NUMBER_OF_SIMULATIONS] = 100;
     _intOptions[SEED] = 1;
     _intOptions[NUM_BLAS_THREADS] = 1;
+    _intOptions[DEEP_POLY_NUM_THREADS] = 1;
     _intOptions[NUM_CONSTRAINTS_TO_REFINE_INC_LIN] = 30;
+    _intOptions[CHECKPOINT_INTERVAL] = 600;
 
     /*
       Float options
@@ -100,6 +110,10 @@ void Options::initializeDefaultValues()
     _stringOptions[SOI_INITIALIZATION_STRATEGY] = "input-assignment";
     _stringOptions[LP_SOLVER] = gurobiEnabled() ? "gurobi" : "native";
     _stringOptions[SOFTMAX_BOUND_TYPE] = "lse";
+    _stringOptions[DNC_LISTEN_ADDRESS] = "";
+    _stringOptions[DNC_CONNECT_ADDRESS] = "";
+    _stringOptions[CHECKPOINT_FILE] = "";
+    _stringOptions[PREPROCESSING_CACHE_DIRECTORY] = "";
 }
 
 void Options::parseOptions( int argc, char **argv )
@@ -83,6 +83,39 @@ public:
         // logically-consecutive weighted sum layers into a single
         // weighted sum layer, to reduce the number of variables
         DO_NOT_MERGE_CONSECUTIVE_WEIGHTED_SUM_LAYERS,
+
+        // Continue solving from the checkpoint stored in CHECKPOINT_FILE
+        RESUME,
+
+        // When multiple threads are allowed, run a different solver configuration
+        // (branching heuristic, SoI search strategy, symbolic bound tightening,
+        // pricing rule) on each thread. The problem is solved once any of the
+        // threads finishes.
+        PORTFOLIO,
+
+        // Make SnC runs reproducible: fixed assignment of subqueries to workers,
+        // random seeds derived from the subquery ids, and subquery timeouts
+        // measured in main loop iterations instead of seconds
+        DETERMINISTIC_DNC,
+
+        // Optimize the lower relaxation slopes of the activation functions in
+        // DeepPoly by gradient ascent on the bounds of the output layer
+        DEEP_POLY_OPTIMIZE_SLOPES,
+
+        // Add the split constraints of the fixed ReLU neurons to DeepPoly with
+        // Lagrange multipliers optimized by gradient ascent
+        DEEP_POLY_OPTIMIZE_SPLIT_MULTIPLIERS,
+
+        // Multiply the symbolic bounds by the dense weights in single precision
+        // in DeepPoly, accounting for the rounding error in the biases
+        DEEP_POLY_SINGLE_PRECISION,
+
+        // Dump the query in the binary input query format
+        QUERY_DUMP_BINARY,
+
+        // Solve each disjunct of a top-level disjunction over the input
+        // variables of a VNN-LIB property as a separate SnC subquery
+        EXPAND_INPUT_DISJUNCTIONS,
     };
 
     enum IntOptions {
@@ -113,8 +146,15 @@ public:
         // The number of threads to use for OpenBLAS matrix multiplication.
         NUM_BLAS_THREADS,
 
+        // The number of threads among which DeepPoly splits the
+        // back-substitution of each layer
+        DEEP_POLY_NUM_THREADS,
+
         // Maximal number of constraints to refine in incremental linearization
         NUM_CONSTRAINTS_TO_REFINE_INC_LIN,
+
+        // The number of seconds between two checkpoints
+        CHECKPOINT_INTERVAL,
     };
 
     enum FloatOptions {
@@ -155,7 +195,18 @@ public:
         SOI_INITIALIZATION_STRATEGY,
 
         // The procedure/solver for solving the LP
-        LP_SOLVER
+        LP_SOLVER,
+
+        // Distributed DnC: the address on which the coordinator listens for
+        // workers, and the address of the coordinator a worker connects to
+        DNC_LISTEN_ADDRESS,
+        DNC_CONNECT_ADDRESS,
+
+        // The file in which the solving progress is periodically stored
+        CHECKPOINT_FILE,
+
+        // The directory in which processed queries are cached across runs
+        PREPROCESSING_CACHE_DIRECTORY,
     };
 
     /*
@@ -0,0 +1,193 @@
+/*********************                                                        */
+/*! \file Checkpoint.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "Checkpoint.h"
+
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "SubQuerySerializer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+/*
+  A checkpoint is a text file:
+
+    marabou-checkpoint <version>
+    query <fingerprint>
+    engine
+    bounds <case split>
+    state <smt state>
+
+  or, for DnC:
+
+    marabou-checkpoint <version>
+    query <fingerprint>
+    dnc <number of subqueries>
+    <one serialized subquery per line>
+*/
+static const char *CHECKPOINT_HEADER = "marabou-checkpoint 1";
+
+Checkpoint::Checkpoint()
+    : _mode( ENGINE )
+{
+    _smtState._stateId = 0;
+}
+
+Checkpoint::~Checkpoint()
+{
+    for ( auto &stackEntry : _smtState._stack )
+        delete stackEntry;
+    _smtState._stack.clear();
+}
+
+void Checkpoint::write( const String &path ) const
+{
+    String temporaryPath = path + ".tmp";
+    std::ofstream output( temporaryPath.ascii(), std::ios::trunc );
+    if ( !output )
+        throw MarabouError( MarabouError::CHECKPOINT_WRITE_FAILED,
+                            Stringf( "Cannot write checkpoint to %s", temporaryPath.ascii() )
+                                .ascii() );
+
+    output << CHECKPOINT_HEADER << "\n";
+    output << "query " << _queryFingerprint.ascii() << "\n";
+
+    if ( _mode == ENGINE )
+    {
+        std::ostringstream bounds;
+        SubQuerySerializer::serializeCaseSplit( _rootBounds, bounds );
+        std::ostringstream smtState;
+        SubQuerySerializer::serializeSmtState( _smtState, smtState );
+
+        output << "engine\n";
+        output << "bounds " << bounds.str() << "\n";
+        output << "state " << smtState.str() << "\n";
+    }
+    else
+    {
+        output << "dnc " << _subQueries.size() << "\n";
+        for ( const auto &subQuery : _subQueries )
+            output << subQuery.ascii() << "\n";
+    }
+
+    output.close();
+    if ( output.fail() || std::rename( temporaryPath.ascii(), path.ascii() ) != 0 )
+        throw MarabouError( MarabouError::CHECKPOINT_WRITE_FAILED,
+                            Stringf( "Cannot write checkpoint to %s", path.ascii() ).ascii() );
+}
+
+std::unique_ptr<Checkpoint> Checkpoint::read( const String &path )
+{
+    std::ifstream input( path.ascii() );
+    if ( !input )
+        throw MarabouError( MarabouError::FILE_DOES_NOT_EXIST,
+                            Stringf( "Checkpoint %s not found", path.ascii() ).ascii() );
+
+    auto readLine = [&input]() {
+        std::string line;
+        if ( !std::getline( input, line ) )
+            throw MarabouError( MarabouError::INVALID_CHECKPOINT, "Unexpected end of file" );
+        return String( line.c_str() );
+    };
+    auto readField = [&readLine]( const String &name ) {
+        String line = readLine();
+        String prefix = name + " ";
+        if ( line.length() < prefix.length() || line.substring( 0, prefix.length() ) != prefix )
+            throw MarabouError( MarabouError::INVALID_CHECKPOINT,
+                                Stringf( "Expected field %s", name.ascii() ).ascii() );
+        return line.substring( prefix.length(), line.length() - prefix.length() );
+    };
+
+    if ( readLine() != CHECKPOINT_HEADER )
+        throw MarabouError( MarabouError::INVALID_CHECKPOINT, "Unknown checkpoint format" );
+
+    std::unique_ptr<Checkpoint> checkpoint( new Checkpoint );
+    checkpoint->_queryFingerprint = readField( "query" );
+
+    String mode = readLine();
+    if ( mode == "engine" )
+    {
+        checkpoint->_mode = ENGINE;
+
+        std::istringstream bounds( readField( "bounds" ).ascii() );
+        SubQuerySerializer::deserializeCaseSplit( bounds, checkpoint->_rootBounds );
+        std::istringstream smtState( readField( "state" ).ascii() );
+        SubQuerySerializer::deserializeSmtState( smtState, checkpoint->_smtState );
+    }
+    else if ( mode.length() > 4 && mode.substring( 0, 4 ) == "dnc " )
+    {
+        checkpoint->_mode = DNC;
+
+        unsigned numSubQueries = atoi( mode.substring( 4, mode.length() - 4 ).ascii() );
+        for ( unsigned i = 0; i < numSubQueries; ++i )
+            checkpoint->_subQueries.append( readLine() );
+    }
+    else
+        throw MarabouError( MarabouError::INVALID_CHECKPOINT,
+                            Stringf( "Unknown checkpoint mode %s", mode.ascii() ).ascii() );
+
+    return checkpoint;
+}
+
+void Checkpoint::checkCompatibility( Mode mode, const String &queryFingerprint ) const
+{
+    if ( mode != _mode )
+        throw MarabouError( MarabouError::CHECKPOINT_QUERY_MISMATCH,
+                            mode == DNC ? "The checkpoint was not created in DnC mode"
+                                        : "The checkpoint was created in DnC mode" );
+
+    if ( queryFingerprint != _queryFingerprint )
+        throw MarabouError( MarabouError::CHECKPOINT_QUERY_MISMATCH,
+                            Stringf( "The checkpoint was created for a different query (%s, "
+                                     "expected %s)",
+                                     _queryFingerprint.ascii(),
+                                     queryFingerprint.ascii() )
+                                .ascii() );
+}
+
+void UnsolvedSubQueries::add( const SubQuery &subQuery )
+{
+    String serialized = SubQuerySerializer::serializeSubQuery( subQuery );
+    std::lock_guard<std::mutex> lock( _mutex );
+    _subQueries[subQuery._queryId] = serialized;
+}
+
+void UnsolvedSubQueries::remove( const String &queryId )
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    if ( _subQueries.exists( queryId ) )
+        _subQueries.erase( queryId );
+}
+
+void UnsolvedSubQueries::store( Checkpoint &checkpoint ) const
+{
+    checkpoint._mode = Checkpoint::DNC;
+    checkpoint._subQueries.clear();
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    for ( const auto &subQuery : _subQueries )
+        checkpoint._subQueries.append( subQuery.second );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,114 @@
+/*********************                                                        */
+/*! \file Checkpoint.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The progress of a solve, stored on disk so that an interrupted solve can
+ ** be resumed. For the sequential engine, this is the SMT stack and the
+ ** bounds tightened at the root; for DnC, the subqueries not solved yet.
+ ** Either way, the parts of the search space already proved UNSAT are not
+ ** part of the checkpoint.
+
+ **/
+
+#ifndef __Checkpoint_h__
+#define __Checkpoint_h__
+
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "SmtState.h"
+#include "SubQuery.h"
+
+#include <memory>
+#include <mutex>
+
+class Checkpoint
+{
+public:
+    enum Mode {
+        ENGINE = 0,
+        DNC = 1,
+    };
+
+    Checkpoint();
+    ~Checkpoint();
+
+    /*
+      Write the checkpoint to the given file. The file is replaced
+      atomically, so that an interruption never leaves a partial
+      checkpoint behind.
+    */
+    void write( const String &path ) const;
+
+    /*
+      Read a checkpoint from the given file. Throws a MarabouError if the
+      file does not exist or is malformed.
+    */
+    static std::unique_ptr<Checkpoint> read( const String &path );
+
+    /*
+      Throw a MarabouError if the checkpoint was not created for the given
+      mode and preprocessed query.
+    */
+    void checkCompatibility( Mode mode, const String &queryFingerprint ) const;
+
+    Mode _mode;
+
+    /*
+      The fingerprint of the preprocessed query the checkpoint refers to
+    */
+    String _queryFingerprint;
+
+    /*
+      Engine mode: the bounds tightened at the root of the search tree,
+      and the SMT state. The stack entries are owned by the checkpoint
+      until they are handed to the engine.
+    */
+    PiecewiseLinearCaseSplit _rootBounds;
+    SmtState _smtState;
+
+    /*
+      DnC mode: the serialized subqueries not solved yet
+    */
+    List<String> _subQueries;
+};
+
+/*
+  The subqueries of a DnC solve that have not been solved yet, in
+  serialized form. Maintained by the workers when checkpointing is enabled:
+  a subquery is added before it is put in the queue, and removed once it has
+  been proved UNSAT or divided.
+*/
+class UnsolvedSubQueries
+{
+public:
+    void add( const SubQuery &subQuery );
+    void remove( const String &queryId );
+
+    /*
+      Store the unsolved subqueries in a DnC checkpoint
+    */
+    void store( Checkpoint &checkpoint ) const;
+
+private:
+    mutable std::mutex _mutex;
+    Map<String, String> _subQueries;
+};
+
+#endif // __Checkpoint_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,427 @@
+/*********************                                                        */
+/*! \file DnCCoordinator.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "DnCCoordinator.h"
+
+#include "Checkpoint.h"
+#include "CommonError.h"
+#include "Debug.h"
+#include "GlobalConfiguration.h"
+#include "MStringf.h"
+#include "SubQuerySerializer.h"
+#include "TimeUtils.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <sstream>
+#include <vector>
+
+DnCCoordinator::DnCCoordinator( const String &address,
+                                const String &queryFingerprint,
+                                unsigned verbosity )
+    : _address( address )
+    , _queryFingerprint( queryFingerprint )
+    , _verbosity( verbosity )
+    , _listener( nullptr )
+    , _nextWorkerId( 0 )
+    , _exitCode( IEngine::NOT_DONE )
+    , _checkpointFile( "" )
+    , _checkpointIntervalInSeconds( 0 )
+{
+}
+
+DnCCoordinator::~DnCCoordinator()
+{
+    for ( auto &worker : _workers )
+        delete worker.second;
+    _workers.clear();
+}
+
+void DnCCoordinator::listen()
+{
+    _listener = Socket::listen( _address );
+    DNC_COORDINATOR_LOG( Stringf( "Listening on %s", _address.ascii() ).ascii() );
+}
+
+IEngine::ExitCode DnCCoordinator::solve( SubQueries &subQueries,
+                                         unsigned long long timeoutInMicroSeconds )
+{
+    enum {
+        POLL_INTERVAL_IN_MILLISECONDS = 100,
+        MICROSECONDS_IN_SECOND = 1000000,
+    };
+
+    ASSERT( _listener );
+
+    for ( const auto &subQuery : subQueries )
+    {
+        _pendingSubQueries.append( SubQuerySerializer::serializeSubQuery( *subQuery ) );
+        delete subQuery;
+    }
+    subQueries.clear();
+
+    struct timespec startTime = TimeUtils::sampleMicro();
+    _lastCheckpointTime = startTime;
+
+    while ( _exitCode == IEngine::NOT_DONE )
+    {
+        if ( getNumUnsolvedSubQueries() == 0 )
+        {
+            _exitCode = IEngine::UNSAT;
+            break;
+        }
+
+        if ( timeoutInMicroSeconds > 0 &&
+             TimeUtils::timePassed( startTime, TimeUtils::sampleMicro() ) >=
+                 timeoutInMicroSeconds )
+        {
+            _exitCode = IEngine::TIMEOUT;
+            break;
+        }
+
+        // Wait for new connections or messages from the workers
+        std::vector<struct pollfd> requests;
+        std::vector<unsigned> workerIds;
+        struct pollfd request;
+        request.fd = _listener->getDescriptor();
+        request.events = POLLIN;
+        request.revents = 0;
+        requests.push_back( request );
+        for ( const auto &worker : _workers )
+        {
+            request.fd = worker.second->_socket->getDescriptor();
+            requests.push_back( request );
+            workerIds.push_back( worker.first );
+        }
+
+        if ( poll( requests.data(), requests.size(), POLL_INTERVAL_IN_MILLISECONDS ) > 0 )
+        {
+            if ( requests[0].revents & POLLIN )
+                acceptWorker();
+
+            for ( unsigned i = 0; i < workerIds.size(); ++i )
+            {
+                if ( !requests[i + 1].revents )
+                    continue;
+
+                if ( !handleMessages( *_workers[workerIds[i]] ) )
+                    dropWorker( workerIds[i] );
+
+                if ( _exitCode != IEngine::NOT_DONE )
+                    break;
+            }
+        }
+
+        if ( _exitCode != IEngine::NOT_DONE )
+            break;
+
+        dropSilentWorkers();
+        assignSubQueries();
+
+        if ( _checkpointFile != "" &&
+             TimeUtils::timePassed( _lastCheckpointTime, TimeUtils::sampleMicro() ) >=
+                 (unsigned long long)_checkpointIntervalInSeconds * MICROSECONDS_IN_SECOND )
+            writeCheckpoint();
+    }
+
+    if ( _checkpointFile != "" && _exitCode == IEngine::TIMEOUT )
+        writeCheckpoint();
+
+    // Tell the workers to stop, whatever they are doing
+    sendToAllWorkers( "QUIT" );
+    for ( auto &worker : _workers )
+        delete worker.second;
+    _workers.clear();
+    _listener = nullptr;
+
+    return _exitCode;
+}
+
+const Map<unsigned, double> &DnCCoordinator::getSolution() const
+{
+    return _solution;
+}
+
+void DnCCoordinator::enableCheckpointing( const String &checkpointFile,
+                                          unsigned intervalInSeconds )
+{
+    _checkpointFile = checkpointFile;
+    _checkpointIntervalInSeconds = intervalInSeconds;
+}
+
+bool DnCCoordinator::startsWith( const String &line, const String &prefix )
+{
+    return line.length() >= prefix.length() &&
+           line.substring( 0, prefix.length() ) == prefix;
+}
+
+String DnCCoordinator::stripPrefix( const String &line, const String &prefix )
+{
+    ASSERT( startsWith( line, prefix ) );
+    return line.substring( prefix.length(), line.length() - prefix.length() );
+}
+
+String DnCCoordinator::getQueryId( const String &serializedSubQuery )
+{
+    size_t separator = serializedSubQuery.find( " " );
+    if ( separator == std::string::npos )
+        return serializedSubQuery;
+    return serializedSubQuery.substring( 0, separator );
+}
+
+void DnCCoordinator::acceptWorker()
+{
+    WorkerConnection *worker = new WorkerConnection;
+    try
+    {
+        worker->_socket = _listener->accept();
+    }
+    catch ( const CommonError & )
+    {
+        delete worker;
+        return;
+    }
+
+    worker->_id = _nextWorkerId++;
+    worker->_greeted = false;
+    worker->_idle = false;
+    worker->_lastHeardFrom = TimeUtils::sampleMicro();
+    _workers[worker->_id] = worker;
+
+    DNC_COORDINATOR_LOG( Stringf( "Worker %u connected", worker->_id ).ascii() );
+}
+
+bool DnCCoordinator::handleMessages( WorkerConnection &worker )
+{
+    List<String> lines;
+    if ( !worker._socket->receiveLines( lines ) )
+        return false;
+
+    worker._lastHeardFrom = TimeUtils::sampleMicro();
+    for ( const auto &line : lines )
+    {
+        if ( !handleMessage( worker, line ) )
+            return false;
+        if ( _exitCode != IEngine::NOT_DONE )
+            break;
+    }
+    return true;
+}
+
+bool DnCCoordinator::handleMessage( WorkerConnection &worker, const String &line )
+{
+    if ( startsWith( line, "HELLO " ) )
+    {
+        String fingerprint = stripPrefix( line, "HELLO " );
+        if ( fingerprint != _queryFingerprint )
+        {
+            printf( "DnCCoordinator: rejecting worker %u, whose preprocessed query (%s) differs "
+                    "from ours (%s)\n",
+                    worker._id,
+                    fingerprint.ascii(),
+                    _queryFingerprint.ascii() );
+            try
+            {
+                worker._socket->sendLine( "QUIT" );
+            }
+            catch ( const CommonError & )
+            {
+            }
+            return false;
+        }
+        worker._greeted = true;
+    }
+    else if ( !worker._greeted )
+    {
+        // The first message must be the greeting
+        return false;
+    }
+    else if ( line == "READY" )
+    {
+        worker._idle = true;
+    }
+    else if ( line == "HEARTBEAT" )
+    {
+        // Nothing to do, the time has already been updated
+    }
+    else if ( startsWith( line, "SPLIT " ) )
+    {
+        _pendingSubQueries.append( stripPrefix( line, "SPLIT " ) );
+    }
+    else if ( startsWith( line, "SOLUTION " ) )
+    {
+        std::istringstream input( stripPrefix( line, "SOLUTION " ).ascii() );
+        unsigned numberOfVariables = 0;
+        input >> numberOfVariables;
+        _solution.clear();
+        for ( unsigned i = 0; i < numberOfVariables; ++i )
+        {
+            std::string value;
+            input >> value;
+            _solution[i] = strtod( value.c_str(), NULL );
+        }
+    }
+    else if ( startsWith( line, "RESULT " ) )
+    {
+        String result = stripPrefix( line, "RESULT " );
+        String queryId = getQueryId( result );
+        String exitCode = result.substring( queryId.length(), result.length() - queryId.length() )
+                              .trim();
+
+        if ( !worker._assignedSubQueries.exists( queryId ) )
+            return false;
+        worker._assignedSubQueries.erase( queryId );
+
+        if ( _verbosity > 0 )
+            printf( "Worker %u: Query %s %s, %u tasks remaining\n",
+                    worker._id,
+                    stripPrefix( queryId, "#" ).ascii(),
+                    exitCode.ascii(),
+                    getNumUnsolvedSubQueries() );
+
+        if ( exitCode == "sat" )
+            _exitCode = IEngine::SAT;
+        else if ( exitCode == "error" )
+            _exitCode = IEngine::ERROR;
+        else if ( exitCode != "unsat" && exitCode != "timeout" )
+            return false;
+    }
+    else
+    {
+        DNC_COORDINATOR_LOG(
+            Stringf( "Unexpected message from worker %u: %s", worker._id, line.ascii() ).ascii() );
+        return false;
+    }
+
+    return true;
+}
+
+void DnCCoordinator::assignSubQueries()
+{
+    List<unsigned> lostWorkers;
+    for ( auto &it : _workers )
+    {
+        WorkerConnection *worker = it.second;
+        if ( _pendingSubQueries.empty() )
+            break;
+
+        if ( !worker->_greeted || !worker->_idle )
+            continue;
+
+        String subQuery = _pendingSubQueries.front();
+        _pendingSubQueries.erase( _pendingSubQueries.begin() );
+        worker->_assignedSubQueries[getQueryId( subQuery )] = subQuery;
+        worker->_idle = false;
+
+        try
+        {
+            worker->_socket->sendLine( String( "SUBQUERY " ) + subQuery );
+        }
+        catch ( const CommonError & )
+        {
+            lostWorkers.append( it.first );
+        }
+    }
+
+    for ( const auto &workerId : lostWorkers )
+        dropWorker( workerId );
+}
+
+void DnCCoordinator::dropSilentWorkers()
+{
+    enum {
+        MICROSECONDS_IN_MILLISECOND = 1000,
+    };
+
+    struct timespec now = TimeUtils::sampleMicro();
+    List<unsigned> silentWorkers;
+    for ( const auto &worker : _workers )
+    {
+        if ( TimeUtils::timePassed( worker.second->_lastHeardFrom, now ) >
+             (unsigned long long)GlobalConfiguration::DNC_HEARTBEAT_TIMEOUT_IN_MILLISECONDS *
+                 MICROSECONDS_IN_MILLISECOND )
+            silentWorkers.append( worker.first );
+    }
+
+    for ( const auto &workerId : silentWorkers )
+        dropWorker( workerId );
+}
+
+void DnCCoordinator::dropWorker( unsigned workerId )
+{
+    WorkerConnection *worker = _workers[workerId];
+
+    // Reassigned subqueries go to the front of the queue, as they have been
+    // waiting for the longest
+    for ( const auto &subQuery : worker->_assignedSubQueries )
+        _pendingSubQueries.appendHead( subQuery.second );
+
+    if ( _verbosity > 0 && worker->_greeted )
+        printf( "DnCCoordinator: lost worker %u, reassigning %u subqueries\n",
+                workerId,
+                worker->_assignedSubQueries.size() );
+
+    delete worker;
+    _workers.erase( workerId );
+}
+
+void DnCCoordinator::sendToAllWorkers( const String &message )
+{
+    for ( auto &worker : _workers )
+    {
+        try
+        {
+            worker.second->_socket->sendLine( message );
+        }
+        catch ( const CommonError & )
+        {
+            // The worker is gone already
+        }
+    }
+}
+
+unsigned DnCCoordinator::getNumUnsolvedSubQueries() const
+{
+    unsigned numUnsolved = _pendingSubQueries.size();
+    for ( const auto &worker : _workers )
+        numUnsolved += worker.second->_assignedSubQueries.size();
+    return numUnsolved;
+}
+
+void DnCCoordinator::writeCheckpoint()
+{
+    Checkpoint checkpoint;
+    checkpoint._mode = Checkpoint::DNC;
+    checkpoint._queryFingerprint = _queryFingerprint;
+    checkpoint._subQueries = _pendingSubQueries;
+    for ( const auto &worker : _workers )
+        for ( const auto &subQuery : worker.second->_assignedSubQueries )
+            checkpoint._subQueries.append( subQuery.second );
+    checkpoint.write( _checkpointFile );
+
+    _lastCheckpointTime = TimeUtils::sampleMicro();
+    if ( _verbosity > 0 )
+        printf( "DnCCoordinator: checkpoint stored with %u unsolved subqueries\n",
+                checkpoint._subQueries.size() );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,173 @@
+/*********************                                                        */
+/*! \file DnCCoordinator.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The coordinator of a distributed split-and-conquer solve. Subqueries are
+ ** handed out to worker processes (see DnCRemoteWorker) over sockets, one
+ ** at a time. Workers that time out on a subquery divide it and send the
+ ** new subqueries back to the coordinator.
+ **
+ ** The protocol is line based. A worker sends:
+ **
+ **   HELLO <fingerprint>      once, after connecting
+ **   READY                    when it is idle and wants a subquery
+ **   HEARTBEAT                periodically, while it is alive
+ **   SPLIT <subquery>         a subquery created by dividing its current one
+ **   SOLUTION <n> <values>    the satisfying assignment, before RESULT sat
+ **   RESULT #<id> <result>    the result (unsat, sat, timeout or error)
+ **
+ ** and the coordinator sends:
+ **
+ **   SUBQUERY <subquery>      a subquery to solve
+ **   QUIT                     the worker should stop
+ **
+ ** where subqueries are serialized with SubQuerySerializer. A worker that
+ ** disconnects or misses its heartbeats is dropped, and the subqueries
+ ** assigned to it are put back in the queue.
+
+ **/
+
+#ifndef __DnCCoordinator_h__
+#define __DnCCoordinator_h__
+
+#include "IEngine.h"
+#include "InputQuery.h"
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+#include "Socket.h"
+#include "SubQuery.h"
+
+#include <ctime>
+#include <memory>
+
+#define DNC_COORDINATOR_LOG( x, ... )                                                              \
+    LOG( GlobalConfiguration::DNC_MANAGER_LOGGING, "DnCCoordinator: %s\n", x )
+
+class DnCCoordinator
+{
+public:
+    DnCCoordinator( const String &address, const String &queryFingerprint, unsigned verbosity );
+    ~DnCCoordinator();
+
+    /*
+      Start listening for workers. Must be called before any worker tries
+      to connect.
+    */
+    void listen();
+
+    /*
+      Distribute the given subqueries (which the coordinator takes ownership
+      of) and the ones derived from them among the workers, until either
+      all of them are UNSAT, one of them is SAT, a worker reports an error,
+      or the timeout (0 means no timeout) is reached. Return the result.
+    */
+    IEngine::ExitCode solve( SubQueries &subQueries, unsigned long long timeoutInMicroSeconds );
+
+    /*
+      If solve() returned SAT, the satisfying assignment of the variables
+      of the original input query, as reported by the worker.
+    */
+    const Map<unsigned, double> &getSolution() const;
+
+    /*
+      Periodically store the unsolved subqueries (pending and assigned) in
+      the given file, and also when the timeout is reached
+    */
+    void enableCheckpointing( const String &checkpointFile, unsigned intervalInSeconds );
+
+    /*
+      Protocol helpers, shared with DnCRemoteWorker
+    */
+    static bool startsWith( const String &line, const String &prefix );
+    static String stripPrefix( const String &line, const String &prefix );
+    static String getQueryId( const String &serializedSubQuery );
+
+private:
+    struct WorkerConnection
+    {
+        unsigned _id;
+        std::unique_ptr<Socket> _socket;
+        bool _greeted;
+        bool _idle;
+
+        /*
+          The subqueries currently assigned to this worker, by query id
+        */
+        Map<String, String> _assignedSubQueries;
+
+        struct timespec _lastHeardFrom;
+    };
+
+    String _address;
+    String _queryFingerprint;
+    unsigned _verbosity;
+
+    std::unique_ptr<Socket> _listener;
+
+    /*
+      Connected workers, by id
+    */
+    Map<unsigned, WorkerConnection *> _workers;
+    unsigned _nextWorkerId;
+
+    /*
+      Serialized subqueries that are not yet assigned to any worker
+    */
+    List<String> _pendingSubQueries;
+
+    IEngine::ExitCode _exitCode;
+    Map<unsigned, double> _solution;
+
+    String _checkpointFile;
+    unsigned _checkpointIntervalInSeconds;
+    struct timespec _lastCheckpointTime;
+
+    void acceptWorker();
+
+    /*
+      Handle the messages of a worker. Return false if the worker should
+      be dropped.
+    */
+    bool handleMessages( WorkerConnection &worker );
+    bool handleMessage( WorkerConnection &worker, const String &line );
+
+    /*
+      Assign pending subqueries to idle workers
+    */
+    void assignSubQueries();
+
+    /*
+      Drop the workers that have not been heard from for too long
+    */
+    void dropSilentWorkers();
+
+    /*
+      Close the connection to a worker and put its subqueries back in the
+      queue
+    */
+    void dropWorker( unsigned workerId );
+
+    void sendToAllWorkers( const String &message );
+
+    unsigned getNumUnsolvedSubQueries() const;
+
+    void writeCheckpoint();
+};
+
+#endif // __DnCCoordinator_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
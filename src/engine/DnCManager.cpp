@@ -15,8 +15,12 @@
 
 #include "DnCManager.h"
 
+#include "Checkpoint.h"
 #include "Debug.h"
+#include "DnCCoordinator.h"
+#include "DnCRemoteWorker.h"
 #include "DnCWorker.h"
+#include "FloatUtils.h"
 #include "GetCPUData.h"
 #include "GlobalConfiguration.h"
 #include "LargestIntervalDivider.h"
@@ -25,15 +29,22 @@
 #include "Options.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PolarityBasedDivider.h"
+#include "PortfolioConfiguration.h"
 #include "QueryDivider.h"
+#include "SharedRootBounds.h"
 #include "SnCDivideStrategy.h"
+#include "SubQuerySerializer.h"
 #include "TimeUtils.h"
 #include "Vector.h"
 
 #include <atomic>
 #include <chrono>
 #include <cmath>
+#include <signal.h>
+#include <sys/wait.h>
 #include <thread>
+#include <unistd.h>
+#include <vector>
 
 #ifdef ENABLE_OPENBLAS
 #include "cblas.h"
@@ -42,6 +53,7 @@
 void DnCManager::dncSolve( WorkerQueue *workload,
                            std::shared_ptr<Engine> engine,
                            std::unique_ptr<InputQuery> inputQuery,
+                           const List<unsigned> &initialBasis,
                            std::atomic_int &numUnsolvedSubQueries,
                            std::atomic_bool &shouldQuitSolving,
                            unsigned threadId,
@@ -51,7 +63,9 @@ void DnCManager::dncSolve( WorkerQueue *workload,
                            bool restoreTreeStates,
                            unsigned verbosity,
                            unsigned seed,
-                           bool parallelDeepSoI )
+                           bool parallelDeepSoI,
+                           bool deterministic,
+                           UnsolvedSubQueries *unsolvedSubQueries )
 {
     unsigned cpuId = 0;
     (void)threadId;
@@ -62,7 +76,7 @@ void DnCManager::dncSolve( WorkerQueue *workload,
 
     engine->setRandomSeed( seed );
     if ( threadId != 0 )
-        engine->processInputQuery( *inputQuery, false );
+        engine->processPreprocessedInputQuery( std::move( inputQuery ), initialBasis );
 
     DnCWorker worker( workload,
                       engine,
@@ -74,6 +88,9 @@ void DnCManager::dncSolve( WorkerQueue *workload,
                       divideStrategy,
                       verbosity,
                       parallelDeepSoI );
+    worker.setUnsolvedSubQueries( unsolvedSubQueries );
+    if ( deterministic )
+        worker.setDeterministic( seed );
     while ( !shouldQuitSolving.load() )
     {
         worker.popOneSubQueryAndSolve( restoreTreeStates );
@@ -88,6 +105,11 @@ DnCManager::DnCManager( InputQuery *inputQuery )
     , _numUnsolvedSubQueries( 0 )
     , _verbosity( Options::get()->getInt( Options::VERBOSITY ) )
     , _runParallelDeepSoI( Options::get()->getBool( Options::PARALLEL_DEEPSOI ) )
+    , _runPortfolio( Options::get()->getBool( Options::PORTFOLIO ) )
+    , _runDeterministic( Options::get()->getBool( Options::DETERMINISTIC_DNC ) )
+    , _sharedRootBounds( nullptr )
+    , _checkpointFile( Options::get()->getString( Options::CHECKPOINT_FILE ) )
+    , _checkpointIntervalInSeconds( Options::get()->getInt( Options::CHECKPOINT_INTERVAL ) )
 {
     SnCDivideStrategy sncSplittingStrategy = Options::get()->getSnCDivideStrategy();
     if ( sncSplittingStrategy == SnCDivideStrategy::Auto )
@@ -142,6 +164,13 @@ void DnCManager::solve()
         (unsigned long long)timeoutInSeconds * (unsigned long long)MICROSECONDS_IN_SECOND;
     DNC_MANAGER_LOG( Stringf( "timeout in micro seconds: %llu", timeoutInMicroSeconds ).ascii() );
 
+    String listenAddress = Options::get()->getString( Options::DNC_LISTEN_ADDRESS );
+    if ( listenAddress != "" )
+    {
+        solveDistributed( listenAddress, timeoutInMicroSeconds );
+        return;
+    }
+
     struct timespec startTime = TimeUtils::sampleMicro();
 
     unsigned numWorkers = Options::get()->getInt( Options::NUM_WORKERS );
@@ -175,9 +204,25 @@ void DnCManager::solve()
     if ( !_workload )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::workload" );
 
+    // In parallel DeepSoI and portfolio modes, each worker solves the whole
+    // query, and the first one to finish solves the problem
+    bool solveWholeQuery = _runParallelDeepSoI || _runPortfolio;
+
+    String queryFingerprint = _baseEngine->getInputQuery()->computeFingerprint();
     SubQueries subQueries;
-    if ( !_runParallelDeepSoI )
-        initialDivide( subQueries );
+    if ( !solveWholeQuery )
+    {
+        if ( Options::get()->getBool( Options::RESUME ) )
+        {
+            if ( !resumeSubQueries( queryFingerprint, subQueries ) )
+            {
+                _exitCode = DnCManager::UNSAT;
+                return;
+            }
+        }
+        else
+            initialDivide( subQueries );
+    }
     else
     {
         for ( unsigned i = 0; i < numWorkers; ++i )
@@ -193,61 +238,112 @@ void DnCManager::solve()
         }
     }
 
-    // Create objects shared across workers
-    _numUnsolvedSubQueries = _runParallelDeepSoI ? 1 : subQueries.size();
-    std::atomic_bool shouldQuitSolving( false );
-    WorkerQueue *workload = new WorkerQueue( 0 );
+    // Keep track of the unsolved subqueries, so that they can be stored in
+    // checkpoints
+    std::unique_ptr<UnsolvedSubQueries> unsolvedSubQueries = nullptr;
+    if ( _checkpointFile != "" && !solveWholeQuery )
+    {
+        unsolvedSubQueries = std::unique_ptr<UnsolvedSubQueries>( new UnsolvedSubQueries );
+        for ( const auto &subQuery : subQueries )
+            unsolvedSubQueries->add( *subQuery );
+    }
+
+    // Create objects shared across workers. In deterministic mode, each
+    // worker instead has its own queue, counter and quit flag, and the
+    // initial subqueries are assigned to the workers in a round-robin
+    // fashion. The subqueries a worker solves, and their order, then do not
+    // depend on how the threads are scheduled.
+    bool deterministic = _runDeterministic && !solveWholeQuery;
+    unsigned numQueues = deterministic ? numWorkers : 1;
+    std::vector<std::unique_ptr<WorkerQueue>> workloads;
+    std::vector<std::atomic_int> numUnsolvedSubQueries( numQueues );
+    std::vector<std::atomic_bool> shouldQuitSolving( numQueues );
+    for ( unsigned i = 0; i < numQueues; ++i )
+    {
+        workloads.push_back( std::unique_ptr<WorkerQueue>( new WorkerQueue( 0 ) ) );
+        numUnsolvedSubQueries[i] = 0;
+    }
+
+    unsigned subQueryIndex = 0;
     for ( auto &subQuery : subQueries )
     {
-        if ( !workload->push( subQuery ) )
+        unsigned queueIndex = subQueryIndex++ % numQueues;
+        if ( !workloads[queueIndex]->push( subQuery ) )
         {
             // This should never happen
             ASSERT( false );
         }
+        numUnsolvedSubQueries[queueIndex] += 1;
     }
+    if ( solveWholeQuery )
+        numUnsolvedSubQueries[0] = 1;
+
+    // Workers without subqueries are done from the start
+    for ( unsigned i = 0; i < numQueues; ++i )
+        shouldQuitSolving[i] = ( numUnsolvedSubQueries[i].load() == 0 );
 
     unsigned onlineDivides = Options::get()->getInt( Options::NUM_ONLINE_DIVIDES );
     float timeoutFactor = Options::get()->getFloat( Options::TIMEOUT_FACTOR );
     bool restoreTreeStates = Options::get()->getBool( Options::RESTORE_TREE_STATES );
     unsigned seed = Options::get()->getInt( Options::SEED );
 
-    auto baseInputQuery =
-        std::unique_ptr<InputQuery>( new InputQuery( *( _baseEngine->getInputQuery() ) ) );
+    // Get the processed input query from the base engine before any of the
+    // workers starts solving. The copies share the network weights with the
+    // base engine, so that only the mutable state is duplicated per worker.
+    std::vector<std::unique_ptr<InputQuery>> inputQueries( numWorkers );
+    for ( unsigned threadId = 1; threadId < numWorkers; ++threadId )
+        inputQueries[threadId] =
+            std::unique_ptr<InputQuery>( new InputQuery( *( _baseEngine->getInputQuery() ) ) );
 
     // Spawn threads and start solving
     std::list<std::thread> threads;
     for ( unsigned threadId = 0; threadId < numWorkers; ++threadId )
     {
-        std::unique_ptr<InputQuery> inputQuery = nullptr;
-        if ( threadId != 0 )
-            // Get the processed input query from the base engine
-            inputQuery = std::unique_ptr<InputQuery>( new InputQuery( *( baseInputQuery ) ) );
-
+        unsigned queueIndex = threadId % numQueues;
         threads.push_back( std::thread( dncSolve,
-                                        workload,
+                                        workloads[queueIndex].get(),
                                         _engines[threadId],
-                                        threadId != 0 ? std::move( inputQuery ) : nullptr,
-                                        std::ref( _numUnsolvedSubQueries ),
-                                        std::ref( shouldQuitSolving ),
+                                        std::move( inputQueries[threadId] ),
+                                        std::cref( _baseEngine->getInitialBasis() ),
+                                        std::ref( numUnsolvedSubQueries[queueIndex] ),
+                                        std::ref( shouldQuitSolving[queueIndex] ),
                                         threadId,
                                         onlineDivides,
                                         timeoutFactor,
                                         _sncSplittingStrategy,
                                         restoreTreeStates,
                                         _verbosity,
-                                        _runParallelDeepSoI ? seed + threadId : seed,
-                                        _runParallelDeepSoI ) );
+                                        solveWholeQuery ? seed + threadId : seed,
+                                        solveWholeQuery,
+                                        deterministic,
+                                        unsolvedSubQueries.get() ) );
     }
 
     // Wait until either all subQueries are solved or a satisfying assignment is
     // found by some worker
-    while ( !shouldQuitSolving.load() )
+    struct timespec lastCheckpointTime = TimeUtils::sampleMicro();
+    while ( !allWorkersDone( shouldQuitSolving ) )
     {
         updateTimeoutReached( startTime, timeoutInMicroSeconds );
         if ( _timeoutReached )
-            shouldQuitSolving = true;
+        {
+            for ( auto &flag : shouldQuitSolving )
+                flag = true;
+        }
         else
+        {
+            if ( deterministic )
+                stopWorkersAfterFirstSat( shouldQuitSolving );
+
+            if ( unsolvedSubQueries &&
+                 TimeUtils::timePassed( lastCheckpointTime, TimeUtils::sampleMicro() ) >=
+                     (unsigned long long)_checkpointIntervalInSeconds * MICROSECONDS_IN_SECOND )
+            {
+                writeCheckpoint( *unsolvedSubQueries, queryFingerprint );
+                lastCheckpointTime = TimeUtils::sampleMicro();
+            }
             std::this_thread::sleep_for( std::chrono::milliseconds( numWorkers ) );
+        }
     }
 
 
@@ -258,8 +354,202 @@ void DnCManager::solve()
     for ( auto &thread : threads )
         thread.join();
 
+    _numUnsolvedSubQueries = 0;
+    for ( const auto &numUnsolved : numUnsolvedSubQueries )
+        _numUnsolvedSubQueries += numUnsolved.load();
+
     updateDnCExitCode();
-    return;
+
+    // The subqueries still being solved when the workers quit remain
+    // unsolved, and are part of the final checkpoint
+    if ( unsolvedSubQueries &&
+         ( _exitCode == DnCManager::TIMEOUT || _exitCode == DnCManager::QUIT_REQUESTED ) )
+        writeCheckpoint( *unsolvedSubQueries, queryFingerprint );
+}
+
+void DnCManager::solveDistributed( const String &address,
+                                   unsigned long long timeoutInMicroSeconds )
+{
+    struct timespec startTime = TimeUtils::sampleMicro();
+
+    if ( !createEngines( 1 ) )
+    {
+        _exitCode = DnCManager::UNSAT;
+        return;
+    }
+
+#ifdef ENABLE_OPENBLAS
+    // Each worker process occupies one thread
+    openblas_set_num_threads( 1 );
+#endif
+
+    String queryFingerprint = _baseEngine->getInputQuery()->computeFingerprint();
+    DnCCoordinator coordinator( address, queryFingerprint, _verbosity );
+    if ( _checkpointFile != "" )
+        coordinator.enableCheckpointing( _checkpointFile, _checkpointIntervalInSeconds );
+    coordinator.listen();
+
+    // The local workers are forked before the initial divide, so that their
+    // engines are in the same state as those of remote workers
+    List<pid_t> localWorkers;
+    unsigned numLocalWorkers = Options::get()->getInt( Options::NUM_WORKERS );
+    for ( unsigned i = 0; i < numLocalWorkers; ++i )
+    {
+        pid_t pid = spawnLocalWorker( address );
+        if ( pid > 0 )
+            localWorkers.append( pid );
+    }
+
+    SubQueries subQueries;
+    if ( Options::get()->getBool( Options::RESUME ) )
+        resumeSubQueries( queryFingerprint, subQueries );
+    else
+        initialDivide( subQueries );
+
+    unsigned long long elapsed = TimeUtils::timePassed( startTime, TimeUtils::sampleMicro() );
+    unsigned long long remainingTime = 0;
+    if ( timeoutInMicroSeconds > 0 )
+        remainingTime = elapsed < timeoutInMicroSeconds ? timeoutInMicroSeconds - elapsed : 1;
+
+    IEngine::ExitCode result = coordinator.solve( subQueries, remainingTime );
+    waitForLocalWorkers( localWorkers );
+
+    switch ( result )
+    {
+    case IEngine::UNSAT:
+        _exitCode = DnCManager::UNSAT;
+        break;
+    case IEngine::SAT:
+        _exitCode = DnCManager::SAT;
+        _remoteSolution = coordinator.getSolution();
+        break;
+    case IEngine::TIMEOUT:
+        _timeoutReached = true;
+        _exitCode = DnCManager::TIMEOUT;
+        break;
+    default:
+        _exitCode = DnCManager::ERROR;
+        break;
+    }
+}
+
+bool DnCManager::resumeSubQueries( const String &queryFingerprint, SubQueries &subQueries )
+{
+    std::unique_ptr<Checkpoint> checkpoint = Checkpoint::read( _checkpointFile );
+    checkpoint->checkCompatibility( Checkpoint::DNC, queryFingerprint );
+
+    for ( const auto &subQuery : checkpoint->_subQueries )
+        subQueries.append( SubQuerySerializer::deserializeSubQuery( subQuery ) );
+
+    if ( _verbosity > 0 )
+        printf( "DnCManager: resuming with %u unsolved subqueries\n", subQueries.size() );
+    return !subQueries.empty();
+}
+
+void DnCManager::writeCheckpoint( const UnsolvedSubQueries &unsolvedSubQueries,
+                                  const String &queryFingerprint )
+{
+    Checkpoint checkpoint;
+    checkpoint._queryFingerprint = queryFingerprint;
+    unsolvedSubQueries.store( checkpoint );
+    checkpoint.write( _checkpointFile );
+
+    if ( _verbosity > 0 )
+        printf( "DnCManager: checkpoint stored with %u unsolved subqueries\n",
+                checkpoint._subQueries.size() );
+}
+
+void DnCManager::runRemoteWorker( const String &coordinatorAddress )
+{
+    if ( !createEngines( 1 ) )
+    {
+        // Solved by preprocessing, which the coordinator will also find out
+        _exitCode = DnCManager::UNSAT;
+        return;
+    }
+
+#ifdef ENABLE_OPENBLAS
+    openblas_set_num_threads( 1 );
+#endif
+
+    runWorker( coordinatorAddress );
+}
+
+void DnCManager::runWorker( const String &coordinatorAddress )
+{
+    _baseEngine->setRandomSeed( Options::get()->getInt( Options::SEED ) );
+    DnCRemoteWorker worker( _baseEngine,
+                            *_baseInputQuery,
+                            coordinatorAddress,
+                            Options::get()->getInt( Options::NUM_ONLINE_DIVIDES ),
+                            Options::get()->getFloat( Options::TIMEOUT_FACTOR ),
+                            _sncSplittingStrategy,
+                            Options::get()->getBool( Options::RESTORE_TREE_STATES ) );
+    worker.run();
+}
+
+pid_t DnCManager::spawnLocalWorker( const String &coordinatorAddress )
+{
+    fflush( stdout );
+    pid_t pid = fork();
+    if ( pid < 0 )
+    {
+        printf( "DnCManager: failed to start a local worker process\n" );
+        return pid;
+    }
+
+    if ( pid > 0 )
+        return pid;
+
+    // In the worker process. Exit without unwinding, as the state of the
+    // coordinator belongs to the parent process.
+    int status = 0;
+    try
+    {
+        runWorker( coordinatorAddress );
+    }
+    catch ( const Error &e )
+    {
+        fprintf( stderr,
+                 "Local worker caught a %s error. Code: %u, Errno: %i, Message: %s.\n",
+                 e.getErrorClass(),
+                 e.getCode(),
+                 e.getErrno(),
+                 e.getUserMessage() );
+        status = 1;
+    }
+    fflush( stdout );
+    _exit( status );
+}
+
+void DnCManager::waitForLocalWorkers( const List<pid_t> &localWorkers )
+{
+    enum {
+        NUM_ATTEMPTS = 50,
+        MILLISECONDS_BETWEEN_ATTEMPTS = 100,
+    };
+
+    List<pid_t> running = localWorkers;
+    for ( unsigned attempt = 0; attempt < NUM_ATTEMPTS && !running.empty(); ++attempt )
+    {
+        List<pid_t> stillRunning;
+        for ( const auto &pid : running )
+        {
+            if ( waitpid( pid, NULL, WNOHANG ) == 0 )
+                stillRunning.append( pid );
+        }
+        running = stillRunning;
+
+        if ( !running.empty() )
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds( MILLISECONDS_BETWEEN_ATTEMPTS ) );
+    }
+
+    for ( const auto &pid : running )
+    {
+        kill( pid, SIGKILL );
+        waitpid( pid, NULL, 0 );
+    }
 }
 
 DnCManager::DnCExitCode DnCManager::getExitCode() const
@@ -267,6 +557,33 @@ DnCManager::DnCExitCode DnCManager::getExitCode() const
     return _exitCode;
 }
 
+bool DnCManager::allWorkersDone( const std::vector<std::atomic_bool> &shouldQuitSolving )
+{
+    for ( const auto &flag : shouldQuitSolving )
+        if ( !flag.load() )
+            return false;
+    return true;
+}
+
+void DnCManager::stopWorkersAfterFirstSat( std::vector<std::atomic_bool> &shouldQuitSolving )
+{
+    // A worker that is done no longer touches its engine, so its exit code
+    // can be read safely. The workers before the first satisfiable one keep
+    // going, as they may still find a satisfying assignment of their own.
+    for ( unsigned i = 0; i < shouldQuitSolving.size(); ++i )
+    {
+        if ( shouldQuitSolving[i].load() && _engines[i]->getExitCode() == Engine::SAT )
+        {
+            for ( unsigned j = i + 1; j < shouldQuitSolving.size(); ++j )
+            {
+                shouldQuitSolving[j] = true;
+                *( _engines[j]->getQuitRequested() ) = true;
+            }
+            return;
+        }
+    }
+}
+
 void DnCManager::updateDnCExitCode()
 {
     bool hasSat = false;
@@ -327,7 +644,15 @@ String DnCManager::getResultString()
 
 void DnCManager::extractSolution( InputQuery &inputQuery )
 {
-    ASSERT( _engineWithSATAssignment != nullptr );
+    if ( _engineWithSATAssignment == nullptr )
+    {
+        // The solution was found by a worker process
+        ASSERT( !_remoteSolution.empty() );
+        for ( const auto &value : _remoteSolution )
+            inputQuery.setSolutionValue( value.first, value.second );
+        return;
+    }
+
     _engineWithSATAssignment->extractSolution( inputQuery, _baseEngine->getPreprocessor() );
 }
 
@@ -423,11 +748,39 @@ bool DnCManager::createEngines( unsigned numberOfEngines )
         _engines.append( engine );
     }
 
+    if ( _runPortfolio )
+    {
+        // The base engine has processed the query with the configuration of
+        // the command line options, which is that of the first member
+        _sharedRootBounds = std::unique_ptr<SharedRootBounds>( new SharedRootBounds );
+        for ( unsigned i = 0; i < numberOfEngines; ++i )
+        {
+            PortfolioConfiguration configuration = PortfolioConfiguration::getConfiguration( i );
+            if ( i > 0 )
+                _engines[i]->setPortfolioConfiguration( configuration );
+            _engines[i]->setSharedRootBounds( _sharedRootBounds.get() );
+
+            if ( _verbosity > 0 )
+                printf( "DnCManager: thread #%u uses %s\n", i, configuration.toString().ascii() );
+        }
+    }
+
     return true;
 }
 
+void DnCManager::setInputDisjuncts( const List<PiecewiseLinearCaseSplit> &inputDisjuncts )
+{
+    _inputDisjuncts = inputDisjuncts;
+}
+
 void DnCManager::initialDivide( SubQueries &subQueries )
 {
+    if ( !_inputDisjuncts.empty() )
+    {
+        expandInputDisjuncts( subQueries );
+        return;
+    }
+
     auto split = std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit() );
     std::unique_ptr<QueryDivider> queryDivider = nullptr;
     if ( _sncSplittingStrategy == SnCDivideStrategy::Polarity )
@@ -460,6 +813,78 @@ void DnCManager::initialDivide( SubQueries &subQueries )
         pow( 2, initialDivides ), queryId, 0, *split, initialTimeout, subQueries );
 }
 
+void DnCManager::expandInputDisjuncts( SubQueries &subQueries )
+{
+    Preprocessor *preprocessor = _baseEngine->getPreprocessor();
+    InputQuery *inputQuery = _baseEngine->getInputQuery();
+    unsigned initialTimeout = Options::get()->getInt( Options::INITIAL_TIMEOUT );
+
+    unsigned disjunctIndex = 0;
+    for ( const auto &disjunct : _inputDisjuncts )
+    {
+        ++disjunctIndex;
+
+        Map<unsigned, double> lowerBounds;
+        Map<unsigned, double> upperBounds;
+        for ( const auto &bound : disjunct.getBoundTightenings() )
+        {
+            unsigned variable = bound._variable;
+            if ( bound._type == Tightening::LB )
+            {
+                if ( !lowerBounds.exists( variable ) || bound._value > lowerBounds[variable] )
+                    lowerBounds[variable] = bound._value;
+            }
+            else if ( !upperBounds.exists( variable ) || bound._value < upperBounds[variable] )
+                upperBounds[variable] = bound._value;
+        }
+
+        auto split = std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit() );
+        bool feasible = true;
+        for ( unsigned variable : _baseInputQuery->getInputVariables() )
+        {
+            double lb = lowerBounds.exists( variable ) ? lowerBounds[variable]
+                                                       : FloatUtils::negativeInfinity();
+            double ub =
+                upperBounds.exists( variable ) ? upperBounds[variable] : FloatUtils::infinity();
+
+            // Map the variable to its index in the processed query
+            while ( preprocessor->variableIsMerged( variable ) )
+                variable = preprocessor->getMergedIndex( variable );
+
+            if ( preprocessor->variableIsFixed( variable ) )
+            {
+                double value = preprocessor->getFixedValue( variable );
+                if ( FloatUtils::lt( value, lb ) || FloatUtils::gt( value, ub ) )
+                    feasible = false;
+                continue;
+            }
+
+            variable = preprocessor->getNewIndex( variable );
+            lb = FloatUtils::max( lb, inputQuery->getLowerBound( variable ) );
+            ub = FloatUtils::min( ub, inputQuery->getUpperBound( variable ) );
+            if ( FloatUtils::gt( lb, ub ) )
+                feasible = false;
+
+            split->storeBoundTightening( Tightening( variable, lb, Tightening::LB ) );
+            split->storeBoundTightening( Tightening( variable, ub, Tightening::UB ) );
+        }
+
+        if ( !feasible )
+        {
+            DNC_MANAGER_LOG(
+                Stringf( "Input disjunct %u is infeasible, skipping it", disjunctIndex ).ascii() );
+            continue;
+        }
+
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = Stringf( "%u", disjunctIndex );
+        subQuery->_split = std::move( split );
+        subQuery->_timeoutInSeconds = initialTimeout;
+        subQuery->_depth = 0;
+        subQueries.append( subQuery );
+    }
+}
+
 void DnCManager::updateTimeoutReached( timespec startTime,
                                        unsigned long long timeoutInMicroSeconds )
 {
@@ -18,11 +18,19 @@
 
 #include "Engine.h"
 #include "InputQuery.h"
+#include "List.h"
+#include "Map.h"
+#include "PiecewiseLinearCaseSplit.h"
 #include "SnCDivideStrategy.h"
 #include "SubQuery.h"
 #include "Vector.h"
 
 #include <atomic>
+#include <sys/types.h>
+#include <vector>
+
+class SharedRootBounds;
+class UnsolvedSubQueries;
 
 #define DNC_MANAGER_LOG( x, ... )                                                                  \
     LOG( GlobalConfiguration::DNC_MANAGER_LOGGING, "DnCManager: %s\n", x )
@@ -46,11 +54,23 @@ public:
 
     void freeMemoryIfNeeded();
 
+    /*
+      Start from one subquery per disjunct, instead of dividing the input
+      region. The disjuncts bound variables of the original input query.
+    */
+    void setInputDisjuncts( const List<PiecewiseLinearCaseSplit> &inputDisjuncts );
+
     /*
       Perform the Divide-and-conquer solving
     */
     void solve();
 
+    /*
+      Act as a worker process of a distributed Divide-and-conquer solve,
+      whose coordinator listens on the given address
+    */
+    void runRemoteWorker( const String &coordinatorAddress );
+
     /*
       Return the DnCExitCode of the DnCManager
     */
@@ -79,12 +99,37 @@ public:
     void extractSolution( InputQuery &inputQuery );
 
 private:
+    /*
+      Perform the Divide-and-conquer solving as the coordinator of worker
+      processes, which connect to the given address
+    */
+    void solveDistributed( const String &address, unsigned long long timeoutInMicroSeconds );
+
+    /*
+      Start a worker process on this machine, forked from the current
+      process after preprocessing. Return its pid, or -1 on failure.
+    */
+    pid_t spawnLocalWorker( const String &coordinatorAddress );
+
+    /*
+      Solve the subqueries sent by the coordinator at the given address with
+      the base engine, which has already processed the input query
+    */
+    void runWorker( const String &coordinatorAddress );
+
+    /*
+      Wait for the local worker processes to exit, killing the ones that
+      do not exit in time
+    */
+    void waitForLocalWorkers( const List<pid_t> &localWorkers );
+
     /*
       Create and run a DnCWorker
     */
     static void dncSolve( WorkerQueue *workload,
                           std::shared_ptr<Engine> engine,
                           std::unique_ptr<InputQuery> inputQuery,
+                          const List<unsigned> &initialBasis,
                           std::atomic_int &numUnsolvedSubQueries,
                           std::atomic_bool &shouldQuitSolving,
                           unsigned threadId,
@@ -94,11 +139,27 @@ private:
                           bool restoreTreeStates,
                           unsigned verbosity,
                           unsigned seed,
-                          bool parallelDeepSoI );
+                          bool parallelDeepSoI,
+                          bool deterministic,
+                          UnsolvedSubQueries *unsolvedSubQueries );
+
+    /*
+      Whether all workers have been asked to quit, or have quit on their own
+    */
+    static bool allWorkersDone( const std::vector<std::atomic_bool> &shouldQuitSolving );
+
+    /*
+      In deterministic mode, once a worker has found a satisfying assignment,
+      stop the workers with a higher index. The reported assignment is then
+      always the one of the satisfiable worker with the lowest index.
+    */
+    void stopWorkersAfterFirstSat( std::vector<std::atomic_bool> &shouldQuitSolving );
 
     /*
       Create the base engine from the network and property files,
-      and if necessary, create engines for workers
+      and if necessary, create engines for workers. Only the base engine
+      processes the input query; the workers are later initialized from
+      its processed query and initial basis.
     */
     bool createEngines( unsigned numberOfEngines );
 
@@ -108,6 +169,27 @@ private:
     */
     void initialDivide( SubQueries &subQueries );
 
+    /*
+      Invoked instead of the divide of the input region when input disjuncts
+      are set. Create a subquery for each disjunct that bounds the input
+      variables of the processed query by the intersection of the disjunct
+      and the bounds of the base engine. Disjuncts that do not intersect
+      them are left out.
+    */
+    void expandInputDisjuncts( SubQueries &subQueries );
+
+    /*
+      Instead of the initial divide, read the unsolved subqueries from the
+      checkpoint file. Return false if there are none left.
+    */
+    bool resumeSubQueries( const String &queryFingerprint, SubQueries &subQueries );
+
+    /*
+      Store the unsolved subqueries in the checkpoint file
+    */
+    void writeCheckpoint( const UnsolvedSubQueries &unsolvedSubQueries,
+                          const String &queryFingerprint );
+
     /*
       Read the exitCode of the engine of each thread, and update the manager's
       exitCode.
@@ -134,12 +216,23 @@ private:
     */
     std::shared_ptr<Engine> _engineWithSATAssignment;
 
+    /*
+      In distributed mode, the satisfying assignment reported by a worker
+      process
+    */
+    Map<unsigned, double> _remoteSolution;
+
     /*
       Alternatively, we could construct the DnCManager by directly providing the
       inputQuery instead of the network and property filepaths.
     */
     InputQuery *_baseInputQuery;
 
+    /*
+      The disjuncts that the initial subqueries correspond to, if any
+    */
+    List<PiecewiseLinearCaseSplit> _inputDisjuncts;
+
     /*
       The exit code of the DnCManager.
     */
@@ -170,10 +263,33 @@ private:
     */
     bool _runParallelDeepSoI;
 
+    /*
+      True if running portfolio mode, in which each thread solves the whole
+      query with a different configuration
+    */
+    bool _runPortfolio;
+
+    /*
+      True if SnC runs should be reproducible
+    */
+    bool _runDeterministic;
+
+    /*
+      In portfolio mode, the bounds proved at the root by any of the engines
+    */
+    std::unique_ptr<SharedRootBounds> _sharedRootBounds;
+
     /*
       The strategy for dividing a query
     */
     SnCDivideStrategy _sncSplittingStrategy;
+
+    /*
+      The file in which the unsolved subqueries are periodically stored, if
+      any, and the number of seconds between two checkpoints
+    */
+    String _checkpointFile;
+    unsigned _checkpointIntervalInSeconds;
 };
 
 #endif // __DnCManager_h__
@@ -86,7 +86,12 @@ void DnCMarabou::run()
             printf( "Property: %s\n", propertyFilePath.ascii() );
             if ( propertyFilePath.endsWith( ".vnnlib" ) )
             {
-                VnnLibParser().parse( propertyFilePath, _inputQuery );
+                // A dumped query keeps the disjunction
+                if ( Options::get()->getBool( Options::EXPAND_INPUT_DISJUNCTIONS ) &&
+                     Options::get()->getString( Options::QUERY_DUMP_FILE ) == "" )
+                    VnnLibParser().parse( propertyFilePath, _inputQuery, _inputDisjuncts );
+                else
+                    VnnLibParser().parse( propertyFilePath, _inputQuery );
             }
             else
             {
@@ -101,7 +106,10 @@ void DnCMarabou::run()
     String queryDumpFilePath = Options::get()->getString( Options::QUERY_DUMP_FILE );
     if ( queryDumpFilePath.length() > 0 )
     {
-        _inputQuery.saveQuery( queryDumpFilePath );
+        if ( Options::get()->getBool( Options::QUERY_DUMP_BINARY ) )
+            _inputQuery.saveBinaryQuery( queryDumpFilePath );
+        else
+            _inputQuery.saveQuery( queryDumpFilePath );
         printf( "\nInput query successfully dumped to file\n" );
         exit( 0 );
     }
@@ -110,6 +118,20 @@ void DnCMarabou::run()
       Step 3: initialize the DNC core
     */
     _dncManager = std::unique_ptr<DnCManager>( new DnCManager( &_inputQuery ) );
+    if ( !_inputDisjuncts.empty() )
+    {
+        printf( "Expanding the input disjunction of the property into %u subqueries\n",
+                _inputDisjuncts.size() );
+        _dncManager->setInputDisjuncts( _inputDisjuncts );
+    }
+
+    String coordinatorAddress = Options::get()->getString( Options::DNC_CONNECT_ADDRESS );
+    if ( coordinatorAddress != "" )
+    {
+        // Results are reported to the coordinator, not printed
+        _dncManager->runRemoteWorker( coordinatorAddress );
+        return;
+    }
 
     struct timespec start = TimeUtils::sampleMicro();
 
@@ -18,7 +18,9 @@
 
 #include "DnCManager.h"
 #include "InputQuery.h"
+#include "List.h"
 #include "Options.h"
+#include "PiecewiseLinearCaseSplit.h"
 
 class DnCMarabou
 {
@@ -33,6 +35,13 @@ public:
 private:
     std::unique_ptr<DnCManager> _dncManager;
     InputQuery _inputQuery;
+
+    /*
+      With --expand-input-disjunctions, the disjuncts of the input
+      disjunction of the property, each solved as a separate subquery
+    */
+    List<PiecewiseLinearCaseSplit> _inputDisjuncts;
+
     /*
       Display the results
     */
@@ -0,0 +1,279 @@
+/*********************                                                        */
+/*! \file DnCRemoteWorker.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "DnCRemoteWorker.h"
+
+#include "CommonError.h"
+#include "Debug.h"
+#include "DnCCoordinator.h"
+#include "DnCWorker.h"
+#include "GlobalConfiguration.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "SubQuerySerializer.h"
+#include "TimeUtils.h"
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+DnCRemoteWorker::DnCRemoteWorker( std::shared_ptr<Engine> engine,
+                                  const InputQuery &originalQuery,
+                                  const String &coordinatorAddress,
+                                  unsigned onlineDivides,
+                                  float timeoutFactor,
+                                  SnCDivideStrategy divideStrategy,
+                                  bool restoreTreeStates )
+    : _engine( engine )
+    , _originalQuery( originalQuery )
+    , _coordinatorAddress( coordinatorAddress )
+    , _onlineDivides( onlineDivides )
+    , _timeoutFactor( timeoutFactor )
+    , _divideStrategy( divideStrategy )
+    , _restoreTreeStates( restoreTreeStates )
+    , _socket( nullptr )
+    , _incomingSubQueries( new WorkerQueue( 0 ) )
+    , _quitRequested( false )
+    , _shouldQuitSolving( false )
+    , _done( false )
+{
+}
+
+DnCRemoteWorker::~DnCRemoteWorker()
+{
+    SubQuery *subQuery = NULL;
+    while ( _incomingSubQueries->pop( subQuery ) )
+        delete subQuery;
+    delete _incomingSubQueries;
+}
+
+void DnCRemoteWorker::run()
+{
+    connect();
+    String fingerprint = _engine->getInputQuery()->computeFingerprint();
+    _socket->sendLine( String( "HELLO " ) + fingerprint );
+
+    std::thread communicationThread( &DnCRemoteWorker::communicate, this );
+
+    WorkerQueue workload( 0 );
+    std::atomic_int numUnsolvedSubQueries( 0 );
+    DnCWorker worker( &workload,
+                      _engine,
+                      numUnsolvedSubQueries,
+                      _shouldQuitSolving,
+                      0,
+                      _onlineDivides,
+                      _timeoutFactor,
+                      _divideStrategy,
+                      0,
+                      false );
+
+    try
+    {
+        while ( !_quitRequested.load() )
+        {
+            _socket->sendLine( "READY" );
+            SubQuery *subQuery = waitForSubQuery();
+            if ( !subQuery )
+                break;
+
+            String queryId = subQuery->_queryId;
+            numUnsolvedSubQueries = 1;
+
+            // The quit flag must be cleared before checking whether the
+            // coordinator asked us to quit, so that a request arriving in
+            // between is not lost
+            _shouldQuitSolving = false;
+            if ( _quitRequested.load() || !workload.push( subQuery ) )
+            {
+                delete subQuery;
+                break;
+            }
+
+            IEngine::ExitCode result = worker.popOneSubQueryAndSolve( _restoreTreeStates );
+            if ( result == IEngine::QUIT_REQUESTED || result == IEngine::NOT_DONE )
+                break;
+
+            if ( result == IEngine::SAT )
+                sendSolution();
+            reportResult( queryId, result, workload );
+
+            if ( result == IEngine::SAT || result == IEngine::ERROR )
+                break;
+        }
+    }
+    catch ( const CommonError & )
+    {
+        // Lost the connection to the coordinator
+    }
+
+    _done = true;
+    communicationThread.join();
+
+    SubQuery *subQuery = NULL;
+    while ( workload.pop( subQuery ) )
+        delete subQuery;
+    _socket = nullptr;
+}
+
+void DnCRemoteWorker::connect()
+{
+    for ( unsigned attempt = 1;; ++attempt )
+    {
+        try
+        {
+            _socket = Socket::connect( _coordinatorAddress );
+            return;
+        }
+        catch ( const CommonError & )
+        {
+            if ( attempt >= GlobalConfiguration::DNC_WORKER_CONNECTION_ATTEMPTS )
+                throw;
+        }
+        std::this_thread::sleep_for( std::chrono::seconds( 1 ) );
+    }
+}
+
+void DnCRemoteWorker::communicate()
+{
+    enum {
+        MICROSECONDS_IN_MILLISECOND = 1000,
+    };
+
+    auto requestQuit = [this]() {
+        _quitRequested = true;
+        _shouldQuitSolving = true;
+        *_engine->getQuitRequested() = true;
+    };
+
+    unsigned heartbeatInterval = GlobalConfiguration::DNC_HEARTBEAT_INTERVAL_IN_MILLISECONDS;
+    struct timespec lastHeartbeat = TimeUtils::sampleMicro();
+    while ( !_done.load() )
+    {
+        try
+        {
+            if ( _socket->waitForInput( heartbeatInterval ) )
+            {
+                List<String> lines;
+                if ( !_socket->receiveLines( lines ) )
+                {
+                    requestQuit();
+                    return;
+                }
+
+                for ( const auto &line : lines )
+                {
+                    if ( DnCCoordinator::startsWith( line, "SUBQUERY " ) )
+                    {
+                        SubQuery *subQuery = SubQuerySerializer::deserializeSubQuery(
+                            DnCCoordinator::stripPrefix( line, "SUBQUERY " ) );
+                        if ( !_incomingSubQueries->push( subQuery ) )
+                            throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
+                    }
+                    else if ( line == "QUIT" )
+                    {
+                        requestQuit();
+                        return;
+                    }
+                }
+            }
+
+            struct timespec now = TimeUtils::sampleMicro();
+            if ( TimeUtils::timePassed( lastHeartbeat, now ) >=
+                 (unsigned long long)heartbeatInterval * MICROSECONDS_IN_MILLISECOND )
+            {
+                _socket->sendLine( "HEARTBEAT" );
+                lastHeartbeat = now;
+            }
+        }
+        catch ( const Error &e )
+        {
+            printf( "DnCRemoteWorker: %s error while communicating with the coordinator (code "
+                    "%u)\n",
+                    e.getErrorClass(),
+                    e.getCode() );
+            requestQuit();
+            return;
+        }
+    }
+}
+
+SubQuery *DnCRemoteWorker::waitForSubQuery()
+{
+    SubQuery *subQuery = NULL;
+    while ( !_incomingSubQueries->pop( subQuery ) )
+    {
+        if ( _quitRequested.load() )
+            return NULL;
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+    return subQuery;
+}
+
+void DnCRemoteWorker::reportResult( const String &queryId,
+                                    IEngine::ExitCode result,
+                                    WorkerQueue &workload )
+{
+    String resultString;
+    switch ( result )
+    {
+    case IEngine::UNSAT:
+        resultString = "unsat";
+        break;
+    case IEngine::SAT:
+        resultString = "sat";
+        break;
+    case IEngine::TIMEOUT:
+        resultString = "timeout";
+        break;
+    default:
+        resultString = "error";
+        break;
+    }
+
+    // The subqueries created by dividing a subquery that timed out are sent
+    // before its result, so that the coordinator never considers the
+    // problem solved while they are still in flight
+    SubQuery *subQuery = NULL;
+    while ( workload.pop( subQuery ) )
+    {
+        String serializedSubQuery = SubQuerySerializer::serializeSubQuery( *subQuery );
+        _socket->sendLine( String( "SPLIT " ) + serializedSubQuery );
+        delete subQuery;
+    }
+
+    _socket->sendLine( Stringf( "RESULT #%s %s", queryId.ascii(), resultString.ascii() ) );
+}
+
+void DnCRemoteWorker::sendSolution()
+{
+    InputQuery solution( _originalQuery );
+    _engine->extractSolution( solution );
+
+    std::ostringstream message;
+    message << "SOLUTION " << solution.getNumberOfVariables();
+    for ( unsigned i = 0; i < solution.getNumberOfVariables(); ++i )
+        message << Stringf( " %a", solution.getSolutionValue( i ) ).ascii();
+
+    _socket->sendLine( message.str() );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
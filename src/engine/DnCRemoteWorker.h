@@ -0,0 +1,122 @@
+/*********************                                                        */
+/*! \file DnCRemoteWorker.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A worker process of a distributed split-and-conquer solve. It receives
+ ** subqueries from a DnCCoordinator and solves them one at a time with a
+ ** DnCWorker, reporting the results (and the subqueries created by
+ ** dividing the ones that timed out) back to the coordinator. See
+ ** DnCCoordinator.h for the protocol.
+
+ **/
+
+#ifndef __DnCRemoteWorker_h__
+#define __DnCRemoteWorker_h__
+
+#include "Engine.h"
+#include "InputQuery.h"
+#include "MString.h"
+#include "SnCDivideStrategy.h"
+#include "Socket.h"
+#include "SubQuery.h"
+
+#include <atomic>
+#include <memory>
+
+class DnCRemoteWorker
+{
+public:
+    /*
+      The engine must have already processed the input query. The original
+      input query is used to extract the satisfying assignment, if one is
+      found.
+    */
+    DnCRemoteWorker( std::shared_ptr<Engine> engine,
+                     const InputQuery &originalQuery,
+                     const String &coordinatorAddress,
+                     unsigned onlineDivides,
+                     float timeoutFactor,
+                     SnCDivideStrategy divideStrategy,
+                     bool restoreTreeStates );
+
+    ~DnCRemoteWorker();
+
+    /*
+      Connect to the coordinator and solve the subqueries it sends, until
+      the coordinator tells the worker to quit or the connection is lost.
+    */
+    void run();
+
+private:
+    std::shared_ptr<Engine> _engine;
+    const InputQuery &_originalQuery;
+    String _coordinatorAddress;
+    unsigned _onlineDivides;
+    float _timeoutFactor;
+    SnCDivideStrategy _divideStrategy;
+    bool _restoreTreeStates;
+
+    std::unique_ptr<Socket> _socket;
+
+    /*
+      Subqueries received from the coordinator
+    */
+    WorkerQueue *_incomingSubQueries;
+
+    /*
+      Set when the coordinator asks the worker to quit, or disconnects
+    */
+    std::atomic_bool _quitRequested;
+
+    /*
+      The quit flag of the DnCWorker solving the current subquery
+    */
+    std::atomic_bool _shouldQuitSolving;
+
+    /*
+      Set when the main loop is done, to stop the communication thread
+    */
+    std::atomic_bool _done;
+
+    /*
+      Connect to the coordinator, retrying for a while in case it is not
+      up yet
+    */
+    void connect();
+
+    /*
+      Receive messages from the coordinator and send heartbeats, until the
+      main loop is done.
+    */
+    void communicate();
+
+    /*
+      Block until a subquery arrives. Return NULL if the worker should quit.
+    */
+    SubQuery *waitForSubQuery();
+
+    /*
+      Report the result of a subquery, along with the new subqueries in
+      the workload if it timed out
+    */
+    void reportResult( const String &queryId, IEngine::ExitCode result, WorkerQueue &workload );
+
+    void sendSolution();
+};
+
+#endif // __DnCRemoteWorker_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -15,6 +15,7 @@
 
 #include "DnCWorker.h"
 
+#include "Checkpoint.h"
 #include "Debug.h"
 #include "EngineState.h"
 #include "IEngine.h"
@@ -51,6 +52,9 @@ DnCWorker::DnCWorker( WorkerQueue *workload,
     , _timeoutFactor( timeoutFactor )
     , _verbosity( verbosity )
     , _parallelDeepSoI( parallelDeepSoI )
+    , _unsolvedSubQueries( NULL )
+    , _deterministic( false )
+    , _seed( 0 )
 {
     setQueryDivider( divideStrategy );
 
@@ -62,6 +66,29 @@ DnCWorker::DnCWorker( WorkerQueue *workload,
     }
 }
 
+void DnCWorker::setUnsolvedSubQueries( UnsolvedSubQueries *unsolvedSubQueries )
+{
+    _unsolvedSubQueries = unsolvedSubQueries;
+}
+
+void DnCWorker::setDeterministic( unsigned seed )
+{
+    _deterministic = true;
+    _seed = seed;
+}
+
+unsigned DnCWorker::getSubQuerySeed( const String &queryId ) const
+{
+    // FNV-1a, so that the seed does not depend on the standard library
+    unsigned hash = 2166136261u;
+    for ( unsigned i = 0; i < queryId.length(); ++i )
+    {
+        hash ^= (unsigned char)queryId[i];
+        hash *= 16777619u;
+    }
+    return _seed + hash;
+}
+
 void DnCWorker::setQueryDivider( SnCDivideStrategy divideStrategy )
 {
     if ( divideStrategy == SnCDivideStrategy::Polarity )
@@ -74,7 +101,7 @@ void DnCWorker::setQueryDivider( SnCDivideStrategy divideStrategy )
     }
 }
 
-void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
+IEngine::ExitCode DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
 {
     SubQuery *subQuery = NULL;
     // Boost queue stores the next element into the passed-in pointer
@@ -90,10 +117,20 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
             smtState = std::move( subQuery->_smtState );
         unsigned timeoutInSeconds = subQuery->_timeoutInSeconds;
 
-        // Reset the engine state
-        _engine->restoreState( *_initialState );
+        // Reset the engine state. In parallel DeepSoI and portfolio modes,
+        // each engine solves the query only once, from its initial state.
+        if ( _initialState )
+            _engine->restoreState( *_initialState );
         _engine->reset();
 
+        if ( _deterministic )
+        {
+            _engine->setRandomSeed( getSubQuerySeed( queryId ) );
+            _engine->setMainLoopIterationBudget(
+                (unsigned long long)timeoutInSeconds *
+                GlobalConfiguration::DNC_DETERMINISTIC_ITERATIONS_PER_SECOND );
+        }
+
         // TODO: each worker is going to keep a map from *CaseSplit to an
         // object of class DnCStatistics, which contains some basic
         // statistics. The maps are owned by the DnCManager.
@@ -107,7 +144,8 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
         IEngine::ExitCode result = IEngine::NOT_DONE;
         if ( fullSolveNeeded )
         {
-            _engine->solve( timeoutInSeconds );
+            // In deterministic mode, the iteration budget replaces the timeout
+            _engine->solve( _deterministic ? 0 : timeoutInSeconds );
             result = _engine->getExitCode();
         }
         else
@@ -122,6 +160,8 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
         if ( result == IEngine::UNSAT )
         {
             // If UNSAT, continue to solve
+            if ( _unsolvedSubQueries )
+                _unsolvedSubQueries->remove( queryId );
             *_numUnsolvedSubQueries -= 1;
             if ( _numUnsolvedSubQueries->load() == 0 || _parallelDeepSoI )
                 *_shouldQuitSolving = true;
@@ -159,6 +199,9 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
                     newSubQuery->_smtState = std::move( newSmtStates[i++] );
                 }
 
+                if ( _unsolvedSubQueries )
+                    _unsolvedSubQueries->add( *newSubQuery );
+
                 if ( !_workload->push( std::move( newSubQuery ) ) )
                 {
                     throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
@@ -166,6 +209,8 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
 
                 *_numUnsolvedSubQueries += 1;
             }
+            if ( _unsolvedSubQueries )
+                _unsolvedSubQueries->remove( queryId );
             *_numUnsolvedSubQueries -= 1;
             delete subQuery;
         }
@@ -202,11 +247,14 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
                 delete subQuery;
             }
         }
+
+        return result;
     }
     else
     {
         // If the queue is empty but the pop fails, wait and retry
         std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        return IEngine::NOT_DONE;
     }
 }
 
@@ -23,6 +23,8 @@
 
 #include <atomic>
 
+class UnsolvedSubQueries;
+
 class DnCWorker
 {
 public:
@@ -38,10 +40,24 @@ public:
                bool parallelDeepSoI );
 
     /*
-      Pop one subQuery, solve it and handle the result
-      Return true if the DnCWorker should continue running
+      Pop one subQuery, solve it and handle the result.
+      Return the result of the subQuery, or NOT_DONE if the queue was empty.
+    */
+    IEngine::ExitCode popOneSubQueryAndSolve( bool restoreTreeStates = false );
+
+    /*
+      Keep the given set of unsolved subqueries up to date, so that it can
+      be stored in checkpoints
     */
-    void popOneSubQueryAndSolve( bool restoreTreeStates = false );
+    void setUnsolvedSubQueries( UnsolvedSubQueries *unsolvedSubQueries );
+
+    /*
+      Make the solving of each subquery reproducible: the engine is seeded
+      from the given seed and the id of the subquery, and the timeout of the
+      subquery is enforced as a budget of main loop iterations instead of
+      wall-clock time
+    */
+    void setDeterministic( unsigned seed );
 
 private:
     /*
@@ -59,6 +75,11 @@ private:
     */
     void printProgress( String queryId, IEngine::ExitCode result ) const;
 
+    /*
+      The random seed used for the given subquery in deterministic mode
+    */
+    unsigned getSubQuerySeed( const String &queryId ) const;
+
     /*
       The queue of subqueries (shared across threads)
     */
@@ -87,6 +108,17 @@ private:
     float _timeoutFactor;
     unsigned _verbosity;
     bool _parallelDeepSoI;
+
+    /*
+      The unsolved subqueries to keep up to date, if checkpointing is enabled
+    */
+    UnsolvedSubQueries *_unsolvedSubQueries;
+
+    /*
+      Whether subqueries are solved reproducibly, and the base seed
+    */
+    bool _deterministic;
+    unsigned _seed;
 };
 
 #endif // __DnCWorker_h__
@@ -17,6 +17,7 @@
 #include "Engine.h"
 
 #include "AutoConstraintMatrixAnalyzer.h"
+#include "Checkpoint.h"
 #include "Debug.h"
 #include "DisjunctionConstraint.h"
 #include "EngineState.h"
@@ -27,8 +28,11 @@
 #include "MarabouError.h"
 #include "NLRError.h"
 #include "PiecewiseLinearConstraint.h"
+#include "PortfolioConfiguration.h"
 #include "Preprocessor.h"
+#include "SharedRootBounds.h"
 #include "TableauRow.h"
+#include "ThreadLocalRandom.h"
 #include "TimeUtils.h"
 #include "VariableOutOfBoundDuringOptimizationException.h"
 #include "Vector.h"
@@ -72,6 +76,15 @@ Engine::Engine()
     , _produceUNSATProofs( Options::get()->getBool( Options::PRODUCE_PROOFS ) )
     , _groundBoundManager( _context )
     , _UNSATCertificate( NULL )
+    , _checkpointFile( "" )
+    , _checkpointIntervalInMicroSeconds( 0 )
+    , _checkpointToResume( nullptr )
+    , _divideStrategy( Options::get()->getDivideStrategy() )
+    , _soiSearchStrategy( Options::get()->getSoISearchStrategy() )
+    , _sharedRootBounds( nullptr )
+    , _rootBoundsExchanged( false )
+    , _mainLoopIterationBudget( 0 )
+    , _mainLoopIterationsAtStart( 0 )
 {
     _smtCore.setStatistics( &_statistics );
     _tableau->setStatistics( &_statistics );
@@ -150,6 +163,12 @@ bool Engine::inSnCMode() const
 void Engine::setRandomSeed( unsigned seed )
 {
     srand( seed );
+    ThreadLocalRandom::seed( seed );
+}
+
+void Engine::setMainLoopIterationBudget( unsigned long long budget )
+{
+    _mainLoopIterationBudget = budget;
 }
 
 InputQuery Engine::prepareSnCInputQuery()
@@ -218,6 +237,9 @@ bool Engine::solve( double timeoutInSeconds )
         ENGINE_LOG( "Encoding convex relaxation into Gurobi - done" );
     }
 
+    if ( _checkpointToResume && !restoreCheckpoint() )
+        return false;
+
     mainLoopStatistics();
     if ( _verbosity > 0 )
     {
@@ -227,6 +249,8 @@ bool Engine::solve( double timeoutInSeconds )
     }
 
     bool splitJustPerformed = true;
+    _mainLoopIterationsAtStart =
+        _statistics.getLongAttribute( Statistics::NUM_MAIN_LOOP_ITERATIONS );
     struct timespec mainLoopStart = TimeUtils::sampleMicro();
     while ( true )
     {
@@ -246,6 +270,8 @@ bool Engine::solve( double timeoutInSeconds )
 
             _exitCode = Engine::TIMEOUT;
             _statistics.timeout();
+            if ( _checkpointFile != "" )
+                writeCheckpoint();
             return false;
         }
 
@@ -259,9 +285,16 @@ bool Engine::solve( double timeoutInSeconds )
             }
 
             _exitCode = Engine::QUIT_REQUESTED;
+            if ( _checkpointFile != "" )
+                writeCheckpoint();
             return false;
         }
 
+        if ( _checkpointFile != "" &&
+             TimeUtils::timePassed( _lastCheckpointTime, mainLoopEnd ) >=
+                 _checkpointIntervalInMicroSeconds )
+            writeCheckpoint();
+
         try
         {
             DEBUG( _tableau->verifyInvariants() );
@@ -300,6 +333,18 @@ bool Engine::solve( double timeoutInSeconds )
             // Perform any SmtCore-initiated case splits
             if ( _smtCore.needToSplit() )
             {
+                if ( _sharedRootBounds && !_rootBoundsExchanged &&
+                     _smtCore.getStackDepth() == 0 )
+                {
+                    // The bounds adopted from the other engines might allow
+                    // further tightening, or even solve the query, before
+                    // splitting
+                    exchangeRootBounds();
+                    splitJustPerformed = true;
+                    continue;
+                }
+                if ( _checkpointFile != "" && _smtCore.getStackDepth() == 0 )
+                    storeRootBounds();
                 _smtCore.performSplit();
                 splitJustPerformed = true;
                 continue;
@@ -1418,6 +1463,8 @@ void Engine::initializeNetworkLevelReasoning()
     if ( _networkLevelReasoner )
     {
         _networkLevelReasoner->computeSuccessorLayers();
+        _networkLevelReasoner->sparsifyWeights(
+            GlobalConfiguration::NLR_SPARSE_WEIGHTS_MAXIMUM_DENSITY );
         _networkLevelReasoner->setTableau( _tableau );
         if ( Options::get()->getBool( Options::DUMP_TOPOLOGY ) )
         {
@@ -1483,75 +1530,19 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
             delete[] constraintMatrix;
             constraintMatrix = createConstraintMatrix();
 
-            List<unsigned> initialBasis;
             List<unsigned> basicRows;
-            selectInitialVariablesForBasis( constraintMatrix, initialBasis, basicRows );
+            _initialBasis.clear();
+            selectInitialVariablesForBasis( constraintMatrix, _initialBasis, basicRows );
             addAuxiliaryVariables();
-            augmentInitialBasisIfNeeded( initialBasis, basicRows );
-
-            storeEquationsInDegradationChecker();
-
-            // The equations have changed, recreate the constraint matrix
-            delete[] constraintMatrix;
-            constraintMatrix = createConstraintMatrix();
-
-            unsigned n = _preprocessedQuery->getNumberOfVariables();
-            _boundManager.initialize( n );
-
-            initializeTableau( constraintMatrix, initialBasis );
-            _boundManager.initializeBoundExplainer( n, _tableau->getM() );
+            augmentInitialBasisIfNeeded( _initialBasis, basicRows );
             delete[] constraintMatrix;
 
-            if ( _produceUNSATProofs )
-            {
-                _UNSATCertificate = new UnsatCertificateNode( NULL, PiecewiseLinearCaseSplit() );
-                _UNSATCertificateCurrentPointer->set( _UNSATCertificate );
-                _UNSATCertificate->setVisited();
-                _groundBoundManager.initialize( n );
-
-                for ( unsigned i = 0; i < n; ++i )
-                {
-                    _groundBoundManager.setUpperBound( i, _preprocessedQuery->getUpperBound( i ) );
-                    _groundBoundManager.setLowerBound( i, _preprocessedQuery->getLowerBound( i ) );
-                }
-            }
+            initializeNativeTableau( _initialBasis );
         }
         else
-        {
-            ASSERT( _lpSolverType == LPSolverType::GUROBI );
-
-            ASSERT( GlobalConfiguration::USE_DEEPSOI_LOCAL_SEARCH == true );
-
-            if ( _verbosity > 0 )
-                printf( "Using Gurobi to solve LP...\n" );
-
-            unsigned n = _preprocessedQuery->getNumberOfVariables();
-            unsigned m = _preprocessedQuery->getEquations().size();
-            // Only use BoundManager to store the bounds.
-            _boundManager.initialize( n );
-            _tableau->setDimensions( m, n );
-            initializeBoundsAndConstraintWatchersInTableau( n );
-        }
-
-        for ( const auto &constraint : _plConstraints )
-            constraint->registerTableau( _tableau );
-        for ( const auto &constraint : _nlConstraints )
-            constraint->registerTableau( _tableau );
-
-        if ( _networkLevelReasoner && Options::get()->getBool( Options::DUMP_BOUNDS ) )
-            _networkLevelReasoner->dumpBounds();
+            initializeExternalLPSolverBounds();
 
-        if ( GlobalConfiguration::USE_DEEPSOI_LOCAL_SEARCH )
-        {
-            _soiManager = std::unique_ptr<SumOfInfeasibilitiesManager>(
-                new SumOfInfeasibilitiesManager( *_preprocessedQuery, *_tableau ) );
-            _soiManager->setStatistics( &_statistics );
-        }
-
-        if ( GlobalConfiguration::WARM_START )
-            warmStart();
-
-        decideBranchingHeuristics();
+        initializeSearchComponents();
 
         struct timespec end = TimeUtils::sampleMicro();
         _statistics.setLongAttribute( Statistics::PREPROCESSING_TIME_MICRO,
@@ -1589,6 +1580,145 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
     return true;
 }
 
+bool Engine::processPreprocessedInputQuery( std::unique_ptr<InputQuery> preprocessedQuery,
+                                            const List<unsigned> &initialBasis )
+{
+    ENGINE_LOG( "processPreprocessedInputQuery starting\n" );
+    struct timespec start = TimeUtils::sampleMicro();
+
+    try
+    {
+        // The query has already been preprocessed, its bounds tightened and
+        // its auxiliary variables added by the engine that produced it
+        _preprocessingEnabled = false;
+        _preprocessedQuery = std::move( preprocessedQuery );
+
+        informConstraintsOfInitialBounds( *_preprocessedQuery );
+        initializeNetworkLevelReasoning();
+
+        if ( _lpSolverType == LPSolverType::NATIVE )
+        {
+            _initialBasis = initialBasis;
+            initializeNativeTableau( _initialBasis );
+        }
+        else
+            initializeExternalLPSolverBounds();
+
+        initializeSearchComponents();
+
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.setLongAttribute( Statistics::PREPROCESSING_TIME_MICRO,
+                                      TimeUtils::timePassed( start, end ) );
+
+        if ( !_tableau->allBoundsValid() )
+            throw InfeasibleQueryException();
+    }
+    catch ( const InfeasibleQueryException & )
+    {
+        ENGINE_LOG( "processPreprocessedInputQuery done\n" );
+
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.setLongAttribute( Statistics::PREPROCESSING_TIME_MICRO,
+                                      TimeUtils::timePassed( start, end ) );
+
+        _exitCode = Engine::UNSAT;
+        return false;
+    }
+
+    ENGINE_LOG( "processPreprocessedInputQuery done\n" );
+
+    _smtCore.storeDebuggingSolution( _preprocessedQuery->_debuggingSolution );
+    return true;
+}
+
+bool Engine::processCachedInputQuery( PreprocessingCache::Entry &entry )
+{
+    bool feasible =
+        processPreprocessedInputQuery( std::move( entry._preprocessedQuery ), entry._initialBasis );
+
+    _preprocessor.restoreVariableMaps( entry._fixedVariables,
+                                       entry._mergedVariables,
+                                       entry._unusedSymbolicallyFixedVariables,
+                                       entry._oldIndexToNewIndex );
+    _preprocessingEnabled = true;
+
+    return feasible;
+}
+
+const List<unsigned> &Engine::getInitialBasis() const
+{
+    return _initialBasis;
+}
+
+void Engine::initializeNativeTableau( const List<unsigned> &initialBasis )
+{
+    storeEquationsInDegradationChecker();
+
+    double *constraintMatrix = createConstraintMatrix();
+
+    unsigned n = _preprocessedQuery->getNumberOfVariables();
+    _boundManager.initialize( n );
+
+    initializeTableau( constraintMatrix, initialBasis );
+    _boundManager.initializeBoundExplainer( n, _tableau->getM() );
+    delete[] constraintMatrix;
+
+    if ( _produceUNSATProofs )
+    {
+        _UNSATCertificate = new UnsatCertificateNode( NULL, PiecewiseLinearCaseSplit() );
+        _UNSATCertificateCurrentPointer->set( _UNSATCertificate );
+        _UNSATCertificate->setVisited();
+        _groundBoundManager.initialize( n );
+
+        for ( unsigned i = 0; i < n; ++i )
+        {
+            _groundBoundManager.setUpperBound( i, _preprocessedQuery->getUpperBound( i ) );
+            _groundBoundManager.setLowerBound( i, _preprocessedQuery->getLowerBound( i ) );
+        }
+    }
+}
+
+void Engine::initializeExternalLPSolverBounds()
+{
+    ASSERT( _lpSolverType == LPSolverType::GUROBI );
+
+    ASSERT( GlobalConfiguration::USE_DEEPSOI_LOCAL_SEARCH == true );
+
+    if ( _verbosity > 0 )
+        printf( "Using Gurobi to solve LP...\n" );
+
+    unsigned n = _preprocessedQuery->getNumberOfVariables();
+    unsigned m = _preprocessedQuery->getEquations().size();
+    // Only use BoundManager to store the bounds.
+    _boundManager.initialize( n );
+    _tableau->setDimensions( m, n );
+    initializeBoundsAndConstraintWatchersInTableau( n );
+}
+
+void Engine::initializeSearchComponents()
+{
+    for ( const auto &constraint : _plConstraints )
+        constraint->registerTableau( _tableau );
+    for ( const auto &constraint : _nlConstraints )
+        constraint->registerTableau( _tableau );
+
+    if ( _networkLevelReasoner && Options::get()->getBool( Options::DUMP_BOUNDS ) )
+        _networkLevelReasoner->dumpBounds();
+
+    if ( GlobalConfiguration::USE_DEEPSOI_LOCAL_SEARCH )
+    {
+        _soiManager = std::unique_ptr<SumOfInfeasibilitiesManager>(
+            new SumOfInfeasibilitiesManager( *_preprocessedQuery, *_tableau ) );
+        _soiManager->setStatistics( &_statistics );
+        _soiManager->setSearchStrategy( _soiSearchStrategy );
+    }
+
+    if ( GlobalConfiguration::WARM_START )
+        warmStart();
+
+    decideBranchingHeuristics();
+}
+
 void Engine::performMILPSolverBoundedTightening( InputQuery *inputQuery )
 {
     if ( _networkLevelReasoner && Options::get()->gurobiEnabled() )
@@ -2415,24 +2545,21 @@ void Engine::performSimulation()
         return;
     }
 
-    // outer vector is for neuron
-    // inner vector is for simulation value
-    Vector<Vector<double>> simulations;
+    // One row of input values per sample
+    const NLR::Layer *inputLayer = _networkLevelReasoner->getLayer( 0 );
+    unsigned inputSize = inputLayer->getSize();
+    Vector<double> simulations( _simulationSize * inputSize );
 
     std::mt19937 mt( GlobalConfiguration::SIMULATION_RANDOM_SEED );
 
-    for ( unsigned i = 0; i < _networkLevelReasoner->getLayer( 0 )->getSize(); ++i )
+    for ( unsigned i = 0; i < inputSize; ++i )
     {
-        std::uniform_real_distribution<double> distribution(
-            _networkLevelReasoner->getLayer( 0 )->getLb( i ),
-            _networkLevelReasoner->getLayer( 0 )->getUb( i ) );
-        Vector<double> simulationInput( _simulationSize );
-
+        std::uniform_real_distribution<double> distribution( inputLayer->getLb( i ),
+                                                             inputLayer->getUb( i ) );
         for ( unsigned j = 0; j < _simulationSize; ++j )
-            simulationInput[j] = distribution( mt );
-        simulations.append( simulationInput );
+            simulations[j * inputSize + i] = distribution( mt );
     }
-    _networkLevelReasoner->simulate( &simulations );
+    _networkLevelReasoner->simulate( simulations.data(), _simulationSize );
 }
 
 unsigned Engine::performSymbolicBoundTightening( InputQuery *inputQuery )
@@ -2459,7 +2586,14 @@ unsigned Engine::performSymbolicBoundTightening( InputQuery *inputQuery )
 
     // Step 2: perform SBT
     if ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING )
+    {
         _networkLevelReasoner->symbolicBoundPropagation();
+        unsigned long long memory = _networkLevelReasoner->getPeakSymbolicBoundMemory();
+        if ( memory >
+             _statistics.getLongAttribute( Statistics::MAX_SYMBOLIC_BOUND_TIGHTENING_MEMORY ) )
+            _statistics.setLongAttribute( Statistics::MAX_SYMBOLIC_BOUND_TIGHTENING_MEMORY,
+                                          memory );
+    }
     else if ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::DEEP_POLY )
         _networkLevelReasoner->deepPolyPropagation();
 
@@ -2520,6 +2654,12 @@ unsigned Engine::performSymbolicBoundTightening( InputQuery *inputQuery )
 
 bool Engine::shouldExitDueToTimeout( double timeout ) const
 {
+    if ( _mainLoopIterationBudget > 0 &&
+         _statistics.getLongAttribute( Statistics::NUM_MAIN_LOOP_ITERATIONS ) -
+                 _mainLoopIterationsAtStart >=
+             _mainLoopIterationBudget )
+        return true;
+
     // A timeout value of 0 means no time limit
     if ( timeout == 0 )
         return false;
@@ -2691,7 +2831,7 @@ void Engine::updateDirections()
 
 void Engine::decideBranchingHeuristics()
 {
-    DivideStrategy divideStrategy = Options::get()->getDivideStrategy();
+    DivideStrategy divideStrategy = _divideStrategy;
     if ( divideStrategy == DivideStrategy::Auto )
     {
         if ( !_produceUNSATProofs && !_preprocessedQuery->getInputVariables().empty() &&
@@ -2893,9 +3033,12 @@ bool Engine::restoreSmtState( SmtState &smtState )
             performSymbolicBoundTightening();
         while ( applyAllValidConstraintCaseSplits() );
 
-        // Step 2: replay the stack
-        for ( auto &stackEntry : smtState._stack )
+        // Step 2: replay the stack. The SmtCore takes ownership of the
+        // entries it replays.
+        while ( !smtState._stack.empty() )
         {
+            SmtStackEntry *stackEntry = smtState._stack.front();
+            smtState._stack.erase( smtState._stack.begin() );
             _smtCore.replaySmtStackEntry( stackEntry );
             // Do all the bound propagation, and set ReLU constraints to inactive (at
             // least the one corresponding to the _activeSplit applied above.
@@ -2937,6 +3080,133 @@ void Engine::storeSmtState( SmtState &smtState )
     _smtCore.storeSmtState( smtState );
 }
 
+void Engine::enableCheckpointing( const String &checkpointFile, unsigned intervalInSeconds )
+{
+    _checkpointFile = checkpointFile;
+    _checkpointIntervalInMicroSeconds =
+        (unsigned long long)intervalInSeconds * MICROSECONDS_TO_SECONDS;
+    _lastCheckpointTime = TimeUtils::sampleMicro();
+}
+
+void Engine::resumeFromCheckpoint( std::unique_ptr<Checkpoint> checkpoint )
+{
+    ASSERT( _preprocessedQuery );
+    checkpoint->checkCompatibility( Checkpoint::ENGINE, _preprocessedQuery->computeFingerprint() );
+    _checkpointToResume = std::move( checkpoint );
+}
+
+void Engine::writeCheckpoint()
+{
+    Checkpoint checkpoint;
+    checkpoint._mode = Checkpoint::ENGINE;
+    checkpoint._queryFingerprint = _preprocessedQuery->computeFingerprint();
+    checkpoint._rootBounds = _rootBounds;
+    _smtCore.storeSmtState( checkpoint._smtState );
+    checkpoint.write( _checkpointFile );
+
+    _lastCheckpointTime = TimeUtils::sampleMicro();
+    if ( _verbosity > 0 )
+        printf( "Engine: checkpoint stored at depth %u\n", _smtCore.getStackDepth() );
+}
+
+void Engine::storeRootBounds()
+{
+    List<Tightening> tightenings;
+    getTightenedBounds( tightenings );
+
+    _rootBounds = PiecewiseLinearCaseSplit();
+    for ( const auto &tightening : tightenings )
+        _rootBounds.storeBoundTightening( tightening );
+}
+
+void Engine::getTightenedBounds( List<Tightening> &tightenings ) const
+{
+    for ( unsigned i = 0; i < _preprocessedQuery->getNumberOfVariables(); ++i )
+    {
+        double lb = _boundManager.getLowerBound( i );
+        if ( FloatUtils::gt( lb, _preprocessedQuery->getLowerBound( i ) ) )
+            tightenings.append( Tightening( i, lb, Tightening::LB ) );
+
+        double ub = _boundManager.getUpperBound( i );
+        if ( FloatUtils::lt( ub, _preprocessedQuery->getUpperBound( i ) ) )
+            tightenings.append( Tightening( i, ub, Tightening::UB ) );
+    }
+}
+
+void Engine::setPortfolioConfiguration( const PortfolioConfiguration &configuration )
+{
+    ASSERT( !_preprocessedQuery );
+    _divideStrategy = configuration._divideStrategy;
+    _soiSearchStrategy = configuration._soiSearchStrategy;
+    _symbolicBoundTighteningType = configuration._symbolicBoundTighteningType;
+
+    if ( configuration._useDantzigsRule )
+        _activeEntryStrategy = &_dantzigsRule;
+    else
+        _activeEntryStrategy = _projectedSteepestEdgeRule;
+    _activeEntryStrategy->setStatistics( &_statistics );
+}
+
+void Engine::setSharedRootBounds( SharedRootBounds *sharedRootBounds )
+{
+    _sharedRootBounds = sharedRootBounds;
+}
+
+void Engine::exchangeRootBounds()
+{
+    ASSERT( _smtCore.getStackDepth() == 0 );
+    _rootBoundsExchanged = true;
+
+    List<Tightening> tightenings;
+    getTightenedBounds( tightenings );
+    _sharedRootBounds->publish( tightenings );
+
+    tightenings.clear();
+    _sharedRootBounds->getTightenings( tightenings );
+
+    PiecewiseLinearCaseSplit adoptedBounds;
+    for ( const auto &tightening : tightenings )
+    {
+        if ( ( tightening._type == Tightening::LB &&
+               FloatUtils::gt( tightening._value,
+                               _boundManager.getLowerBound( tightening._variable ) ) ) ||
+             ( tightening._type == Tightening::UB &&
+               FloatUtils::lt( tightening._value,
+                               _boundManager.getUpperBound( tightening._variable ) ) ) )
+            adoptedBounds.storeBoundTightening( tightening );
+    }
+
+    if ( adoptedBounds.getBoundTightenings().empty() )
+        return;
+
+    ENGINE_LOG( Stringf( "Adopting %u bounds proved at the root by other engines",
+                         adoptedBounds.getBoundTightenings().size() )
+                    .ascii() );
+    _statistics.incUnsignedAttribute( Statistics::NUM_ROOT_BOUNDS_ADOPTED,
+                                      adoptedBounds.getBoundTightenings().size() );
+
+    // Recorded as a valid split, so that the bounds survive precision
+    // restorations
+    applySplit( adoptedBounds );
+    _smtCore.recordImpliedValidSplit( adoptedBounds );
+}
+
+bool Engine::restoreCheckpoint()
+{
+    std::unique_ptr<Checkpoint> checkpoint = std::move( _checkpointToResume );
+
+    // The root bounds are valid at the root, and are replayed along with the
+    // other valid splits there
+    if ( !checkpoint->_rootBounds.getBoundTightenings().empty() )
+        checkpoint->_smtState._impliedValidSplitsAtRoot.appendHead( checkpoint->_rootBounds );
+
+    if ( _verbosity > 0 )
+        printf( "Engine: resuming from a checkpoint at depth %u\n",
+                checkpoint->_smtState._stack.size() );
+
+    return restoreSmtState( checkpoint->_smtState );
+}
+
 bool Engine::solveWithMILPEncoding( double timeoutInSeconds )
 {
     try
@@ -3043,6 +3313,11 @@ bool Engine::performDeepSoILocalSearch()
                                       TimeUtils::timePassed( start, end ) );
         start = end;
 
+        // Proposals might keep being accepted without ever triggering a
+        // split, so let the main loop handle quit requests
+        if ( _quitRequested )
+            return false;
+
         if ( lastProposalAccepted )
         {
             /*
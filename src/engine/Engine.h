@@ -37,6 +37,7 @@
 #include "Map.h"
 #include "Options.h"
 #include "PrecisionRestorer.h"
+#include "PreprocessingCache.h"
 #include "Preprocessor.h"
 #include "SignalHandler.h"
 #include "SmtCore.h"
@@ -58,6 +59,9 @@
 
 #define ENGINE_LOG( x, ... ) LOG( GlobalConfiguration::ENGINE_LOGGING, "Engine: %s\n", x )
 
+class Checkpoint;
+class PortfolioConfiguration;
+class SharedRootBounds;
 class EngineState;
 class InputQuery;
 class PiecewiseLinearConstraint;
@@ -102,6 +106,31 @@ public:
     bool processInputQuery( InputQuery &inputQuery );
     bool processInputQuery( InputQuery &inputQuery, bool preprocess );
 
+    /*
+      Process an input query that has already been processed by another
+      engine (e.g., the base engine in DnC mode), reusing the initial basis
+      that engine selected. Preprocessing, bound tightening, redundancy
+      analysis and basis selection are skipped, so that only the mutable
+      solving state is built. Return false if the query is found to be
+      infeasible, true otherwise.
+    */
+    bool processPreprocessedInputQuery( std::unique_ptr<InputQuery> preprocessedQuery,
+                                        const List<unsigned> &initialBasis );
+
+    /*
+      Process an input query whose processed state was loaded from a
+      PreprocessingCache, like processPreprocessedInputQuery. The
+      preprocessor's variable maps are restored as well, so that solutions
+      are extracted for the original query. Return false if the query is
+      found to be infeasible, true otherwise.
+    */
+    bool processCachedInputQuery( PreprocessingCache::Entry &entry );
+
+    /*
+      The initial basis selected when the input query was processed.
+    */
+    const List<unsigned> &getInitialBasis() const;
+
     InputQuery prepareSnCInputQuery();
     void exportInputQueryWithError( String errorMessage );
 
@@ -203,6 +232,32 @@ public:
     */
     void storeSmtState( SmtState &smtState );
 
+    /*
+      Periodically store the SMT state and the bounds tightened at the root
+      in the given file, and also when quitting due to a timeout or an
+      external request. Must be called after processInputQuery.
+    */
+    void enableCheckpointing( const String &checkpointFile, unsigned intervalInSeconds );
+
+    /*
+      Continue the search from the given checkpoint when solve is called.
+      Throws a MarabouError if the checkpoint was created for a different
+      query. Must be called after processInputQuery.
+    */
+    void resumeFromCheckpoint( std::unique_ptr<Checkpoint> checkpoint );
+
+    /*
+      Search with the given configuration instead of the one given by the
+      command line options. Must be called before the query is processed.
+    */
+    void setPortfolioConfiguration( const PortfolioConfiguration &configuration );
+
+    /*
+      Exchange the bounds proved at the root of the search tree with other
+      engines solving the same preprocessed query, before the first split
+    */
+    void setSharedRootBounds( SharedRootBounds *sharedRootBounds );
+
     /*
       Pick the piecewise linear constraint for splitting
     */
@@ -248,6 +303,8 @@ public:
 
     void setRandomSeed( unsigned seed );
 
+    void setMainLoopIterationBudget( unsigned long long budget );
+
     /*
       Returns true iff the engine is in proof production mode
     */
@@ -367,6 +424,11 @@ private:
     */
     std::unique_ptr<InputQuery> _preprocessedQuery;
 
+    /*
+      The initial basis of the tableau.
+    */
+    List<unsigned> _initialBasis;
+
     /*
       Pivot selection strategies.
     */
@@ -691,7 +753,8 @@ private:
     void performSimulation();
 
     /*
-      Check whether a timeout value has been provided and exceeded.
+      Check whether a timeout value has been provided and exceeded, or
+      whether the main loop iteration budget has been used up.
     */
     bool shouldExitDueToTimeout( double timeout ) const;
 
@@ -722,6 +785,9 @@ private:
     void initializeTableau( const double *constraintMatrix, const List<unsigned> &initialBasis );
     void initializeBoundsAndConstraintWatchersInTableau( unsigned numberOfVariables );
     void initializeNetworkLevelReasoning();
+    void initializeNativeTableau( const List<unsigned> &initialBasis );
+    void initializeExternalLPSolverBounds();
+    void initializeSearchComponents();
     double *createConstraintMatrix();
     void addAuxiliaryVariables();
     void augmentInitialBasisIfNeeded( List<unsigned> &initialBasis,
@@ -832,6 +898,71 @@ private:
     UnsatCertificateNode *_UNSATCertificate;
     CVC4::context::CDO<UnsatCertificateNode *> *_UNSATCertificateCurrentPointer;
 
+    /*
+      Checkpointing: the file the progress is stored in, the interval and
+      time of the last checkpoint, and the bounds tightened at the root of
+      the search tree before the first split.
+    */
+    String _checkpointFile;
+    unsigned long long _checkpointIntervalInMicroSeconds;
+    struct timespec _lastCheckpointTime;
+    PiecewiseLinearCaseSplit _rootBounds;
+
+    /*
+      The checkpoint to continue from when solving starts
+    */
+    std::unique_ptr<Checkpoint> _checkpointToResume;
+
+    /*
+      Store the current progress in the checkpoint file
+    */
+    void writeCheckpoint();
+
+    /*
+      Store the bounds that are tighter than those of the preprocessed
+      query. Called at the root of the search tree, before the first split.
+    */
+    void storeRootBounds();
+
+    /*
+      Get the current bounds that are tighter than those of the
+      preprocessed query
+    */
+    void getTightenedBounds( List<Tightening> &tightenings ) const;
+
+    /*
+      The branching heuristic and the SoI search strategy, which are those
+      of the command line options unless set by a portfolio configuration
+    */
+    DivideStrategy _divideStrategy;
+    SoISearchStrategy _soiSearchStrategy;
+
+    /*
+      The bounds proved at the root by the engines of a portfolio, and
+      whether this engine has exchanged its own yet
+    */
+    SharedRootBounds *_sharedRootBounds;
+    bool _rootBoundsExchanged;
+
+    /*
+      The maximal number of main loop iterations of a call to solve (0 for
+      no limit), and the number of iterations when the call started
+    */
+    unsigned long long _mainLoopIterationBudget;
+    unsigned long long _mainLoopIterationsAtStart;
+
+    /*
+      Publish the bounds proved at the root, and adopt the ones published
+      by the other engines as valid splits. Called before the first split.
+    */
+    void exchangeRootBounds();
+
+    /*
+      Replay the SMT state of the checkpoint to resume from. Return false
+      if the query is found to be UNSAT in the process.
+    */
+    bool restoreCheckpoint();
+
     /*
       Returns true iff there is a variable with bounds that can explain infeasibility of the tableau
     */
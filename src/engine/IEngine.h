@@ -104,6 +104,15 @@ public:
     virtual void reset() = 0;
     virtual List<unsigned> getInputVariables() const = 0;
 
+    /*
+      Methods for deterministic DnC: seed the random number generator of
+      the calling thread, and limit the number of main loop iterations of
+      each call to solve (0 means no limit). An engine that reaches the
+      limit exits with TIMEOUT.
+    */
+    virtual void setRandomSeed( unsigned seed ) = 0;
+    virtual void setMainLoopIterationBudget( unsigned long long budget ) = 0;
+
     /*
       Pick the piecewise linear constraint for internal splitting
     */
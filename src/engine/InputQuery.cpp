@@ -17,6 +17,7 @@
 
 #include "AutoFile.h"
 #include "BilinearConstraint.h"
+#include "BinaryQueryFormat.h"
 #include "Debug.h"
 #include "FloatUtils.h"
 #include "LeakyReluConstraint.h"
@@ -28,6 +29,9 @@
 #include "SoftmaxConstraint.h"
 #include "SymbolicBoundTighteningType.h"
 
+#include <algorithm>
+#include <vector>
+
 #define INPUT_QUERY_LOG( x, ... )                                                                  \
     LOG( GlobalConfiguration::INPUT_QUERY_LOGGING, "Input Query: %s\n", x )
 
@@ -245,6 +249,16 @@ const List<NonlinearConstraint *> &InputQuery::getNonlinearConstraints() const
     return _nlConstraints;
 }
 
+void InputQuery::addConvolution( const ConvolutionRecord &convolution )
+{
+    _convolutions.append( convolution );
+}
+
+const List<InputQuery::ConvolutionRecord> &InputQuery::getConvolutions() const
+{
+    return _convolutions;
+}
+
 unsigned InputQuery::countInfiniteBounds()
 {
     unsigned result = 0;
@@ -309,6 +323,7 @@ InputQuery &InputQuery::operator=( const InputQuery &other )
 
     _numberOfVariables = other._numberOfVariables;
     _equations = other._equations;
+    _convolutions = other._convolutions;
     _lowerBounds = other._lowerBounds;
     _upperBounds = other._upperBounds;
     _solution = other._solution;
@@ -531,6 +546,115 @@ void InputQuery::saveQuery( const String &fileName )
     queryFile->close();
 }
 
+void InputQuery::saveBinaryQuery( const String &fileName )
+{
+    using namespace BinaryQueryFormat;
+
+    List<String> serializedConstraints;
+    for ( const auto &constraint : _plConstraints )
+        serializedConstraints.append( constraint->serializeToString() );
+    for ( const auto &constraint : _nlConstraints )
+        serializedConstraints.append( constraint->serializeToString() );
+
+    Header header;
+    initializeHeader( header );
+    header.numberOfVariables = _numberOfVariables;
+    header.numberOfInputVariables = _inputIndexToVariable.size();
+    header.numberOfOutputVariables = _outputIndexToVariable.size();
+    header.numberOfLowerBounds = _lowerBounds.size();
+    header.numberOfUpperBounds = _upperBounds.size();
+    header.numberOfEquations = _equations.size();
+    for ( const auto &equation : _equations )
+        header.numberOfAddends += equation._addends.size();
+    header.numberOfPiecewiseLinearConstraints = _plConstraints.size();
+    header.numberOfNonlinearConstraints = _nlConstraints.size();
+    for ( const auto &serializedConstraint : serializedConstraints )
+        header.numberOfConstraintCharacters += serializedConstraint.length();
+
+    // Lay out the whole file in memory, padding included, and write it at once
+    Layout layout = computeLayout( header );
+    std::vector<char> buffer( layout.fileSize, 0 );
+    char *data = buffer.data();
+    memcpy( data, &header, sizeof( Header ) );
+
+    uint32_t *inputVariables = (uint32_t *)( data + layout.offsets[INPUT_VARIABLES] );
+    for ( const auto &pair : _inputIndexToVariable )
+    {
+        *( inputVariables++ ) = pair.first;
+        *( inputVariables++ ) = pair.second;
+    }
+
+    uint32_t *outputVariables = (uint32_t *)( data + layout.offsets[OUTPUT_VARIABLES] );
+    for ( const auto &pair : _outputIndexToVariable )
+    {
+        *( outputVariables++ ) = pair.first;
+        *( outputVariables++ ) = pair.second;
+    }
+
+    uint32_t *lowerBoundVariables = (uint32_t *)( data + layout.offsets[LOWER_BOUND_VARIABLES] );
+    double *lowerBoundValues = (double *)( data + layout.offsets[LOWER_BOUND_VALUES] );
+    for ( const auto &lb : _lowerBounds )
+    {
+        *( lowerBoundVariables++ ) = lb.first;
+        *( lowerBoundValues++ ) = lb.second;
+    }
+
+    uint32_t *upperBoundVariables = (uint32_t *)( data + layout.offsets[UPPER_BOUND_VARIABLES] );
+    double *upperBoundValues = (double *)( data + layout.offsets[UPPER_BOUND_VALUES] );
+    for ( const auto &ub : _upperBounds )
+    {
+        *( upperBoundVariables++ ) = ub.first;
+        *( upperBoundValues++ ) = ub.second;
+    }
+
+    uint32_t *equationTypes = (uint32_t *)( data + layout.offsets[EQUATION_TYPES] );
+    double *equationScalars = (double *)( data + layout.offsets[EQUATION_SCALARS] );
+    uint64_t *equationOffsets = (uint64_t *)( data + layout.offsets[EQUATION_OFFSETS] );
+    uint32_t *addendVariables = (uint32_t *)( data + layout.offsets[ADDEND_VARIABLES] );
+    double *addendCoefficients = (double *)( data + layout.offsets[ADDEND_COEFFICIENTS] );
+    uint64_t addendIndex = 0;
+    for ( const auto &equation : _equations )
+    {
+        *( equationTypes++ ) = equation._type;
+        *( equationScalars++ ) = equation._scalar;
+        *( equationOffsets++ ) = addendIndex;
+        for ( const auto &addend : equation._addends )
+        {
+            addendVariables[addendIndex] = addend._variable;
+            addendCoefficients[addendIndex] = addend._coefficient;
+            ++addendIndex;
+        }
+    }
+    *equationOffsets = addendIndex;
+
+    uint64_t *constraintOffsets = (uint64_t *)( data + layout.offsets[CONSTRAINT_OFFSETS] );
+    char *constraintCharacters = data + layout.offsets[CONSTRAINT_CHARACTERS];
+    uint64_t characterIndex = 0;
+    for ( const auto &serializedConstraint : serializedConstraints )
+    {
+        *( constraintOffsets++ ) = characterIndex;
+        memcpy( constraintCharacters + characterIndex,
+                serializedConstraint.ascii(),
+                serializedConstraint.length() );
+        characterIndex += serializedConstraint.length();
+    }
+    *constraintOffsets = characterIndex;
+
+    // Write in pieces, as a single write of a large query may be partial
+    enum {
+        MAXIMUM_WRITE_SIZE = 1 << 24,
+    };
+
+    AutoFile queryFile( fileName );
+    queryFile->open( IFile::MODE_WRITE_TRUNCATE );
+    for ( uint64_t written = 0; written < layout.fileSize; written += MAXIMUM_WRITE_SIZE )
+    {
+        uint64_t size = std::min<uint64_t>( MAXIMUM_WRITE_SIZE, layout.fileSize - written );
+        queryFile->write( String( data + written, size ) );
+    }
+    queryFile->close();
+}
+
 void InputQuery::markInputVariable( unsigned variable, unsigned inputIndex )
 {
     _variableToInputIndex[variable] = inputIndex;
@@ -605,6 +729,37 @@ void InputQuery::printAllBounds() const
     printf( "\n\n" );
 }
 
+String InputQuery::computeFingerprint() const
+{
+    // FNV-1a hash of the variable bounds
+    unsigned long long hash = 14695981039346656037ULL;
+    auto hashBytes = [&hash]( const void *data, unsigned size ) {
+        const unsigned char *bytes = (const unsigned char *)data;
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    for ( const auto &bound : _lowerBounds )
+    {
+        hashBytes( &bound.first, sizeof( bound.first ) );
+        hashBytes( &bound.second, sizeof( bound.second ) );
+    }
+    for ( const auto &bound : _upperBounds )
+    {
+        hashBytes( &bound.first, sizeof( bound.first ) );
+        hashBytes( &bound.second, sizeof( bound.second ) );
+    }
+
+    return Stringf( "%u-%u-%u-%llx",
+                    _numberOfVariables,
+                    _equations.size(),
+                    _plConstraints.size(),
+                    hash );
+}
+
 void InputQuery::printInputOutputBounds() const
 {
     printf( "Dumping bounds of the input and output variables:\n" );
@@ -776,6 +931,7 @@ bool InputQuery::constructNetworkLevelReasoner( List<Equation> &unhandledEquatio
     Set<NonlinearConstraint *> handledNLConstraints;
     // Now, repeatedly attempt to construct additional layers
     while (
+        constructConvolutionLayer( nlr, handledVariableToLayer, newLayerIndex, handledEquations ) ||
         constructWeighedSumLayer( nlr, handledVariableToLayer, newLayerIndex, handledEquations ) ||
         constructReluLayer( nlr, handledVariableToLayer, newLayerIndex, handledPLConstraints ) ||
         constructRoundLayer( nlr, handledVariableToLayer, newLayerIndex, handledNLConstraints ) ||
@@ -876,6 +1032,151 @@ void InputQuery::mergeConsecutiveWeightedSumLayers(
     }
 }
 
+bool InputQuery::constructConvolutionLayer( NLR::NetworkLevelReasoner *nlr,
+                                            Map<unsigned, unsigned> &handledVariableToLayer,
+                                            unsigned newLayerIndex,
+                                            Set<unsigned> &handledEquations )
+{
+    INPUT_QUERY_LOG( "Attempting to construct convolutionLayer..." );
+
+    for ( const auto &convolution : _convolutions )
+    {
+        // The outputs should not have been handled, and the inputs should
+        // all be in the same layer
+        const Vector<unsigned> &inputVariables = convolution._inputVariables;
+        const Vector<unsigned> &outputVariables = convolution._outputVariables;
+        if ( outputVariables.empty() || handledVariableToLayer.exists( outputVariables[0] ) ||
+             !handledVariableToLayer.exists( inputVariables[0] ) )
+            continue;
+
+        unsigned sourceLayerIndex = handledVariableToLayer[inputVariables[0]];
+        bool inputsReady = true;
+        for ( const auto &variable : inputVariables )
+        {
+            if ( !handledVariableToLayer.exists( variable ) ||
+                 handledVariableToLayer[variable] != sourceLayerIndex )
+            {
+                inputsReady = false;
+                break;
+            }
+        }
+        if ( !inputsReady )
+            continue;
+
+        // Find the equation that defines each output variable
+        Map<unsigned, unsigned> variableToNeuron;
+        for ( unsigned i = 0; i < outputVariables.size(); ++i )
+            variableToNeuron[outputVariables[i]] = i;
+
+        Vector<const Equation *> neuronToEquation( outputVariables.size(), NULL );
+        Vector<unsigned> equationIndices;
+        unsigned index = 0;
+        for ( const auto &eq : _equations )
+        {
+            if ( handledEquations.exists( index++ ) || eq._type != Equation::EQ )
+                continue;
+
+            unsigned outputVariable = 0;
+            unsigned numberOfOutputVariables = 0;
+            bool otherVariables = false;
+            for ( const auto &addend : eq._addends )
+            {
+                if ( variableToNeuron.exists( addend._variable ) )
+                {
+                    outputVariable = addend._variable;
+                    ++numberOfOutputVariables;
+                }
+                else if ( !handledVariableToLayer.exists( addend._variable ) ||
+                          handledVariableToLayer[addend._variable] != sourceLayerIndex )
+                    otherVariables = true;
+            }
+
+            if ( numberOfOutputVariables != 1 || otherVariables ||
+                 neuronToEquation[variableToNeuron[outputVariable]] != NULL )
+                continue;
+
+            neuronToEquation[variableToNeuron[outputVariable]] = &eq;
+            equationIndices.append( index - 1 );
+        }
+
+        if ( equationIndices.size() != outputVariables.size() )
+            continue;
+
+        const NLR::Layer *sourceLayer = nlr->getLayer( sourceLayerIndex );
+        Vector<unsigned> inputNeurons;
+        for ( const auto &variable : inputVariables )
+            inputNeurons.append( sourceLayer->variableToNeuron( variable ) );
+
+        auto kernel = std::make_shared<const NLR::Convolution>(
+            convolution._shape, convolution._kernel, inputNeurons, sourceLayer->getSize() );
+
+        /*
+          Check that the equations are those of the convolution, with the
+          output variable's coefficient normalized to -1, as for weighted
+          sum layers. Otherwise, they have been modified since the
+          convolution was recorded, and are left to a weighted sum layer.
+        */
+        bool equationsMatch = true;
+        unsigned numberOfWeights = 0;
+        for ( unsigned i = 0; i < outputVariables.size() && equationsMatch; ++i )
+        {
+            const Equation *eq = neuronToEquation[i];
+            double factor = -1.0 / eq->getCoefficient( outputVariables[i] );
+            for ( const auto &addend : eq->_addends )
+            {
+                if ( addend._variable == outputVariables[i] || addend._coefficient == 0 )
+                    continue;
+
+                ++numberOfWeights;
+                double weight = kernel->get( sourceLayer->variableToNeuron( addend._variable ), i );
+                if ( !FloatUtils::areEqual( factor * addend._coefficient, weight ) )
+                {
+                    equationsMatch = false;
+                    break;
+                }
+            }
+        }
+
+        if ( !equationsMatch || numberOfWeights != kernel->getNnz() )
+        {
+            INPUT_QUERY_LOG( "\tEquations do not match the recorded convolution" );
+            continue;
+        }
+
+        nlr->addLayer( newLayerIndex, NLR::Layer::CONV, outputVariables.size() );
+        nlr->addLayerDependency( sourceLayerIndex, newLayerIndex );
+
+        NLR::Layer *layer = nlr->getLayer( newLayerIndex );
+        layer->setConvolution( sourceLayerIndex, kernel );
+        for ( unsigned i = 0; i < outputVariables.size(); ++i )
+        {
+            unsigned variable = outputVariables[i];
+            handledVariableToLayer[variable] = newLayerIndex;
+
+            layer->setLb( i,
+                          _lowerBounds.exists( variable ) ? _lowerBounds[variable]
+                                                          : FloatUtils::negativeInfinity() );
+            layer->setUb( i,
+                          _upperBounds.exists( variable ) ? _upperBounds[variable]
+                                                          : FloatUtils::infinity() );
+
+            nlr->setNeuronVariable( NLR::NeuronIndex( newLayerIndex, i ), variable );
+
+            double factor = -1.0 / neuronToEquation[i]->getCoefficient( variable );
+            nlr->setBias( newLayerIndex, i, factor * -neuronToEquation[i]->_scalar );
+        }
+
+        for ( const auto &equationIndex : equationIndices )
+            handledEquations.insert( equationIndex );
+
+        INPUT_QUERY_LOG( "\tSuccessful!" );
+        return true;
+    }
+
+    INPUT_QUERY_LOG( "\tFailed!" );
+    return false;
+}
+
 bool InputQuery::constructWeighedSumLayer( NLR::NetworkLevelReasoner *nlr,
                                            Map<unsigned, unsigned> &handledVariableToLayer,
                                            unsigned newLayerIndex,
@@ -62,6 +62,23 @@ public:
     const List<NonlinearConstraint *> &getNonlinearConstraints() const;
     List<NonlinearConstraint *> &getNonlinearConstraints();
 
+    /*
+      A convolution whose equations are in the query, recorded by the
+      parser so that the network level reasoner can represent it as a
+      convolutional layer instead of a weighted sum layer. The variables
+      are listed in the order of the input and output tensors.
+    */
+    struct ConvolutionRecord
+    {
+        NLR::Convolution::Shape _shape;
+        Vector<double> _kernel;
+        Vector<unsigned> _inputVariables;
+        Vector<unsigned> _outputVariables;
+    };
+
+    void addConvolution( const ConvolutionRecord &convolution );
+    const List<ConvolutionRecord> &getConvolutions() const;
+
     /*
       Methods for handling input and output variables
     */
@@ -117,6 +134,20 @@ public:
     */
     void saveQuery( const String &fileName );
 
+    /*
+      Serializes the query to a file in the binary format described in
+      BinaryQueryFormat.h. QueryLoader loads such files by mapping them into
+      memory instead of parsing them.
+    */
+    void saveBinaryQuery( const String &fileName );
+
+    /*
+      A string identifying the query by its dimensions and variable bounds.
+      Used to check that a distributed DnC worker or a checkpoint refers to
+      the same preprocessed query.
+    */
+    String computeFingerprint() const;
+
     /*
       Print input and output bounds
     */
@@ -167,6 +198,7 @@ private:
     Map<unsigned, double> _upperBounds;
     List<PiecewiseLinearConstraint *> _plConstraints;
     List<NonlinearConstraint *> _nlConstraints;
+    List<ConvolutionRecord> _convolutions;
 
     Map<unsigned, double> _solution;
 
@@ -185,6 +217,10 @@ private:
     /*
       Methods called by constructNetworkLevelReasoner
     */
+    bool constructConvolutionLayer( NLR::NetworkLevelReasoner *nlr,
+                                    Map<unsigned, unsigned> &handledVariableToLayer,
+                                    unsigned newLayerIndex,
+                                    Set<unsigned> &handledEquations );
     bool constructWeighedSumLayer( NLR::NetworkLevelReasoner *nlr,
                                    Map<unsigned, unsigned> &handledVariableToLayer,
                                    unsigned newLayerIndex,
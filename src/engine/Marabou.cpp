@@ -18,6 +18,7 @@
 
 #include "AcasParser.h"
 #include "AutoFile.h"
+#include "Checkpoint.h"
 #include "File.h"
 #include "GlobalConfiguration.h"
 #include "MStringf.h"
@@ -37,6 +38,7 @@ Marabou::Marabou()
     , _onnxParser( NULL )
     , _cegarSolver( NULL )
     , _engine( std::unique_ptr<Engine>( new Engine() ) )
+    , _preprocessingCacheHit( false )
 {
 }
 
@@ -87,7 +89,8 @@ void Marabou::prepareInputQuery()
         }
 
         printf( "InputQuery: %s\n", inputQueryFilePath.ascii() );
-        _inputQuery = QueryLoader::loadQuery( inputQueryFilePath );
+        if ( !lookUpPreprocessingCache( { inputQueryFilePath } ) )
+            _inputQuery = QueryLoader::loadQuery( inputQueryFilePath );
     }
     else
     {
@@ -110,36 +113,47 @@ void Marabou::prepareInputQuery()
         }
         printf( "Network: %s\n", networkFilePath.ascii() );
 
-        if ( ( (String)networkFilePath ).endsWith( ".onnx" ) )
+        String propertyFilePath = Options::get()->getString( Options::PROPERTY_FILE_PATH );
+        List<String> filePaths = { networkFilePath };
+        if ( propertyFilePath != "" )
+            filePaths.append( propertyFilePath );
+
+        if ( lookUpPreprocessingCache( filePaths ) )
         {
-            InputQueryBuilder queryBuilder;
-            OnnxParser::parse( queryBuilder, networkFilePath, {}, {} );
-            queryBuilder.generateQuery( _inputQuery );
+            printf( "Property: %s\n", propertyFilePath != "" ? propertyFilePath.ascii() : "None" );
         }
         else
         {
-            _acasParser = new AcasParser( networkFilePath );
-            _acasParser->generateQuery( _inputQuery );
-        }
-
-        /*
-          Step 2: extract the property in question
-        */
-        String propertyFilePath = Options::get()->getString( Options::PROPERTY_FILE_PATH );
-        if ( propertyFilePath != "" )
-        {
-            printf( "Property: %s\n", propertyFilePath.ascii() );
-            if ( propertyFilePath.endsWith( ".vnnlib" ) )
+            if ( ( (String)networkFilePath ).endsWith( ".onnx" ) )
             {
-                VnnLibParser().parse( propertyFilePath, _inputQuery );
+                InputQueryBuilder queryBuilder;
+                OnnxParser::parse( queryBuilder, networkFilePath, {}, {} );
+                queryBuilder.generateQuery( _inputQuery );
             }
             else
             {
-                PropertyParser().parse( propertyFilePath, _inputQuery );
+                _acasParser = new AcasParser( networkFilePath );
+                _acasParser->generateQuery( _inputQuery );
+            }
+
+            /*
+              Step 2: extract the property in question
+            */
+            if ( propertyFilePath != "" )
+            {
+                printf( "Property: %s\n", propertyFilePath.ascii() );
+                if ( propertyFilePath.endsWith( ".vnnlib" ) )
+                {
+                    VnnLibParser().parse( propertyFilePath, _inputQuery );
+                }
+                else
+                {
+                    PropertyParser().parse( propertyFilePath, _inputQuery );
+                }
             }
+            else
+                printf( "Property: None\n" );
         }
-        else
-            printf( "Property: None\n" );
 
         printf( "\n" );
     }
@@ -150,12 +164,29 @@ void Marabou::prepareInputQuery()
     String queryDumpFilePath = Options::get()->getString( Options::QUERY_DUMP_FILE );
     if ( queryDumpFilePath.length() > 0 )
     {
-        _inputQuery.saveQuery( queryDumpFilePath );
+        if ( Options::get()->getBool( Options::QUERY_DUMP_BINARY ) )
+            _inputQuery.saveBinaryQuery( queryDumpFilePath );
+        else
+            _inputQuery.saveQuery( queryDumpFilePath );
         printf( "\nInput query successfully dumped to file\n" );
         exit( 0 );
     }
 }
 
+bool Marabou::lookUpPreprocessingCache( const List<String> &filePaths )
+{
+    String cacheDirectory = Options::get()->getString( Options::PREPROCESSING_CACHE_DIRECTORY );
+    if ( cacheDirectory == "" )
+        return false;
+
+    _preprocessingCache =
+        std::unique_ptr<PreprocessingCache>( new PreprocessingCache( cacheDirectory ) );
+    _preprocessingCacheKey = PreprocessingCache::computeKey( filePaths );
+    _preprocessingCacheHit =
+        _preprocessingCache->load( _preprocessingCacheKey, _inputQuery, _cachedPreprocessing );
+    return _preprocessingCacheHit;
+}
+
 void Marabou::importDebuggingSolution()
 {
     String fileName = Options::get()->getString( Options::IMPORT_ASSIGNMENT_FILE_PATH );
@@ -219,8 +250,26 @@ void Marabou::solveQuery()
 
     struct timespec start = TimeUtils::sampleMicro();
     unsigned timeoutInSeconds = Options::get()->getInt( Options::TIMEOUT );
-    if ( _engine->processInputQuery( _inputQuery ) )
+
+    // On a cache hit, the engine starts from the cached processed query.
+    // On a miss, the processed query is stored before the search starts.
+    bool feasible = _preprocessingCacheHit
+                      ? _engine->processCachedInputQuery( _cachedPreprocessing )
+                      : _engine->processInputQuery( _inputQuery );
+    if ( feasible && _preprocessingCache && !_preprocessingCacheHit )
+        _preprocessingCache->store( _preprocessingCacheKey, _inputQuery, *_engine );
+
+    if ( feasible )
     {
+        String checkpointFile = Options::get()->getString( Options::CHECKPOINT_FILE );
+        if ( checkpointFile != "" )
+        {
+            if ( Options::get()->getBool( Options::RESUME ) )
+                _engine->resumeFromCheckpoint( Checkpoint::read( checkpointFile ) );
+            _engine->enableCheckpointing( checkpointFile,
+                                          Options::get()->getInt( Options::CHECKPOINT_INTERVAL ) );
+        }
+
         _engine->solve( timeoutInSeconds );
         if ( _engine->shouldProduceProofs() && _engine->getExitCode() == Engine::UNSAT )
             _engine->certifyUNSATCertificate();
@@ -321,6 +370,9 @@ void Marabou::displayResults( unsigned long long microSecondsElapsed ) const
         printf( "Unexpected exit code! (this should not happen)" );
     }
 
+    if ( _preprocessingCache )
+        _preprocessingCache->printStatistics();
+
     // Create a summary file, if requested
     String summaryFilePath = Options::get()->getString( Options::SUMMARY_FILE );
     if ( summaryFilePath != "" )
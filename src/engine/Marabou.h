@@ -21,6 +21,7 @@
 #include "IncrementalLinearization.h"
 #include "InputQuery.h"
 #include "OnnxParser.h"
+#include "PreprocessingCache.h"
 
 class Marabou
 {
@@ -63,6 +64,12 @@ private:
      */
     void importDebuggingSolution();
 
+    /*
+      If a preprocessing cache is enabled, look up the query built from the
+      given files, and load it on a hit. Return true on a hit.
+    */
+    bool lookUpPreprocessingCache( const List<String> &filePaths );
+
     /*
       ACAS network parser
     */
@@ -82,6 +89,15 @@ private:
       The solver
     */
     std::unique_ptr<Engine> _engine;
+
+    /*
+      The cache of processed queries, if enabled, the key of the query and
+      the processed state loaded on a cache hit
+    */
+    std::unique_ptr<PreprocessingCache> _preprocessingCache;
+    String _preprocessingCacheKey;
+    bool _preprocessingCacheHit;
+    PreprocessingCache::Entry _cachedPreprocessing;
 };
 
 #endif // __Marabou_h__
@@ -53,6 +53,12 @@ public:
         BOUNDS_NOT_UP_TO_DATE_IN_LP_SOLVER = 28,
         INVALID_LEAKY_RELU_SLOPE = 29,
         UNABLE_TO_RECONSTRUCT_SOLUTION_FOR_ELIMINATED_NEURONS = 30,
+        INVALID_SERIALIZED_SUBQUERY = 31,
+        INVALID_CHECKPOINT = 32,
+        CHECKPOINT_QUERY_MISMATCH = 33,
+        CHECKPOINT_WRITE_FAILED = 34,
+        INVALID_PREPROCESSING_CACHE_ENTRY = 35,
+        PREPROCESSING_CACHE_WRITE_FAILED = 36,
 
         // Error codes for Query Loader
         FILE_DOES_NOT_EXIST = 100,
@@ -61,6 +67,7 @@ public:
         UNSUPPORTED_TRANSCENDENTAL_CONSTRAINT = 103,
         UNSUPPORTED_NON_LINEAR_CONSTRAINT = 104,
         ONNX_PARSER_ERROR = 105,
+        INVALID_QUERY_FILE = 106,
 
         FEATURE_NOT_YET_SUPPORTED = 900,
 
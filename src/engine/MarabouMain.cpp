@@ -78,6 +78,13 @@ int marabouMain( int argc, char **argv )
             return 0;
         };
 
+        if ( options->getString( Options::DNC_LISTEN_ADDRESS ) != "" ||
+             options->getString( Options::DNC_CONNECT_ADDRESS ) != "" )
+            options->setBool( Options::DNC_MODE, true );
+
+        if ( options->getBool( Options::EXPAND_INPUT_DISJUNCTIONS ) )
+            options->setBool( Options::DNC_MODE, true );
+
         if ( options->getBool( Options::PRODUCE_PROOFS ) )
         {
             GlobalConfiguration::USE_DEEPSOI_LOCAL_SEARCH = false;
@@ -92,6 +99,31 @@ int marabouMain( int argc, char **argv )
             printf( "Proof production is not yet supported with snc mode, turning --snc off.\n" );
         }
 
+        if ( options->getBool( Options::PRODUCE_PROOFS ) &&
+             ( options->getBool( Options::PORTFOLIO ) ) )
+        {
+            options->setBool( Options::PORTFOLIO, false );
+            printf( "Proof production is not yet supported with portfolio mode, turning "
+                    "--portfolio off.\n" );
+        }
+
+        if ( options->getBool( Options::PRODUCE_PROOFS ) &&
+             options->getString( Options::CHECKPOINT_FILE ) != "" )
+        {
+            options->setString( Options::CHECKPOINT_FILE, "" );
+            options->setBool( Options::RESUME, false );
+            printf( "Proof production is not yet supported with checkpoints, turning "
+                    "--checkpoint-file off.\n" );
+        }
+
+        if ( options->getBool( Options::PRODUCE_PROOFS ) &&
+             options->getString( Options::PREPROCESSING_CACHE_DIRECTORY ) != "" )
+        {
+            options->setString( Options::PREPROCESSING_CACHE_DIRECTORY, "" );
+            printf( "Proof production is not yet supported with the preprocessing cache, turning "
+                    "--preprocessing-cache off.\n" );
+        }
+
         if ( options->getBool( Options::PRODUCE_PROOFS ) &&
              ( options->getBool( Options::SOLVE_WITH_MILP ) ) )
         {
@@ -115,6 +147,47 @@ int marabouMain( int argc, char **argv )
                                       "Cannot set both --snc and --poi to true..." );
         }
 
+        if ( options->getBool( Options::PORTFOLIO ) &&
+             ( options->getBool( Options::DNC_MODE ) ||
+               options->getBool( Options::PARALLEL_DEEPSOI ) ) )
+        {
+            throw ConfigurationError( ConfigurationError::INCOMPTATIBLE_OPTIONS,
+                                      "Cannot combine --portfolio with --snc or --poi..." );
+        }
+
+        if ( options->getBool( Options::DETERMINISTIC_DNC ) &&
+             ( options->getString( Options::DNC_LISTEN_ADDRESS ) != "" ||
+               options->getString( Options::DNC_CONNECT_ADDRESS ) != "" ) )
+        {
+            throw ConfigurationError( ConfigurationError::INCOMPTATIBLE_OPTIONS,
+                                      "Cannot combine --deterministic with --dnc-listen or "
+                                      "--dnc-connect..." );
+        }
+
+        if ( options->getBool( Options::DETERMINISTIC_DNC ) &&
+             !options->getBool( Options::DNC_MODE ) )
+        {
+            options->setBool( Options::DETERMINISTIC_DNC, false );
+            printf( "--deterministic only applies to snc mode, turning it off.\n" );
+        }
+
+        if ( options->getBool( Options::PORTFOLIO ) &&
+             options->getInt( Options::NUM_WORKERS ) > 1 &&
+             options->getString( Options::CHECKPOINT_FILE ) != "" )
+        {
+            options->setString( Options::CHECKPOINT_FILE, "" );
+            options->setBool( Options::RESUME, false );
+            printf( "Checkpoints are not yet supported in portfolio mode, turning "
+                    "--checkpoint-file off.\n" );
+        }
+
+        if ( options->getBool( Options::RESUME ) &&
+             options->getString( Options::CHECKPOINT_FILE ) == "" )
+        {
+            throw ConfigurationError( ConfigurationError::INCOMPTATIBLE_OPTIONS,
+                                      "--resume requires --checkpoint-file..." );
+        }
+
         if ( options->getBool( Options::PARALLEL_DEEPSOI ) &&
              ( options->getBool( Options::SOLVE_WITH_MILP ) ) )
         {
@@ -122,8 +195,16 @@ int marabouMain( int argc, char **argv )
             printf( "Cannot set both --poi and --milp to true, turning --milp off.\n" );
         }
 
+        if ( options->getBool( Options::PORTFOLIO ) &&
+             ( options->getBool( Options::SOLVE_WITH_MILP ) ) )
+        {
+            options->setBool( Options::SOLVE_WITH_MILP, false );
+            printf( "Cannot set both --portfolio and --milp to true, turning --milp off.\n" );
+        }
+
         if ( options->getBool( Options::DNC_MODE ) ||
-             ( options->getBool( Options::PARALLEL_DEEPSOI ) &&
+             ( ( options->getBool( Options::PARALLEL_DEEPSOI ) ||
+                 options->getBool( Options::PORTFOLIO ) ) &&
                options->getInt( Options::NUM_WORKERS ) > 1 ) )
             DnCMarabou().run();
         else
@@ -0,0 +1,119 @@
+/*********************                                                        */
+/*! \file PortfolioConfiguration.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "PortfolioConfiguration.h"
+
+#include "MStringf.h"
+#include "Options.h"
+
+PortfolioConfiguration::PortfolioConfiguration()
+    : _divideStrategy( Options::get()->getDivideStrategy() )
+    , _soiSearchStrategy( Options::get()->getSoISearchStrategy() )
+    , _symbolicBoundTighteningType( Options::get()->getSymbolicBoundTighteningType() )
+    , _useDantzigsRule( false )
+{
+}
+
+PortfolioConfiguration::PortfolioConfiguration(
+    DivideStrategy divideStrategy,
+    SoISearchStrategy soiSearchStrategy,
+    SymbolicBoundTighteningType symbolicBoundTighteningType,
+    bool useDantzigsRule )
+    : _divideStrategy( divideStrategy )
+    , _soiSearchStrategy( soiSearchStrategy )
+    , _symbolicBoundTighteningType( symbolicBoundTighteningType )
+    , _useDantzigsRule( useDantzigsRule )
+{
+}
+
+PortfolioConfiguration PortfolioConfiguration::getConfiguration( unsigned index )
+{
+    if ( index == 0 )
+        return PortfolioConfiguration();
+
+    // Plain symbolic bound tightening is left out, as the network level
+    // reasoner only allocates its buffers when it is selected on the command
+    // line
+    static const PortfolioConfiguration configurations[] = {
+        PortfolioConfiguration( DivideStrategy::ReLUViolation,
+                                SoISearchStrategy::MCMC,
+                                SymbolicBoundTighteningType::DEEP_POLY,
+                                true ),
+        PortfolioConfiguration( DivideStrategy::Polarity,
+                                SoISearchStrategy::MCMC,
+                                SymbolicBoundTighteningType::NONE,
+                                false ),
+        PortfolioConfiguration( DivideStrategy::Auto,
+                                SoISearchStrategy::WALKSAT,
+                                SymbolicBoundTighteningType::DEEP_POLY,
+                                false ),
+        PortfolioConfiguration( DivideStrategy::PseudoImpact,
+                                SoISearchStrategy::MCMC,
+                                SymbolicBoundTighteningType::NONE,
+                                true ),
+        PortfolioConfiguration( DivideStrategy::EarliestReLU,
+                                SoISearchStrategy::MCMC,
+                                SymbolicBoundTighteningType::DEEP_POLY,
+                                false ),
+    };
+    unsigned numConfigurations = sizeof( configurations ) / sizeof( configurations[0] );
+
+    return configurations[( index - 1 ) % numConfigurations];
+}
+
+String PortfolioConfiguration::toString() const
+{
+    const char *divideStrategy = "auto";
+    switch ( _divideStrategy )
+    {
+    case DivideStrategy::Polarity:
+        divideStrategy = "polarity";
+        break;
+    case DivideStrategy::EarliestReLU:
+        divideStrategy = "earliest-relu";
+        break;
+    case DivideStrategy::ReLUViolation:
+        divideStrategy = "relu-violation";
+        break;
+    case DivideStrategy::LargestInterval:
+        divideStrategy = "largest-interval";
+        break;
+    case DivideStrategy::PseudoImpact:
+        divideStrategy = "pseudo-impact";
+        break;
+    case DivideStrategy::Auto:
+        break;
+    }
+
+    const char *symbolicBoundTighteningType = "none";
+    if ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING )
+        symbolicBoundTighteningType = "sbt";
+    else if ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::DEEP_POLY )
+        symbolicBoundTighteningType = "deeppoly";
+
+    return Stringf( "branch=%s, soi=%s, tightening=%s, pricing=%s",
+                    divideStrategy,
+                    _soiSearchStrategy == SoISearchStrategy::WALKSAT ? "walksat" : "mcmc",
+                    symbolicBoundTighteningType,
+                    _useDantzigsRule ? "dantzig" : "steepest-edge" );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,66 @@
+/*********************                                                        */
+/*! \file PortfolioConfiguration.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The search-time settings of an engine that differ between the members
+ ** of a solver portfolio. All members solve the same preprocessed query.
+
+ **/
+
+#ifndef __PortfolioConfiguration_h__
+#define __PortfolioConfiguration_h__
+
+#include "DivideStrategy.h"
+#include "MString.h"
+#include "SoISearchStrategy.h"
+#include "SymbolicBoundTighteningType.h"
+
+class PortfolioConfiguration
+{
+public:
+    /*
+      The configuration given by the command line options
+    */
+    PortfolioConfiguration();
+
+    PortfolioConfiguration( DivideStrategy divideStrategy,
+                            SoISearchStrategy soiSearchStrategy,
+                            SymbolicBoundTighteningType symbolicBoundTighteningType,
+                            bool useDantzigsRule );
+
+    /*
+      The configuration of the given member of the portfolio. Member 0 uses
+      the command line options, and the others cycle through a fixed list of
+      configurations.
+    */
+    static PortfolioConfiguration getConfiguration( unsigned index );
+
+    String toString() const;
+
+    DivideStrategy _divideStrategy;
+    SoISearchStrategy _soiSearchStrategy;
+    SymbolicBoundTighteningType _symbolicBoundTighteningType;
+
+    /*
+      The pricing rule of the simplex: Dantzig's rule if true, projected
+      steepest edge otherwise
+    */
+    bool _useDantzigsRule;
+};
+
+#endif // __PortfolioConfiguration_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,795 @@
+/*********************                                                        */
+/*! \file PreprocessingCache.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "PreprocessingCache.h"
+
+#include "Convolution.h"
+#include "Debug.h"
+#include "Engine.h"
+#include "Error.h"
+#include "File.h"
+#include "Layer.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "NetworkLevelReasoner.h"
+#include "Options.h"
+#include "PiecewiseLinearConstraint.h"
+#include "Preprocessor.h"
+#include "QueryLoader.h"
+#include "Set.h"
+#include "SparseWeightMatrix.h"
+#include "Vector.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+static const char STATE_MAGIC[8] = { 'M', 'A', 'R', 'A', 'B', 'O', 'U', 'C' };
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+static const char *QUERY_FILE = "query.ipqb";
+static const char *PREPROCESSED_QUERY_FILE = "preprocessed.ipqb";
+static const char *STATE_FILE = "state";
+
+/*
+  The state file is a sequence of native-endian values:
+
+    magic, version, byte order mark
+    initial basis
+    fixed, merged, unused symbolically fixed and reindexed variables
+    whether the processed query has a network level reasoner, and if so:
+      the type, size and alpha of each layer
+      for each layer: its source layers with their non-zero weights or
+        convolution, its biases, the activation sources, variables and
+        eliminated values of its neurons
+      the constraints in topological order, as indices into the piecewise
+        linear constraints of the processed query
+
+  Every list is preceded by its uint64_t length.
+*/
+class StateWriter
+{
+public:
+    StateWriter( std::string &buffer )
+        : _buffer( buffer )
+    {
+    }
+
+    template <typename T> void write( T value )
+    {
+        _buffer.append( (const char *)&value, sizeof( T ) );
+    }
+
+    void writeCount( uint64_t count )
+    {
+        write<uint64_t>( count );
+    }
+
+private:
+    std::string &_buffer;
+};
+
+class StateReader
+{
+public:
+    StateReader( const std::string &data )
+        : _data( data )
+        , _offset( 0 )
+    {
+    }
+
+    template <typename T> T read()
+    {
+        if ( _data.size() - _offset < sizeof( T ) )
+            throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                                "Unexpected end of the state file" );
+
+        T value;
+        memcpy( &value, _data.data() + _offset, sizeof( T ) );
+        _offset += sizeof( T );
+        return value;
+    }
+
+    /*
+      The length of a list whose elements take at least elementSize bytes
+    */
+    uint64_t readCount( uint64_t elementSize )
+    {
+        uint64_t count = read<uint64_t>();
+        if ( count > ( _data.size() - _offset ) / elementSize )
+            throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                                "Invalid list length in the state file" );
+        return count;
+    }
+
+    /*
+      An index that must be smaller than the given bound
+    */
+    unsigned readIndex( unsigned bound, const char *description )
+    {
+        uint32_t index = read<uint32_t>();
+        if ( index >= bound )
+            throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                                Stringf( "Invalid %s %u in the state file", description, index )
+                                    .ascii() );
+        return index;
+    }
+
+    bool done() const
+    {
+        return _offset == _data.size();
+    }
+
+private:
+    const std::string &_data;
+    size_t _offset;
+};
+
+static void hashBytes( unsigned long long &hash, const void *data, size_t size )
+{
+    // FNV-1a
+    const unsigned char *bytes = (const unsigned char *)data;
+    for ( size_t i = 0; i < size; ++i )
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+static bool hasActivationSources( NLR::Layer::Type type )
+{
+    return type != NLR::Layer::INPUT && type != NLR::Layer::WEIGHTED_SUM &&
+           type != NLR::Layer::CONV;
+}
+
+static void writeWeights( StateWriter &writer, const NLR::Layer *layer, unsigned sourceLayer )
+{
+    unsigned rows = layer->getSourceLayers()[sourceLayer];
+    unsigned columns = layer->getSize();
+
+    if ( layer->hasSparseWeights( sourceLayer ) )
+    {
+        const NLR::SparseWeightMatrix *weights = layer->getSparseWeights( sourceLayer );
+        const unsigned *rowStarts = weights->getRowStarts();
+        const unsigned *columnIndices = weights->getColumnIndices();
+        const double *values = weights->getValues();
+
+        writer.writeCount( weights->getNnz() );
+        for ( unsigned i = 0; i < rows; ++i )
+        {
+            for ( unsigned j = rowStarts[i]; j < rowStarts[i + 1]; ++j )
+            {
+                writer.write<uint32_t>( i );
+                writer.write<uint32_t>( columnIndices[j] );
+                writer.write<double>( values[j] );
+            }
+        }
+        return;
+    }
+
+    const double *weights = layer->getWeights( sourceLayer );
+    uint64_t nonZeros = 0;
+    for ( unsigned i = 0; i < rows * columns; ++i )
+    {
+        // Keep negative zeros, so that the weights are restored bit for bit
+        if ( weights[i] != 0 || std::signbit( weights[i] ) )
+            ++nonZeros;
+    }
+
+    writer.writeCount( nonZeros );
+    for ( unsigned i = 0; i < rows; ++i )
+    {
+        for ( unsigned j = 0; j < columns; ++j )
+        {
+            double weight = weights[i * columns + j];
+            if ( weight != 0 || std::signbit( weight ) )
+            {
+                writer.write<uint32_t>( i );
+                writer.write<uint32_t>( j );
+                writer.write<double>( weight );
+            }
+        }
+    }
+}
+
+static void writeConvolution( StateWriter &writer, const NLR::Convolution *convolution )
+{
+    const NLR::Convolution::Shape &shape = convolution->getShape();
+    writer.write<uint32_t>( shape._inputChannels );
+    writer.write<uint32_t>( shape._inputWidth );
+    writer.write<uint32_t>( shape._inputHeight );
+    writer.write<uint32_t>( shape._outputChannels );
+    writer.write<uint32_t>( shape._outputWidth );
+    writer.write<uint32_t>( shape._outputHeight );
+    writer.write<uint32_t>( shape._kernelWidth );
+    writer.write<uint32_t>( shape._kernelHeight );
+    writer.write<uint32_t>( shape._strideWidth );
+    writer.write<uint32_t>( shape._strideHeight );
+    writer.write<uint32_t>( shape._padLeft );
+    writer.write<uint32_t>( shape._padBottom );
+
+    const Vector<double> &kernel = convolution->getKernel();
+    writer.writeCount( kernel.size() );
+    for ( unsigned i = 0; i < kernel.size(); ++i )
+        writer.write<double>( kernel[i] );
+
+    const Vector<unsigned> &inputNeurons = convolution->getInputNeurons();
+    writer.writeCount( inputNeurons.size() );
+    for ( unsigned i = 0; i < inputNeurons.size(); ++i )
+        writer.write<uint32_t>( inputNeurons[i] );
+}
+
+static void writeNetworkLevelReasoner( StateWriter &writer,
+                                       NLR::NetworkLevelReasoner *nlr,
+                                       const InputQuery &preprocessedQuery )
+{
+    unsigned numberOfLayers = nlr->getNumberOfLayers();
+    writer.writeCount( numberOfLayers );
+    for ( unsigned i = 0; i < numberOfLayers; ++i )
+    {
+        const NLR::Layer *layer = nlr->getLayer( i );
+        ASSERT( layer->getLayerIndex() == i );
+
+        writer.write<uint32_t>( layer->getLayerType() );
+        writer.write<uint32_t>( layer->getSize() );
+        writer.write<double>( layer->getAlpha() );
+    }
+
+    for ( unsigned i = 0; i < numberOfLayers; ++i )
+    {
+        const NLR::Layer *layer = nlr->getLayer( i );
+        NLR::Layer::Type type = layer->getLayerType();
+        unsigned size = layer->getSize();
+
+        writer.writeCount( layer->getSourceLayers().size() );
+        for ( const auto &sourceLayer : layer->getSourceLayers() )
+        {
+            writer.write<uint32_t>( sourceLayer.first );
+            if ( type == NLR::Layer::WEIGHTED_SUM )
+                writeWeights( writer, layer, sourceLayer.first );
+            else if ( type == NLR::Layer::CONV )
+                writeConvolution( writer, layer->getConvolution( sourceLayer.first ) );
+        }
+
+        const double *biases = layer->getBiases();
+        writer.write<uint8_t>( biases != nullptr );
+        if ( biases )
+        {
+            for ( unsigned j = 0; j < size; ++j )
+                writer.write<double>( biases[j] );
+        }
+
+        if ( hasActivationSources( type ) )
+        {
+            for ( unsigned j = 0; j < size; ++j )
+            {
+                List<NLR::NeuronIndex> sources = layer->getActivationSources( j );
+                writer.writeCount( sources.size() );
+                for ( const auto &source : sources )
+                {
+                    writer.write<uint32_t>( source._layer );
+                    writer.write<uint32_t>( source._neuron );
+                }
+            }
+        }
+
+        for ( unsigned j = 0; j < size; ++j )
+        {
+            if ( layer->neuronHasVariable( j ) )
+            {
+                writer.write<uint8_t>( 1 );
+                writer.write<uint32_t>( layer->neuronToVariable( j ) );
+            }
+            else if ( layer->neuronEliminated( j ) )
+            {
+                writer.write<uint8_t>( 2 );
+                writer.write<double>( layer->getEliminatedNeuronValue( j ) );
+            }
+            else
+                writer.write<uint8_t>( 0 );
+        }
+    }
+
+    Map<const PiecewiseLinearConstraint *, unsigned> constraintToIndex;
+    unsigned index = 0;
+    for ( const auto &constraint : preprocessedQuery.getPiecewiseLinearConstraints() )
+        constraintToIndex[constraint] = index++;
+
+    List<PiecewiseLinearConstraint *> constraints = nlr->getConstraintsInTopologicalOrder();
+    writer.writeCount( constraints.size() );
+    for ( const auto &constraint : constraints )
+        writer.write<uint32_t>( constraintToIndex[constraint] );
+}
+
+static void serializeState( Engine &engine, std::string &result )
+{
+    StateWriter writer( result );
+    for ( unsigned i = 0; i < sizeof( STATE_MAGIC ); ++i )
+        writer.write<char>( STATE_MAGIC[i] );
+    writer.write<uint32_t>( PreprocessingCache::VERSION );
+    writer.write<uint32_t>( BYTE_ORDER_MARK );
+
+    const List<unsigned> &initialBasis = engine.getInitialBasis();
+    writer.writeCount( initialBasis.size() );
+    for ( const auto &variable : initialBasis )
+        writer.write<uint32_t>( variable );
+
+    const Preprocessor *preprocessor = engine.getPreprocessor();
+
+    writer.writeCount( preprocessor->getFixedVariables().size() );
+    for ( const auto &fixed : preprocessor->getFixedVariables() )
+    {
+        writer.write<uint32_t>( fixed.first );
+        writer.write<double>( fixed.second );
+    }
+
+    writer.writeCount( preprocessor->getMergedVariables().size() );
+    for ( const auto &merged : preprocessor->getMergedVariables() )
+    {
+        writer.write<uint32_t>( merged.first );
+        writer.write<uint32_t>( merged.second );
+    }
+
+    writer.writeCount( preprocessor->getUnusedSymbolicallyFixedVariables().size() );
+    for ( const auto &fixed : preprocessor->getUnusedSymbolicallyFixedVariables() )
+    {
+        writer.write<uint32_t>( fixed.first );
+        writer.write<double>( fixed.second._constant );
+        writer.writeCount( fixed.second._addends.size() );
+        for ( const auto &addend : fixed.second._addends )
+        {
+            writer.write<uint32_t>( addend.first );
+            writer.write<double>( addend.second );
+        }
+    }
+
+    writer.writeCount( preprocessor->getOldIndexToNewIndex().size() );
+    for ( const auto &index : preprocessor->getOldIndexToNewIndex() )
+    {
+        writer.write<uint32_t>( index.first );
+        writer.write<uint32_t>( index.second );
+    }
+
+    const InputQuery &preprocessedQuery = *engine.getInputQuery();
+    NLR::NetworkLevelReasoner *nlr = preprocessedQuery.getNetworkLevelReasoner();
+    writer.write<uint8_t>( nlr != nullptr );
+    if ( nlr )
+        writeNetworkLevelReasoner( writer, nlr, preprocessedQuery );
+}
+
+static void readConvolution( StateReader &reader,
+                             NLR::Layer *layer,
+                             unsigned sourceLayer,
+                             unsigned sourceLayerSize )
+{
+    NLR::Convolution::Shape shape;
+    shape._inputChannels = reader.read<uint32_t>();
+    shape._inputWidth = reader.read<uint32_t>();
+    shape._inputHeight = reader.read<uint32_t>();
+    shape._outputChannels = reader.read<uint32_t>();
+    shape._outputWidth = reader.read<uint32_t>();
+    shape._outputHeight = reader.read<uint32_t>();
+    shape._kernelWidth = reader.read<uint32_t>();
+    shape._kernelHeight = reader.read<uint32_t>();
+    shape._strideWidth = reader.read<uint32_t>();
+    shape._strideHeight = reader.read<uint32_t>();
+    shape._padLeft = reader.read<uint32_t>();
+    shape._padBottom = reader.read<uint32_t>();
+
+    Vector<double> kernel;
+    uint64_t kernelSize = reader.readCount( sizeof( double ) );
+    for ( uint64_t i = 0; i < kernelSize; ++i )
+        kernel.append( reader.read<double>() );
+
+    Vector<unsigned> inputNeurons;
+    uint64_t numberOfInputNeurons = reader.readCount( sizeof( uint32_t ) );
+    for ( uint64_t i = 0; i < numberOfInputNeurons; ++i )
+        inputNeurons.append( reader.readIndex( sourceLayerSize, "source neuron" ) );
+
+    if ( kernelSize != (uint64_t)shape._outputChannels * shape._inputChannels *
+                           shape._kernelWidth * shape._kernelHeight ||
+         numberOfInputNeurons !=
+             (uint64_t)shape._inputChannels * shape._inputWidth * shape._inputHeight ||
+         (uint64_t)shape._outputChannels * shape._outputWidth * shape._outputHeight !=
+             layer->getSize() )
+        throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                            "Invalid convolution in the state file" );
+
+    layer->setConvolution( sourceLayer,
+                           std::make_shared<const NLR::Convolution>(
+                               shape, kernel, inputNeurons, sourceLayerSize ) );
+}
+
+static NLR::NetworkLevelReasoner *readNetworkLevelReasoner( StateReader &reader,
+                                                           InputQuery &preprocessedQuery )
+{
+    std::unique_ptr<NLR::NetworkLevelReasoner> nlr( new NLR::NetworkLevelReasoner );
+
+    uint64_t numberOfLayers = reader.readCount( 2 * sizeof( uint32_t ) + sizeof( double ) );
+    for ( unsigned i = 0; i < numberOfLayers; ++i )
+    {
+        uint32_t type = reader.read<uint32_t>();
+        uint32_t size = reader.read<uint32_t>();
+        double alpha = reader.read<double>();
+        if ( type > NLR::Layer::BILINEAR || ( i == 0 ) != ( type == NLR::Layer::INPUT ) )
+            throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                                Stringf( "Invalid type of layer %u in the state file", i )
+                                    .ascii() );
+
+        nlr->addLayer( i, (NLR::Layer::Type)type, size );
+        nlr->getLayer( i )->setAlpha( alpha );
+    }
+
+    unsigned numberOfVariables = preprocessedQuery.getNumberOfVariables();
+    for ( unsigned i = 0; i < numberOfLayers; ++i )
+    {
+        NLR::Layer *layer = nlr->getLayer( i );
+        NLR::Layer::Type type = layer->getLayerType();
+        unsigned size = layer->getSize();
+
+        uint64_t numberOfSourceLayers = reader.readCount( sizeof( uint32_t ) );
+        if ( ( type == NLR::Layer::INPUT && numberOfSourceLayers > 0 ) ||
+             ( type == NLR::Layer::CONV && numberOfSourceLayers != 1 ) )
+            throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                                Stringf( "Invalid source layers of layer %u in the state file", i )
+                                    .ascii() );
+        for ( uint64_t j = 0; j < numberOfSourceLayers; ++j )
+        {
+            unsigned sourceLayer = reader.readIndex( i, "source layer" );
+            unsigned sourceLayerSize = nlr->getLayer( sourceLayer )->getSize();
+            nlr->addLayerDependency( sourceLayer, i );
+
+            if ( type == NLR::Layer::WEIGHTED_SUM )
+            {
+                uint64_t numberOfWeights =
+                    reader.readCount( 2 * sizeof( uint32_t ) + sizeof( double ) );
+                for ( uint64_t k = 0; k < numberOfWeights; ++k )
+                {
+                    unsigned sourceNeuron = reader.readIndex( sourceLayerSize, "source neuron" );
+                    unsigned targetNeuron = reader.readIndex( size, "neuron" );
+                    double weight = reader.read<double>();
+                    layer->setWeight( sourceLayer, sourceNeuron, targetNeuron, weight );
+                }
+            }
+            else if ( type == NLR::Layer::CONV )
+                readConvolution( reader, layer, sourceLayer, sourceLayerSize );
+        }
+
+        bool hasBiases = reader.read<uint8_t>();
+        if ( hasBiases != ( layer->getBiases() != nullptr ) )
+            throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                                "Unexpected biases in the state file" );
+        if ( hasBiases )
+        {
+            for ( unsigned j = 0; j < size; ++j )
+                layer->setBias( j, reader.read<double>() );
+        }
+
+        if ( hasActivationSources( type ) )
+        {
+            for ( unsigned j = 0; j < size; ++j )
+            {
+                uint64_t numberOfSources = reader.readCount( 2 * sizeof( uint32_t ) );
+                if ( numberOfSources == 0 )
+                    throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                                        "Neuron without activation sources in the state file" );
+                for ( uint64_t k = 0; k < numberOfSources; ++k )
+                {
+                    unsigned sourceLayer = reader.readIndex( i, "source layer" );
+                    unsigned sourceNeuron = reader.readIndex(
+                        nlr->getLayer( sourceLayer )->getSize(), "source neuron" );
+                    layer->addActivationSource( sourceLayer, sourceNeuron, j );
+                }
+            }
+        }
+
+        for ( unsigned j = 0; j < size; ++j )
+        {
+            uint8_t status = reader.read<uint8_t>();
+            if ( status == 1 )
+                layer->setNeuronVariable( j, reader.readIndex( numberOfVariables, "variable" ) );
+            else if ( status == 2 && type != NLR::Layer::INPUT )
+                layer->eliminateNeuron( j, reader.read<double>() );
+            else if ( status != 0 )
+                throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                                    "Invalid neuron in the state file" );
+        }
+    }
+
+    Vector<PiecewiseLinearConstraint *> constraints;
+    for ( const auto &constraint : preprocessedQuery.getPiecewiseLinearConstraints() )
+        constraints.append( constraint );
+
+    Set<unsigned> constraintsInTopologicalOrder;
+    uint64_t numberOfConstraints = reader.readCount( sizeof( uint32_t ) );
+    for ( uint64_t i = 0; i < numberOfConstraints; ++i )
+    {
+        unsigned index = reader.readIndex( constraints.size(), "constraint" );
+        if ( constraintsInTopologicalOrder.exists( index ) )
+            throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                                "Repeated constraint in the state file" );
+        constraintsInTopologicalOrder.insert( index );
+        nlr->addConstraintInTopologicalOrder( constraints[index] );
+    }
+
+    return nlr.release();
+}
+
+/*
+  Restore the state stored by serializeState. The processed query must
+  have been loaded into the entry.
+*/
+static void deserializeState( const std::string &serialized, PreprocessingCache::Entry &entry )
+{
+    StateReader reader( serialized );
+    for ( unsigned i = 0; i < sizeof( STATE_MAGIC ); ++i )
+    {
+        if ( reader.read<char>() != STATE_MAGIC[i] )
+            throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                                "Not a preprocessing cache state file" );
+    }
+    if ( reader.read<uint32_t>() != PreprocessingCache::VERSION ||
+         reader.read<uint32_t>() != BYTE_ORDER_MARK )
+        throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                            "Unsupported version or byte order of the state file" );
+
+    InputQuery &preprocessedQuery = *entry._preprocessedQuery;
+    unsigned numberOfVariables = preprocessedQuery.getNumberOfVariables();
+
+    entry._initialBasis.clear();
+    uint64_t basisSize = reader.readCount( sizeof( uint32_t ) );
+    for ( uint64_t i = 0; i < basisSize; ++i )
+        entry._initialBasis.append( reader.readIndex( numberOfVariables, "basic variable" ) );
+
+    // The variables of the maps belong to the original query, and are
+    // checked against it when a solution is extracted
+    entry._fixedVariables.clear();
+    uint64_t numberOfFixedVariables = reader.readCount( sizeof( uint32_t ) + sizeof( double ) );
+    for ( uint64_t i = 0; i < numberOfFixedVariables; ++i )
+    {
+        unsigned variable = reader.read<uint32_t>();
+        entry._fixedVariables[variable] = reader.read<double>();
+    }
+
+    entry._mergedVariables.clear();
+    uint64_t numberOfMergedVariables = reader.readCount( 2 * sizeof( uint32_t ) );
+    for ( uint64_t i = 0; i < numberOfMergedVariables; ++i )
+    {
+        unsigned variable = reader.read<uint32_t>();
+        entry._mergedVariables[variable] = reader.read<uint32_t>();
+    }
+
+    entry._unusedSymbolicallyFixedVariables.clear();
+    uint64_t numberOfSymbolicallyFixedVariables =
+        reader.readCount( sizeof( uint32_t ) + sizeof( double ) + sizeof( uint64_t ) );
+    for ( uint64_t i = 0; i < numberOfSymbolicallyFixedVariables; ++i )
+    {
+        unsigned variable = reader.read<uint32_t>();
+        LinearExpression &expression = entry._unusedSymbolicallyFixedVariables[variable];
+        expression._constant = reader.read<double>();
+        uint64_t numberOfAddends = reader.readCount( sizeof( uint32_t ) + sizeof( double ) );
+        for ( uint64_t j = 0; j < numberOfAddends; ++j )
+        {
+            unsigned addendVariable = reader.read<uint32_t>();
+            expression._addends[addendVariable] = reader.read<double>();
+        }
+    }
+
+    entry._oldIndexToNewIndex.clear();
+    uint64_t numberOfReindexedVariables = reader.readCount( 2 * sizeof( uint32_t ) );
+    for ( uint64_t i = 0; i < numberOfReindexedVariables; ++i )
+    {
+        unsigned variable = reader.read<uint32_t>();
+        entry._oldIndexToNewIndex[variable] = reader.readIndex( numberOfVariables, "variable" );
+    }
+
+    if ( reader.read<uint8_t>() )
+        preprocessedQuery.setNetworkLevelReasoner(
+            readNetworkLevelReasoner( reader, preprocessedQuery ) );
+
+    if ( !reader.done() )
+        throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                            "Trailing data in the state file" );
+}
+
+static void readFile( const String &path, std::string &contents )
+{
+    std::ifstream input( path.ascii(), std::ios::binary );
+    if ( !input )
+        throw MarabouError( MarabouError::FILE_DOES_NOT_EXIST, path.ascii() );
+
+    contents.assign( std::istreambuf_iterator<char>( input ), std::istreambuf_iterator<char>() );
+    if ( input.bad() )
+        throw MarabouError( MarabouError::INVALID_PREPROCESSING_CACHE_ENTRY,
+                            Stringf( "Cannot read %s", path.ascii() ).ascii() );
+}
+
+static void writeFile( const String &path, const std::string &contents )
+{
+    std::ofstream output( path.ascii(), std::ios::binary | std::ios::trunc );
+    output.write( contents.data(), contents.size() );
+    output.close();
+    if ( output.fail() )
+        throw MarabouError( MarabouError::PREPROCESSING_CACHE_WRITE_FAILED,
+                            Stringf( "Cannot write %s", path.ascii() ).ascii() );
+}
+
+static void removeEntryDirectory( const String &path )
+{
+    unlink( ( path + "/" + QUERY_FILE ).ascii() );
+    unlink( ( path + "/" + PREPROCESSED_QUERY_FILE ).ascii() );
+    unlink( ( path + "/" + STATE_FILE ).ascii() );
+    rmdir( path.ascii() );
+}
+
+PreprocessingCache::PreprocessingCache( const String &directory )
+    : _directory( directory )
+    , _numberOfHits( 0 )
+    , _numberOfMisses( 0 )
+{
+}
+
+String PreprocessingCache::computeKey( const List<String> &filePaths )
+{
+    enum {
+        CHUNK_SIZE = 1 << 20,
+    };
+
+    unsigned long long hash = 14695981039346656037ULL;
+
+    std::vector<char> chunk( CHUNK_SIZE );
+    for ( const auto &filePath : filePaths )
+    {
+        std::ifstream input( filePath.ascii(), std::ios::binary );
+        if ( !input )
+            throw MarabouError( MarabouError::FILE_DOES_NOT_EXIST, filePath.ascii() );
+
+        unsigned long long fileSize = 0;
+        while ( input )
+        {
+            input.read( chunk.data(), CHUNK_SIZE );
+            hashBytes( hash, chunk.data(), input.gcount() );
+            fileSize += input.gcount();
+        }
+        hashBytes( hash, &fileSize, sizeof( fileSize ) );
+    }
+
+    Options *options = Options::get();
+    String configuration =
+        Stringf( "%u %s %s %s %s %d %d %d %d %d %d %a %a",
+                 VERSION,
+                 options->getString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE ).ascii(),
+                 options->getString( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ).ascii(),
+                 options->getString( Options::LP_SOLVER ).ascii(),
+                 options->getString( Options::SOFTMAX_BOUND_TYPE ).ascii(),
+                 options->getInt( Options::NUMBER_OF_SIMULATIONS ),
+                 options->getInt( Options::SEED ),
+                 options->getBool( Options::DO_NOT_MERGE_CONSECUTIVE_WEIGHTED_SUM_LAYERS ),
+                 options->getBool( Options::DEEP_POLY_SINGLE_PRECISION ),
+                 options->getBool( Options::DEEP_POLY_OPTIMIZE_SLOPES ),
+                 options->getBool( Options::DEEP_POLY_OPTIMIZE_SPLIT_MULTIPLIERS ),
+                 options->getFloat( Options::PREPROCESSOR_BOUND_TOLERANCE ),
+                 options->getFloat( Options::MILP_SOLVER_TIMEOUT ) );
+    hashBytes( hash, configuration.ascii(), configuration.length() );
+
+    return Stringf( "%016llx", hash );
+}
+
+bool PreprocessingCache::load( const String &key, InputQuery &inputQuery, Entry &entry )
+{
+    String path = getEntryPath( key );
+    if ( !File::exists( path + "/" + STATE_FILE ) )
+    {
+        ++_numberOfMisses;
+        return false;
+    }
+
+    try
+    {
+        InputQuery originalQuery = QueryLoader::loadBinaryQuery( path + "/" + QUERY_FILE );
+        entry._preprocessedQuery = std::unique_ptr<InputQuery>( new InputQuery(
+            QueryLoader::loadBinaryQuery( path + "/" + PREPROCESSED_QUERY_FILE ) ) );
+
+        std::string state;
+        readFile( path + "/" + STATE_FILE, state );
+        deserializeState( state, entry );
+
+        inputQuery = originalQuery;
+    }
+    catch ( const Error &e )
+    {
+        printf( "Warning: ignoring the preprocessing cache entry %s: %s\n",
+                path.ascii(),
+                e.getUserMessage() );
+        entry._preprocessedQuery = nullptr;
+        ++_numberOfMisses;
+        return false;
+    }
+
+    ++_numberOfHits;
+    return true;
+}
+
+void PreprocessingCache::store( const String &key, InputQuery &inputQuery, Engine &engine )
+{
+    String path = getEntryPath( key );
+    String temporaryPath = Stringf( "%s.tmp.%u", path.ascii(), (unsigned)getpid() );
+
+    try
+    {
+        if ( mkdir( _directory.ascii(), 0755 ) != 0 && errno != EEXIST )
+            throw MarabouError( MarabouError::PREPROCESSING_CACHE_WRITE_FAILED,
+                                Stringf( "Cannot create %s", _directory.ascii() ).ascii() );
+        if ( mkdir( temporaryPath.ascii(), 0755 ) != 0 )
+            throw MarabouError( MarabouError::PREPROCESSING_CACHE_WRITE_FAILED,
+                                Stringf( "Cannot create %s", temporaryPath.ascii() ).ascii() );
+
+        inputQuery.saveBinaryQuery( temporaryPath + "/" + QUERY_FILE );
+        engine.getInputQuery()->saveBinaryQuery( temporaryPath + "/" + PREPROCESSED_QUERY_FILE );
+
+        std::string state;
+        serializeState( engine, state );
+        writeFile( temporaryPath + "/" + STATE_FILE, state );
+
+        // If another run has stored the entry in the meantime, keep its copy
+        if ( std::rename( temporaryPath.ascii(), path.ascii() ) != 0 )
+            removeEntryDirectory( temporaryPath );
+    }
+    catch ( const Error &e )
+    {
+        printf( "Warning: cannot store the preprocessing cache entry %s: %s\n",
+                path.ascii(),
+                e.getUserMessage() );
+        removeEntryDirectory( temporaryPath );
+    }
+}
+
+unsigned PreprocessingCache::getNumberOfHits() const
+{
+    return _numberOfHits;
+}
+
+unsigned PreprocessingCache::getNumberOfMisses() const
+{
+    return _numberOfMisses;
+}
+
+void PreprocessingCache::printStatistics() const
+{
+    printf( "Preprocessing cache (%s) - hits: %u, misses: %u\n",
+            _directory.ascii(),
+            _numberOfHits,
+            _numberOfMisses );
+}
+
+String PreprocessingCache::getEntryPath( const String &key ) const
+{
+    return _directory + "/" + key;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,104 @@
+/*********************                                                        */
+/*! \file PreprocessingCache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** An on-disk cache of processed queries, so that verifying the same
+ ** network and property again skips parsing, preprocessing and root bound
+ ** tightening.
+ **
+ ** An entry is a subdirectory of the cache directory, named after the key,
+ ** that holds the original query and the processed query in the binary
+ ** input query format, and a state file with the initial basis, the
+ ** preprocessor's variable maps and the network level reasoner of the
+ ** processed query. Entries are written to a temporary directory that is
+ ** then renamed, so concurrent runs never read a partial entry.
+
+ **/
+
+#ifndef __PreprocessingCache_h__
+#define __PreprocessingCache_h__
+
+#include "InputQuery.h"
+#include "LinearExpression.h"
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+
+#include <memory>
+
+class Engine;
+
+class PreprocessingCache
+{
+public:
+    enum {
+        // Incremented whenever the layout of an entry changes
+        VERSION = 1,
+    };
+
+    /*
+      The state of an engine that has processed a query
+    */
+    struct Entry
+    {
+        std::unique_ptr<InputQuery> _preprocessedQuery;
+        List<unsigned> _initialBasis;
+
+        Map<unsigned, double> _fixedVariables;
+        Map<unsigned, unsigned> _mergedVariables;
+        Map<unsigned, LinearExpression> _unusedSymbolicallyFixedVariables;
+        Map<unsigned, unsigned> _oldIndexToNewIndex;
+    };
+
+    PreprocessingCache( const String &directory );
+
+    /*
+      The key of a query built from the given files (e.g., the network and
+      the property): a hash of their contents and of the options that affect
+      the processing of the query
+    */
+    static String computeKey( const List<String> &filePaths );
+
+    /*
+      Load the original query and the processed state stored for the key.
+      Return false on a miss, i.e., if there is no entry for the key or if
+      the entry cannot be read.
+    */
+    bool load( const String &key, InputQuery &inputQuery, Entry &entry );
+
+    /*
+      Store the original query and the state of the engine that has just
+      processed it, before it starts solving. Failures are reported but do
+      not interrupt the run.
+    */
+    void store( const String &key, InputQuery &inputQuery, Engine &engine );
+
+    unsigned getNumberOfHits() const;
+    unsigned getNumberOfMisses() const;
+    void printStatistics() const;
+
+private:
+    String _directory;
+
+    unsigned _numberOfHits;
+    unsigned _numberOfMisses;
+
+    String getEntryPath( const String &key ) const;
+};
+
+#endif // __PreprocessingCache_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
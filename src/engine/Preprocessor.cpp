@@ -1041,6 +1041,38 @@ unsigned Preprocessor::getNewIndex( unsigned oldIndex ) const
     return oldIndex;
 }
 
+const Map<unsigned, double> &Preprocessor::getFixedVariables() const
+{
+    return _fixedVariables;
+}
+
+const Map<unsigned, unsigned> &Preprocessor::getMergedVariables() const
+{
+    return _mergedVariables;
+}
+
+const Map<unsigned, LinearExpression> &Preprocessor::getUnusedSymbolicallyFixedVariables() const
+{
+    return _unusedSymbolicallyFixedVariables;
+}
+
+const Map<unsigned, unsigned> &Preprocessor::getOldIndexToNewIndex() const
+{
+    return _oldIndexToNewIndex;
+}
+
+void Preprocessor::restoreVariableMaps(
+    const Map<unsigned, double> &fixedVariables,
+    const Map<unsigned, unsigned> &mergedVariables,
+    const Map<unsigned, LinearExpression> &unusedSymbolicallyFixedVariables,
+    const Map<unsigned, unsigned> &oldIndexToNewIndex )
+{
+    _fixedVariables = fixedVariables;
+    _mergedVariables = mergedVariables;
+    _unusedSymbolicallyFixedVariables = unusedSymbolicallyFixedVariables;
+    _oldIndexToNewIndex = oldIndexToNewIndex;
+}
+
 void Preprocessor::setStatistics( Statistics *statistics )
 {
     _statistics = statistics;
@@ -71,6 +71,22 @@ public:
     */
     void setSolutionValuesOfEliminatedNeurons( InputQuery &inputQuery );
 
+    /*
+      The maps from the variables of the original query to those of the
+      preprocessed query. They can be restored in a fresh preprocessor, so
+      that solutions of a preprocessed query stored earlier (e.g., in a
+      PreprocessingCache) can be mapped back without preprocessing again.
+    */
+    const Map<unsigned, double> &getFixedVariables() const;
+    const Map<unsigned, unsigned> &getMergedVariables() const;
+    const Map<unsigned, LinearExpression> &getUnusedSymbolicallyFixedVariables() const;
+    const Map<unsigned, unsigned> &getOldIndexToNewIndex() const;
+    void
+    restoreVariableMaps( const Map<unsigned, double> &fixedVariables,
+                         const Map<unsigned, unsigned> &mergedVariables,
+                         const Map<unsigned, LinearExpression> &unusedSymbolicallyFixedVariables,
+                         const Map<unsigned, unsigned> &oldIndexToNewIndex );
+
 private:
     void freeMemoryIfNeeded();
 
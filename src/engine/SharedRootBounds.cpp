@@ -0,0 +1,55 @@
+/*********************                                                        */
+/*! \file SharedRootBounds.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "SharedRootBounds.h"
+
+#include "FloatUtils.h"
+
+void SharedRootBounds::publish( const List<Tightening> &tightenings )
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    for ( const auto &tightening : tightenings )
+    {
+        if ( tightening._type == Tightening::LB )
+        {
+            if ( !_lowerBounds.exists( tightening._variable ) ||
+                 FloatUtils::gt( tightening._value, _lowerBounds[tightening._variable] ) )
+                _lowerBounds[tightening._variable] = tightening._value;
+        }
+        else
+        {
+            if ( !_upperBounds.exists( tightening._variable ) ||
+                 FloatUtils::lt( tightening._value, _upperBounds[tightening._variable] ) )
+                _upperBounds[tightening._variable] = tightening._value;
+        }
+    }
+}
+
+void SharedRootBounds::getTightenings( List<Tightening> &tightenings ) const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    for ( const auto &lowerBound : _lowerBounds )
+        tightenings.append( Tightening( lowerBound.first, lowerBound.second, Tightening::LB ) );
+    for ( const auto &upperBound : _upperBounds )
+        tightenings.append( Tightening( upperBound.first, upperBound.second, Tightening::UB ) );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
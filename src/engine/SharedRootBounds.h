@@ -0,0 +1,55 @@
+/*********************                                                        */
+/*! \file SharedRootBounds.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Bounds proved at the root of the search tree by any of several engines
+ ** solving the same preprocessed query. As these bounds hold for the whole
+ ** query, each engine can adopt the ones found by the others.
+
+ **/
+
+#ifndef __SharedRootBounds_h__
+#define __SharedRootBounds_h__
+
+#include "List.h"
+#include "Map.h"
+#include "Tightening.h"
+
+#include <mutex>
+
+class SharedRootBounds
+{
+public:
+    /*
+      Record bounds proved at the root. Only the ones tighter than the
+      bounds already known are kept.
+    */
+    void publish( const List<Tightening> &tightenings );
+
+    /*
+      Get the tightest known bounds
+    */
+    void getTightenings( List<Tightening> &tightenings ) const;
+
+private:
+    mutable std::mutex _mutex;
+    Map<unsigned, double> _lowerBounds;
+    Map<unsigned, double> _upperBounds;
+};
+
+#endif // __SharedRootBounds_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
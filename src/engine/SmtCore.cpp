@@ -571,6 +571,11 @@ void SmtCore::replaySmtStackEntry( SmtStackEntry *stackEntry )
     _engine->storeState( *stateBeforeSplits, TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE );
     stackEntry->_engineState = stateBeforeSplits;
 
+    // Every stack entry has its own context level, which is popped along
+    // with the entry
+    _engine->preContextPushHook();
+    pushContext();
+
     // Apply all the splits
     _engine->applySplit( stackEntry->_activeSplit );
     for ( const auto &impliedSplit : stackEntry->_impliedValidSplits )
@@ -0,0 +1,255 @@
+/*********************                                                        */
+/*! \file SubQuerySerializer.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "SubQuerySerializer.h"
+
+#include "Equation.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "SmtStackEntry.h"
+#include "Tightening.h"
+
+#include <cstdlib>
+
+/*
+  The serialized form of a subquery is:
+
+    #<queryId> <depth> <timeout> <split> <hasSmtState> [<smtState>]
+
+  where a split is
+
+    <#bounds> { <variable> <L|U> <value> } <#equations> { <equation> }
+
+  and an equation is
+
+    <type> <scalar> <#addends> { <coefficient> <variable> }
+
+  The SmtState is serialized as its id, the implied valid splits at the
+  root, and then the stack entries, each consisting of the active split,
+  the implied valid splits and the alternative splits.
+
+  The query id is prefixed by '#', because the id of the root query is
+  empty.
+*/
+
+String SubQuerySerializer::serializeSubQuery( const SubQuery &subQuery )
+{
+    std::ostringstream output;
+    output << "#" << subQuery._queryId.ascii() << " " << subQuery._depth << " "
+           << subQuery._timeoutInSeconds << " ";
+
+    if ( subQuery._split )
+        serializeCaseSplit( *subQuery._split, output );
+    else
+        serializeCaseSplit( PiecewiseLinearCaseSplit(), output );
+
+    if ( subQuery._smtState )
+    {
+        output << "1 ";
+        serializeSmtState( *subQuery._smtState, output );
+    }
+    else
+        output << "0";
+
+    return String( output.str() ).trim();
+}
+
+SubQuery *SubQuerySerializer::deserializeSubQuery( const String &serialized )
+{
+    std::istringstream input( serialized.ascii() );
+
+    String queryId = readToken( input );
+    if ( queryId.length() == 0 || queryId[0] != '#' )
+        throw MarabouError( MarabouError::INVALID_SERIALIZED_SUBQUERY,
+                            "Missing query id in serialized subquery" );
+
+    std::unique_ptr<SubQuery> subQuery( new SubQuery );
+    subQuery->_queryId = queryId.substring( 1, queryId.length() - 1 );
+    subQuery->_depth = readUnsigned( input );
+    subQuery->_timeoutInSeconds = readUnsigned( input );
+
+    subQuery->_split = std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
+    deserializeCaseSplit( input, *subQuery->_split );
+
+    if ( readUnsigned( input ) != 0 )
+    {
+        subQuery->_smtState = std::unique_ptr<SmtState>( new SmtState );
+        deserializeSmtState( input, *subQuery->_smtState );
+    }
+
+    if ( readToken( input ) != "" )
+        throw MarabouError( MarabouError::INVALID_SERIALIZED_SUBQUERY,
+                            "Trailing data in serialized subquery" );
+
+    return subQuery.release();
+}
+
+void SubQuerySerializer::serializeCaseSplit( const PiecewiseLinearCaseSplit &split,
+                                             std::ostringstream &output )
+{
+    const List<Tightening> &bounds = split.getBoundTightenings();
+    output << bounds.size() << " ";
+    for ( const auto &bound : bounds )
+    {
+        output << bound._variable << ( bound._type == Tightening::LB ? " L " : " U " );
+        serializeDouble( bound._value, output );
+    }
+
+    const List<Equation> &equations = split.getEquations();
+    output << equations.size() << " ";
+    for ( const auto &equation : equations )
+    {
+        output << (unsigned)equation._type << " ";
+        serializeDouble( equation._scalar, output );
+        output << equation._addends.size() << " ";
+        for ( const auto &addend : equation._addends )
+        {
+            serializeDouble( addend._coefficient, output );
+            output << addend._variable << " ";
+        }
+    }
+}
+
+void SubQuerySerializer::serializeSmtState( const SmtState &smtState, std::ostringstream &output )
+{
+    output << smtState._stateId << " ";
+    serializeCaseSplits( smtState._impliedValidSplitsAtRoot, output );
+
+    output << smtState._stack.size() << " ";
+    for ( const auto &stackEntry : smtState._stack )
+    {
+        serializeCaseSplit( stackEntry->_activeSplit, output );
+        serializeCaseSplits( stackEntry->_impliedValidSplits, output );
+        serializeCaseSplits( stackEntry->_alternativeSplits, output );
+    }
+}
+
+void SubQuerySerializer::deserializeCaseSplit( std::istringstream &input,
+                                               PiecewiseLinearCaseSplit &split )
+{
+    unsigned numBounds = readUnsigned( input );
+    for ( unsigned i = 0; i < numBounds; ++i )
+    {
+        unsigned variable = readUnsigned( input );
+        String type = readToken( input );
+        if ( type != "L" && type != "U" )
+            throw MarabouError( MarabouError::INVALID_SERIALIZED_SUBQUERY,
+                                Stringf( "Invalid bound type: %s", type.ascii() ).ascii() );
+        double value = readDouble( input );
+        split.storeBoundTightening(
+            Tightening( variable, value, type == "L" ? Tightening::LB : Tightening::UB ) );
+    }
+
+    unsigned numEquations = readUnsigned( input );
+    for ( unsigned i = 0; i < numEquations; ++i )
+    {
+        unsigned type = readUnsigned( input );
+        if ( type > Equation::LE )
+            throw MarabouError( MarabouError::INVALID_SERIALIZED_SUBQUERY,
+                                Stringf( "Invalid equation type: %u", type ).ascii() );
+
+        Equation equation( (Equation::EquationType)type );
+        equation.setScalar( readDouble( input ) );
+        unsigned numAddends = readUnsigned( input );
+        for ( unsigned j = 0; j < numAddends; ++j )
+        {
+            double coefficient = readDouble( input );
+            equation.addAddend( coefficient, readUnsigned( input ) );
+        }
+        split.addEquation( equation );
+    }
+}
+
+void SubQuerySerializer::deserializeSmtState( std::istringstream &input, SmtState &smtState )
+{
+    smtState._stateId = readUnsigned( input );
+    deserializeCaseSplits( input, smtState._impliedValidSplitsAtRoot );
+
+    unsigned numStackEntries = readUnsigned( input );
+    for ( unsigned i = 0; i < numStackEntries; ++i )
+    {
+        SmtStackEntry *stackEntry = new SmtStackEntry;
+        stackEntry->_engineState = NULL;
+        smtState._stack.append( stackEntry );
+
+        deserializeCaseSplit( input, stackEntry->_activeSplit );
+        deserializeCaseSplits( input, stackEntry->_impliedValidSplits );
+        deserializeCaseSplits( input, stackEntry->_alternativeSplits );
+    }
+}
+
+void SubQuerySerializer::serializeDouble( double value, std::ostringstream &output )
+{
+    output << Stringf( "%a ", value ).ascii();
+}
+
+void SubQuerySerializer::serializeCaseSplits( const List<PiecewiseLinearCaseSplit> &splits,
+                                              std::ostringstream &output )
+{
+    output << splits.size() << " ";
+    for ( const auto &split : splits )
+        serializeCaseSplit( split, output );
+}
+
+String SubQuerySerializer::readToken( std::istringstream &input )
+{
+    std::string token;
+    input >> token;
+    return String( token );
+}
+
+unsigned SubQuerySerializer::readUnsigned( std::istringstream &input )
+{
+    String token = readToken( input );
+    char *end = NULL;
+    unsigned long value = strtoul( token.ascii(), &end, 10 );
+    if ( token.length() == 0 || *end != '\0' )
+        throw MarabouError( MarabouError::INVALID_SERIALIZED_SUBQUERY,
+                            Stringf( "Expected an unsigned integer, got: %s", token.ascii() )
+                                .ascii() );
+    return (unsigned)value;
+}
+
+double SubQuerySerializer::readDouble( std::istringstream &input )
+{
+    String token = readToken( input );
+    char *end = NULL;
+    double value = strtod( token.ascii(), &end );
+    if ( token.length() == 0 || *end != '\0' )
+        throw MarabouError( MarabouError::INVALID_SERIALIZED_SUBQUERY,
+                            Stringf( "Expected a floating point value, got: %s", token.ascii() )
+                                .ascii() );
+    return value;
+}
+
+void SubQuerySerializer::deserializeCaseSplits( std::istringstream &input,
+                                                List<PiecewiseLinearCaseSplit> &splits )
+{
+    unsigned numSplits = readUnsigned( input );
+    for ( unsigned i = 0; i < numSplits; ++i )
+    {
+        PiecewiseLinearCaseSplit split;
+        deserializeCaseSplit( input, split );
+        splits.append( split );
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,76 @@
+/*********************                                                        */
+/*! \file SubQuerySerializer.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Conversion of subqueries (the case split and the optional SmtState) to
+ ** and from a single line of text, so that they can be sent to other
+ ** processes or stored on disk.
+
+ **/
+
+#ifndef __SubQuerySerializer_h__
+#define __SubQuerySerializer_h__
+
+#include "MString.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "SmtState.h"
+#include "SubQuery.h"
+
+#include <sstream>
+
+class SubQuerySerializer
+{
+public:
+    /*
+      Serialize the subquery into a single line of whitespace-separated
+      tokens. Floating point values are written in hexadecimal notation,
+      so the deserialized subquery is identical to the original one.
+    */
+    static String serializeSubQuery( const SubQuery &subQuery );
+
+    /*
+      Reconstruct a subquery from its serialized form. The caller takes
+      ownership of the returned subquery. Throws a MarabouError if the
+      input is malformed.
+    */
+    static SubQuery *deserializeSubQuery( const String &serialized );
+
+    /*
+      Serialization of the individual components, also used when storing
+      solver states in other formats.
+    */
+    static void serializeCaseSplit( const PiecewiseLinearCaseSplit &split,
+                                    std::ostringstream &output );
+    static void serializeSmtState( const SmtState &smtState, std::ostringstream &output );
+
+    static void deserializeCaseSplit( std::istringstream &input, PiecewiseLinearCaseSplit &split );
+    static void deserializeSmtState( std::istringstream &input, SmtState &smtState );
+
+private:
+    static void serializeDouble( double value, std::ostringstream &output );
+    static void serializeCaseSplits( const List<PiecewiseLinearCaseSplit> &splits,
+                                     std::ostringstream &output );
+
+    static String readToken( std::istringstream &input );
+    static unsigned readUnsigned( std::istringstream &input );
+    static double readDouble( std::istringstream &input );
+    static void deserializeCaseSplits( std::istringstream &input,
+                                       List<PiecewiseLinearCaseSplit> &splits );
+};
+
+#endif // __SubQuerySerializer_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -333,6 +333,11 @@ void SumOfInfeasibilitiesManager::setStatistics( Statistics *statistics )
     _statistics = statistics;
 }
 
+void SumOfInfeasibilitiesManager::setSearchStrategy( SoISearchStrategy searchStrategy )
+{
+    _searchStrategy = searchStrategy;
+}
+
 void SumOfInfeasibilitiesManager::setPhaseStatusInLastAcceptedPhasePattern(
     PiecewiseLinearConstraint *constraint,
     PhaseStatus phase )
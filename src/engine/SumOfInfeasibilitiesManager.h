@@ -104,6 +104,8 @@ public:
 
     void setStatistics( Statistics *statistics );
 
+    void setSearchStrategy( SoISearchStrategy searchStrategy );
+
     /* For debug use */
     void setPhaseStatusInLastAcceptedPhasePattern( PiecewiseLinearConstraint *constraint,
                                                    PhaseStatus phase );
@@ -33,6 +33,8 @@ public:
         wasDiscarded = false;
 
         lastStoredState = NULL;
+        _mainLoopIterationBudget = 0;
+        _lastTimeoutInSeconds = 0;
     }
 
     ~MockEngine()
@@ -113,8 +115,10 @@ public:
 
     unsigned _timeToSolve;
     IEngine::ExitCode _exitCode;
+    double _lastTimeoutInSeconds;
     bool solve( double timeoutInSeconds )
     {
+        _lastTimeoutInSeconds = timeoutInSeconds;
         if ( timeoutInSeconds >= _timeToSolve )
             _exitCode = IEngine::TIMEOUT;
         return _exitCode == IEngine::SAT;
@@ -139,6 +143,18 @@ public:
     {
     }
 
+    List<unsigned> _randomSeeds;
+    void setRandomSeed( unsigned seed )
+    {
+        _randomSeeds.append( seed );
+    }
+
+    unsigned long long _mainLoopIterationBudget;
+    void setMainLoopIterationBudget( unsigned long long budget )
+    {
+        _mainLoopIterationBudget = budget;
+    }
+
     List<unsigned> _inputVariables;
     void setInputVariables( List<unsigned> &inputVariables )
     {
@@ -0,0 +1,152 @@
+/*********************                                                        */
+/*! \file Test_Checkpoint.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "Checkpoint.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "MockErrno.h"
+#include "SmtStackEntry.h"
+#include "SubQuerySerializer.h"
+
+#include <cstdio>
+#include <cxxtest/TestSuite.h>
+#include <fstream>
+#include <unistd.h>
+
+class CheckpointTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockErrno *mockErrno;
+    String _path;
+
+    void setUp()
+    {
+        TS_ASSERT( mockErrno = new MockErrno );
+        _path = Stringf( "/tmp/Test_Checkpoint.%u.txt", (unsigned)getpid() );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mockErrno );
+        std::remove( _path.ascii() );
+    }
+
+    void test_engine_checkpoint_round_trip()
+    {
+        Checkpoint checkpoint;
+        checkpoint._mode = Checkpoint::ENGINE;
+        checkpoint._queryFingerprint = "10-4-3-abc";
+        checkpoint._rootBounds.storeBoundTightening( Tightening( 2, 0.25, Tightening::LB ) );
+        checkpoint._rootBounds.storeBoundTightening( Tightening( 7, -1.0 / 3, Tightening::UB ) );
+
+        PiecewiseLinearCaseSplit split;
+        split.storeBoundTightening( Tightening( 5, 0, Tightening::UB ) );
+        checkpoint._smtState._stateId = 12;
+        checkpoint._smtState._impliedValidSplitsAtRoot.append( split );
+
+        SmtStackEntry *entry = new SmtStackEntry;
+        entry->_engineState = NULL;
+        entry->_activeSplit = split;
+        entry->_alternativeSplits.append( checkpoint._rootBounds );
+        checkpoint._smtState._stack.append( entry );
+
+        TS_ASSERT_THROWS_NOTHING( checkpoint.write( _path ) );
+
+        std::unique_ptr<Checkpoint> copy;
+        TS_ASSERT_THROWS_NOTHING( copy = Checkpoint::read( _path ) );
+        TS_ASSERT_EQUALS( copy->_mode, Checkpoint::ENGINE );
+        TS_ASSERT_EQUALS( copy->_queryFingerprint, "10-4-3-abc" );
+        TS_ASSERT( copy->_rootBounds == checkpoint._rootBounds );
+        TS_ASSERT_EQUALS( copy->_smtState._stateId, 12U );
+        TS_ASSERT_EQUALS( copy->_smtState._impliedValidSplitsAtRoot,
+                          checkpoint._smtState._impliedValidSplitsAtRoot );
+        TS_ASSERT_EQUALS( copy->_smtState._stack.size(), 1U );
+        TS_ASSERT( copy->_smtState._stack.front()->_activeSplit == split );
+        TS_ASSERT_EQUALS( copy->_smtState._stack.front()->_alternativeSplits,
+                          entry->_alternativeSplits );
+
+        TS_ASSERT_THROWS_NOTHING(
+            copy->checkCompatibility( Checkpoint::ENGINE, "10-4-3-abc" ) );
+        TS_ASSERT_THROWS_EQUALS( copy->checkCompatibility( Checkpoint::ENGINE, "10-4-3-abd" ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::CHECKPOINT_QUERY_MISMATCH );
+        TS_ASSERT_THROWS_EQUALS( copy->checkCompatibility( Checkpoint::DNC, "10-4-3-abc" ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::CHECKPOINT_QUERY_MISMATCH );
+    }
+
+    void test_unsolved_subqueries()
+    {
+        UnsolvedSubQueries unsolvedSubQueries;
+
+        for ( unsigned i = 1; i <= 3; ++i )
+        {
+            SubQuery subQuery;
+            subQuery._queryId = Stringf( "%u", i );
+            subQuery._depth = 1;
+            subQuery._timeoutInSeconds = 10;
+            subQuery._split =
+                std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
+            subQuery._split->storeBoundTightening( Tightening( 0, i, Tightening::LB ) );
+            unsolvedSubQueries.add( subQuery );
+        }
+
+        // Subquery 2 is proved UNSAT
+        unsolvedSubQueries.remove( "2" );
+        unsolvedSubQueries.remove( "4" );
+
+        Checkpoint checkpoint;
+        checkpoint._queryFingerprint = "fingerprint";
+        unsolvedSubQueries.store( checkpoint );
+        TS_ASSERT_EQUALS( checkpoint._mode, Checkpoint::DNC );
+        TS_ASSERT_THROWS_NOTHING( checkpoint.write( _path ) );
+
+        std::unique_ptr<Checkpoint> copy;
+        TS_ASSERT_THROWS_NOTHING( copy = Checkpoint::read( _path ) );
+        TS_ASSERT_THROWS_NOTHING( copy->checkCompatibility( Checkpoint::DNC, "fingerprint" ) );
+        TS_ASSERT_EQUALS( copy->_subQueries.size(), 2U );
+
+        List<String> queryIds;
+        for ( const auto &serialized : copy->_subQueries )
+        {
+            SubQuery *subQuery = SubQuerySerializer::deserializeSubQuery( serialized );
+            queryIds.append( subQuery->_queryId );
+            delete subQuery;
+        }
+        TS_ASSERT_EQUALS( queryIds, List<String>( { "1", "3" } ) );
+    }
+
+    void test_invalid_checkpoints()
+    {
+        TS_ASSERT_THROWS_EQUALS( Checkpoint::read( _path ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::FILE_DOES_NOT_EXIST );
+
+        std::ofstream( _path.ascii() ) << "marabou-checkpoint 1\nquery x\ndnc 2\n#1 0 0 0 0\n";
+        TS_ASSERT_THROWS_EQUALS( Checkpoint::read( _path ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_CHECKPOINT );
+
+        std::ofstream( _path.ascii() ) << "something else\n";
+        TS_ASSERT_THROWS_EQUALS( Checkpoint::read( _path ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_CHECKPOINT );
+    }
+};
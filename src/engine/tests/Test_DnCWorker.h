@@ -69,7 +69,7 @@ public:
         return counter;
     }
 
-    void createPlaceHolderSubQuery()
+    void createPlaceHolderSubQuery( String queryId = "" )
     {
         // Add a subQuery to workload.
         // This subQuery serves only as a placeholder, as the exitCode of the
@@ -91,7 +91,7 @@ public:
         split->storeBoundTightening( bound5 );
         split->storeBoundTightening( bound6 );
 
-        subQuery->_queryId = "";
+        subQuery->_queryId = queryId;
         subQuery->_split = std::move( split );
         subQuery->_timeoutInSeconds = 5;
         TS_ASSERT( _workload->push( std::move( subQuery ) ) );
@@ -292,6 +292,45 @@ public:
         TS_ASSERT( numUnsolvedSubQueries.load() == 1 );
         TS_ASSERT( shouldQuitSolving.load() );
     }
+
+    void test_deterministic_mode()
+    {
+        // In deterministic mode, each subquery is solved with a seed derived
+        // from its id and with its timeout converted into an iteration budget
+        createPlaceHolderSubQuery( "1-1" );
+        createPlaceHolderSubQuery( "1-2" );
+        createPlaceHolderSubQuery( "1-1" );
+        _engine->setExitCode( IEngine::UNSAT );
+        std::atomic_int numUnsolvedSubQueries( 3 );
+        std::atomic_bool shouldQuitSolving( false );
+        DnCWorker dncWorker( _workload,
+                             _engine,
+                             numUnsolvedSubQueries,
+                             shouldQuitSolving,
+                             0,
+                             2,
+                             1,
+                             SnCDivideStrategy::LargestInterval,
+                             0,
+                             false );
+        dncWorker.setDeterministic( 42 );
+
+        for ( unsigned i = 0; i < 3; ++i )
+            dncWorker.popOneSubQueryAndSolve();
+
+        TS_ASSERT( shouldQuitSolving.load() );
+        TS_ASSERT_EQUALS( _engine->_lastTimeoutInSeconds, 0 );
+        TS_ASSERT_EQUALS( _engine->_mainLoopIterationBudget,
+                          5ULL * GlobalConfiguration::DNC_DETERMINISTIC_ITERATIONS_PER_SECOND );
+
+        TS_ASSERT_EQUALS( _engine->_randomSeeds.size(), 3U );
+        auto seed = _engine->_randomSeeds.begin();
+        unsigned first = *seed++;
+        unsigned second = *seed++;
+        unsigned third = *seed;
+        TS_ASSERT_DIFFERS( first, second );
+        TS_ASSERT_EQUALS( first, third );
+    }
 };
 
 //
@@ -0,0 +1,122 @@
+/*********************                                                        */
+/*! \file Test_SharedRootBounds.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "PortfolioConfiguration.h"
+#include "SharedRootBounds.h"
+
+#include <cxxtest/TestSuite.h>
+#include <thread>
+
+class SharedRootBoundsTestSuite : public CxxTest::TestSuite
+{
+public:
+    bool getBound( const List<Tightening> &tightenings,
+                   unsigned variable,
+                   Tightening::BoundType type,
+                   double &value )
+    {
+        for ( const auto &tightening : tightenings )
+        {
+            if ( tightening._variable == variable && tightening._type == type )
+            {
+                value = tightening._value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void test_only_the_tightest_bounds_are_kept()
+    {
+        SharedRootBounds sharedRootBounds;
+
+        List<Tightening> first;
+        first.append( Tightening( 0, 1, Tightening::LB ) );
+        first.append( Tightening( 0, 5, Tightening::UB ) );
+        first.append( Tightening( 3, -2, Tightening::UB ) );
+        sharedRootBounds.publish( first );
+
+        List<Tightening> second;
+        second.append( Tightening( 0, 0.5, Tightening::LB ) );
+        second.append( Tightening( 0, 4, Tightening::UB ) );
+        second.append( Tightening( 3, -1, Tightening::UB ) );
+        second.append( Tightening( 7, 2, Tightening::LB ) );
+        sharedRootBounds.publish( second );
+
+        List<Tightening> tightenings;
+        sharedRootBounds.getTightenings( tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 4U );
+
+        double value = 0;
+        TS_ASSERT( getBound( tightenings, 0, Tightening::LB, value ) );
+        TS_ASSERT_EQUALS( value, 1 );
+        TS_ASSERT( getBound( tightenings, 0, Tightening::UB, value ) );
+        TS_ASSERT_EQUALS( value, 4 );
+        TS_ASSERT( getBound( tightenings, 3, Tightening::UB, value ) );
+        TS_ASSERT_EQUALS( value, -2 );
+        TS_ASSERT( getBound( tightenings, 7, Tightening::LB, value ) );
+        TS_ASSERT_EQUALS( value, 2 );
+        TS_ASSERT( !getBound( tightenings, 3, Tightening::LB, value ) );
+    }
+
+    void test_concurrent_publishing()
+    {
+        SharedRootBounds sharedRootBounds;
+
+        std::list<std::thread> threads;
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            threads.push_back( std::thread( [&sharedRootBounds, i]() {
+                for ( unsigned j = 0; j < 100; ++j )
+                {
+                    List<Tightening> tightenings;
+                    tightenings.append( Tightening( j, i, Tightening::LB ) );
+                    tightenings.append( Tightening( j, 10.0 - i, Tightening::UB ) );
+                    sharedRootBounds.publish( tightenings );
+                }
+            } ) );
+        }
+        for ( auto &thread : threads )
+            thread.join();
+
+        List<Tightening> tightenings;
+        sharedRootBounds.getTightenings( tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 200U );
+        for ( const auto &tightening : tightenings )
+            TS_ASSERT_EQUALS( tightening._value, tightening._type == Tightening::LB ? 3 : 7 );
+    }
+
+    void test_portfolio_configurations()
+    {
+        // The first member uses the command line options
+        PortfolioConfiguration first = PortfolioConfiguration::getConfiguration( 0 );
+        TS_ASSERT_EQUALS( first.toString(), PortfolioConfiguration().toString() );
+
+        // The other members cycle through distinct configurations
+        for ( unsigned i = 2; i < 6; ++i )
+            TS_ASSERT_DIFFERS( PortfolioConfiguration::getConfiguration( i ).toString(),
+                               PortfolioConfiguration::getConfiguration( i - 1 ).toString() );
+        TS_ASSERT_EQUALS( PortfolioConfiguration::getConfiguration( 6 ).toString(),
+                          PortfolioConfiguration::getConfiguration( 1 ).toString() );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,143 @@
+/*********************                                                        */
+/*! \file Test_SubQuerySerializer.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "FloatUtils.h"
+#include "MarabouError.h"
+#include "MockErrno.h"
+#include "SmtStackEntry.h"
+#include "SubQuerySerializer.h"
+
+#include <cxxtest/TestSuite.h>
+
+class SubQuerySerializerTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockErrno *mockErrno;
+
+    void setUp()
+    {
+        TS_ASSERT( mockErrno = new MockErrno );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mockErrno );
+    }
+
+    PiecewiseLinearCaseSplit makeSplit( unsigned variable, double value )
+    {
+        PiecewiseLinearCaseSplit split;
+        split.storeBoundTightening( Tightening( variable, value, Tightening::LB ) );
+        split.storeBoundTightening( Tightening( variable + 1, value / 3, Tightening::UB ) );
+
+        Equation equation( Equation::GE );
+        equation.addAddend( 0.1, variable );
+        equation.addAddend( -1.0 / 7, variable + 2 );
+        equation.setScalar( value );
+        split.addEquation( equation );
+        return split;
+    }
+
+    void test_round_trip_without_smt_state()
+    {
+        SubQuery subQuery;
+        subQuery._queryId = "3-1-2";
+        subQuery._depth = 2;
+        subQuery._timeoutInSeconds = 17;
+        subQuery._split = std::unique_ptr<PiecewiseLinearCaseSplit>(
+            new PiecewiseLinearCaseSplit( makeSplit( 5, 0.3 ) ) );
+        subQuery._split->storeBoundTightening(
+            Tightening( 9, FloatUtils::negativeInfinity(), Tightening::LB ) );
+
+        String serialized = SubQuerySerializer::serializeSubQuery( subQuery );
+        TS_ASSERT( !serialized.contains( "\n" ) );
+
+        SubQuery *copy = NULL;
+        TS_ASSERT_THROWS_NOTHING( copy = SubQuerySerializer::deserializeSubQuery( serialized ) );
+
+        TS_ASSERT_EQUALS( copy->_queryId, "3-1-2" );
+        TS_ASSERT_EQUALS( copy->_depth, 2U );
+        TS_ASSERT_EQUALS( copy->_timeoutInSeconds, 17U );
+        TS_ASSERT( *copy->_split == *subQuery._split );
+        TS_ASSERT( !copy->_smtState );
+
+        // Values are restored exactly
+        TS_ASSERT_EQUALS( copy->_split->getBoundTightenings().front()._value, 0.3 );
+        TS_ASSERT_EQUALS( copy->_split->getEquations().front()._addends.back()._coefficient,
+                          -1.0 / 7 );
+
+        delete copy;
+    }
+
+    void test_round_trip_of_root_query_with_smt_state()
+    {
+        SubQuery subQuery;
+        subQuery._queryId = "";
+        subQuery._depth = 0;
+        subQuery._timeoutInSeconds = 0;
+        subQuery._split = std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
+
+        subQuery._smtState = std::unique_ptr<SmtState>( new SmtState );
+        subQuery._smtState->_stateId = 4;
+        subQuery._smtState->_impliedValidSplitsAtRoot.append( makeSplit( 1, -2.5 ) );
+
+        SmtStackEntry *entry = new SmtStackEntry;
+        entry->_engineState = NULL;
+        entry->_activeSplit = makeSplit( 2, 1 );
+        entry->_alternativeSplits.append( makeSplit( 3, 1e-9 ) );
+        entry->_alternativeSplits.append( makeSplit( 4, 1e9 ) );
+        subQuery._smtState->_stack.append( entry );
+
+        SubQuery *copy = NULL;
+        TS_ASSERT_THROWS_NOTHING( copy = SubQuerySerializer::deserializeSubQuery(
+                                      SubQuerySerializer::serializeSubQuery( subQuery ) ) );
+
+        TS_ASSERT_EQUALS( copy->_queryId, "" );
+        TS_ASSERT( copy->_split->getBoundTightenings().empty() );
+        TS_ASSERT( copy->_split->getEquations().empty() );
+
+        TS_ASSERT( copy->_smtState );
+        TS_ASSERT_EQUALS( copy->_smtState->_stateId, 4U );
+        TS_ASSERT_EQUALS( copy->_smtState->_impliedValidSplitsAtRoot,
+                          subQuery._smtState->_impliedValidSplitsAtRoot );
+        TS_ASSERT_EQUALS( copy->_smtState->_stack.size(), 1U );
+
+        SmtStackEntry *copiedEntry = copy->_smtState->_stack.front();
+        TS_ASSERT( copiedEntry->_activeSplit == entry->_activeSplit );
+        TS_ASSERT( copiedEntry->_impliedValidSplits.empty() );
+        TS_ASSERT_EQUALS( copiedEntry->_alternativeSplits, entry->_alternativeSplits );
+        TS_ASSERT( !copiedEntry->_engineState );
+
+        delete entry;
+        delete copiedEntry;
+        delete copy;
+    }
+
+    void test_malformed_input()
+    {
+        TS_ASSERT_THROWS_EQUALS( SubQuerySerializer::deserializeSubQuery( "" ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_SERIALIZED_SUBQUERY );
+        TS_ASSERT_THROWS_EQUALS( SubQuerySerializer::deserializeSubQuery( "#1 0 5 1 0 X 0x1p+0" ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_SERIALIZED_SUBQUERY );
+        TS_ASSERT_THROWS_EQUALS( SubQuerySerializer::deserializeSubQuery( "#1 0 5 0 0 0 extra" ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_SERIALIZED_SUBQUERY );
+    }
+};
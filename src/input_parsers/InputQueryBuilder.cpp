@@ -123,6 +123,11 @@ void InputQueryBuilder::addAbsConstraint( Variable inputVar, Variable outputVar
     _absList.append( new AbsoluteValueConstraint( inputVar, outputVar ) );
 }
 
+void InputQueryBuilder::addConvolution( const InputQuery::ConvolutionRecord &convolution )
+{
+    _convolutionList.append( convolution );
+}
+
 void InputQueryBuilder::generateQuery( InputQuery &query )
 {
     query.setNumberOfVariables( _numVars );
@@ -146,6 +151,11 @@ void InputQueryBuilder::generateQuery( InputQuery &query )
         query.addEquation( equation );
     }
 
+    for ( const InputQuery::ConvolutionRecord &convolution : _convolutionList )
+    {
+        query.addConvolution( convolution );
+    }
+
     for ( ReluConstraint *constraintPtr : _reluList )
     {
         DEBUG( {
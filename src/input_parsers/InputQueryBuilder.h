@@ -53,6 +53,7 @@ private:
     List<SignConstraint *> _signList;
     Map<Variable, float> _lowerBounds;
     Map<Variable, float> _upperBounds;
+    List<InputQuery::ConvolutionRecord> _convolutionList;
 
 public:
     InputQueryBuilder();
@@ -71,6 +72,7 @@ public:
     void addSignConstraint( Variable var1, Variable var2 );
     void addMaxConstraint( Variable maxVar, Set<Variable> elements );
     void addAbsConstraint( Variable var1, Variable var2 );
+    void addConvolution( const InputQuery::ConvolutionRecord &convolution );
 
     void generateQuery( InputQuery &query );
 
@@ -32,6 +32,7 @@
 #include "TensorUtils.h"
 #include "onnx.proto3.pb.h"
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <math.h>
@@ -66,7 +67,7 @@ void OnnxParser::parse( InputQueryBuilder &query,
  * Utilities *
  *************/
 
-void illTypedAttributeError( onnx::NodeProto &node,
+void illTypedAttributeError( const onnx::NodeProto &node,
                              const onnx::AttributeProto &attr,
                              onnx::AttributeProto_AttributeType expectedType )
 {
@@ -79,7 +80,7 @@ void illTypedAttributeError( onnx::NodeProto &node,
     throw MarabouError( MarabouError::ONNX_PARSER_ERROR, errorMessage.ascii() );
 }
 
-void missingAttributeError( onnx::NodeProto &node, String attributeName )
+void missingAttributeError( const onnx::NodeProto &node, String attributeName )
 {
     String errorMessage = Stringf( "Onnx node of type %s is missing the expected attribute %s",
                                    node.op_type().c_str(),
@@ -87,7 +88,7 @@ void missingAttributeError( onnx::NodeProto &node, String attributeName )
     throw MarabouError( MarabouError::ONNX_PARSER_ERROR, errorMessage.ascii() );
 }
 
-void unimplementedOperationError( onnx::NodeProto &node )
+void unimplementedOperationError( const onnx::NodeProto &node )
 {
     String errorMessage = Stringf( "Onnx '%s' operation not yet implemented for command line "
                                    "support. Should be relatively easy to add.",
@@ -95,7 +96,7 @@ void unimplementedOperationError( onnx::NodeProto &node )
     throw MarabouError( MarabouError::ONNX_PARSER_ERROR, errorMessage.ascii() );
 }
 
-void unimplementedAttributeError( onnx::NodeProto &node, String attributeName )
+void unimplementedAttributeError( const onnx::NodeProto &node, String attributeName )
 {
     String errorMessage =
         Stringf( "Onnx '%s' operation with non-default value for attribute '%s' not yet supported.",
@@ -111,7 +112,7 @@ void unimplementedConstantTypeError( onnx::TensorProto_DataType type )
     throw MarabouError( MarabouError::ONNX_PARSER_ERROR, errorMessage.ascii() );
 }
 
-void unsupportedError( onnx::NodeProto &node )
+void unsupportedError( const onnx::NodeProto &node )
 {
     String errorMessage =
         Stringf( "Onnx operation %s not currently supported by Marabou", node.op_type().c_str() );
@@ -141,7 +142,7 @@ void missingNodeError( String &missingNodeName )
     throw MarabouError( MarabouError::ONNX_PARSER_ERROR, errorMessage.ascii() );
 }
 
-void unexpectedNumberOfInputs( onnx::NodeProto &node,
+void unexpectedNumberOfInputs( const onnx::NodeProto &node,
                                unsigned int actualNumberOfInputs,
                                unsigned int lowerBound,
                                unsigned int upperBound )
@@ -190,7 +191,7 @@ void checkTensorDataType( const onnx::TensorProto &tensor, int32_t expectedDataT
     }
 }
 
-TensorShape shapeOfInput( onnx::ValueInfoProto &input )
+TensorShape shapeOfInput( const onnx::ValueInfoProto &input )
 {
     TensorShape result;
     for ( auto dim : input.type().tensor_type().shape().dim() )
@@ -293,7 +294,9 @@ void checkEndianness()
 }
 
 const onnx::AttributeProto *
-findAttribute( onnx::NodeProto &node, String name, onnx::AttributeProto_AttributeType expectedType )
+findAttribute( const onnx::NodeProto &node,
+               String name,
+               onnx::AttributeProto_AttributeType expectedType )
 {
     for ( const onnx::AttributeProto &attr : node.attribute() )
     {
@@ -309,7 +312,7 @@ findAttribute( onnx::NodeProto &node, String name, onnx::AttributeProto_Attribut
     return nullptr;
 }
 
-float getFloatAttribute( onnx::NodeProto &node, String name, float defaultValue )
+float getFloatAttribute( const onnx::NodeProto &node, String name, float defaultValue )
 {
     const onnx::AttributeProto *attr =
         findAttribute( node, name, onnx::AttributeProto_AttributeType_FLOAT );
@@ -320,7 +323,7 @@ float getFloatAttribute( onnx::NodeProto &node, String name, float defaultValue
     return attr->f();
 }
 
-String getStringAttribute( onnx::NodeProto &node, String name, String defaultValue )
+String getStringAttribute( const onnx::NodeProto &node, String name, String defaultValue )
 {
     const onnx::AttributeProto *attr =
         findAttribute( node, name, onnx::AttributeProto_AttributeType_STRING );
@@ -331,7 +334,7 @@ String getStringAttribute( onnx::NodeProto &node, String name, String defaultVal
     return attr->s();
 }
 
-int getIntAttribute( onnx::NodeProto &node, String name, int defaultValue )
+int getIntAttribute( const onnx::NodeProto &node, String name, int defaultValue )
 {
     const onnx::AttributeProto *attr =
         findAttribute( node, name, onnx::AttributeProto_AttributeType_INT );
@@ -342,7 +345,7 @@ int getIntAttribute( onnx::NodeProto &node, String name, int defaultValue )
     return attr->i();
 }
 
-int getRequiredIntAttribute( onnx::NodeProto &node, String name )
+int getRequiredIntAttribute( const onnx::NodeProto &node, String name )
 {
     const onnx::AttributeProto *attr =
         findAttribute( node, name, onnx::AttributeProto_AttributeType_INT );
@@ -353,7 +356,7 @@ int getRequiredIntAttribute( onnx::NodeProto &node, String name )
     return attr->i();
 }
 
-const onnx::TensorProto &getTensorAttribute( onnx::NodeProto &node, String name )
+const onnx::TensorProto &getTensorAttribute( const onnx::NodeProto &node, String name )
 {
     const onnx::AttributeProto *attr =
         findAttribute( node, name, onnx::AttributeProto_AttributeType_TENSOR );
@@ -364,7 +367,7 @@ const onnx::TensorProto &getTensorAttribute( onnx::NodeProto &node, String name
     return attr->t();
 }
 
-Vector<int> getIntsAttribute( onnx::NodeProto &node, String name, Vector<int> &defaultValue )
+Vector<int> getIntsAttribute( const onnx::NodeProto &node, String name, Vector<int> &defaultValue )
 {
     const onnx::AttributeProto *attr =
         findAttribute( node, name, onnx::AttributeProto_AttributeType_INTS );
@@ -382,7 +385,7 @@ Vector<int> getIntsAttribute( onnx::NodeProto &node, String name, Vector<int> &d
 }
 
 Vector<unsigned int>
-getNonNegativeIntsAttribute( onnx::NodeProto &node, String name, Vector<uint> &defaultValue )
+getNonNegativeIntsAttribute( const onnx::NodeProto &node, String name, Vector<uint> &defaultValue )
 {
     const onnx::AttributeProto *attr =
         findAttribute( node, name, onnx::AttributeProto_AttributeType_INTS );
@@ -410,26 +413,49 @@ getNonNegativeIntsAttribute( onnx::NodeProto &node, String name, Vector<uint> &d
 }
 
 
+/**
+ * @brief Returns the raw bytes of the tensor, checking that they hold the
+ * given number of elements, or NULL if the values are stored in the typed
+ * fields instead. The bytes are read in place from the protobuf message.
+ */
+const char *getTensorRawData( const onnx::TensorProto &tensor, int size, size_t elementSize )
+{
+    const std::string &rawData = tensor.raw_data();
+    if ( rawData.empty() )
+        return NULL;
+
+    checkEndianness();
+    if ( rawData.size() < size * elementSize )
+    {
+        String errorMessage = Stringf( "Tensor '%s' has %zu bytes of data but %d elements",
+                                       tensor.name().c_str(),
+                                       rawData.size(),
+                                       size );
+        throw MarabouError( MarabouError::ONNX_PARSER_ERROR, errorMessage.ascii() );
+    }
+    return rawData.data();
+}
+
 Vector<double> getTensorFloatValues( const onnx::TensorProto &tensor, const TensorShape shape )
 {
     int size = tensorSize( shape );
-    std::string raw_data = tensor.raw_data();
-    Vector<double> result;
-    if ( raw_data.size() != 0 )
+    Vector<double> result( size );
+    const char *bytes = getTensorRawData( tensor, size, sizeof( float ) );
+    if ( bytes )
     {
-        checkEndianness();
-        const char *bytes = raw_data.c_str();
-        const float *floats = reinterpret_cast<const float *>( bytes );
+        // The bytes of the protobuf message need not be aligned
         for ( int i = 0; i < size; i++ )
         {
-            result.append( *( floats + i ) );
+            float value;
+            memcpy( &value, bytes + i * sizeof( float ), sizeof( float ) );
+            result[i] = value;
         }
     }
     else
     {
         for ( int i = 0; i < size; i++ )
         {
-            result.append( tensor.float_data( i ) );
+            result[i] = tensor.float_data( i );
         }
     }
     return result;
@@ -438,25 +464,18 @@ Vector<double> getTensorFloatValues( const onnx::TensorProto &tensor, const Tens
 Vector<int64_t> getTensorIntValues( const onnx::TensorProto &tensor, const TensorShape shape )
 {
     int size = tensorSize( shape );
-    std::string raw_data = tensor.raw_data();
-    Vector<int64_t> result;
-    if ( raw_data.size() != 0 )
+    Vector<int64_t> result( size );
+    const char *bytes = getTensorRawData( tensor, size, sizeof( int64_t ) );
+    if ( bytes )
     {
-        checkEndianness();
-        const char *bytes = raw_data.c_str();
-        const int64_t *ints = reinterpret_cast<const int64_t *>( bytes );
-        for ( int i = 0; i < size; i++ )
-        {
-            int64_t value = *( ints + i );
-            result.append( value );
-        }
+        memcpy( result.data(), bytes, size * sizeof( int64_t ) );
     }
     else
     {
         for ( int i = 0; i < size; i++ )
         {
             int value = tensor.int64_data( i );
-            result.append( value );
+            result[i] = value;
         }
     }
     return result;
@@ -465,25 +484,17 @@ Vector<int64_t> getTensorIntValues( const onnx::TensorProto &tensor, const Tenso
 Vector<int32_t> getTensorInt32Values( const onnx::TensorProto &tensor, const TensorShape shape )
 {
     int size = tensorSize( shape );
-    std::string raw_data = tensor.raw_data();
-    Vector<int32_t> result;
-    if ( raw_data.size() != 0 )
+    Vector<int32_t> result( size );
+    const char *bytes = getTensorRawData( tensor, size, sizeof( int32_t ) );
+    if ( bytes )
     {
-        checkEndianness();
-        const char *bytes = raw_data.c_str();
-        const int32_t *int32 = reinterpret_cast<const int32_t *>( bytes );
-        for ( int i = 0; i < size; i++ )
-        {
-            int32_t value = *( int32 + i );
-            result.append( value );
-        }
+        memcpy( result.data(), bytes, size * sizeof( int32_t ) );
     }
     else
     {
         for ( int i = 0; i < size; i++ )
         {
-            int32_t value = tensor.int32_data( i );
-            result.append( value );
+            result[i] = tensor.int32_data( i );
         }
     }
     return result;
@@ -570,12 +581,13 @@ OnnxParser::OnnxParser( InputQueryBuilder &query,
     Vector<char> buffer( size );
     input.read( buffer.data(), size );
 
-    // parse protobuf
+    // parse protobuf, and take the graph without copying it
     onnx::ModelProto model;
     model.ParseFromArray( buffer.data(), size );
-    _network = model.graph();
+    _network.Swap( model.mutable_graph() );
 
     _numberOfFoundInputs = 0;
+    indexGraph();
 
 
     if ( inputNames.empty() )
@@ -637,39 +649,56 @@ void OnnxParser::validateUserTerminalNames( const Set<String> &terminalNames )
 {
     for ( String terminalName : terminalNames )
     {
-        for ( auto node : _network.node() )
+        if ( !_outputNameToNode.exists( terminalName.ascii() ) )
         {
-            for ( String outputNodeName : node.output() )
-            {
-                if ( terminalName == outputNodeName )
-                    return;
-            }
+            String errorMessage = Stringf( "Output %s not found in graph!", terminalName.ascii() );
+            throw MarabouError( MarabouError::ONNX_PARSER_ERROR, errorMessage.ascii() );
         }
-
-        String errorMessage = Stringf( "Output %s not found in graph!", terminalName.ascii() );
-        throw MarabouError( MarabouError::ONNX_PARSER_ERROR, errorMessage.ascii() );
     }
 }
 
-const Set<String> OnnxParser::readInputNames()
+/**
+ * @brief Indexes the nodes of the graph by their outputs and the
+ * initializers by their names, so that looking them up does not require a
+ * scan of the graph.
+ */
+void OnnxParser::indexGraph()
 {
-    ASSERT( _network.input().size() >= 1 );
+    for ( const onnx::NodeProto &node : _network.node() )
+    {
+        for ( const std::string &outputName : node.output() )
+        {
+            if ( !_outputNameToNode.exists( outputName ) )
+                _outputNameToNode[outputName] = &node;
+        }
+    }
 
-    Set<String> initializerNames;
-    for ( auto &initNode : _network.initializer() )
+    for ( const onnx::TensorProto &initializer : _network.initializer() )
     {
-        ONNX_LOG( Stringf( "Found initialiser '%s'", initNode.name().c_str() ).ascii() );
-        initializerNames.insert( initNode.name() );
+        ONNX_LOG( Stringf( "Found initialiser '%s'", initializer.name().c_str() ).ascii() );
+        if ( _initializers.exists( initializer.name() ) )
+        {
+            String errorMessage = Stringf( "Initializers in Onnx network must have a unique name "
+                                           "but found duplicate name '%s'",
+                                           initializer.name().c_str() );
+            throw MarabouError( MarabouError::ONNX_PARSER_ERROR, errorMessage.ascii() );
+        }
+        _initializers[initializer.name()] = &initializer;
     }
+}
+
+const Set<String> OnnxParser::readInputNames()
+{
+    ASSERT( _network.input().size() >= 1 );
 
     Set<String> inputNames;
-    for ( auto &inputNode : _network.input() )
+    for ( const auto &inputNode : _network.input() )
     {
         ONNX_LOG( Stringf( "Found input '%s'", inputNode.name().c_str() ).ascii() );
-        inputNames.insert( inputNode.name() );
+        if ( !_initializers.exists( inputNode.name() ) )
+            inputNames.insert( inputNode.name() );
     }
-
-    return Set<String>::difference( inputNames, initializerNames );
+    return inputNames;
 }
 
 const Set<String> OnnxParser::readOutputNames()
@@ -686,7 +715,7 @@ const Set<String> OnnxParser::readOutputNames()
 void OnnxParser::initializeShapeAndConstantMaps()
 {
     // Add shapes for inputs
-    for ( auto input : _network.input() )
+    for ( const auto &input : _network.input() )
     {
         String inputName = input.name();
         _shapeMap.insert( inputName, shapeOfInput( input ) );
@@ -700,24 +729,14 @@ void OnnxParser::initializeShapeAndConstantMaps()
         }
     }
 
-    // Initialise constants
+    // Initialise constants. Their names are unique, as checked by indexGraph
     for ( const onnx::TensorProto &constant : _network.initializer() )
     {
         String constantName = constant.name();
-        if ( isConstantNode( constantName ) )
-        {
-            String errorMessage = Stringf( "Initializers in Onnx network must have a unique name "
-                                           "but found duplicate name '%s'",
-                                           constantName.ascii() );
-            throw MarabouError( MarabouError::ONNX_PARSER_ERROR, errorMessage.ascii() );
-        }
-        else
-        {
-            TensorShape constantShape = shapeOfConstant( constant );
-            _shapeMap.insert( constantName, constantShape );
-            _processedNodes.insert( constantName );
-            insertConstant( constantName, constant, constantShape );
-        }
+        TensorShape constantShape = shapeOfConstant( constant );
+        _shapeMap.insert( constantName, constantShape );
+        _processedNodes.insert( constantName );
+        insertConstant( constantName, constant, constantShape );
     }
 }
 
@@ -790,9 +809,9 @@ void OnnxParser::processNode( String &nodeName, bool makeEquations )
 
     _processedNodes.insert( nodeName );
 
-    List<onnx::NodeProto> nodes = getNodesWithOutput( nodeName );
-    ASSERT( nodes.size() == 1 );
-    onnx::NodeProto &node = nodes.front();
+    if ( !_outputNameToNode.exists( nodeName.ascii() ) )
+        missingNodeError( nodeName );
+    const onnx::NodeProto &node = *_outputNameToNode[nodeName.ascii()];
 
     // First recursively process the input nodes.
     // This ensures that shapes and values of a node's inputs have been computed first.
@@ -834,29 +853,12 @@ Vector<Variable> OnnxParser::makeNodeVariables( String &nodeName, bool isInput )
     return variables;
 }
 
-List<onnx::NodeProto> OnnxParser::getNodesWithOutput( String &nodeName )
-{
-    List<onnx::NodeProto> nodes;
-    for ( auto node : _network.node() )
-    {
-        for ( auto outputName : node.output() )
-        {
-            if ( outputName == nodeName.ascii() )
-            {
-                nodes.append( node );
-                break;
-            }
-        }
-    }
-    return nodes;
-}
-
-Set<String> OnnxParser::getInputsToNode( onnx::NodeProto &node )
+Set<String> OnnxParser::getInputsToNode( const onnx::NodeProto &node )
 {
     Set<String> inputNames;
     for ( String inputNodeName : node.input() )
     {
-        if ( getNodesWithOutput( inputNodeName ).size() >= 1 )
+        if ( _outputNameToNode.exists( inputNodeName.ascii() ) )
         {
             inputNames.insert( inputNodeName );
         }
@@ -871,7 +873,7 @@ Set<String> OnnxParser::getInputsToNode( onnx::NodeProto &node )
  * @param node Name of node for which we want to compute the output shape
  * @param makeEquations Create Marabou equations for this node if True
  */
-void OnnxParser::makeMarabouEquations( onnx::NodeProto &node, bool makeEquations )
+void OnnxParser::makeMarabouEquations( const onnx::NodeProto &node, bool makeEquations )
 {
     auto nodeType = node.op_type().c_str();
     ONNX_LOG(
@@ -969,7 +971,7 @@ void OnnxParser::makeMarabouEquations( onnx::NodeProto &node, bool makeEquations
  *
  * @param node The ONNX node
  */
-void OnnxParser::constant( onnx::NodeProto &node )
+void OnnxParser::constant( const onnx::NodeProto &node )
 {
     String outputNodeName = node.output()[0];
     const onnx::TensorProto &value = getTensorAttribute( node, "value" );
@@ -985,7 +987,7 @@ void OnnxParser::constant( onnx::NodeProto &node )
  *
  * @param node The ONNX node
  */
-void OnnxParser::identity( onnx::NodeProto &node )
+void OnnxParser::identity( const onnx::NodeProto &node )
 {
     String outputNodeName = node.output()[0];
     String inputNodeName = node.input()[0];
@@ -1000,7 +1002,7 @@ void OnnxParser::identity( onnx::NodeProto &node )
  *
  * @param node The ONNX node
  */
-void OnnxParser::dropout( onnx::NodeProto &node )
+void OnnxParser::dropout( const onnx::NodeProto &node )
 {
     if ( node.input().size() == 3 )
     {
@@ -1026,7 +1028,7 @@ void OnnxParser::dropout( onnx::NodeProto &node )
  *
  * @param node The ONNX node
  */
-void OnnxParser::cast( onnx::NodeProto &node )
+void OnnxParser::cast( const onnx::NodeProto &node )
 {
     String outputNodeName = node.output()[0];
     String inputNodeName = node.input()[0];
@@ -1100,7 +1102,7 @@ void OnnxParser::cast( onnx::NodeProto &node )
  *
  * @param node The ONNX node
  */
-void OnnxParser::reshape( onnx::NodeProto &node )
+void OnnxParser::reshape( const onnx::NodeProto &node )
 {
     // Assume first input is array to be reshaped, second input is the new shape array
     String inputNodeName = node.input()[0];
@@ -1125,7 +1127,7 @@ void OnnxParser::reshape( onnx::NodeProto &node )
  *
  * @param node The ONNX node
  */
-void OnnxParser::flatten( onnx::NodeProto &node )
+void OnnxParser::flatten( const onnx::NodeProto &node )
 {
     String outputNodeName = node.output()[0];
     String inputNodeName = node.input()[0];
@@ -1160,7 +1162,7 @@ void OnnxParser::flatten( onnx::NodeProto &node )
  *
  * @param node The ONNX node
  */
-void OnnxParser::transpose( onnx::NodeProto &node )
+void OnnxParser::transpose( const onnx::NodeProto &node )
 {
     String inputNodeName = node.input()[0];
     String outputNodeName = node.output()[0];
@@ -1205,7 +1207,7 @@ void OnnxParser::transpose( onnx::NodeProto &node )
  *
  * @param node The ONNX node
  */
-void OnnxParser::squeeze( onnx::NodeProto &node )
+void OnnxParser::squeeze( const onnx::NodeProto &node )
 {
     String inputNodeName = node.input()[0];
     String outputNodeName = node.output()[0];
@@ -1272,7 +1274,7 @@ void OnnxParser::squeeze( onnx::NodeProto &node )
  *
  * @param node The ONNX node
  */
-void OnnxParser::unsqueeze( onnx::NodeProto &node )
+void OnnxParser::unsqueeze( const onnx::NodeProto &node )
 {
     String inputNodeName = node.input()[0];
     String outputNodeName = node.output()[0];
@@ -1315,7 +1317,7 @@ void OnnxParser::unsqueeze( onnx::NodeProto &node )
  * Implements https://github.com/onnx/onnx/blob/master/docs/Operators.md#batchnormalization.
  * @param node The ONNX node
  */
-void OnnxParser::batchNormEquations( onnx::NodeProto &node, bool makeEquations )
+void OnnxParser::batchNormEquations( const onnx::NodeProto &node, bool makeEquations )
 {
     String outputNodeName = node.output()[0];
     String inputNodeName = node.input()[0];
@@ -1380,7 +1382,8 @@ void OnnxParser::batchNormEquations( onnx::NodeProto &node, bool makeEquations )
  * @param node ONNX node representing the MaxPool operation
  * @param makeEquations True if we need to create new variables and add new Relus
  */
-void OnnxParser::maxPoolEquations( onnx::NodeProto &node, [[maybe_unused]] bool makeEquations )
+void OnnxParser::maxPoolEquations( const onnx::NodeProto &node,
+                                   [[maybe_unused]] bool makeEquations )
 {
     String inputNodeName = node.input()[0];
     String outputNodeName = node.output()[0];
@@ -1524,7 +1527,7 @@ void OnnxParser::maxPoolEquations( onnx::NodeProto &node, [[maybe_unused]] bool
  * @param node ONNX node representing the operation
  * @param makeEquations True if we need to create new variables
  */
-void OnnxParser::convEquations( onnx::NodeProto &node, [[maybe_unused]] bool makeEquations )
+void OnnxParser::convEquations( const onnx::NodeProto &node, [[maybe_unused]] bool makeEquations )
 {
     String outputNodeName = node.output()[0];
 
@@ -1532,7 +1535,7 @@ void OnnxParser::convEquations( onnx::NodeProto &node, [[maybe_unused]] bool mak
     // First input should be variable tensor
     String inputNodeName = node.input()[0];
     TensorShape inputShape = _shapeMap[inputNodeName];
-    [[maybe_unused]] unsigned int inputChannels = inputShape[1];
+    unsigned int inputChannels = inputShape[1];
     unsigned int inputWidth = inputShape[2];
     unsigned int inputHeight = inputShape[3];
 
@@ -1696,6 +1699,29 @@ void OnnxParser::convEquations( onnx::NodeProto &node, [[maybe_unused]] bool mak
             }
         }
     }
+
+    // Record the convolution itself, so that the network level reasoner
+    // can propagate bounds through it without expanding the kernel
+    if ( inputVars.size() == inputChannels * inputWidth * inputHeight )
+    {
+        InputQuery::ConvolutionRecord convolution;
+        convolution._shape._inputChannels = inputChannels;
+        convolution._shape._inputWidth = inputWidth;
+        convolution._shape._inputHeight = inputHeight;
+        convolution._shape._outputChannels = outChannels;
+        convolution._shape._outputWidth = outWidth;
+        convolution._shape._outputHeight = outHeight;
+        convolution._shape._kernelWidth = filterWidth;
+        convolution._shape._kernelHeight = filterHeight;
+        convolution._shape._strideWidth = strideWidth;
+        convolution._shape._strideHeight = strideHeight;
+        convolution._shape._padLeft = padLeft;
+        convolution._shape._padBottom = padBottom;
+        convolution._kernel = filter;
+        convolution._inputVariables = inputVars;
+        convolution._outputVariables = outputVars;
+        _query.addConvolution( convolution );
+    }
 }
 
 /**
@@ -1706,7 +1732,7 @@ void OnnxParser::convEquations( onnx::NodeProto &node, [[maybe_unused]] bool mak
  * @param node ONNX node representing the operation
  * @param makeEquations True if we need to create new variables
  */
-void OnnxParser::gemmEquations( onnx::NodeProto &node, bool makeEquations )
+void OnnxParser::gemmEquations( const onnx::NodeProto &node, bool makeEquations )
 {
     String outputNodeName = node.output()[0];
 
@@ -1793,7 +1819,7 @@ void OnnxParser::gemmEquations( onnx::NodeProto &node, bool makeEquations )
  * @param node ONNX node representing the Relu operation
  * @param makeEquations True if we need to create new variables and add new Relus
  */
-void OnnxParser::reluEquations( onnx::NodeProto &node, bool makeEquations )
+void OnnxParser::reluEquations( const onnx::NodeProto &node, bool makeEquations )
 {
     String outputNodeName = node.output()[0];
     String inputNodeName = node.input()[0];
@@ -1823,7 +1849,7 @@ void OnnxParser::reluEquations( onnx::NodeProto &node, bool makeEquations )
  * @param node ONNX node representing the LeakyRelu operation
  * @param makeEquations True if we need to create new variables and add new LeakyRelus
  */
-void OnnxParser::leakyReluEquations( onnx::NodeProto &node, bool makeEquations )
+void OnnxParser::leakyReluEquations( const onnx::NodeProto &node, bool makeEquations )
 {
     String outputNodeName = node.output()[0];
     String inputNodeName = node.input()[0];
@@ -1855,7 +1881,7 @@ void OnnxParser::leakyReluEquations( onnx::NodeProto &node, bool makeEquations )
  * @param node ONNX node representing the Add operation
  * @param makeEquations True if we need to create new variables and write Marabou equations
  */
-void OnnxParser::scaleAndAddEquations( onnx::NodeProto &node,
+void OnnxParser::scaleAndAddEquations( const onnx::NodeProto &node,
                                        bool makeEquations,
                                        double coefficient1,
                                        double coefficient2 )
@@ -1988,7 +2014,7 @@ void OnnxParser::scaleAndAddEquations( onnx::NodeProto &node,
  * @param node ONNX node representing the MatMul operation
  * @param makeEquations True if we need to create new variables and write Marabou equations
  */
-void OnnxParser::matMulEquations( onnx::NodeProto &node, bool makeEquations )
+void OnnxParser::matMulEquations( const onnx::NodeProto &node, bool makeEquations )
 {
     String nodeName = node.output()[0];
 
@@ -2127,7 +2153,7 @@ void OnnxParser::matMulEquations( onnx::NodeProto &node, bool makeEquations )
  * @param node ONNX node representing the Sigmoid operation
  * @param makeEquations True if we need to create new variables and write Marabou equations
  */
-void OnnxParser::sigmoidEquations( onnx::NodeProto &node, bool makeEquations )
+void OnnxParser::sigmoidEquations( const onnx::NodeProto &node, bool makeEquations )
 {
     String outputNodeName = node.output()[0];
     String inputNodeName = node.input()[0];
@@ -2157,7 +2183,7 @@ void OnnxParser::sigmoidEquations( onnx::NodeProto &node, bool makeEquations )
  * @param node ONNX node representing the Tanh operation
  * @param makeEquations True if we need to create new variables and write Marabou equations
  */
-void OnnxParser::tanhEquations( onnx::NodeProto &node, bool makeEquations )
+void OnnxParser::tanhEquations( const onnx::NodeProto &node, bool makeEquations )
 {
     String outputName = node.output()[0];
     String inputName = node.input()[0];
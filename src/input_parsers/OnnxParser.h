@@ -15,6 +15,7 @@
 #ifndef __OnnxParser_h__
 #define __OnnxParser_h__
 
+#include "HashMap.h"
 #include "InputQuery.h"
 #include "InputQueryBuilder.h"
 #include "List.h"
@@ -54,6 +55,13 @@ private:
     */
     Set<String> _terminalNames;
 
+    /*
+      The nodes of the graph indexed by their outputs, and the initializers
+      indexed by their names. Both point into _network.
+    */
+    HashMap<std::string, const onnx::NodeProto *> _outputNameToNode;
+    HashMap<std::string, const onnx::TensorProto *> _initializers;
+
     // State //
 
     Map<String, TensorShape> _shapeMap;
@@ -72,14 +80,14 @@ private:
     void validateUserTerminalNames( const Set<String> &terminalNames );
 
     void readNetwork( const String &path );
+    void indexGraph();
     void initializeShapeAndConstantMaps();
     void validateAllInputsAndOutputsFound();
 
     void processGraph();
     void processNode( String &nodeName, bool makeEquations );
-    void makeMarabouEquations( onnx::NodeProto &node, bool makeEquations );
-    Set<String> getInputsToNode( onnx::NodeProto &node );
-    List<onnx::NodeProto> getNodesWithOutput( String &nodeName );
+    void makeMarabouEquations( const onnx::NodeProto &node, bool makeEquations );
+    Set<String> getInputsToNode( const onnx::NodeProto &node );
     Vector<Variable> makeNodeVariables( String &nodeName, bool isInput );
 
     bool isConstantNode( String name );
@@ -87,28 +95,28 @@ private:
     void transferValues( String oldName, String newName );
     void insertConstant( String name, const onnx::TensorProto &tensor, TensorShape shape );
 
-    void constant( onnx::NodeProto &node );
-    void identity( onnx::NodeProto &node );
-    void dropout( onnx::NodeProto &node );
-    void cast( onnx::NodeProto &node );
-    void reshape( onnx::NodeProto &node );
-    void squeeze( onnx::NodeProto &node );
-    void unsqueeze( onnx::NodeProto &node );
-    void flatten( onnx::NodeProto &node );
-    void transpose( onnx::NodeProto &node );
-    void batchNormEquations( onnx::NodeProto &node, bool makeEquations );
-    void maxPoolEquations( onnx::NodeProto &node, bool makeEquations );
-    void convEquations( onnx::NodeProto &node, bool makeEquations );
-    void gemmEquations( onnx::NodeProto &node, bool makeEquations );
-    void scaleAndAddEquations( onnx::NodeProto &node,
+    void constant( const onnx::NodeProto &node );
+    void identity( const onnx::NodeProto &node );
+    void dropout( const onnx::NodeProto &node );
+    void cast( const onnx::NodeProto &node );
+    void reshape( const onnx::NodeProto &node );
+    void squeeze( const onnx::NodeProto &node );
+    void unsqueeze( const onnx::NodeProto &node );
+    void flatten( const onnx::NodeProto &node );
+    void transpose( const onnx::NodeProto &node );
+    void batchNormEquations( const onnx::NodeProto &node, bool makeEquations );
+    void maxPoolEquations( const onnx::NodeProto &node, bool makeEquations );
+    void convEquations( const onnx::NodeProto &node, bool makeEquations );
+    void gemmEquations( const onnx::NodeProto &node, bool makeEquations );
+    void scaleAndAddEquations( const onnx::NodeProto &node,
                                bool makeEquations,
                                double coefficient1,
                                double coefficient2 );
-    void matMulEquations( onnx::NodeProto &node, bool makeEquations );
-    void reluEquations( onnx::NodeProto &node, bool makeEquations );
-    void leakyReluEquations( onnx::NodeProto &node, bool makeEquations );
-    void sigmoidEquations( onnx::NodeProto &node, bool makeEquations );
-    void tanhEquations( onnx::NodeProto &node, bool makeEquations );
+    void matMulEquations( const onnx::NodeProto &node, bool makeEquations );
+    void reluEquations( const onnx::NodeProto &node, bool makeEquations );
+    void leakyReluEquations( const onnx::NodeProto &node, bool makeEquations );
+    void sigmoidEquations( const onnx::NodeProto &node, bool makeEquations );
+    void tanhEquations( const onnx::NodeProto &node, bool makeEquations );
 };
 
 #endif // __OnnxParser_h__
@@ -18,7 +18,9 @@
 #include "DisjunctionConstraint.h"
 #include "Equation.h"
 #include "File.h"
+#include "FloatUtils.h"
 #include "InputParserError.h"
+#include "Set.h"
 
 #include <regex>
 
@@ -70,6 +72,11 @@ static String readVnnlibFile( const String &vnnlibFilePath )
     return vnnlibContent;
 }
 
+VnnLibParser::VnnLibParser()
+    : _inputDisjuncts( nullptr )
+{
+}
+
 void VnnLibParser::parse( const String &vnnlibFilePath, InputQuery &inputQuery )
 {
     String vnnlibContent = readVnnlibFile( vnnlibFilePath );
@@ -77,25 +84,95 @@ void VnnLibParser::parse( const String &vnnlibFilePath, InputQuery &inputQuery )
     parseVnnlib( vnnlibContent, inputQuery );
 }
 
-void VnnLibParser::parseVnnlib( const String &vnnlibContent, InputQuery &inputQuery )
+void VnnLibParser::parse( const String &vnnlibFilePath,
+                          InputQuery &inputQuery,
+                          List<PiecewiseLinearCaseSplit> &inputDisjuncts )
 {
-    std::regex re( R"(\(|\)|[\w\-\\.]+|<=|>=|\+|-|\*)" );
+    inputDisjuncts.clear();
+    _inputDisjuncts = &inputDisjuncts;
+
+    parse( vnnlibFilePath, inputQuery );
+    if ( !inputDisjuncts.empty() )
+        boundInputVariablesByDisjuncts( inputQuery );
 
-    auto tokens_begin = std::cregex_token_iterator(
-        vnnlibContent.ascii(), vnnlibContent.ascii() + vnnlibContent.length(), re );
-    auto tokens_end = std::cregex_token_iterator();
+    _inputDisjuncts = nullptr;
+}
+
+bool VnnLibParser::isInputDisjunction( const List<PiecewiseLinearCaseSplit> &disjuncts,
+                                       const InputQuery &inputQuery ) const
+{
+    if ( disjuncts.empty() )
+        return false;
 
-    Vector<String> all_tokens;
+    Set<unsigned> inputVariables;
+    for ( unsigned variable : inputQuery.getInputVariables() )
+        inputVariables.insert( variable );
 
-    for ( std::cregex_token_iterator it = tokens_begin; it != tokens_end; ++it )
+    for ( const auto &disjunct : disjuncts )
     {
-        auto match = *it;
-        auto match_str = String( match.str().c_str() );
+        if ( !disjunct.getEquations().empty() )
+            return false;
 
-        all_tokens.append( match_str );
+        for ( const auto &bound : disjunct.getBoundTightenings() )
+        {
+            if ( !inputVariables.exists( bound._variable ) )
+                return false;
+        }
     }
 
-    parseScript( all_tokens, inputQuery );
+    return true;
+}
+
+void VnnLibParser::boundInputVariablesByDisjuncts( InputQuery &inputQuery ) const
+{
+    List<unsigned> inputVariables = inputQuery.getInputVariables();
+
+    // The smallest box that contains every disjunct
+    Map<unsigned, double> lowerBounds;
+    Map<unsigned, double> upperBounds;
+    for ( unsigned variable : inputVariables )
+    {
+        lowerBounds[variable] = FloatUtils::infinity();
+        upperBounds[variable] = FloatUtils::negativeInfinity();
+    }
+
+    for ( const auto &disjunct : *_inputDisjuncts )
+    {
+        Map<unsigned, double> disjunctLowerBounds;
+        Map<unsigned, double> disjunctUpperBounds;
+        for ( unsigned variable : inputVariables )
+        {
+            disjunctLowerBounds[variable] = FloatUtils::negativeInfinity();
+            disjunctUpperBounds[variable] = FloatUtils::infinity();
+        }
+
+        for ( const auto &bound : disjunct.getBoundTightenings() )
+        {
+            unsigned variable = bound._variable;
+            if ( bound._type == Tightening::LB )
+                disjunctLowerBounds[variable] =
+                    FloatUtils::max( disjunctLowerBounds[variable], bound._value );
+            else
+                disjunctUpperBounds[variable] =
+                    FloatUtils::min( disjunctUpperBounds[variable], bound._value );
+        }
+
+        for ( unsigned variable : inputVariables )
+        {
+            lowerBounds[variable] =
+                FloatUtils::min( lowerBounds[variable], disjunctLowerBounds[variable] );
+            upperBounds[variable] =
+                FloatUtils::max( upperBounds[variable], disjunctUpperBounds[variable] );
+        }
+    }
+
+    for ( unsigned variable : inputVariables )
+    {
+        if ( lowerBounds[variable] > inputQuery.getLowerBound( variable ) )
+            inputQuery.setLowerBound( variable, lowerBounds[variable] );
+        if ( upperBounds[variable] < inputQuery.getUpperBound( variable ) )
+            inputQuery.setUpperBound( variable, upperBounds[variable] );
+    }
 }
 
 int VnnLibParser::parseScript( const Vector<String> &tokens, InputQuery &inputQuery )
@@ -277,7 +354,11 @@ int VnnLibParser::parseAssert( int index, const Vector<String> &tokens, InputQue
             disjunctList.append( split );
         }
 
-        inputQuery.addPiecewiseLinearConstraint( new DisjunctionConstraint( disjunctList ) );
+        if ( _inputDisjuncts && _inputDisjuncts->empty() &&
+             isInputDisjunction( disjunctList, inputQuery ) )
+            *_inputDisjuncts = disjunctList;
+        else
+            inputQuery.addPiecewiseLinearConstraint( new DisjunctionConstraint( disjunctList ) );
         ++index;
     }
     else
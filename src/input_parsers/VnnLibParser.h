@@ -17,15 +17,33 @@
 #define _VnnLibParser_h_
 
 #include "InputQuery.h"
+#include "List.h"
 #include "MString.h"
 #include "Map.h"
+#include "PiecewiseLinearCaseSplit.h"
 #include "Vector.h"
 
 class VnnLibParser
 {
 public:
+    VnnLibParser();
+
     void parse( const String &vnnlibFilePath, InputQuery &inputQuery );
 
+    /*
+      Parse the property, except that the first top-level disjunction whose
+      disjuncts only bound input variables is not added to the query as a
+      DisjunctionConstraint. Instead, its disjuncts are stored in
+      inputDisjuncts, and the input variables are bounded by the smallest
+      box that contains all of them. The property is then satisfiable if
+      and only if the query is satisfiable under one of the disjuncts, so
+      the disjuncts can be solved as independent subqueries. If there is no
+      such disjunction, inputDisjuncts is left empty.
+    */
+    void parse( const String &vnnlibFilePath,
+                InputQuery &inputQuery,
+                List<PiecewiseLinearCaseSplit> &inputDisjuncts );
+
 private:
     class Term
     {
@@ -45,6 +63,17 @@ private:
 
     Map<String, unsigned int> _varMap;
 
+    /*
+      Where to store the disjuncts of an input disjunction, or nullptr if
+      disjunctions are not expanded
+    */
+    List<PiecewiseLinearCaseSplit> *_inputDisjuncts;
+
+    bool isInputDisjunction( const List<PiecewiseLinearCaseSplit> &disjuncts,
+                             const InputQuery &inputQuery ) const;
+
+    void boundInputVariablesByDisjuncts( InputQuery &inputQuery ) const;
+
     void parseVnnlib( const String &vnnlibContent, InputQuery &inputQuery );
 
     int parseScript( const Vector<String> &tokens, InputQuery &inputQuery );
@@ -281,6 +281,45 @@ public:
         run_test( "conv", input, output );
     }
 
+    void test_conv_layer_in_nlr()
+    {
+        // The convolution should become a single convolutional layer of the
+        // network level reasoner, which evaluates it without a weight matrix
+        String networkPath = RESOURCES_DIR "/onnx/layer-zoo/conv.onnx";
+        InputQueryBuilder queryBuilder;
+        TS_ASSERT_THROWS_NOTHING( OnnxParser::parse( queryBuilder, networkPath, {}, {} ) );
+
+        InputQuery inputQuery;
+        queryBuilder.generateQuery( inputQuery );
+        TS_ASSERT_EQUALS( inputQuery.getConvolutions().size(), 1U );
+
+        List<Equation> unhandledEquations;
+        Set<unsigned> varsInUnhandledConstraints;
+        TS_ASSERT( inputQuery.constructNetworkLevelReasoner( unhandledEquations,
+                                                             varsInUnhandledConstraints ) );
+        TS_ASSERT( unhandledEquations.empty() );
+
+        NLR::NetworkLevelReasoner *nlr = inputQuery.getNetworkLevelReasoner();
+        TS_ASSERT_EQUALS( nlr->getNumberOfLayers(), 2U );
+        TS_ASSERT_EQUALS( nlr->getLayer( 1 )->getLayerType(), NLR::Layer::CONV );
+
+        double input[25];
+        for ( unsigned i = 0; i < 25; ++i )
+            input[i] = i;
+        double output[25];
+        TS_ASSERT_THROWS_NOTHING( nlr->evaluate( input, output ) );
+
+        Vector<double> expectedOutput = {
+            12.0, 21.0,  27.0,  33.0,  24.0,  //
+            33.0, 54.0,  63.0,  72.0,  51.0,  //
+            63.0, 99.0,  108.0, 117.0, 81.0,  //
+            93.0, 144.0, 153.0, 162.0, 111.0, //
+            72.0, 111.0, 117.0, 123.0, 84.0,  //
+        };
+        for ( unsigned i = 0; i < 25; ++i )
+            TS_ASSERT_DELTA( output[i], expectedOutput[i], DELTA );
+    }
+
     void test_gemm()
     {
         // 0.25 * input * [[0.5, 1.0], [1.0, 2.0]]^T  + 0.5 * [3, 4.5]
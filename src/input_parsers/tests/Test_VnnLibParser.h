@@ -13,6 +13,7 @@
  **/
 
 #include "Engine.h"
+#include "FloatUtils.h"
 #include "InputQuery.h"
 #include "OnnxParser.h"
 #include "VnnLibParser.h"
@@ -406,4 +407,54 @@ public:
         TS_ASSERT( upperBounds.exists( inputVar ) && upperBounds.get( inputVar ) == 1 )
         TS_ASSERT( lowerBounds.exists( outputVar ) && lowerBounds.get( outputVar ) == 0 )
     }
+
+    void test_expand_input_disjunction()
+    {
+        String queryPath = RESOURCES_DIR "/onnx/vnnlib/test_input_disjunction.vnnlib";
+        String onnxPath = RESOURCES_DIR "/onnx/vnnlib/test_tiny_vnncomp.onnx";
+
+        InputQueryBuilder queryBuilder;
+        TS_ASSERT_THROWS_NOTHING( OnnxParser::parse( queryBuilder, onnxPath, {}, {} ) );
+        queryBuilder.generateQuery( *inputQuery );
+        unsigned numberOfConstraints = inputQuery->getPiecewiseLinearConstraints().size();
+
+        List<PiecewiseLinearCaseSplit> inputDisjuncts;
+        TS_ASSERT_THROWS_NOTHING(
+            VnnLibParser().parse( queryPath, *inputQuery, inputDisjuncts ) );
+
+        unsigned int inputVar = inputQuery->inputVariableByIndex( 0 );
+
+        // The input disjunction is expanded...
+        TS_ASSERT_EQUALS( inputDisjuncts.size(), 2U );
+        List<Tightening> bounds = inputDisjuncts.front().getBoundTightenings();
+        TS_ASSERT_EQUALS( bounds.size(), 2U );
+        TS_ASSERT( bounds.front() == Tightening( inputVar, -1, Tightening::LB ) );
+        TS_ASSERT( bounds.back() == Tightening( inputVar, 0, Tightening::UB ) );
+        bounds = inputDisjuncts.back().getBoundTightenings();
+        TS_ASSERT( bounds.front() == Tightening( inputVar, 0.5, Tightening::LB ) );
+        TS_ASSERT( bounds.back() == Tightening( inputVar, 1, Tightening::UB ) );
+
+        // ... and the input is bounded by the box that contains the disjuncts
+        TS_ASSERT_EQUALS( inputQuery->getLowerBound( inputVar ), -1 );
+        TS_ASSERT_EQUALS( inputQuery->getUpperBound( inputVar ), 0.75 );
+
+        // The output disjunction keeps its encoding
+        TS_ASSERT_EQUALS( inputQuery->getPiecewiseLinearConstraints().size(),
+                          numberOfConstraints + 1 );
+    }
+
+    void test_input_disjunction_without_expansion()
+    {
+        parse( "test_input_disjunction.vnnlib", "test_tiny_vnncomp.onnx" );
+
+        unsigned int inputVar = inputQuery->inputVariableByIndex( 0 );
+        TS_ASSERT_EQUALS( inputQuery->getLowerBound( inputVar ), FloatUtils::negativeInfinity() );
+        TS_ASSERT_EQUALS( inputQuery->getUpperBound( inputVar ), 0.75 );
+
+        // The input disjunction precedes the output disjunction
+        auto constraint = inputQuery->getPiecewiseLinearConstraints().rbegin();
+        ++constraint;
+        auto *disjunction = (DisjunctionConstraint *)( *constraint );
+        TS_ASSERT_EQUALS( disjunction->getCaseSplits().size(), 2U );
+    }
 };
\ No newline at end of file
@@ -0,0 +1,172 @@
+/*********************                                                        */
+/*! \file Convolution.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "Convolution.h"
+
+#include "Debug.h"
+
+#include <algorithm>
+
+namespace NLR {
+
+bool Convolution::Shape::operator==( const Shape &other ) const
+{
+    return _inputChannels == other._inputChannels && _inputWidth == other._inputWidth &&
+           _inputHeight == other._inputHeight && _outputChannels == other._outputChannels &&
+           _outputWidth == other._outputWidth && _outputHeight == other._outputHeight &&
+           _kernelWidth == other._kernelWidth && _kernelHeight == other._kernelHeight &&
+           _strideWidth == other._strideWidth && _strideHeight == other._strideHeight &&
+           _padLeft == other._padLeft && _padBottom == other._padBottom;
+}
+
+Convolution::Convolution( const Shape &shape,
+                          const Vector<double> &kernel,
+                          const Vector<unsigned> &inputNeurons,
+                          unsigned sourceLayerSize )
+    : _shape( shape )
+    , _kernel( kernel )
+    , _inputNeurons( inputNeurons )
+    , _rows( sourceLayerSize )
+{
+    ASSERT( _kernel.size() == _shape._outputChannels * _shape._inputChannels *
+                                  _shape._kernelWidth * _shape._kernelHeight );
+    ASSERT( _inputNeurons.size() ==
+            _shape._inputChannels * _shape._inputWidth * _shape._inputHeight );
+
+    _sourceNeuronToPosition.assign( _rows, _inputNeurons.size() );
+    for ( unsigned position = 0; position < _inputNeurons.size(); ++position )
+    {
+        ASSERT( _inputNeurons[position] < _rows );
+        _sourceNeuronToPosition[_inputNeurons[position]] = position;
+    }
+}
+
+const Convolution::Shape &Convolution::getShape() const
+{
+    return _shape;
+}
+
+const Vector<double> &Convolution::getKernel() const
+{
+    return _kernel;
+}
+
+const Vector<unsigned> &Convolution::getInputNeurons() const
+{
+    return _inputNeurons;
+}
+
+unsigned Convolution::getNumberOfRows() const
+{
+    return _rows;
+}
+
+unsigned Convolution::getNumberOfColumns() const
+{
+    return _shape._outputChannels * _shape._outputWidth * _shape._outputHeight;
+}
+
+unsigned Convolution::getNnz() const
+{
+    unsigned nnz = 0;
+    forEachWeight( [&]( unsigned, unsigned, double ) { ++nnz; } );
+    return nnz;
+}
+
+double Convolution::get( unsigned row, unsigned column ) const
+{
+    ASSERT( row < _rows && column < getNumberOfColumns() );
+
+    unsigned position = _sourceNeuronToPosition[row];
+    if ( position == _inputNeurons.size() )
+        return 0;
+
+    unsigned c = position / ( _shape._inputWidth * _shape._inputHeight );
+    unsigned w = ( position / _shape._inputHeight ) % _shape._inputWidth;
+    unsigned h = position % _shape._inputHeight;
+
+    unsigned k = column / ( _shape._outputWidth * _shape._outputHeight );
+    unsigned i = ( column / _shape._outputHeight ) % _shape._outputWidth;
+    unsigned j = column % _shape._outputHeight;
+
+    // The offsets within the kernel, which wrap around if negative
+    unsigned di = w + _shape._padLeft - _shape._strideWidth * i;
+    unsigned dj = h + _shape._padBottom - _shape._strideHeight * j;
+    if ( di >= _shape._kernelWidth || dj >= _shape._kernelHeight )
+        return 0;
+
+    return _kernel[( ( k * _shape._inputChannels + c ) * _shape._kernelWidth + di ) *
+                       _shape._kernelHeight +
+                   dj];
+}
+
+void Convolution::toDense( double *result ) const
+{
+    unsigned columns = getNumberOfColumns();
+    std::fill_n( result, _rows * columns, 0 );
+    forEachWeight( [&]( unsigned sourceNeuron, unsigned targetNeuron, double weight ) {
+        result[sourceNeuron * columns + targetNeuron] = weight;
+    } );
+}
+
+void Convolution::multiplyFromLeft( const double *left,
+                                    double *result,
+                                    unsigned rowsOfLeft,
+                                    SparseWeightMatrix::Entries entries ) const
+{
+    unsigned columns = getNumberOfColumns();
+    for ( unsigned r = 0; r < rowsOfLeft; ++r )
+    {
+        const double *leftRow = left + r * _rows;
+        double *resultRow = result + r * columns;
+        forEachWeight( [&]( unsigned sourceNeuron, unsigned targetNeuron, double weight ) {
+            if ( ( entries == SparseWeightMatrix::POSITIVE_ENTRIES && weight < 0 ) ||
+                 ( entries == SparseWeightMatrix::NEGATIVE_ENTRIES && weight > 0 ) )
+                return;
+
+            resultRow[targetNeuron] += leftRow[sourceNeuron] * weight;
+        } );
+    }
+}
+
+void Convolution::multiplyFromRight( const double *right,
+                                     double *result,
+                                     unsigned columnsOfRight ) const
+{
+    // The transposed convolution: scatter each row of right, scaled by
+    // the kernel, into the rows of the source neurons it depends on
+    forEachWeight( [&]( unsigned sourceNeuron, unsigned targetNeuron, double weight ) {
+        const double *rightRow = right + targetNeuron * columnsOfRight;
+        double *resultRow = result + sourceNeuron * columnsOfRight;
+        for ( unsigned j = 0; j < columnsOfRight; ++j )
+            resultRow[j] += weight * rightRow[j];
+    } );
+}
+
+bool Convolution::operator==( const Convolution &other ) const
+{
+    return _shape == other._shape && _kernel == other._kernel &&
+           _inputNeurons == other._inputNeurons && _rows == other._rows;
+}
+
+} // namespace NLR
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
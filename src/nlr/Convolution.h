@@ -0,0 +1,170 @@
+/*********************                                                        */
+/*! \file Convolution.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __Convolution_h__
+#define __Convolution_h__
+
+#include "SparseWeightMatrix.h"
+#include "Vector.h"
+
+namespace NLR {
+
+/*
+  The weights between a source layer and a convolutional layer, stored
+  as the kernel of a 2D convolution instead of as a matrix. The input and
+  output tensors are laid out as in ONNX: (channel, width, height), with
+  the height varying fastest. The neurons of the convolutional layer are
+  the output tensor in this order, and the source layer neurons that make
+  up the input tensor are given by _inputNeurons.
+
+  Conceptually, this is the (source layer size x output size) weight
+  matrix of a weighted sum layer: multiplying with it from the left is a
+  convolution, and multiplying with it from the right is a transposed
+  convolution.
+*/
+class Convolution
+{
+public:
+    struct Shape
+    {
+        unsigned _inputChannels;
+        unsigned _inputWidth;
+        unsigned _inputHeight;
+        unsigned _outputChannels;
+        unsigned _outputWidth;
+        unsigned _outputHeight;
+        unsigned _kernelWidth;
+        unsigned _kernelHeight;
+        unsigned _strideWidth;
+        unsigned _strideHeight;
+
+        // The padding at the end of each dimension is implied by the
+        // output shape
+        unsigned _padLeft;
+        unsigned _padBottom;
+
+        bool operator==( const Shape &other ) const;
+    };
+
+    /*
+      The kernel is indexed (output channel, input channel, width,
+      height). inputNeurons[p] is the source layer neuron at position p of
+      the input tensor.
+    */
+    Convolution( const Shape &shape,
+                 const Vector<double> &kernel,
+                 const Vector<unsigned> &inputNeurons,
+                 unsigned sourceLayerSize );
+
+    const Shape &getShape() const;
+    const Vector<double> &getKernel() const;
+    const Vector<unsigned> &getInputNeurons() const;
+
+    unsigned getNumberOfRows() const;
+    unsigned getNumberOfColumns() const;
+    unsigned getNnz() const;
+
+    double get( unsigned row, unsigned column ) const;
+
+    /*
+      Store the weights as a dense, row-major matrix
+    */
+    void toDense( double *result ) const;
+
+    /*
+      result += left * M, where left is a dense (rowsOfLeft x rows) matrix
+      and result a dense (rowsOfLeft x columns) matrix, both row-major.
+      Only the weights of the given sign are used, if requested.
+    */
+    void multiplyFromLeft( const double *left,
+                           double *result,
+                           unsigned rowsOfLeft,
+                           SparseWeightMatrix::Entries entries =
+                               SparseWeightMatrix::ALL_ENTRIES ) const;
+
+    /*
+      result += M * right, where right is a dense (columns x columnsOfRight)
+      matrix and result a dense (rows x columnsOfRight) matrix, both
+      row-major.
+    */
+    void multiplyFromRight( const double *right, double *result, unsigned columnsOfRight ) const;
+
+    bool operator==( const Convolution &other ) const;
+
+private:
+    Shape _shape;
+    Vector<double> _kernel;
+    Vector<unsigned> _inputNeurons;
+    unsigned _rows;
+
+    /*
+      The position in the input tensor of each source layer neuron, or the
+      size of the input tensor for neurons that are not part of it
+    */
+    Vector<unsigned> _sourceNeuronToPosition;
+
+    /*
+      Call function( sourceNeuron, targetNeuron, weight ) for every
+      non-zero weight, one output neuron at a time
+    */
+    template <typename Function> void forEachWeight( Function function ) const
+    {
+        unsigned targetNeuron = 0;
+        for ( unsigned k = 0; k < _shape._outputChannels; ++k )
+        {
+            for ( unsigned i = 0; i < _shape._outputWidth; ++i )
+            {
+                for ( unsigned j = 0; j < _shape._outputHeight; ++j )
+                {
+                    const double *weight = _kernel.data() + k * _shape._inputChannels *
+                                                                _shape._kernelWidth *
+                                                                _shape._kernelHeight;
+                    for ( unsigned c = 0; c < _shape._inputChannels; ++c )
+                    {
+                        for ( unsigned di = 0; di < _shape._kernelWidth; ++di )
+                        {
+                            for ( unsigned dj = 0; dj < _shape._kernelHeight; ++dj, ++weight )
+                            {
+                                // Positions in the padding wrap around
+                                unsigned w = _shape._strideWidth * i + di - _shape._padLeft;
+                                unsigned h = _shape._strideHeight * j + dj - _shape._padBottom;
+                                if ( w >= _shape._inputWidth || h >= _shape._inputHeight ||
+                                     *weight == 0 )
+                                    continue;
+
+                                unsigned position =
+                                    ( c * _shape._inputWidth + w ) * _shape._inputHeight + h;
+                                function( _inputNeurons[position], targetNeuron, *weight );
+                            }
+                        }
+                    }
+                    ++targetNeuron;
+                }
+            }
+        }
+    }
+};
+
+} // namespace NLR
+
+#endif // __Convolution_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -33,9 +33,12 @@
 #include "MStringf.h"
 #include "MatrixMultiplication.h"
 #include "NLRError.h"
+#include "Options.h"
+#include "Set.h"
 #include "TimeUtils.h"
 
 #include <boost/thread.hpp>
+#include <thread>
 
 namespace NLR {
 
@@ -47,6 +50,9 @@ DeepPolyAnalysis::DeepPolyAnalysis( LayerOwner *layerOwner )
     , _work2SymbolicUb( NULL )
     , _workSymbolicLowerBias( NULL )
     , _workSymbolicUpperBias( NULL )
+    , _optimizeSlopes( Options::get()->getBool( Options::DEEP_POLY_OPTIMIZE_SLOPES ) )
+    , _optimizeSplitMultipliers(
+          Options::get()->getBool( Options::DEEP_POLY_OPTIMIZE_SPLIT_MULTIPLIERS ) )
 {
     const Map<unsigned, Layer *> &layers = _layerOwner->getLayerIndexToLayer();
     // Get the maximal layer size
@@ -73,6 +79,64 @@ DeepPolyAnalysis::DeepPolyAnalysis( LayerOwner *layerOwner )
         _deepPolyElements[index] = deepPolyElement;
         log( Stringf( "Creating deeppoly element for layer %u - done", index ) );
     }
+
+    if ( Options::get()->getBool( Options::DEEP_POLY_SINGLE_PRECISION ) )
+    {
+        for ( const auto &pair : _deepPolyElements )
+        {
+            Layer::Type type = pair.second->getLayerType();
+            if ( type == Layer::WEIGHTED_SUM || type == Layer::CONV )
+                ( (DeepPolyWeightedSumElement *)pair.second )->setSinglePrecision( true );
+        }
+    }
+
+    unsigned numberOfThreads = getNumberOfThreads();
+    if ( numberOfThreads > 1 )
+    {
+        log( Stringf( "Back-substituting on %u threads", numberOfThreads ) );
+        _threadPool = std::unique_ptr<ThreadPool>( new ThreadPool( numberOfThreads ) );
+        for ( const auto &pair : _deepPolyElements )
+        {
+            Layer::Type type = pair.second->getLayerType();
+            if ( type == Layer::WEIGHTED_SUM || type == Layer::CONV )
+                ( (DeepPolyWeightedSumElement *)pair.second )->setThreadPool( _threadPool.get() );
+        }
+    }
+}
+
+unsigned DeepPolyAnalysis::getNumberOfThreads()
+{
+    Options *options = Options::get();
+    int requested = options->getInt( Options::DEEP_POLY_NUM_THREADS );
+    if ( requested <= 1 )
+        return 1;
+
+    // The softmax elements use shared working memory when back-substituted
+    for ( const auto &pair : _deepPolyElements )
+    {
+        if ( pair.second->getLayerType() == Layer::SOFTMAX )
+        {
+            log( "Parallel back-substitution is not supported with softmax layers" );
+            return 1;
+        }
+    }
+
+    /*
+      Each DnC worker runs its own DeepPoly, with OpenBLAS on one thread.
+      Otherwise, each multiplication may run on several OpenBLAS threads.
+      The threads of DeepPoly are capped so that they do not outnumber the
+      cores when all of them multiply at once.
+    */
+    unsigned threadsPerBackSubstitution = 1;
+    if ( options->getBool( Options::DNC_MODE ) || options->getBool( Options::PARALLEL_DEEPSOI ) ||
+         options->getBool( Options::PORTFOLIO ) )
+        threadsPerBackSubstitution = std::max( 1, options->getInt( Options::NUM_WORKERS ) );
+    else
+        threadsPerBackSubstitution = std::max( 1, options->getInt( Options::NUM_BLAS_THREADS ) );
+
+    unsigned cores = std::max( 1u, std::thread::hardware_concurrency() );
+    unsigned available = std::max( 1u, cores / threadsPerBackSubstitution );
+    return std::min( (unsigned)requested, available );
 }
 
 DeepPolyAnalysis::~DeepPolyAnalysis()
@@ -128,53 +192,637 @@ void DeepPolyAnalysis::run()
 
     deepPolyStart = TimeUtils::sampleMicro();
 
+    runElements();
+    if ( !_optimizeSlopes && !_optimizeSplitMultipliers )
+        return;
+
+    Vector<unsigned> chain;
+    if ( !getChainToInput( chain ) )
+    {
+        log( "Bound optimization is not supported for this network" );
+        return;
+    }
+
+    // The bounds of the first run decide which neurons are fixed, and so
+    // have split constraints, and which are not, and so have slopes to
+    // optimize. The second run propagates the optimized slopes to the
+    // bounds of every layer.
+    optimizeBounds( chain );
+    invalidateLayerBounds();
+    runElements();
+    if ( _optimizeSplitMultipliers )
+        tightenOutputBounds( chain );
+}
+
+void DeepPolyAnalysis::runElements()
+{
+    /*
+      The elements keep their symbolic and concrete bounds between runs, so
+      an element only needs to be executed again if the bounds of its layer
+      changed since the last run, e.g. because of a split, or if one of its
+      predecessors was executed again. Elements before the first affected
+      layer are skipped.
+    */
+    Set<unsigned> executedLayers;
+    const Map<unsigned, Layer *> &layers = _layerOwner->getLayerIndexToLayer();
+    try
+    {
+        for ( const auto &pair : layers )
+        {
+            /*
+              Go over the layers, one by one. Each time construct and execute
+              the abstract element.
+            */
+            unsigned index = pair.first;
+            Layer *layer = pair.second;
+
+            ASSERT( _deepPolyElements.exists( index ) );
+            DeepPolyElement *deepPolyElement = _deepPolyElements[index];
+
+            bool affected = layerBoundsChanged( layer );
+            for ( const auto &predecessor : deepPolyElement->getPredecessorIndices() )
+            {
+                if ( executedLayers.exists( predecessor.first ) )
+                    affected = true;
+            }
+            if ( !affected )
+            {
+                log( Stringf( "Skipping deeppoly analysis for layer %u", index ) );
+                continue;
+            }
+            executedLayers.insert( index );
+
+            log( Stringf( "Running deeppoly analysis for layer %u...", index ) );
+            deepPolyElement->execute( _deepPolyElements );
+
+            // Extract updated bounds
+            for ( unsigned j = 0; j < deepPolyElement->getSize(); ++j )
+            {
+                if ( layer->neuronEliminated( j ) )
+                    continue;
+                storeTighterBounds( layer,
+                                    j,
+                                    deepPolyElement->getLowerBound( j ),
+                                    deepPolyElement->getUpperBound( j ) );
+            }
+            storeLayerBounds( layer );
+            log( Stringf( "Running deeppoly analysis for layer %u - done", index ) );
+        }
+    }
+    catch ( ... )
+    {
+        // The elements may be left half executed
+        invalidateLayerBounds();
+        throw;
+    }
+}
+
+bool DeepPolyAnalysis::layerBoundsChanged( const Layer *layer ) const
+{
+    unsigned index = layer->getLayerIndex();
+    if ( !_layerLbs.exists( index ) )
+        return true;
+
+    const Vector<double> &lbs = _layerLbs[index];
+    const Vector<double> &ubs = _layerUbs[index];
+    for ( unsigned i = 0; i < layer->getSize(); ++i )
+    {
+        if ( layer->getLb( i ) != lbs[i] || layer->getUb( i ) != ubs[i] )
+            return true;
+    }
+    return false;
+}
+
+void DeepPolyAnalysis::storeLayerBounds( const Layer *layer )
+{
+    /*
+      Store the bounds after the tighter bounds of the element were stored
+      in the layer. If the layer still has these bounds in the next run,
+      executing the element again would give the same result.
+    */
+    unsigned index = layer->getLayerIndex();
+    _layerLbs[index] = Vector<double>( layer->getLbs(), layer->getLbs() + layer->getSize() );
+    _layerUbs[index] = Vector<double>( layer->getUbs(), layer->getUbs() + layer->getSize() );
+}
+
+void DeepPolyAnalysis::invalidateLayerBounds()
+{
+    _layerLbs.clear();
+    _layerUbs.clear();
+}
+
+void DeepPolyAnalysis::storeTighterBounds( Layer *layer, unsigned neuron, double lb, double ub )
+{
+    unsigned index = layer->getLayerIndex();
+    if ( layer->getLb( neuron ) < lb )
+    {
+        log( Stringf( "Neuron %u_%u lower-bound updated from  %f to %f",
+                      index,
+                      neuron,
+                      layer->getLb( neuron ),
+                      lb ) );
+        layer->setLb( neuron, lb );
+        _layerOwner->receiveTighterBound(
+            Tightening( layer->neuronToVariable( neuron ), lb, Tightening::LB ) );
+    }
+    if ( layer->getUb( neuron ) > ub )
+    {
+        log( Stringf( "Neuron %u_%u upper-bound updated from  %f to %f",
+                      index,
+                      neuron,
+                      layer->getUb( neuron ),
+                      ub ) );
+        layer->setUb( neuron, ub );
+        _layerOwner->receiveTighterBound(
+            Tightening( layer->neuronToVariable( neuron ), ub, Tightening::UB ) );
+    }
+}
+
+void DeepPolyAnalysis::optimizeBounds( const Vector<unsigned> &chain )
+{
+    Map<unsigned, LayerSlopes> slopes;
+    if ( _optimizeSlopes )
+    {
+        for ( unsigned index : chain )
+        {
+            DeepPolyElement *element = _deepPolyElements[index];
+            LayerSlopes layerSlopes;
+            for ( unsigned i = 0; i < element->getSize(); ++i )
+            {
+                double minSlope;
+                double maxSlope;
+                double pivot;
+                if ( !element->getLowerSlopeRange( i, minSlope, maxSlope, pivot ) ||
+                     !FloatUtils::lt( minSlope, maxSlope ) )
+                    continue;
+
+                layerSlopes._neurons.append( i );
+                layerSlopes._minSlopes.append( minSlope );
+                layerSlopes._maxSlopes.append( maxSlope );
+                layerSlopes._pivots.append( pivot );
+                layerSlopes._slopes.append( element->getSymbolicLb()[i] );
+                layerSlopes._gradient.append( 0 );
+            }
+
+            if ( !layerSlopes._neurons.empty() )
+                slopes[index] = layerSlopes;
+        }
+    }
+
+    bool hasSplits = _optimizeSplitMultipliers && updateSplitMultipliers( chain );
+    if ( slopes.empty() && !hasSplits )
+        return;
+
+    Vector<double> lowerBounds;
+    Vector<double> upperBounds;
+    double multiplierScale;
+    if ( !computeOutputBounds( chain, slopes, lowerBounds, upperBounds, multiplierScale ) )
+        return;
+
+    double bestObjective = getObjective( lowerBounds, upperBounds );
+    Map<unsigned, Vector<double>> bestSlopes;
+    for ( const auto &pair : slopes )
+        bestSlopes[pair.first] = pair.second._slopes;
+    Map<unsigned, LayerMultipliers> bestMultipliers = _splitMultipliers;
+
+    double stepSize = GlobalConfiguration::DEEP_POLY_SLOPE_OPTIMIZATION_STEP_SIZE;
+    for ( unsigned iteration = 0;
+          iteration < GlobalConfiguration::DEEP_POLY_SLOPE_OPTIMIZATION_ITERATIONS;
+          ++iteration )
+    {
+        double maxSlopeGradient = 0;
+        for ( const auto &pair : slopes )
+        {
+            for ( double gradient : pair.second._gradient )
+                maxSlopeGradient = std::max( maxSlopeGradient, FloatUtils::abs( gradient ) );
+        }
+
+        double maxMultiplierGradient = 0;
+        for ( const auto &pair : _splitMultipliers )
+        {
+            for ( double gradient : pair.second._lowerGradient )
+                maxMultiplierGradient =
+                    std::max( maxMultiplierGradient, FloatUtils::abs( gradient ) );
+            for ( double gradient : pair.second._upperGradient )
+                maxMultiplierGradient =
+                    std::max( maxMultiplierGradient, FloatUtils::abs( gradient ) );
+        }
+
+        if ( FloatUtils::isZero( maxSlopeGradient ) && FloatUtils::isZero( maxMultiplierGradient ) )
+            break;
+
+        // Take a step along the gradient, scaled so that no slope moves by
+        // more than the step size, and project back onto the slope ranges
+        if ( !FloatUtils::isZero( maxSlopeGradient ) )
+        {
+            for ( auto &pair : slopes )
+            {
+                DeepPolyElement *element = _deepPolyElements[pair.first];
+                LayerSlopes &layerSlopes = pair.second;
+                for ( unsigned p = 0; p < layerSlopes._neurons.size(); ++p )
+                {
+                    double slope = layerSlopes._slopes[p] +
+                                   stepSize * layerSlopes._gradient[p] / maxSlopeGradient;
+                    slope = std::max( layerSlopes._minSlopes[p],
+                                      std::min( layerSlopes._maxSlopes[p], slope ) );
+                    layerSlopes._slopes[p] = slope;
+                    element->setOptimizedLowerSlope( layerSlopes._neurons[p], slope );
+                }
+
+                // Recompute the relaxations of the layer with the new slopes
+                element->execute( _deepPolyElements );
+            }
+        }
+
+        // The multipliers are on the scale of the coefficients of the
+        // bounds, and are projected back onto the non-negative numbers
+        if ( !FloatUtils::isZero( maxMultiplierGradient ) )
+        {
+            double multiplierStep = stepSize * multiplierScale / maxMultiplierGradient;
+            for ( auto &pair : _splitMultipliers )
+            {
+                LayerMultipliers &multipliers = pair.second;
+                for ( unsigned k = 0; k < multipliers._lower.size(); ++k )
+                {
+                    multipliers._lower[k] += multiplierStep * multipliers._lowerGradient[k];
+                    multipliers._lower[k] = std::max( 0.0, multipliers._lower[k] );
+                    multipliers._upper[k] += multiplierStep * multipliers._upperGradient[k];
+                    multipliers._upper[k] = std::max( 0.0, multipliers._upper[k] );
+                }
+            }
+        }
+        stepSize *= GlobalConfiguration::DEEP_POLY_SLOPE_OPTIMIZATION_STEP_DECAY;
+
+        if ( !computeOutputBounds( chain, slopes, lowerBounds, upperBounds, multiplierScale ) )
+            break;
+
+        double objective = getObjective( lowerBounds, upperBounds );
+        log( Stringf( "Bound optimization iteration %u: objective %f", iteration, objective ) );
+        if ( objective > bestObjective )
+        {
+            bestObjective = objective;
+            for ( const auto &pair : slopes )
+                bestSlopes[pair.first] = pair.second._slopes;
+            bestMultipliers = _splitMultipliers;
+        }
+    }
+
+    // Cache the best slopes in the elements, and the best multipliers,
+    // where they are also the starting point of the next optimization
+    for ( const auto &pair : bestSlopes )
+    {
+        DeepPolyElement *element = _deepPolyElements[pair.first];
+        const Vector<unsigned> &neurons = slopes[pair.first]._neurons;
+        for ( unsigned p = 0; p < neurons.size(); ++p )
+            element->setOptimizedLowerSlope( neurons[p], pair.second[p] );
+    }
+    _splitMultipliers = bestMultipliers;
+}
+
+double DeepPolyAnalysis::getObjective( const Vector<double> &lowerBounds,
+                                       const Vector<double> &upperBounds ) const
+{
+    double objective = 0;
+    for ( unsigned j = 0; j < lowerBounds.size(); ++j )
+        objective += lowerBounds[j] - upperBounds[j];
+    return objective;
+}
+
+bool DeepPolyAnalysis::updateSplitMultipliers( const Vector<unsigned> &chain )
+{
+    unsigned outputSize = _deepPolyElements[chain[0]]->getSize();
+    bool hasSplits = false;
+    for ( unsigned k = 0; k + 1 < chain.size(); ++k )
+    {
+        DeepPolyElement *element = _deepPolyElements[chain[k]];
+        if ( element->getLayerType() != Layer::RELU &&
+             element->getLayerType() != Layer::LEAKY_RELU )
+            continue;
+
+        const Layer *layer = _layerOwner->getLayer( chain[k] );
+        DeepPolyElement *predecessor = _deepPolyElements[chain[k + 1]];
+        unsigned size = element->getSize();
+        if ( !_splitMultipliers.exists( chain[k] ) )
+        {
+            LayerMultipliers multipliers;
+            multipliers._signs = Vector<double>( size, 0 );
+            multipliers._lower = Vector<double>( size * outputSize, 0 );
+            multipliers._upper = Vector<double>( size * outputSize, 0 );
+            multipliers._lowerGradient = Vector<double>( size * outputSize, 0 );
+            multipliers._upperGradient = Vector<double>( size * outputSize, 0 );
+            _splitMultipliers[chain[k]] = multipliers;
+        }
+
+        // The multipliers of a neuron are kept as long as its phase stays
+        // the same, and reset otherwise
+        LayerMultipliers &multipliers = _splitMultipliers[chain[k]];
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            unsigned sourceNeuron = ( *layer->getActivationSources( i ).begin() )._neuron;
+            double sign = 0;
+            if ( !FloatUtils::isNegative( predecessor->getLowerBound( sourceNeuron ) ) )
+                sign = 1;
+            else if ( !FloatUtils::isPositive( predecessor->getUpperBound( sourceNeuron ) ) )
+                sign = -1;
+
+            if ( sign != 0 )
+                hasSplits = true;
+
+            if ( sign != multipliers._signs[i] )
+            {
+                multipliers._signs[i] = sign;
+                std::fill_n( multipliers._lower.begin() + i * outputSize, outputSize, 0 );
+                std::fill_n( multipliers._upper.begin() + i * outputSize, outputSize, 0 );
+            }
+        }
+    }
+    return hasSplits;
+}
+
+void DeepPolyAnalysis::tightenOutputBounds( const Vector<unsigned> &chain )
+{
+    updateSplitMultipliers( chain );
+
+    Map<unsigned, LayerSlopes> slopes;
+    Vector<double> lowerBounds;
+    Vector<double> upperBounds;
+    double multiplierScale;
+    if ( !computeOutputBounds( chain, slopes, lowerBounds, upperBounds, multiplierScale ) )
+        return;
+
+    Layer *layer = _layerOwner->getLayerIndexToLayer()[chain[0]];
+    for ( unsigned j = 0; j < layer->getSize(); ++j )
+    {
+        if ( layer->neuronEliminated( j ) )
+            continue;
+        storeTighterBounds(
+            layer,
+            j,
+            lowerBounds[j] - GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT,
+            upperBounds[j] + GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT );
+    }
+}
+
+bool DeepPolyAnalysis::getChainToInput( Vector<unsigned> &chain ) const
+{
     const Map<unsigned, Layer *> &layers = _layerOwner->getLayerIndexToLayer();
+    if ( layers.empty() )
+        return false;
+
+    unsigned index = 0;
     for ( const auto &pair : layers )
+        index = pair.first;
+
+    while ( true )
     {
+        chain.append( index );
+        const Layer *layer = layers[index];
+        Layer::Type type = layer->getLayerType();
+        if ( type == Layer::INPUT )
+            return true;
+
+        if ( type != Layer::WEIGHTED_SUM && type != Layer::CONV && type != Layer::RELU &&
+             type != Layer::LEAKY_RELU && type != Layer::SIGMOID &&
+             type != Layer::ABSOLUTE_VALUE && type != Layer::SIGN && type != Layer::ROUND )
+            return false;
+
+        const Map<unsigned, unsigned> &sourceLayers = layer->getSourceLayers();
+        if ( sourceLayers.size() != 1 )
+            return false;
+        index = sourceLayers.begin()->first;
+    }
+}
+
+bool DeepPolyAnalysis::computeOutputBounds( const Vector<unsigned> &chain,
+                                            Map<unsigned, LayerSlopes> &slopes,
+                                            Vector<double> &lowerBounds,
+                                            Vector<double> &upperBounds,
+                                            double &multiplierScale )
+{
+    unsigned outputSize = _deepPolyElements[chain[0]]->getSize();
+
+    // Back-substitute the bounds of the output layer, starting from the
+    // identity, and record the coefficients of the bounds with respect to
+    // each activation layer, whose signs decide which relaxation is used
+    double *symbolicLb = _work1SymbolicLb;
+    double *symbolicUb = _work1SymbolicUb;
+    double *predecessorSymbolicLb = _work2SymbolicLb;
+    double *predecessorSymbolicUb = _work2SymbolicUb;
+    std::fill_n( symbolicLb, outputSize * outputSize, 0 );
+    std::fill_n( symbolicUb, outputSize * outputSize, 0 );
+    for ( unsigned i = 0; i < outputSize; ++i )
+    {
+        symbolicLb[i * outputSize + i] = 1;
+        symbolicUb[i * outputSize + i] = 1;
+    }
+    std::fill_n( _workSymbolicLowerBias, outputSize, 0 );
+    std::fill_n( _workSymbolicUpperBias, outputSize, 0 );
+
+    multiplierScale = 0;
+    Map<unsigned, Vector<double>> lowerCoefficients;
+    Map<unsigned, Vector<double>> upperCoefficients;
+    for ( unsigned k = 0; k + 1 < chain.size(); ++k )
+    {
+        DeepPolyElement *element = _deepPolyElements[chain[k]];
+        DeepPolyElement *predecessor = _deepPolyElements[chain[k + 1]];
+        Layer::Type type = element->getLayerType();
+        if ( type != Layer::WEIGHTED_SUM && type != Layer::CONV )
+        {
+            unsigned matrixSize = element->getSize() * outputSize;
+            lowerCoefficients[chain[k]] = Vector<double>( symbolicLb, symbolicLb + matrixSize );
+            upperCoefficients[chain[k]] = Vector<double>( symbolicUb, symbolicUb + matrixSize );
+        }
+
+        std::fill_n( predecessorSymbolicLb, predecessor->getSize() * outputSize, 0 );
+        std::fill_n( predecessorSymbolicUb, predecessor->getSize() * outputSize, 0 );
+        element->symbolicBoundInTermsOfPredecessor( symbolicLb,
+                                                    symbolicUb,
+                                                    _workSymbolicLowerBias,
+                                                    _workSymbolicUpperBias,
+                                                    predecessorSymbolicLb,
+                                                    predecessorSymbolicUb,
+                                                    outputSize,
+                                                    predecessor );
+
         /*
-          Go over the layers, one by one. Each time construct and execute
-          the abstract element.
+          The split constraint of a fixed neuron, sign * x_b >= 0, is added
+          to its bounds with a non-negative multiplier: the lower bound of
+          an output y is min ( y - beta * sign * x_b ), and the upper bound
+          is max ( y + beta * sign * x_b ).
         */
-        unsigned index = pair.first;
-        Layer *layer = pair.second;
+        if ( _optimizeSplitMultipliers && _splitMultipliers.exists( chain[k] ) )
+        {
+            const Layer *layer = _layerOwner->getLayer( chain[k] );
+            const LayerMultipliers &multipliers = _splitMultipliers[chain[k]];
+            for ( unsigned i = 0; i < element->getSize(); ++i )
+            {
+                double sign = multipliers._signs[i];
+                if ( sign == 0 )
+                    continue;
+
+                unsigned sourceNeuron = ( *layer->getActivationSources( i ).begin() )._neuron;
+                for ( unsigned j = 0; j < outputSize; ++j )
+                {
+                    double &lowerCoefficient = predecessorSymbolicLb[sourceNeuron * outputSize + j];
+                    double &upperCoefficient = predecessorSymbolicUb[sourceNeuron * outputSize + j];
+                    multiplierScale = std::max( multiplierScale,
+                                                std::max( FloatUtils::abs( lowerCoefficient ),
+                                                          FloatUtils::abs( upperCoefficient ) ) );
+                    lowerCoefficient -= multipliers._lower[i * outputSize + j] * sign;
+                    upperCoefficient += multipliers._upper[i * outputSize + j] * sign;
+                }
+            }
+        }
 
-        ASSERT( _deepPolyElements.exists( index ) );
-        log( Stringf( "Running deeppoly analysis for layer %u...", index ) );
-        DeepPolyElement *deepPolyElement = _deepPolyElements[index];
-        deepPolyElement->execute( _deepPolyElements );
+        std::swap( symbolicLb, predecessorSymbolicLb );
+        std::swap( symbolicUb, predecessorSymbolicUb );
+    }
+
+    // Concretize the bounds over the input box. For each output neuron,
+    // store the input that attains its lower bound and the one that attains
+    // its upper bound, one row per output neuron.
+    unsigned inputIndex = chain.last();
+    DeepPolyElement *inputElement = _deepPolyElements[inputIndex];
+    unsigned inputSize = inputElement->getSize();
+    Map<unsigned, Vector<double>> lowerValues;
+    Map<unsigned, Vector<double>> upperValues;
+    lowerValues[inputIndex] = Vector<double>( outputSize * inputSize );
+    upperValues[inputIndex] = Vector<double>( outputSize * inputSize );
+    double *inputLowerValues = lowerValues[inputIndex].data();
+    double *inputUpperValues = upperValues[inputIndex].data();
+
+    lowerBounds = Vector<double>( _workSymbolicLowerBias, _workSymbolicLowerBias + outputSize );
+    upperBounds = Vector<double>( _workSymbolicUpperBias, _workSymbolicUpperBias + outputSize );
+    for ( unsigned i = 0; i < inputSize; ++i )
+    {
+        double lb = inputElement->getLowerBoundFromLayer( i );
+        double ub = inputElement->getUpperBoundFromLayer( i );
+        if ( !FloatUtils::isFinite( lb ) || !FloatUtils::isFinite( ub ) )
+            return false;
 
-        // Extract updated bounds
-        for ( unsigned j = 0; j < deepPolyElement->getSize(); ++j )
+        for ( unsigned j = 0; j < outputSize; ++j )
         {
-            if ( layer->neuronEliminated( j ) )
-                continue;
-            double lb = deepPolyElement->getLowerBound( j );
-            if ( layer->getLb( j ) < lb )
+            double coefficient = symbolicLb[i * outputSize + j];
+            inputLowerValues[j * inputSize + i] = coefficient >= 0 ? lb : ub;
+            lowerBounds[j] += coefficient * inputLowerValues[j * inputSize + i];
+
+            coefficient = symbolicUb[i * outputSize + j];
+            inputUpperValues[j * inputSize + i] = coefficient >= 0 ? ub : lb;
+            upperBounds[j] += coefficient * inputUpperValues[j * inputSize + i];
+        }
+    }
+
+    /*
+      Evaluate the relaxed network forward on these inputs, with each
+      activation replaced by the linear relaxation that the back-substitution
+      used for the bound. The bound is the value of the output neuron, and
+      each slope multiplies the offset of its neuron's input from the pivot.
+      So, the derivative of a lower bound with respect to the slope of a
+      neuron whose lower relaxation it uses is the coefficient of the neuron
+      times ( input - pivot ), and likewise for the upper bounds. The
+      derivative of the objective with respect to a split multiplier is
+      -sign * x_b, for both bounds.
+    */
+    for ( unsigned k = chain.size() - 1; k-- > 0; )
+    {
+        unsigned index = chain[k];
+        unsigned sourceIndex = chain[k + 1];
+        const Layer *layer = _layerOwner->getLayer( index );
+        DeepPolyElement *element = _deepPolyElements[index];
+        unsigned size = element->getSize();
+        unsigned sourceSize = _deepPolyElements[sourceIndex]->getSize();
+
+        lowerValues[index] = Vector<double>( outputSize * size );
+        upperValues[index] = Vector<double>( outputSize * size );
+        double *layerLowerValues = lowerValues[index].data();
+        double *layerUpperValues = upperValues[index].data();
+        const double *sourceLowerValues = lowerValues[sourceIndex].data();
+        const double *sourceUpperValues = upperValues[sourceIndex].data();
+
+        Layer::Type type = layer->getLayerType();
+        if ( type == Layer::WEIGHTED_SUM || type == Layer::CONV )
+        {
+            Map<unsigned, const double *> sourceValues;
+            sourceValues[sourceIndex] = sourceLowerValues;
+            layer->computeBatch( sourceValues, outputSize, layerLowerValues );
+            sourceValues[sourceIndex] = sourceUpperValues;
+            layer->computeBatch( sourceValues, outputSize, layerUpperValues );
+            continue;
+        }
+
+        const double *lowerCoefficient = lowerCoefficients[index].data();
+        const double *upperCoefficient = upperCoefficients[index].data();
+        const double *coeffLb = element->getSymbolicLb();
+        const double *coeffUb = element->getSymbolicUb();
+        const double *lowerBias = element->getSymbolicLowerBias();
+        const double *upperBias = element->getSymbolicUpperBias();
+        Vector<unsigned> sourceNeurons( size );
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            unsigned sourceNeuron = ( *layer->getActivationSources( i ).begin() )._neuron;
+            sourceNeurons[i] = sourceNeuron;
+            for ( unsigned j = 0; j < outputSize; ++j )
             {
-                log( Stringf( "Neuron %u_%u lower-bound updated from  %f to %f",
-                              index,
-                              j,
-                              layer->getLb( j ),
-                              lb ) );
-                layer->setLb( j, lb );
-                _layerOwner->receiveTighterBound(
-                    Tightening( layer->neuronToVariable( j ), lb, Tightening::LB ) );
+                double value = sourceLowerValues[j * sourceSize + sourceNeuron];
+                layerLowerValues[j * size + i] = lowerCoefficient[i * outputSize + j] >= 0
+                                                   ? coeffLb[i] * value + lowerBias[i]
+                                                   : coeffUb[i] * value + upperBias[i];
+
+                value = sourceUpperValues[j * sourceSize + sourceNeuron];
+                layerUpperValues[j * size + i] = upperCoefficient[i * outputSize + j] >= 0
+                                                   ? coeffUb[i] * value + upperBias[i]
+                                                   : coeffLb[i] * value + lowerBias[i];
             }
-            double ub = deepPolyElement->getUpperBound( j );
-            if ( layer->getUb( j ) > ub )
+        }
+
+        if ( slopes.exists( index ) )
+        {
+            LayerSlopes &layerSlopes = slopes[index];
+            for ( unsigned p = 0; p < layerSlopes._neurons.size(); ++p )
             {
-                log( Stringf( "Neuron %u_%u upper-bound updated from  %f to %f",
-                              index,
-                              j,
-                              layer->getUb( j ),
-                              ub ) );
-                layer->setUb( j, ub );
-                _layerOwner->receiveTighterBound(
-                    Tightening( layer->neuronToVariable( j ), ub, Tightening::UB ) );
+                unsigned i = layerSlopes._neurons[p];
+                unsigned sourceNeuron = sourceNeurons[i];
+                double pivot = layerSlopes._pivots[p];
+                double gradient = 0;
+                for ( unsigned j = 0; j < outputSize; ++j )
+                {
+                    double coefficient = lowerCoefficient[i * outputSize + j];
+                    if ( coefficient >= 0 )
+                        gradient += coefficient *
+                                    ( sourceLowerValues[j * sourceSize + sourceNeuron] - pivot );
+
+                    coefficient = upperCoefficient[i * outputSize + j];
+                    if ( coefficient < 0 )
+                        gradient -= coefficient *
+                                    ( sourceUpperValues[j * sourceSize + sourceNeuron] - pivot );
+                }
+                layerSlopes._gradient[p] = gradient;
             }
         }
-        log( Stringf( "Running deeppoly analysis for layer %u - done", index ) );
+
+        if ( _optimizeSplitMultipliers && _splitMultipliers.exists( index ) )
+        {
+            LayerMultipliers &multipliers = _splitMultipliers[index];
+            for ( unsigned i = 0; i < size; ++i )
+            {
+                double sign = multipliers._signs[i];
+                for ( unsigned j = 0; j < outputSize; ++j )
+                {
+                    multipliers._lowerGradient[i * outputSize + j] =
+                        -sign * sourceLowerValues[j * sourceSize + sourceNeurons[i]];
+                    multipliers._upperGradient[i * outputSize + j] =
+                        -sign * sourceUpperValues[j * sourceSize + sourceNeurons[i]];
+                }
+            }
+        }
+    }
+
+    for ( unsigned j = 0; j < outputSize; ++j )
+    {
+        if ( !FloatUtils::isFinite( lowerBounds[j] ) || !FloatUtils::isFinite( upperBounds[j] ) )
+            return false;
     }
+    return true;
 }
 
 void DeepPolyAnalysis::allocateMemory()
@@ -203,7 +851,7 @@ DeepPolyElement *DeepPolyAnalysis::createDeepPolyElement( Layer *layer )
     DeepPolyElement *deepPolyElement;
     if ( type == Layer::INPUT )
         deepPolyElement = new DeepPolyInputElement( layer );
-    else if ( type == Layer::WEIGHTED_SUM )
+    else if ( type == Layer::WEIGHTED_SUM || type == Layer::CONV )
     {
         deepPolyElement = new DeepPolyWeightedSumElement( layer );
         // Weighted sum layers need working memory for back substitution
@@ -20,8 +20,11 @@
 #include "Layer.h"
 #include "LayerOwner.h"
 #include "Map.h"
+#include "ThreadPool.h"
+#include "Vector.h"
 
 #include <climits>
+#include <memory>
 
 namespace NLR {
 
@@ -53,6 +56,121 @@ private:
 
     unsigned _maxLayerSize;
 
+    /*
+      Whether the lower relaxation slopes of the activation functions are
+      optimized, as in alpha-CROWN (https://arxiv.org/abs/2011.13824)
+    */
+    bool _optimizeSlopes;
+
+    /*
+      Whether the split constraints of the fixed ReLU and leaky ReLU neurons
+      are added to the back-substitution with optimized Lagrange
+      multipliers, as in beta-CROWN (https://arxiv.org/abs/2103.06624)
+    */
+    bool _optimizeSplitMultipliers;
+
+    /*
+      The threads on which the weighted sum elements back-substitute blocks
+      of their neurons, if more than one thread is used
+    */
+    std::unique_ptr<ThreadPool> _threadPool;
+    unsigned getNumberOfThreads();
+
+    /*
+      The optimizable lower relaxation slopes of the neurons of a layer,
+      and the gradient of the objective with respect to them
+    */
+    struct LayerSlopes
+    {
+        Vector<unsigned> _neurons;
+        Vector<double> _minSlopes;
+        Vector<double> _maxSlopes;
+        Vector<double> _pivots;
+        Vector<double> _slopes;
+        Vector<double> _gradient;
+    };
+
+    /*
+      The split multipliers of the neurons of an activation layer, one per
+      neuron and output neuron, stored as [neuron * outputSize + output],
+      for the lower and the upper bounds. The sign of a neuron is 1 if its
+      input is non-negative, -1 if it is non-positive and 0 if the neuron
+      is not fixed. The multipliers are kept across runs, as a warm start.
+    */
+    struct LayerMultipliers
+    {
+        Vector<double> _signs;
+        Vector<double> _lower;
+        Vector<double> _upper;
+        Vector<double> _lowerGradient;
+        Vector<double> _upperGradient;
+    };
+
+    Map<unsigned, LayerMultipliers> _splitMultipliers;
+
+    /*
+      Execute the abstract elements layer by layer, and store the tighter
+      bounds in the layers
+    */
+    void runElements();
+    void storeTighterBounds( Layer *layer, unsigned neuron, double lb, double ub );
+
+    /*
+      The bounds of each layer at the end of the last run, used to skip the
+      layers that are not affected by the changes since then
+    */
+    Map<unsigned, Vector<double>> _layerLbs;
+    Map<unsigned, Vector<double>> _layerUbs;
+
+    bool layerBoundsChanged( const Layer *layer ) const;
+    void storeLayerBounds( const Layer *layer );
+    void invalidateLayerBounds();
+
+    /*
+      Optimize the lower relaxation slopes and the split multipliers by
+      projected gradient ascent on the sum of the lower bounds minus the sum
+      of the upper bounds of the output layer, and cache the best values
+      found. Only networks in which each layer has a single source layer
+      are supported.
+    */
+    void optimizeBounds( const Vector<unsigned> &chain );
+    double getObjective( const Vector<double> &lowerBounds,
+                         const Vector<double> &upperBounds ) const;
+
+    /*
+      Update the signs of the split neurons on the chain from the current
+      bounds of their inputs. Returns true if any neuron is split.
+    */
+    bool updateSplitMultipliers( const Vector<unsigned> &chain );
+
+    /*
+      Store the bounds of the output layer obtained with the optimized
+      split multipliers, if they are tighter
+    */
+    void tightenOutputBounds( const Vector<unsigned> &chain );
+
+    /*
+      Store in chain the indices of the layers from the output layer back to
+      the input layer, if each layer has a single source layer and the
+      symbolic bounds of every layer can be evaluated on a concrete input
+    */
+    bool getChainToInput( Vector<unsigned> &chain ) const;
+
+    /*
+      Back-substitute the bounds of the output layer to the input layer
+      with the current slopes and split multipliers, and store the bounds.
+      The gradients with respect to the slopes and the multipliers are
+      computed by evaluating the relaxed network forward on the inputs that
+      attain each bound. multiplierScale is the largest coefficient of a
+      split neuron, used to scale the multiplier steps. Returns false if
+      the bounds are not finite.
+    */
+    bool computeOutputBounds( const Vector<unsigned> &chain,
+                              Map<unsigned, LayerSlopes> &slopes,
+                              Vector<double> &lowerBounds,
+                              Vector<double> &upperBounds,
+                              double &multiplierScale );
+
     void allocateMemory();
     void freeMemoryIfNeeded();
 
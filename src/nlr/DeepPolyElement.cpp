@@ -104,6 +104,43 @@ double DeepPolyElement::getUpperBoundFromLayer( unsigned index ) const
     return _layer->getUb( index );
 }
 
+bool DeepPolyElement::getLowerSlopeRange( unsigned index,
+                                          double &minSlope,
+                                          double &maxSlope,
+                                          double &pivot ) const
+{
+    if ( !_lowerSlopeRanges.exists( index ) )
+        return false;
+
+    const LowerSlopeRange &range = _lowerSlopeRanges[index];
+    minSlope = range._minSlope;
+    maxSlope = range._maxSlope;
+    pivot = range._pivot;
+    return true;
+}
+
+void DeepPolyElement::setOptimizedLowerSlope( unsigned index, double slope )
+{
+    ASSERT( index < getSize() );
+    _optimizedLowerSlopes[index] = slope;
+}
+
+double DeepPolyElement::getLowerSlope( unsigned index,
+                                       double minSlope,
+                                       double maxSlope,
+                                       double defaultSlope ) const
+{
+    if ( !_optimizedLowerSlopes.exists( index ) )
+        return defaultSlope;
+
+    double slope = _optimizedLowerSlopes.get( index );
+    if ( slope < minSlope )
+        return minSlope;
+    if ( slope > maxSlope )
+        return maxSlope;
+    return slope;
+}
+
 void DeepPolyElement::getConcreteBounds()
 {
     unsigned size = getSize();
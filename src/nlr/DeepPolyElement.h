@@ -79,6 +79,25 @@ public:
     double getLowerBoundFromLayer( unsigned index ) const;
     double getUpperBoundFromLayer( unsigned index ) const;
 
+    /*
+      For activation elements whose lower relaxation of a non-fixed neuron
+      is a line through a fixed point, x_f >= slope * ( x_b - pivot ) + c,
+      that is sound for any slope in [minSlope, maxSlope]: return whether
+      the neuron had such a relaxation in the last execution, and if so,
+      the interval and the pivot.
+    */
+    bool getLowerSlopeRange( unsigned index,
+                             double &minSlope,
+                             double &maxSlope,
+                             double &pivot ) const;
+
+    /*
+      Use the given slope for the lower relaxation of a neuron, instead of
+      the heuristic one, in this and subsequent executions. The slope is
+      clipped to the range that is sound under the bounds of each execution.
+    */
+    void setOptimizedLowerSlope( unsigned index, double slope );
+
 protected:
     Layer *_layer;
     unsigned _size;
@@ -103,6 +122,30 @@ protected:
     double *_workSymbolicLowerBias;
     double *_workSymbolicUpperBias;
 
+    struct LowerSlopeRange
+    {
+        double _minSlope;
+        double _maxSlope;
+        double _pivot;
+    };
+
+    /*
+      The neurons whose lower relaxation slope can be optimized, filled in
+      by the elements that support it when they are executed, and the slopes
+      found by slope optimization
+    */
+    Map<unsigned, LowerSlopeRange> _lowerSlopeRanges;
+    Map<unsigned, double> _optimizedLowerSlopes;
+
+    /*
+      The optimized lower relaxation slope of a neuron clipped to the given
+      range, or the default slope if none was set
+    */
+    double getLowerSlope( unsigned index,
+                          double minSlope,
+                          double maxSlope,
+                          double defaultSlope ) const;
+
     void allocateMemory();
     void freeMemoryIfNeeded();
 
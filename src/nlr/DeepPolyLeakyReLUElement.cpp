@@ -40,6 +40,7 @@ void DeepPolyLeakyReLUElement::execute(
     log( "Executing..." );
     ASSERT( hasPredecessor() );
     allocateMemory();
+    _lowerSlopeRanges.clear();
 
     // Update the symbolic and concrete upper- and lower- bounds
     // of each neuron
@@ -91,28 +92,19 @@ void DeepPolyLeakyReLUElement::execute(
                 _ub[i] = sourceUb;
 
                 // For the lower bound, in general, x_f >= lambda * x_b, where
-                // 0 <= lambda <= 1, would be a sound lower bound. We
-                // use the heuristic described in section 4.1 of
+                // slope <= lambda <= 1, would be a sound lower bound. Unless
+                // lambda was optimized, we use the heuristic described in
+                // section 4.1 of
                 // https://files.sri.inf.ethz.ch/website/papers/DeepPoly.pdf
-                // to set the value of lambda (either 0 or 1 is considered).
-                if ( sourceUb > sourceLb )
-                {
-                    // lambda = 1
-                    // Symbolic lower bound: x_f >= x_b
-                    // Concrete lower bound: x_f >= sourceLb
-                    _symbolicLb[i] = 1;
-                    _symbolicLowerBias[i] = 0;
-                    _lb[i] = sourceLb;
-                }
-                else
-                {
-                    // lambda = 1
-                    // Symbolic lower bound: x_f >= 0
-                    // Concrete lower bound: x_f >= 0
-                    _symbolicLb[i] = _slope;
-                    _symbolicLowerBias[i] = 0;
-                    _lb[i] = _slope * sourceLb;
-                }
+                // to set the value of lambda (either slope or 1 is considered).
+                // Symbolic lower bound: x_f >= lambda * x_b
+                // Concrete lower bound: x_f >= lambda * sourceLb
+                double lambda =
+                    getLowerSlope( i, _slope, 1, sourceUb > sourceLb ? 1 : _slope );
+                _symbolicLb[i] = lambda;
+                _symbolicLowerBias[i] = 0;
+                _lb[i] = lambda * sourceLb;
+                _lowerSlopeRanges[i] = { _slope, 1, 0 };
             }
             else
             {
@@ -36,6 +36,7 @@ void DeepPolyReLUElement::execute( const Map<unsigned, DeepPolyElement *> &deepP
     log( "Executing..." );
     ASSERT( hasPredecessor() );
     allocateMemory();
+    _lowerSlopeRanges.clear();
 
     // Update the symbolic and concrete upper- and lower- bounds
     // of each neuron
@@ -83,28 +84,17 @@ void DeepPolyReLUElement::execute( const Map<unsigned, DeepPolyElement *> &deepP
             _ub[i] = sourceUb;
 
             // For the lower bound, in general, x_f >= lambda * x_b, where
-            // 0 <= lambda <= 1, would be a sound lower bound. We
-            // use the heuristic described in section 4.1 of
+            // 0 <= lambda <= 1, would be a sound lower bound. Unless lambda
+            // was optimized, we use the heuristic described in section 4.1 of
             // https://files.sri.inf.ethz.ch/website/papers/DeepPoly.pdf
             // to set the value of lambda (either 0 or 1 is considered).
-            if ( sourceUb > -sourceLb )
-            {
-                // lambda = 1
-                // Symbolic lower bound: x_f >= x_b
-                // Concrete lower bound: x_f >= sourceLb
-                _symbolicLb[i] = 1;
-                _symbolicLowerBias[i] = 0;
-                _lb[i] = sourceLb;
-            }
-            else
-            {
-                // lambda = 1
-                // Symbolic lower bound: x_f >= 0
-                // Concrete lower bound: x_f >= 0
-                _symbolicLb[i] = 0;
-                _symbolicLowerBias[i] = 0;
-                _lb[i] = 0;
-            }
+            // Symbolic lower bound: x_f >= lambda * x_b
+            // Concrete lower bound: x_f >= lambda * sourceLb
+            double lambda = getLowerSlope( i, 0, 1, sourceUb > -sourceLb ? 1 : 0 );
+            _symbolicLb[i] = lambda;
+            _symbolicLowerBias[i] = 0;
+            _lb[i] = lambda * sourceLb;
+            _lowerSlopeRanges[i] = { 0, 1, 0 };
         }
         log( Stringf( "Neuron%u LB: %f b + %f, UB: %f b + %f",
                       i,
@@ -38,6 +38,7 @@ void DeepPolySigmoidElement::execute(
     log( "Executing..." );
     ASSERT( hasPredecessor() );
     allocateMemory();
+    _lowerSlopeRanges.clear();
 
     // Update the symbolic and concrete upper- and lower- bounds
     // of each neuron
@@ -64,18 +65,13 @@ void DeepPolySigmoidElement::execute(
             double lambdaPrime = std::min( SigmoidConstraint::sigmoidDerivative( sourceLb ),
                                            SigmoidConstraint::sigmoidDerivative( sourceUb ) );
 
-            // update lower bound
-            if ( FloatUtils::isPositive( sourceLb ) )
-            {
-                _symbolicLb[i] = lambda;
-                _symbolicLowerBias[i] = SigmoidConstraint::sigmoid( sourceLb ) - lambda * sourceLb;
-            }
-            else
-            {
-                _symbolicLb[i] = lambdaPrime;
-                _symbolicLowerBias[i] =
-                    SigmoidConstraint::sigmoid( sourceLb ) - lambdaPrime * sourceLb;
-            }
+            // update lower bound. It passes through ( sourceLb, _lb[i] ), and
+            // any slope between 0 and the one below is sound.
+            double maxSlope = FloatUtils::isPositive( sourceLb ) ? lambda : lambdaPrime;
+            double slope = getLowerSlope( i, 0, maxSlope, maxSlope );
+            _symbolicLb[i] = slope;
+            _symbolicLowerBias[i] = _lb[i] - slope * sourceLb;
+            _lowerSlopeRanges[i] = { 0, maxSlope, sourceLb };
 
             // update upper bound
             if ( !FloatUtils::isPositive( sourceUb ) )
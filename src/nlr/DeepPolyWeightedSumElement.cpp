@@ -17,6 +17,8 @@
 
 #include "FloatUtils.h"
 
+#include <cfloat>
+#include <cmath>
 #include <string.h>
 
 namespace NLR {
@@ -24,6 +26,7 @@ namespace NLR {
 DeepPolyWeightedSumElement::DeepPolyWeightedSumElement( Layer *layer )
     : _workLb( NULL )
     , _workUb( NULL )
+    , _threadPool( NULL )
 {
     _layer = layer;
     _size = layer->getSize();
@@ -35,6 +38,50 @@ DeepPolyWeightedSumElement::~DeepPolyWeightedSumElement()
     freeMemoryIfNeeded();
 }
 
+void DeepPolyWeightedSumElement::setThreadPool( ThreadPool *threadPool )
+{
+    _threadPool = threadPool;
+}
+
+void DeepPolyWeightedSumElement::setSinglePrecision( bool singlePrecision )
+{
+    _singlePrecisionWeights.clear();
+    _absoluteSinglePrecisionWeights.clear();
+    _maxAbsoluteWeight.clear();
+    if ( !singlePrecision )
+        return;
+
+    // Store the dense weight matrices whose entries fit in single precision
+    for ( const auto &pair : _layer->getSourceLayers() )
+    {
+        unsigned predecessorIndex = pair.first;
+        if ( _layer->hasSparseWeights( predecessorIndex ) ||
+             _layer->hasConvolution( predecessorIndex ) )
+            continue;
+
+        const double *weights = _layer->getWeights( predecessorIndex );
+        unsigned matrixSize = pair.second * _size;
+        Vector<float> singlePrecisionWeights( matrixSize );
+        Vector<float> absoluteWeights( matrixSize );
+        double maxAbsoluteWeight = 0;
+        bool representable = true;
+        for ( unsigned i = 0; i < matrixSize && representable; ++i )
+        {
+            representable = FloatUtils::abs( weights[i] ) <= FLT_MAX;
+            singlePrecisionWeights[i] = (float)weights[i];
+            absoluteWeights[i] = std::fabs( singlePrecisionWeights[i] );
+            maxAbsoluteWeight = std::max( maxAbsoluteWeight, FloatUtils::abs( weights[i] ) );
+        }
+
+        if ( representable )
+        {
+            _singlePrecisionWeights[predecessorIndex] = singlePrecisionWeights;
+            _absoluteSinglePrecisionWeights[predecessorIndex] = absoluteWeights;
+            _maxAbsoluteWeight[predecessorIndex] = maxAbsoluteWeight;
+        }
+    }
+}
+
 void DeepPolyWeightedSumElement::execute(
     const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore )
 {
@@ -49,9 +96,88 @@ void DeepPolyWeightedSumElement::execute(
 
 void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
     const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore )
+{
+    unsigned numberOfBlocks = 1;
+    if ( _threadPool )
+    {
+        unsigned minimumBlockSize = GlobalConfiguration::DEEP_POLY_PARALLEL_MINIMUM_BLOCK_SIZE;
+        numberOfBlocks = std::min( _threadPool->getNumberOfThreads(),
+                                   ( _size + minimumBlockSize - 1 ) / minimumBlockSize );
+    }
+
+    if ( numberOfBlocks <= 1 )
+    {
+        // Back-substitute all neurons at once, in the shared working memory
+        BackSubstitution backSubstitution;
+        backSubstitution._begin = 0;
+        backSubstitution._size = _size;
+        backSubstitution._work1SymbolicLb = _work1SymbolicLb;
+        backSubstitution._work1SymbolicUb = _work1SymbolicUb;
+        backSubstitution._work2SymbolicLb = _work2SymbolicLb;
+        backSubstitution._work2SymbolicUb = _work2SymbolicUb;
+        backSubstitution._workSymbolicLowerBias = _workSymbolicLowerBias;
+        backSubstitution._workSymbolicUpperBias = _workSymbolicUpperBias;
+        backSubstitution._workLb = _workLb;
+        backSubstitution._workUb = _workUb;
+        computeBoundWithBackSubstitution( backSubstitution, deepPolyElementsBefore );
+        return;
+    }
+
+    /*
+      The bounds of each neuron of this layer are back-substituted
+      independently of the other neurons, so the neurons are partitioned
+      into blocks of consecutive neurons, and each block is back-substituted
+      by a thread of the pool, in its own working memory. The symbolic
+      bounds of a block in terms of an element of size n take n * blockSize
+      entries.
+    */
+    unsigned maxLayerSize = 0;
+    for ( const auto &pair : deepPolyElementsBefore )
+        maxLayerSize = std::max( maxLayerSize, pair.second->getSize() );
+
+    unsigned blockSize = ( _size + numberOfBlocks - 1 ) / numberOfBlocks;
+    numberOfBlocks = ( _size + blockSize - 1 ) / blockSize;
+    log( Stringf( "Back-substituting %u blocks of %u neurons in parallel...",
+                  numberOfBlocks,
+                  blockSize ) );
+    _threadPool->run( numberOfBlocks, [&]( unsigned block ) {
+        BackSubstitution backSubstitution;
+        backSubstitution._begin = block * blockSize;
+        backSubstitution._size = std::min( blockSize, _size - backSubstitution._begin );
+
+        unsigned matrixSize = maxLayerSize * backSubstitution._size;
+        Vector<double> memory( 4 * matrixSize + 4 * backSubstitution._size );
+        double *next = memory.data();
+        backSubstitution._work1SymbolicLb = next;
+        backSubstitution._work1SymbolicUb = ( next += matrixSize );
+        backSubstitution._work2SymbolicLb = ( next += matrixSize );
+        backSubstitution._work2SymbolicUb = ( next += matrixSize );
+        backSubstitution._workSymbolicLowerBias = ( next += matrixSize );
+        backSubstitution._workSymbolicUpperBias = ( next += backSubstitution._size );
+        backSubstitution._workLb = ( next += backSubstitution._size );
+        backSubstitution._workUb = ( next += backSubstitution._size );
+        computeBoundWithBackSubstitution( backSubstitution, deepPolyElementsBefore );
+    } );
+    log( "Back-substituting blocks in parallel - done" );
+}
+
+void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
+    BackSubstitution &backSubstitution,
+    const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore )
 {
     log( "Computing bounds with back substitution..." );
 
+    unsigned size = backSubstitution._size;
+    double *work1SymbolicLb = backSubstitution._work1SymbolicLb;
+    double *work1SymbolicUb = backSubstitution._work1SymbolicUb;
+    double *work2SymbolicLb = backSubstitution._work2SymbolicLb;
+    double *work2SymbolicUb = backSubstitution._work2SymbolicUb;
+    double *workSymbolicLowerBias = backSubstitution._workSymbolicLowerBias;
+    double *workSymbolicUpperBias = backSubstitution._workSymbolicUpperBias;
+    Set<unsigned> &residualLayerIndices = backSubstitution._residualLayerIndices;
+    Map<unsigned, Vector<double>> &residualLb = backSubstitution._residualLb;
+    Map<unsigned, Vector<double>> &residualUb = backSubstitution._residualUb;
+
     // Start with the symbolic upper-/lower- bounds of this layer with
     // respect to its immediate predecessor.
     Map<unsigned, unsigned> predecessorIndices = getPredecessorIndices();
@@ -61,9 +187,9 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
     ASSERT( numPredecessors > 0 );
     // # The invariant we are maintaining:
     // thisLayer <= ( residualUb * residualLayer for each residualLayer ) +
-    //                _work1SymbolicUb * currentElement + _workSymbolicUpperBias;
+    //                work1SymbolicUb * currentElement + workSymbolicUpperBias;
     // thisLayer >= ( residualLb * residualLayer for each residualLayer ) +
-    //                _work1SymbolicLb * currentElement + _workSymbolicLowerBias;
+    //                work1SymbolicLb * currentElement + workSymbolicLowerBias;
 
     unsigned predecessorIndex = 0;
     for ( const auto &pair : predecessorIndices )
@@ -72,12 +198,9 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
         if ( counter < numPredecessors - 1 )
         {
             log( Stringf( "Adding residual from layer %u...", predecessorIndex ) );
-            allocateMemoryForResidualsIfNeeded( predecessorIndex, pair.second );
-            const double *weights = _layer->getWeights( predecessorIndex );
-            memcpy(
-                _residualLb[predecessorIndex], weights, _size * pair.second * sizeof( double ) );
-            memcpy(
-                _residualUb[predecessorIndex], weights, _size * pair.second * sizeof( double ) );
+            allocateMemoryForResidualsIfNeeded( backSubstitution, predecessorIndex, pair.second );
+            copyWeights( predecessorIndex, backSubstitution, residualLb[predecessorIndex].data() );
+            copyWeights( predecessorIndex, backSubstitution, residualUb[predecessorIndex].data() );
             ++counter;
             log( Stringf( "Adding residual from layer %u - done", pair.first ) );
         }
@@ -85,30 +208,29 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
 
     log( Stringf( "Computing symbolic bounds with respect to layer %u...", predecessorIndex ) );
     DeepPolyElement *precedingElement = deepPolyElementsBefore[predecessorIndex];
-    unsigned sourceLayerSize = precedingElement->getSize();
 
-    const double *weights = _layer->getWeights( predecessorIndex );
-    memcpy( _work1SymbolicLb, weights, _size * sourceLayerSize * sizeof( double ) );
-    memcpy( _work1SymbolicUb, weights, _size * sourceLayerSize * sizeof( double ) );
+    copyWeights( predecessorIndex, backSubstitution, work1SymbolicLb );
+    copyWeights( predecessorIndex, backSubstitution, work1SymbolicUb );
 
-    double *bias = _layer->getBiases();
-    memcpy( _workSymbolicLowerBias, bias, _size * sizeof( double ) );
-    memcpy( _workSymbolicUpperBias, bias, _size * sizeof( double ) );
+    double *bias = _layer->getBiases() + backSubstitution._begin;
+    memcpy( workSymbolicLowerBias, bias, size * sizeof( double ) );
+    memcpy( workSymbolicUpperBias, bias, size * sizeof( double ) );
 
     DeepPolyElement *currentElement = precedingElement;
-    concretizeSymbolicBound( _work1SymbolicLb,
-                             _work1SymbolicUb,
-                             _workSymbolicLowerBias,
-                             _workSymbolicUpperBias,
+    concretizeSymbolicBound( backSubstitution,
+                             work1SymbolicLb,
+                             work1SymbolicUb,
+                             workSymbolicLowerBias,
+                             workSymbolicUpperBias,
                              currentElement,
                              deepPolyElementsBefore );
     log( Stringf( "Computing symbolic bounds with respect to layer %u - done", predecessorIndex ) );
 
-    while ( currentElement->hasPredecessor() || !_residualLayerIndices.empty() )
+    while ( currentElement->hasPredecessor() || !residualLayerIndices.empty() )
     {
         // We have the symbolic bounds in terms of the current abstract
-        // element--currentElement, stored in _work1SymbolicLb,
-        // _work1SymbolicUb, _workSymbolicLowerBias, _workSymbolicLowerBias,
+        // element--currentElement, stored in work1SymbolicLb,
+        // work1SymbolicUb, workSymbolicLowerBias, workSymbolicLowerBias,
 
         if ( currentElement->hasPredecessor() )
         {
@@ -127,89 +249,89 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
                 {
                     unsigned predecessorIndex = pair.first;
                     log( Stringf( "Adding residual from layer %u...", predecessorIndex ) );
-                    allocateMemoryForResidualsIfNeeded( predecessorIndex, pair.second );
+                    allocateMemoryForResidualsIfNeeded(
+                        backSubstitution, predecessorIndex, pair.second );
                     // Do we need to add bias here?
                     currentElement->symbolicBoundInTermsOfPredecessor(
-                        _work1SymbolicLb,
-                        _work1SymbolicUb,
+                        work1SymbolicLb,
+                        work1SymbolicUb,
                         NULL,
                         NULL,
-                        _residualLb[predecessorIndex],
-                        _residualUb[predecessorIndex],
-                        _size,
+                        residualLb[predecessorIndex].data(),
+                        residualUb[predecessorIndex].data(),
+                        size,
                         precedingElement );
                     ++counter;
                     log( Stringf( "Adding residual from layer %u - done", pair.first ) );
                 }
             }
 
-            std::fill_n( _work2SymbolicLb, _size * precedingElement->getSize(), 0 );
-            std::fill_n( _work2SymbolicUb, _size * precedingElement->getSize(), 0 );
-            currentElement->symbolicBoundInTermsOfPredecessor( _work1SymbolicLb,
-                                                               _work1SymbolicUb,
-                                                               _workSymbolicLowerBias,
-                                                               _workSymbolicUpperBias,
-                                                               _work2SymbolicLb,
-                                                               _work2SymbolicUb,
-                                                               _size,
+            std::fill_n( work2SymbolicLb, size * precedingElement->getSize(), 0 );
+            std::fill_n( work2SymbolicUb, size * precedingElement->getSize(), 0 );
+            currentElement->symbolicBoundInTermsOfPredecessor( work1SymbolicLb,
+                                                               work1SymbolicUb,
+                                                               workSymbolicLowerBias,
+                                                               workSymbolicUpperBias,
+                                                               work2SymbolicLb,
+                                                               work2SymbolicUb,
+                                                               size,
                                                                precedingElement );
 
             // The symbolic lower-bound is
-            // _work2SymbolicLb * precedingElement + residualLb1 * residualElement1 +
+            // work2SymbolicLb * precedingElement + residualLb1 * residualElement1 +
             // residualLb2 * residualElement2 + ...
             // If the precedingElement is a residual source layer, we can merge
             // in the residualWeights, and remove it from the residual source layers.
-            if ( _residualLayerIndices.exists( predecessorIndex ) )
+            if ( residualLayerIndices.exists( predecessorIndex ) )
             {
                 log( Stringf( "merge residual from layer %u...", predecessorIndex ) );
                 // Add weights of this residual layer
-                for ( unsigned i = 0; i < _size * precedingElement->getSize(); ++i )
+                for ( unsigned i = 0; i < size * precedingElement->getSize(); ++i )
                 {
-                    _work2SymbolicLb[i] += _residualLb[predecessorIndex][i];
-                    _work2SymbolicUb[i] += _residualUb[predecessorIndex][i];
+                    work2SymbolicLb[i] += residualLb[predecessorIndex][i];
+                    work2SymbolicUb[i] += residualUb[predecessorIndex][i];
                 }
-                _residualLayerIndices.erase( predecessorIndex );
-                std::fill_n(
-                    _residualLb[predecessorIndex], _size * precedingElement->getSize(), 0 );
-                std::fill_n(
-                    _residualUb[predecessorIndex], _size * precedingElement->getSize(), 0 );
+                residualLayerIndices.erase( predecessorIndex );
+                std::fill_n( residualLb[predecessorIndex].data(),
+                             size * precedingElement->getSize(),
+                             0 );
+                std::fill_n( residualUb[predecessorIndex].data(),
+                             size * precedingElement->getSize(),
+                             0 );
                 log( Stringf( "merge residual from layer %u - done", predecessorIndex ) );
             }
 
-            double *temp = _work1SymbolicLb;
-            _work1SymbolicLb = _work2SymbolicLb;
-            _work2SymbolicLb = temp;
-
-            temp = _work1SymbolicUb;
-            _work1SymbolicUb = _work2SymbolicUb;
-            _work2SymbolicUb = temp;
+            std::swap( work1SymbolicLb, work2SymbolicLb );
+            std::swap( work1SymbolicUb, work2SymbolicUb );
 
             currentElement = precedingElement;
-            concretizeSymbolicBound( _work1SymbolicLb,
-                                     _work1SymbolicUb,
-                                     _workSymbolicLowerBias,
-                                     _workSymbolicUpperBias,
+            concretizeSymbolicBound( backSubstitution,
+                                     work1SymbolicLb,
+                                     work1SymbolicUb,
+                                     workSymbolicLowerBias,
+                                     workSymbolicUpperBias,
                                      currentElement,
                                      deepPolyElementsBefore );
         }
-        else if ( !_residualLayerIndices.empty() )
+        else if ( !residualLayerIndices.empty() )
         {
             // The current element has no predecessor (i.e., it has been pushed to the input layer
             // but there are still elements in the residual layers. In this case, we should swap
             // the first residual element with the current element.
 
             // Add the current element in the residual element
-            unsigned newCurrentIndex = *_residualLayerIndices.begin();
+            unsigned newCurrentIndex = *residualLayerIndices.begin();
             unsigned residualIndex = currentElement->getLayerIndex();
             log( Stringf( "Adding layer %u to the residual layer\n", residualIndex ).ascii() );
             ASSERT( residualIndex == 0 );
 
-            allocateMemoryForResidualsIfNeeded( residualIndex, currentElement->getSize() );
-            unsigned matrixSize = currentElement->getSize() * _size;
+            allocateMemoryForResidualsIfNeeded(
+                backSubstitution, residualIndex, currentElement->getSize() );
+            unsigned matrixSize = currentElement->getSize() * size;
             for ( unsigned i = 0; i < matrixSize; ++i )
             {
-                _residualLb[residualIndex][i] += _work1SymbolicLb[i];
-                _residualUb[residualIndex][i] += _work1SymbolicUb[i];
+                residualLb[residualIndex][i] += work1SymbolicLb[i];
+                residualUb[residualIndex][i] += work1SymbolicUb[i];
             }
 
             // Make the first residual element the current element and get ready for the next
@@ -218,23 +340,24 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
 
             currentElement = deepPolyElementsBefore[newCurrentIndex];
 
-            unsigned currentMatrixSize = currentElement->getSize() * _size;
-            memcpy( _work1SymbolicLb,
-                    _residualLb[newCurrentIndex],
+            unsigned currentMatrixSize = currentElement->getSize() * size;
+            memcpy( work1SymbolicLb,
+                    residualLb[newCurrentIndex].data(),
                     currentMatrixSize * sizeof( double ) );
-            memcpy( _work1SymbolicUb,
-                    _residualUb[newCurrentIndex],
+            memcpy( work1SymbolicUb,
+                    residualUb[newCurrentIndex].data(),
                     currentMatrixSize * sizeof( double ) );
-            _residualLayerIndices.erase( newCurrentIndex );
-            std::fill_n( _residualLb[newCurrentIndex], currentMatrixSize, 0 );
-            std::fill_n( _residualUb[newCurrentIndex], currentMatrixSize, 0 );
+            residualLayerIndices.erase( newCurrentIndex );
+            std::fill_n( residualLb[newCurrentIndex].data(), currentMatrixSize, 0 );
+            std::fill_n( residualUb[newCurrentIndex].data(), currentMatrixSize, 0 );
         }
     }
-    ASSERT( _residualLayerIndices.empty() );
+    ASSERT( residualLayerIndices.empty() );
     log( "Computing bounds with back substitution - done" );
 }
 
 void DeepPolyWeightedSumElement::concretizeSymbolicBound(
+    BackSubstitution &backSubstitution,
     const double *symbolicLb,
     const double *symbolicUb,
     double const *symbolicLowerBias,
@@ -243,28 +366,38 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBound(
     const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore )
 {
     log( "Concretizing bound..." );
-    std::fill_n( _workLb, _size, 0 );
-    std::fill_n( _workUb, _size, 0 );
-
-    concretizeSymbolicBoundForSourceLayer(
-        symbolicLb, symbolicUb, symbolicLowerBias, symbolicUpperBias, sourceElement );
-
-    for ( const auto &residualLayerIndex : _residualLayerIndices )
+    unsigned size = backSubstitution._size;
+    double *workLb = backSubstitution._workLb;
+    double *workUb = backSubstitution._workUb;
+    std::fill_n( workLb, size, 0 );
+    std::fill_n( workUb, size, 0 );
+
+    concretizeSymbolicBoundForSourceLayer( backSubstitution,
+                                           symbolicLb,
+                                           symbolicUb,
+                                           symbolicLowerBias,
+                                           symbolicUpperBias,
+                                           sourceElement );
+
+    for ( const auto &residualLayerIndex : backSubstitution._residualLayerIndices )
     {
         DeepPolyElement *residualElement = deepPolyElementsBefore[residualLayerIndex];
-        concretizeSymbolicBoundForSourceLayer( _residualLb[residualLayerIndex],
-                                               _residualUb[residualLayerIndex],
-                                               NULL,
-                                               NULL,
-                                               residualElement );
+        concretizeSymbolicBoundForSourceLayer(
+            backSubstitution,
+            backSubstitution._residualLb[residualLayerIndex].data(),
+            backSubstitution._residualUb[residualLayerIndex].data(),
+            NULL,
+            NULL,
+            residualElement );
     }
-    for ( unsigned i = 0; i < _size; ++i )
+    for ( unsigned j = 0; j < size; ++j )
     {
-        if ( _lb[i] < _workLb[i] )
-            _lb[i] = _workLb[i];
-        if ( _ub[i] > _workUb[i] )
-            _ub[i] = _workUb[i];
-        log( Stringf( "Neuron%u working LB: %f, UB: %f", i, _workLb[i], _workUb[i] ) );
+        unsigned i = backSubstitution._begin + j;
+        if ( _lb[i] < workLb[j] )
+            _lb[i] = workLb[j];
+        if ( _ub[i] > workUb[j] )
+            _ub[i] = workUb[j];
+        log( Stringf( "Neuron%u working LB: %f, UB: %f", i, workLb[j], workUb[j] ) );
         log( Stringf( "Neuron%u LB: %f, UB: %f", i, _lb[i], _ub[i] ) );
     }
 
@@ -272,6 +405,7 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBound(
 }
 
 void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer(
+    BackSubstitution &backSubstitution,
     const double *symbolicLb,
     const double *symbolicUb,
     const double *symbolicLowerBias,
@@ -324,6 +458,9 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer(
     */
 
     // Get concrete bounds
+    unsigned size = backSubstitution._size;
+    double *workLb = backSubstitution._workLb;
+    double *workUb = backSubstitution._workUb;
     for ( unsigned i = 0; i < sourceElement->getSize(); ++i )
     {
         double sourceLb = sourceElement->getLowerBoundFromLayer( i ) -
@@ -337,42 +474,41 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer(
                       sourceLb,
                       sourceUb ) );
 
-        for ( unsigned j = 0; j < _size; ++j )
+        for ( unsigned j = 0; j < size; ++j )
         {
             // Compute lower bound
-            double weight = symbolicLb[i * _size + j];
+            double weight = symbolicLb[i * size + j];
             if ( weight >= 0 )
             {
-                _workLb[j] += ( weight * sourceLb );
+                workLb[j] += ( weight * sourceLb );
             }
             else
             {
-                _workLb[j] += ( weight * sourceUb );
+                workLb[j] += ( weight * sourceUb );
             }
 
             // Compute upper bound
-            weight = symbolicUb[i * _size + j];
+            weight = symbolicUb[i * size + j];
             if ( weight >= 0 )
             {
-                _workUb[j] += ( weight * sourceUb );
+                workUb[j] += ( weight * sourceUb );
             }
             else
             {
-                _workUb[j] += ( weight * sourceLb );
+                workUb[j] += ( weight * sourceLb );
             }
         }
     }
 
-    for ( unsigned i = 0; i < _size; ++i )
+    for ( unsigned i = 0; i < size; ++i )
     {
         if ( symbolicLowerBias )
-            _workLb[i] += symbolicLowerBias[i];
+            workLb[i] += symbolicLowerBias[i];
         if ( symbolicUpperBias )
-            _workUb[i] += symbolicUpperBias[i];
+            workUb[i] += symbolicUpperBias[i];
     }
 }
 
-
 void DeepPolyWeightedSumElement::symbolicBoundInTermsOfPredecessor(
     const double *symbolicLb,
     const double *symbolicUb,
@@ -387,23 +523,50 @@ void DeepPolyWeightedSumElement::symbolicBoundInTermsOfPredecessor(
     log( Stringf( "Computing symbolic bounds with respect to layer %u...", predecessorIndex ) );
     unsigned predecessorSize = predecessor->getSize();
 
-    double *weights = _layer->getWeights( predecessorIndex );
     double *biases = _layer->getBiases();
 
     // newSymbolicLb = weights * symbolicLb
     // newSymbolicUb = weights * symbolicUb
-    matrixMultiplication( weights,
-                          symbolicLb,
-                          symbolicLbInTermsOfPredecessor,
-                          predecessorSize,
-                          _size,
-                          targetLayerSize );
-    matrixMultiplication( weights,
-                          symbolicUb,
-                          symbolicUbInTermsOfPredecessor,
-                          predecessorSize,
-                          _size,
-                          targetLayerSize );
+    if ( _layer->hasSparseWeights( predecessorIndex ) )
+    {
+        const SparseWeightMatrix *weights = _layer->getSparseWeights( predecessorIndex );
+        weights->multiplyFromRight( symbolicLb, symbolicLbInTermsOfPredecessor, targetLayerSize );
+        weights->multiplyFromRight( symbolicUb, symbolicUbInTermsOfPredecessor, targetLayerSize );
+    }
+    else if ( _layer->hasConvolution( predecessorIndex ) )
+    {
+        // A transposed convolution of each column of the symbolic bounds
+        const Convolution *convolution = _layer->getConvolution( predecessorIndex );
+        convolution->multiplyFromRight(
+            symbolicLb, symbolicLbInTermsOfPredecessor, targetLayerSize );
+        convolution->multiplyFromRight(
+            symbolicUb, symbolicUbInTermsOfPredecessor, targetLayerSize );
+    }
+    else if ( !_singlePrecisionWeights.exists( predecessorIndex ) || !symbolicLowerBias ||
+              !symbolicUpperBias ||
+              !multiplyInSinglePrecision( symbolicLb,
+                                          symbolicUb,
+                                          symbolicLowerBias,
+                                          symbolicUpperBias,
+                                          symbolicLbInTermsOfPredecessor,
+                                          symbolicUbInTermsOfPredecessor,
+                                          targetLayerSize,
+                                          predecessor ) )
+    {
+        double *weights = _layer->getWeights( predecessorIndex );
+        matrixMultiplication( weights,
+                              symbolicLb,
+                              symbolicLbInTermsOfPredecessor,
+                              predecessorSize,
+                              _size,
+                              targetLayerSize );
+        matrixMultiplication( weights,
+                              symbolicUb,
+                              symbolicUbInTermsOfPredecessor,
+                              predecessorSize,
+                              _size,
+                              targetLayerSize );
+    }
 
     // symbolicLowerBias = biases * symbolicLb
     // symbolicUpperBias = biases * symbolicUb
@@ -414,23 +577,149 @@ void DeepPolyWeightedSumElement::symbolicBoundInTermsOfPredecessor(
     log( Stringf( "Computing symbolic bounds with respect to layer %u - done", predecessorIndex ) );
 }
 
-void DeepPolyWeightedSumElement::allocateMemoryForResidualsIfNeeded( unsigned residualLayerIndex,
-                                                                     unsigned residualLayerSize )
+bool DeepPolyWeightedSumElement::multiplyInSinglePrecision(
+    const double *symbolicLb,
+    const double *symbolicUb,
+    double *symbolicLowerBias,
+    double *symbolicUpperBias,
+    double *symbolicLbInTermsOfPredecessor,
+    double *symbolicUbInTermsOfPredecessor,
+    unsigned targetLayerSize,
+    DeepPolyElement *predecessor ) const
 {
-    _residualLayerIndices.insert( residualLayerIndex );
-    unsigned matrixSize = residualLayerSize * _size;
-    if ( !_residualLb.exists( residualLayerIndex ) )
+    unsigned predecessorIndex = predecessor->getLayerIndex();
+    unsigned predecessorSize = predecessor->getSize();
+    unsigned matrixSize = _size * targetLayerSize;
+
+    // Round the symbolic bounds to single precision
+    Vector<float> lb( matrixSize );
+    Vector<float> ub( matrixSize );
+    Vector<float> absoluteLb( matrixSize );
+    Vector<float> absoluteUb( matrixSize );
+    double maxAbsoluteValue = 0;
+    for ( unsigned i = 0; i < matrixSize; ++i )
+    {
+        maxAbsoluteValue = std::max(
+            maxAbsoluteValue,
+            std::max( FloatUtils::abs( symbolicLb[i] ), FloatUtils::abs( symbolicUb[i] ) ) );
+        lb[i] = (float)symbolicLb[i];
+        ub[i] = (float)symbolicUb[i];
+        absoluteLb[i] = std::fabs( lb[i] );
+        absoluteUb[i] = std::fabs( ub[i] );
+    }
+
+    // Multiply in double precision if a product might overflow, or if the
+    // bounds are not finite
+    double maxAbsoluteWeight = _maxAbsoluteWeight[predecessorIndex];
+    if ( !( _size * maxAbsoluteWeight * maxAbsoluteValue < FLT_MAX / 2 ) )
+        return false;
+
+    unsigned resultSize = predecessorSize * targetLayerSize;
+    Vector<float> productLb( resultSize, 0 );
+    Vector<float> productUb( resultSize, 0 );
+    Vector<float> absoluteProductLb( resultSize, 0 );
+    Vector<float> absoluteProductUb( resultSize, 0 );
+    const float *weights = _singlePrecisionWeights[predecessorIndex].data();
+    const float *absoluteWeights = _absoluteSinglePrecisionWeights[predecessorIndex].data();
+    matrixMultiplication(
+        weights, lb.data(), productLb.data(), predecessorSize, _size, targetLayerSize );
+    matrixMultiplication(
+        weights, ub.data(), productUb.data(), predecessorSize, _size, targetLayerSize );
+    matrixMultiplication( absoluteWeights,
+                          absoluteLb.data(),
+                          absoluteProductLb.data(),
+                          predecessorSize,
+                          _size,
+                          targetLayerSize );
+    matrixMultiplication( absoluteWeights,
+                          absoluteUb.data(),
+                          absoluteProductUb.data(),
+                          predecessorSize,
+                          _size,
+                          targetLayerSize );
+
+    /*
+      Bound the error of each coefficient. With u the unit roundoff and n
+      the inner dimension, rounding the factors to single precision changes
+      each product w * s by at most ( 2u + u^2 ) |w| |s|, and summing n
+      products in single precision adds at most gamma_n = nu / ( 1 - nu )
+      times the sum of their magnitudes, which is the product of the
+      absolute values, itself computed with a relative error of at most
+      gamma_n. Numbers below FLT_MIN lose their relative precision, which
+      is covered by an absolute error of FLT_MIN per operation.
+
+      An error e in the coefficient of a neuron x with |x| <= m is covered
+      by subtracting |e| * m from the lower bias and adding it to the upper
+      bias.
+    */
+    double unitRoundoff = std::ldexp( 1.0, -24 );
+    double gamma = _size * unitRoundoff / ( 1 - _size * unitRoundoff );
+    double roundingError = ( 2 * unitRoundoff + unitRoundoff * unitRoundoff ) /
+                           ( ( 1 - unitRoundoff ) * ( 1 - unitRoundoff ) );
+    double relativeError = ( gamma + roundingError ) / ( 1 - gamma );
+    double absoluteError = ( _size + 2 ) * FLT_MIN * ( maxAbsoluteWeight + maxAbsoluteValue + 2 );
+
+    for ( unsigned i = 0; i < predecessorSize; ++i )
     {
-        double *residualLb = new double[matrixSize];
-        std::fill_n( residualLb, matrixSize, 0 );
-        _residualLb[residualLayerIndex] = residualLb;
+        double magnitude = std::max( FloatUtils::abs( predecessor->getLowerBound( i ) ),
+                                     FloatUtils::abs( predecessor->getUpperBound( i ) ) );
+        for ( unsigned j = 0; j < targetLayerSize; ++j )
+        {
+            unsigned entry = i * targetLayerSize + j;
+            symbolicLbInTermsOfPredecessor[entry] += productLb[entry];
+            symbolicUbInTermsOfPredecessor[entry] += productUb[entry];
+            symbolicLowerBias[j] -=
+                ( relativeError * absoluteProductLb[entry] + absoluteError ) * magnitude;
+            symbolicUpperBias[j] +=
+                ( relativeError * absoluteProductUb[entry] + absoluteError ) * magnitude;
+        }
     }
-    if ( !_residualUb.exists( residualLayerIndex ) )
+    return true;
+}
+
+void DeepPolyWeightedSumElement::copyWeights( unsigned predecessorIndex,
+                                              const BackSubstitution &backSubstitution,
+                                              double *result ) const
+{
+    if ( backSubstitution._begin == 0 && backSubstitution._size == _size )
     {
-        double *residualUb = new double[matrixSize];
-        std::fill_n( residualUb, matrixSize, 0 );
-        _residualUb[residualLayerIndex] = residualUb;
+        copyWeights( predecessorIndex, result );
+        return;
     }
+
+    // Keep the columns of the neurons of the block
+    unsigned predecessorSize = _layer->getSourceLayers()[predecessorIndex];
+    Vector<double> weights( predecessorSize * _size );
+    copyWeights( predecessorIndex, weights.data() );
+    for ( unsigned i = 0; i < predecessorSize; ++i )
+        memcpy( result + i * backSubstitution._size,
+                weights.data() + i * _size + backSubstitution._begin,
+                backSubstitution._size * sizeof( double ) );
+}
+
+void DeepPolyWeightedSumElement::copyWeights( unsigned predecessorIndex, double *result ) const
+{
+    if ( _layer->hasSparseWeights( predecessorIndex ) )
+        _layer->getSparseWeights( predecessorIndex )->toDense( result );
+    else if ( _layer->hasConvolution( predecessorIndex ) )
+        _layer->getConvolution( predecessorIndex )->toDense( result );
+    else
+        memcpy( result,
+                _layer->getWeights( predecessorIndex ),
+                _size * _layer->getSourceLayers()[predecessorIndex] * sizeof( double ) );
+}
+
+void DeepPolyWeightedSumElement::allocateMemoryForResidualsIfNeeded(
+    BackSubstitution &backSubstitution,
+    unsigned residualLayerIndex,
+    unsigned residualLayerSize ) const
+{
+    backSubstitution._residualLayerIndices.insert( residualLayerIndex );
+    unsigned matrixSize = residualLayerSize * backSubstitution._size;
+    if ( !backSubstitution._residualLb.exists( residualLayerIndex ) )
+        backSubstitution._residualLb[residualLayerIndex] = Vector<double>( matrixSize, 0 );
+    if ( !backSubstitution._residualUb.exists( residualLayerIndex ) )
+        backSubstitution._residualUb[residualLayerIndex] = Vector<double>( matrixSize, 0 );
 }
 
 void DeepPolyWeightedSumElement::allocateMemory()
@@ -459,17 +748,6 @@ void DeepPolyWeightedSumElement::freeMemoryIfNeeded()
         delete[] _workUb;
         _workUb = NULL;
     }
-    for ( auto const &pair : _residualLb )
-    {
-        delete[] pair.second;
-    }
-    _residualLb.clear();
-    for ( auto const &pair : _residualUb )
-    {
-        delete[] pair.second;
-    }
-    _residualUb.clear();
-    _residualLayerIndices.clear();
 }
 
 void DeepPolyWeightedSumElement::log( const String &message )
@@ -20,6 +20,8 @@
 #include "Layer.h"
 #include "MStringf.h"
 #include "NLRError.h"
+#include "ThreadPool.h"
+#include "Vector.h"
 
 #include <climits>
 
@@ -41,6 +43,19 @@ public:
                                             unsigned targetLayerSize,
                                             DeepPolyElement *predecessor );
 
+    /*
+      If a thread pool is set, the neurons of this layer are partitioned
+      into blocks that are back-substituted in parallel on the pool
+    */
+    void setThreadPool( ThreadPool *threadPool );
+
+    /*
+      If set, the symbolic bounds are multiplied by the dense weights of
+      this layer in single precision, and a bound on the rounding error is
+      added to the symbolic biases, so that the bounds stay sound
+    */
+    void setSinglePrecision( bool singlePrecision );
+
 private:
     /*
       Memory allocated to store concrete bounds computed at different stages
@@ -49,9 +64,56 @@ private:
     double *_workLb;
     double *_workUb;
 
-    Set<unsigned> _residualLayerIndices;
-    Map<unsigned, double *> _residualLb;
-    Map<unsigned, double *> _residualUb;
+    ThreadPool *_threadPool;
+
+    /*
+      The dense weights from each predecessor rounded to single precision,
+      their absolute values, and the largest absolute weight, if single
+      precision is used
+    */
+    Map<unsigned, Vector<float>> _singlePrecisionWeights;
+    Map<unsigned, Vector<float>> _absoluteSinglePrecisionWeights;
+    Map<unsigned, double> _maxAbsoluteWeight;
+
+    /*
+      Compute the symbolic bounds in terms of the predecessor in single
+      precision, with the rounding error added to the biases. Returns false,
+      without changing anything, if the values are too large for single
+      precision.
+    */
+    bool multiplyInSinglePrecision( const double *symbolicLb,
+                                    const double *symbolicUb,
+                                    double *symbolicLowerBias,
+                                    double *symbolicUpperBias,
+                                    double *symbolicLbInTermsOfPredecessor,
+                                    double *symbolicUbInTermsOfPredecessor,
+                                    unsigned targetLayerSize,
+                                    DeepPolyElement *predecessor ) const;
+
+    /*
+      The back-substitution of a block of consecutive neurons of this
+      layer, starting at _begin: the symbolic bounds of the block in terms
+      of the current element and of each residual layer, stored as
+      [sourceNeuron * _size + neuron], and the working memory for them
+    */
+    struct BackSubstitution
+    {
+        unsigned _begin;
+        unsigned _size;
+
+        double *_work1SymbolicLb;
+        double *_work1SymbolicUb;
+        double *_work2SymbolicLb;
+        double *_work2SymbolicUb;
+        double *_workSymbolicLowerBias;
+        double *_workSymbolicUpperBias;
+        double *_workLb;
+        double *_workUb;
+
+        Set<unsigned> _residualLayerIndices;
+        Map<unsigned, Vector<double>> _residualLb;
+        Map<unsigned, Vector<double>> _residualUb;
+    };
 
     /*
       Compute the concrete upper- and lower- bounds of this layer by concretizing
@@ -59,26 +121,41 @@ private:
     */
     void computeBoundWithBackSubstitution(
         const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore );
+    void computeBoundWithBackSubstitution(
+        BackSubstitution &backSubstitution,
+        const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore );
 
     /*
       Compute concrete bounds using symbolic bounds with respect to a
       sourceElement.
     */
-    void concretizeSymbolicBound( const double *symbolicLb,
+    void concretizeSymbolicBound( BackSubstitution &backSubstitution,
+                                  const double *symbolicLb,
                                   const double *symbolicUb,
                                   const double *symbolicLowerBias,
                                   const double *symbolicUpperBias,
                                   DeepPolyElement *sourceElement,
                                   const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore );
 
-    void concretizeSymbolicBoundForSourceLayer( const double *symbolicLb,
+    void concretizeSymbolicBoundForSourceLayer( BackSubstitution &backSubstitution,
+                                                const double *symbolicLb,
                                                 const double *symbolicUb,
                                                 const double *symbolicLowerBias,
                                                 const double *symbolicUpperBias,
                                                 DeepPolyElement *sourceElement );
 
-    void allocateMemoryForResidualsIfNeeded( unsigned residualLayerIndex,
-                                             unsigned residualLayerSize );
+    /*
+      Store the dense weights from the given predecessor in the result, or
+      only the columns of the neurons of a block
+    */
+    void copyWeights( unsigned predecessorIndex, double *result ) const;
+    void copyWeights( unsigned predecessorIndex,
+                      const BackSubstitution &backSubstitution,
+                      double *result ) const;
+
+    void allocateMemoryForResidualsIfNeeded( BackSubstitution &backSubstitution,
+                                             unsigned residualLayerIndex,
+                                             unsigned residualLayerSize ) const;
     void allocateMemory();
     void freeMemoryIfNeeded();
     void log( const String &message );
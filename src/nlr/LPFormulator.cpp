@@ -430,8 +430,8 @@ void LPFormulator::optimizeBoundsOfNeuronsWithLpRlaxation( ThreadArgument &args,
 
     // declare simulations as local var to avoid a problem which can happen due to multi thread
     // process.
-    const Vector<Vector<double>> *simulations =
-        _layerOwner->getLayer( targetIndex )->getSimulations();
+    const double *simulations = _layerOwner->getLayer( targetIndex )->getSimulations();
+    unsigned numberOfSimulations = _layerOwner->getLayer( targetIndex )->getNumberOfSimulations();
 
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
@@ -448,8 +448,9 @@ void LPFormulator::optimizeBoundsOfNeuronsWithLpRlaxation( ThreadArgument &args,
         skipTightenUb = false;
 
         // Loop for simulation
-        for ( const auto &simValue : ( *simulations ).get( i ) )
+        for ( unsigned j = 0; j < numberOfSimulations; ++j )
         {
+            double simValue = simulations[j * layer->getSize() + i];
             if ( _cutoffInUse && _cutoffValue < simValue ) // If x_lower < 0 < x_sim, do not try to
                                                            // call tightning upper bound.
                 skipTightenUb = true;
@@ -686,6 +687,7 @@ void LPFormulator::addLayerToModel( GurobiWrapper &gurobi,
         break;
 
     case Layer::WEIGHTED_SUM:
+    case Layer::CONV:
         addWeightedSumLayerToLpRelaxation( gurobi, layer, createVariables );
         break;
 
@@ -37,8 +37,9 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
     , _type( type )
     , _size( size )
     , _layerOwner( layerOwner )
-    , _bias( NULL )
+    , _bias( nullptr )
     , _assignment( NULL )
+    , _numberOfSimulations( 0 )
     , _lb( NULL )
     , _ub( NULL )
     , _inputLayerSize( 0 )
@@ -56,10 +57,10 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
 
 void Layer::allocateMemory()
 {
-    if ( _type == WEIGHTED_SUM )
+    if ( _type == WEIGHTED_SUM || _type == CONV )
     {
-        _bias = new double[_size];
-        std::fill_n( _bias, _size, 0 );
+        _bias = allocateSharedArray( _size );
+        std::fill_n( _bias.get(), _size, 0 );
     }
 
     _lb = new double[_size];
@@ -70,19 +71,12 @@ void Layer::allocateMemory()
 
     _assignment = new double[_size];
 
-    _simulations.assign(
-        _size, Vector<double>( Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS ) ) );
-
     _inputLayerSize = ( _type == INPUT ) ? _size : _layerOwner->getLayer( 0 )->getSize();
     if ( Options::get()->getSymbolicBoundTighteningType() ==
          SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING )
     {
-        _symbolicLb = new double[_size * _inputLayerSize];
-        _symbolicUb = new double[_size * _inputLayerSize];
-
-        std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
-        std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
-
+        // The symbolic bounds themselves are only allocated while symbolic
+        // bound tightening needs them
         _symbolicLowerBias = new double[_size];
         _symbolicUpperBias = new double[_size];
 
@@ -101,6 +95,35 @@ void Layer::allocateMemory()
     }
 }
 
+void Layer::allocateSymbolicBounds()
+{
+    if ( _symbolicLb )
+        return;
+
+    _symbolicLb = new double[_size * _inputLayerSize];
+    _symbolicUb = new double[_size * _inputLayerSize];
+}
+
+void Layer::freeSymbolicBounds()
+{
+    if ( _symbolicLb )
+    {
+        delete[] _symbolicLb;
+        _symbolicLb = NULL;
+    }
+
+    if ( _symbolicUb )
+    {
+        delete[] _symbolicUb;
+        _symbolicUb = NULL;
+    }
+}
+
+unsigned long long Layer::getSymbolicBoundsMemory() const
+{
+    return _symbolicLb ? 2ULL * _size * _inputLayerSize * sizeof( double ) : 0;
+}
+
 void Layer::setAssignment( const double *values )
 {
     ASSERT( _eliminatedNeurons.empty() );
@@ -117,24 +140,45 @@ double Layer::getAssignment( unsigned neuron ) const
     return _assignment[neuron];
 }
 
-void Layer::setSimulations( const Vector<Vector<double>> *values )
+void Layer::setSimulations( const double *values, unsigned numberOfSamples )
+{
+    resizeSimulations( numberOfSamples );
+    memcpy( _simulations.data(), values, sizeof( double ) * _size * numberOfSamples );
+}
+
+const double *Layer::getSimulations() const
+{
+    return _simulations.data();
+}
+
+double Layer::getSimulation( unsigned neuron, unsigned sample ) const
+{
+    ASSERT( neuron < _size && sample < _numberOfSimulations );
+    return _simulations.get( sample * _size + neuron );
+}
+
+unsigned Layer::getNumberOfSimulations() const
 {
-    _simulations = *values;
+    return _numberOfSimulations;
 }
 
-const Vector<Vector<double>> *Layer::getSimulations() const
+void Layer::resizeSimulations( unsigned numberOfSamples )
 {
-    return &_simulations;
+    if ( _numberOfSimulations == numberOfSamples )
+        return;
+
+    _numberOfSimulations = numberOfSamples;
+    _simulations.assign( _size * numberOfSamples, 0 );
 }
 
 void Layer::computeAssignment()
 {
     ASSERT( _type != INPUT );
 
-    if ( _type == WEIGHTED_SUM )
+    if ( _type == WEIGHTED_SUM || _type == CONV )
     {
         // Initialize to bias
-        memcpy( _assignment, _bias, sizeof( double ) * _size );
+        memcpy( _assignment, _bias.get(), sizeof( double ) * _size );
 
         // Process each of the source layers
         for ( auto &sourceLayerEntry : _sourceLayers )
@@ -142,8 +186,22 @@ void Layer::computeAssignment()
             const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
             const double *sourceAssignment = sourceLayer->getAssignment();
             unsigned sourceSize = sourceLayerEntry.second;
-            const double *weights = _layerToWeights[sourceLayerEntry.first];
 
+            if ( _layerToSparseWeights.exists( sourceLayerEntry.first ) )
+            {
+                _layerToSparseWeights[sourceLayerEntry.first]->multiplyFromLeft(
+                    sourceAssignment, _assignment, 1 );
+                continue;
+            }
+
+            if ( _layerToConvolution.exists( sourceLayerEntry.first ) )
+            {
+                _layerToConvolution[sourceLayerEntry.first]->multiplyFromLeft(
+                    sourceAssignment, _assignment, 1 );
+                continue;
+            }
+
+            const double *weights = _layerToWeights[sourceLayerEntry.first].get();
             for ( unsigned i = 0; i < sourceSize; ++i )
                 for ( unsigned j = 0; j < _size; ++j )
                     _assignment[j] += ( sourceAssignment[i] * weights[i * _size + j] );
@@ -292,111 +350,170 @@ void Layer::computeAssignment()
 void Layer::computeSimulations()
 {
     ASSERT( _type != INPUT );
+    ASSERT( !_sourceLayers.empty() );
 
-    unsigned simulationSize = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
-    if ( _type == WEIGHTED_SUM )
+    // All the layers hold the same number of samples as the input layer
+    unsigned numberOfSamples =
+        _layerOwner->getLayer( _sourceLayers.begin()->first )->getNumberOfSimulations();
+    resizeSimulations( numberOfSamples );
+
+    Map<unsigned, const double *> layerValues;
+    for ( const auto &sourceLayerEntry : _sourceLayers )
+        layerValues[sourceLayerEntry.first] =
+            _layerOwner->getLayer( sourceLayerEntry.first )->getSimulations();
+
+    computeBatch( layerValues, numberOfSamples, _simulations.data() );
+}
+
+void Layer::computeBatch( const Map<unsigned, const double *> &layerValues,
+                          unsigned numberOfSamples,
+                          double *values ) const
+{
+    ASSERT( _type != INPUT );
+
+    // The value of a source neuron for a sample
+    auto sourceValue = [&]( const NeuronIndex &source, unsigned sample ) {
+        unsigned sourceSize = _layerOwner->getLayer( source._layer )->getSize();
+        return layerValues[source._layer][sample * sourceSize + source._neuron];
+    };
+
+    if ( _type == WEIGHTED_SUM || _type == CONV )
     {
-        // Process each of the source layers
-        for ( auto &sourceLayerEntry : _sourceLayers )
-        {
-            const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
-            const Vector<Vector<double>> *sourceSimulations = sourceLayer->getSimulations();
+        // Start from the biases, and add the contribution of each source
+        // layer as one matrix product: (samples x source size) times
+        // (source size x size)
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
+            memcpy( values + j * _size, _bias.get(), sizeof( double ) * _size );
 
-            unsigned sourceSize = sourceLayerEntry.second;
-            const double *weights = _layerToWeights[sourceLayerEntry.first];
+        for ( const auto &sourceLayerEntry : _sourceLayers )
+        {
+            if ( _layerToSparseWeights.exists( sourceLayerEntry.first ) )
+            {
+                _layerToSparseWeights[sourceLayerEntry.first]->multiplyFromLeft(
+                    layerValues[sourceLayerEntry.first], values, numberOfSamples );
+                continue;
+            }
 
-            for ( unsigned i = 0; i < _size; i++ )
+            if ( _layerToConvolution.exists( sourceLayerEntry.first ) )
             {
-                for ( unsigned j = 0; j < simulationSize; ++j )
-                    _simulations[i][j] = _bias[i];
+                _layerToConvolution[sourceLayerEntry.first]->multiplyFromLeft(
+                    layerValues[sourceLayerEntry.first], values, numberOfSamples );
+                continue;
             }
 
-            for ( unsigned i = 0; i < sourceSize; ++i )
-                for ( unsigned j = 0; j < simulationSize; ++j )
-                    for ( unsigned k = 0; k < _size; ++k )
-                        _simulations[k][j] +=
-                            ( ( *sourceSimulations ).get( i ).get( j ) * weights[i * _size + k] );
+            matrixMultiplication( layerValues[sourceLayerEntry.first],
+                                  _layerToWeights[sourceLayerEntry.first].get(),
+                                  values,
+                                  numberOfSamples,
+                                  sourceLayerEntry.second,
+                                  _size );
         }
     }
-    else if ( _type == RELU )
+    else if ( _type == RELU || _type == ROUND || _type == LEAKY_RELU ||
+              _type == ABSOLUTE_VALUE || _type == SIGN || _type == SIGMOID )
     {
+        // Each neuron has a single source neuron. Copy the sources of each
+        // sample into its row, and then apply the activation to the row.
+        Vector<const double *> sources( _size );
+        Vector<unsigned> sourceSizes( _size );
         for ( unsigned i = 0; i < _size; ++i )
         {
             NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations =
-                ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) )
-                    .get( sourceIndex._neuron );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = FloatUtils::max( simulations.get( j ), 0 );
+            sources[i] = layerValues[sourceIndex._layer] + sourceIndex._neuron;
+            sourceSizes[i] = _layerOwner->getLayer( sourceIndex._layer )->getSize();
         }
-    }
-    else if ( _type == LEAKY_RELU )
-    {
-        for ( unsigned i = 0; i < _size; ++i )
-        {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations =
-                ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) )
-                    .get( sourceIndex._neuron );
-            ASSERT( _alpha > 0 && _alpha < 1 );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] =
-                    FloatUtils::max( simulations.get( j ), _alpha * simulations.get( j ) );
-        }
-    }
-    else if ( _type == ABSOLUTE_VALUE )
-    {
-        for ( unsigned i = 0; i < _size; ++i )
+
+        ASSERT( _type != LEAKY_RELU || ( _alpha > 0 && _alpha < 1 ) );
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
         {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations =
-                ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) )
-                    .get( sourceIndex._neuron );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = FloatUtils::abs( simulations.get( j ) );
+            double *row = values + j * _size;
+            for ( unsigned i = 0; i < _size; ++i )
+                row[i] = sources[i][j * sourceSizes[i]];
+
+            if ( _type == RELU )
+            {
+                for ( unsigned i = 0; i < _size; ++i )
+                    row[i] = row[i] > 0 ? row[i] : 0;
+            }
+            else if ( _type == ROUND )
+            {
+                for ( unsigned i = 0; i < _size; ++i )
+                    row[i] = FloatUtils::round( row[i] );
+            }
+            else if ( _type == LEAKY_RELU )
+            {
+                for ( unsigned i = 0; i < _size; ++i )
+                    row[i] = row[i] > 0 ? row[i] : _alpha * row[i];
+            }
+            else if ( _type == ABSOLUTE_VALUE )
+            {
+                for ( unsigned i = 0; i < _size; ++i )
+                    row[i] = std::fabs( row[i] );
+            }
+            else if ( _type == SIGN )
+            {
+                for ( unsigned i = 0; i < _size; ++i )
+                    row[i] = FloatUtils::isNegative( row[i] ) ? -1 : 1;
+            }
+            else
+            {
+                for ( unsigned i = 0; i < _size; ++i )
+                    row[i] = 1 / ( 1 + std::exp( -row[i] ) );
+            }
         }
     }
     else if ( _type == MAX )
     {
-        for ( unsigned i = 0; i < _size; ++i )
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
         {
-            for ( unsigned j = 0; j < simulationSize; ++j )
+            double *row = values + j * _size;
+            for ( unsigned i = 0; i < _size; ++i )
             {
-                _simulations[i][j] = FloatUtils::negativeInfinity();
-
+                row[i] = FloatUtils::negativeInfinity();
                 for ( const auto &input : _neuronToActivationSources[i] )
                 {
-                    // double value = ( *( _layerOwner->getLayer( input._layer )->getSimulations() )
-                    // )[input._neuron][j];
-                    double value = ( *( _layerOwner->getLayer( input._layer )->getSimulations() ) )
-                                       .get( input._neuron )
-                                       .get( j );
-                    if ( value > _simulations[i][j] )
-                        _simulations[i][j] = value;
+                    double value = sourceValue( input, j );
+                    if ( value > row[i] )
+                        row[i] = value;
                 }
             }
         }
     }
-    else if ( _type == SIGN )
+    else if ( _type == SOFTMAX )
     {
-        for ( unsigned i = 0; i < _size; ++i )
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
         {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations =
-                ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) ).get( i );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = FloatUtils::isNegative( simulations.get( j ) ) ? -1 : 1;
+            double *row = values + j * _size;
+            for ( unsigned i = 0; i < _size; ++i )
+            {
+                Vector<double> inputs;
+                Vector<double> outputs;
+                unsigned outputIndex = 0;
+                unsigned index = 0;
+                for ( const auto &input : _neuronToActivationSources[i] )
+                {
+                    if ( input._neuron == i )
+                        outputIndex = index;
+                    inputs.append( sourceValue( input, j ) );
+                    ++index;
+                }
+
+                SoftmaxConstraint::softmax( inputs, outputs );
+                row[i] = outputs[outputIndex];
+            }
         }
     }
-    else if ( _type == SIGMOID )
+    else if ( _type == BILINEAR )
     {
-        for ( unsigned i = 0; i < _size; ++i )
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
         {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations =
-                ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) ).get( i );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = 1 / ( 1 + std::exp( -simulations.get( j ) ) );
+            double *row = values + j * _size;
+            for ( unsigned i = 0; i < _size; ++i )
+            {
+                row[i] = 1;
+                for ( const auto &input : _neuronToActivationSources[i] )
+                    row[i] *= sourceValue( input, j );
+            }
         }
     }
     else
@@ -410,8 +527,8 @@ void Layer::computeSimulations()
     // prevail.
     for ( const auto &eliminated : _eliminatedNeurons )
     {
-        for ( unsigned j = 0; j < simulationSize; ++j )
-            _simulations[eliminated.first][j] = eliminated.second;
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
+            values[j * _size + eliminated.first] = eliminated.second;
     }
 }
 
@@ -426,13 +543,13 @@ void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize )
 
     if ( _type == WEIGHTED_SUM )
     {
-        _layerToWeights[layerNumber] = new double[layerSize * _size];
-        _layerToPositiveWeights[layerNumber] = new double[layerSize * _size];
-        _layerToNegativeWeights[layerNumber] = new double[layerSize * _size];
+        _layerToWeights[layerNumber] = allocateSharedArray( layerSize * _size );
+        _layerToPositiveWeights[layerNumber] = allocateSharedArray( layerSize * _size );
+        _layerToNegativeWeights[layerNumber] = allocateSharedArray( layerSize * _size );
 
-        std::fill_n( _layerToWeights[layerNumber], layerSize * _size, 0 );
-        std::fill_n( _layerToPositiveWeights[layerNumber], layerSize * _size, 0 );
-        std::fill_n( _layerToNegativeWeights[layerNumber], layerSize * _size, 0 );
+        std::fill_n( _layerToWeights[layerNumber].get(), layerSize * _size, 0 );
+        std::fill_n( _layerToPositiveWeights[layerNumber].get(), layerSize * _size, 0 );
+        std::fill_n( _layerToNegativeWeights[layerNumber].get(), layerSize * _size, 0 );
     }
 }
 
@@ -454,18 +571,28 @@ const Set<unsigned> &Layer::getSuccessorLayers() const
 const double *Layer::getWeightMatrix( unsigned sourceLayer ) const
 {
     ASSERT( _layerToWeights.exists( sourceLayer ) );
-    return _layerToWeights[sourceLayer];
+    ASSERT( !_layerToSparseWeights.exists( sourceLayer ) );
+    return _layerToWeights[sourceLayer].get();
 }
 
 void Layer::removeSourceLayer( unsigned sourceLayer )
 {
     ASSERT( _sourceLayers.exists( sourceLayer ) );
 
-    delete[] _layerToWeights[sourceLayer];
-    delete[] _layerToPositiveWeights[sourceLayer];
-    delete[] _layerToNegativeWeights[sourceLayer];
-
     _sourceLayers.erase( sourceLayer );
+
+    if ( _layerToSparseWeights.exists( sourceLayer ) )
+    {
+        _layerToSparseWeights.erase( sourceLayer );
+        return;
+    }
+
+    if ( _layerToConvolution.exists( sourceLayer ) )
+    {
+        _layerToConvolution.erase( sourceLayer );
+        return;
+    }
+
     _layerToWeights.erase( sourceLayer );
     _layerToPositiveWeights.erase( sourceLayer );
     _layerToNegativeWeights.erase( sourceLayer );
@@ -476,6 +603,16 @@ void Layer::setWeight( unsigned sourceLayer,
                        unsigned targetNeuron,
                        double weight )
 {
+    ASSERT( !_layerToConvolution.exists( sourceLayer ) );
+
+    if ( _layerToSparseWeights.exists( sourceLayer ) )
+        densifyWeights( sourceLayer );
+
+    unsigned sourceLayerSize = _sourceLayers[sourceLayer];
+    detachSharedArray( _layerToWeights[sourceLayer], sourceLayerSize * _size );
+    detachSharedArray( _layerToPositiveWeights[sourceLayer], sourceLayerSize * _size );
+    detachSharedArray( _layerToNegativeWeights[sourceLayer], sourceLayerSize * _size );
+
     unsigned index = sourceNeuron * _size + targetNeuron;
     _layerToWeights[sourceLayer][index] = weight;
 
@@ -493,27 +630,116 @@ void Layer::setWeight( unsigned sourceLayer,
 
 double Layer::getWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron ) const
 {
+    if ( _layerToSparseWeights.exists( sourceLayer ) )
+        return _layerToSparseWeights[sourceLayer]->get( sourceNeuron, targetNeuron );
+
+    if ( _layerToConvolution.exists( sourceLayer ) )
+        return _layerToConvolution[sourceLayer]->get( sourceNeuron, targetNeuron );
+
     unsigned index = sourceNeuron * _size + targetNeuron;
     return _layerToWeights[sourceLayer][index];
 }
 
 double *Layer::getWeights( unsigned sourceLayerIndex ) const
 {
-    return _layerToWeights[sourceLayerIndex];
+    ASSERT( !_layerToSparseWeights.exists( sourceLayerIndex ) );
+    return _layerToWeights[sourceLayerIndex].get();
 }
 
 double *Layer::getPositiveWeights( unsigned sourceLayerIndex ) const
 {
-    return _layerToPositiveWeights[sourceLayerIndex];
+    ASSERT( !_layerToSparseWeights.exists( sourceLayerIndex ) );
+    return _layerToPositiveWeights[sourceLayerIndex].get();
 }
 
 double *Layer::getNegativeWeights( unsigned sourceLayerIndex ) const
 {
-    return _layerToNegativeWeights[sourceLayerIndex];
+    ASSERT( !_layerToSparseWeights.exists( sourceLayerIndex ) );
+    return _layerToNegativeWeights[sourceLayerIndex].get();
+}
+
+void Layer::sparsifyWeights( double maximumDensity )
+{
+    if ( _type != WEIGHTED_SUM )
+        return;
+
+    for ( const auto &sourceLayerEntry : _sourceLayers )
+    {
+        unsigned sourceLayer = sourceLayerEntry.first;
+        unsigned sourceLayerSize = sourceLayerEntry.second;
+        if ( _layerToSparseWeights.exists( sourceLayer ) )
+            continue;
+
+        const double *weights = _layerToWeights[sourceLayer].get();
+        if ( SparseWeightMatrix::density( weights, sourceLayerSize, _size ) > maximumDensity )
+            continue;
+
+        _layerToSparseWeights[sourceLayer] =
+            std::make_shared<const SparseWeightMatrix>( weights, sourceLayerSize, _size );
+        _layerToWeights.erase( sourceLayer );
+        _layerToPositiveWeights.erase( sourceLayer );
+        _layerToNegativeWeights.erase( sourceLayer );
+    }
+}
+
+bool Layer::hasSparseWeights( unsigned sourceLayerIndex ) const
+{
+    return _layerToSparseWeights.exists( sourceLayerIndex );
+}
+
+const SparseWeightMatrix *Layer::getSparseWeights( unsigned sourceLayerIndex ) const
+{
+    ASSERT( _layerToSparseWeights.exists( sourceLayerIndex ) );
+    return _layerToSparseWeights[sourceLayerIndex].get();
+}
+
+void Layer::setConvolution( unsigned sourceLayer, std::shared_ptr<const Convolution> convolution )
+{
+    ASSERT( _type == CONV );
+    ASSERT( _sourceLayers.exists( sourceLayer ) && _sourceLayers.size() == 1 );
+    ASSERT( convolution->getNumberOfRows() == _sourceLayers[sourceLayer] );
+    ASSERT( convolution->getNumberOfColumns() == _size );
+
+    _layerToConvolution[sourceLayer] = convolution;
+}
+
+bool Layer::hasConvolution( unsigned sourceLayerIndex ) const
+{
+    return _layerToConvolution.exists( sourceLayerIndex );
+}
+
+const Convolution *Layer::getConvolution( unsigned sourceLayerIndex ) const
+{
+    ASSERT( _layerToConvolution.exists( sourceLayerIndex ) );
+    return _layerToConvolution[sourceLayerIndex].get();
+}
+
+void Layer::densifyWeights( unsigned sourceLayer )
+{
+    unsigned sourceLayerSize = _sourceLayers[sourceLayer];
+    unsigned matrixSize = sourceLayerSize * _size;
+
+    _layerToWeights[sourceLayer] = allocateSharedArray( matrixSize );
+    _layerToPositiveWeights[sourceLayer] = allocateSharedArray( matrixSize );
+    _layerToNegativeWeights[sourceLayer] = allocateSharedArray( matrixSize );
+
+    double *weights = _layerToWeights[sourceLayer].get();
+    double *positiveWeights = _layerToPositiveWeights[sourceLayer].get();
+    double *negativeWeights = _layerToNegativeWeights[sourceLayer].get();
+
+    _layerToSparseWeights[sourceLayer]->toDense( weights );
+    for ( unsigned i = 0; i < matrixSize; ++i )
+    {
+        positiveWeights[i] = weights[i] > 0 ? weights[i] : 0;
+        negativeWeights[i] = weights[i] > 0 ? 0 : weights[i];
+    }
+
+    _layerToSparseWeights.erase( sourceLayer );
 }
 
 void Layer::setBias( unsigned neuron, double bias )
 {
+    detachSharedArray( _bias, _size );
     _bias[neuron] = bias;
 }
 
@@ -524,7 +750,7 @@ double Layer::getBias( unsigned neuron ) const
 
 double *Layer::getBiases() const
 {
-    return _bias;
+    return _bias.get();
 }
 
 void Layer::addActivationSource( unsigned sourceLayer,
@@ -653,6 +879,7 @@ void Layer::computeIntervalArithmeticBounds()
     switch ( _type )
     {
     case WEIGHTED_SUM:
+    case CONV:
         computeIntervalArithmeticBoundsForWeightedSum();
         break;
 
@@ -693,8 +920,55 @@ void Layer::computeIntervalArithmeticBoundsForWeightedSum()
         unsigned sourceLayerIndex = sourceLayerEntry.first;
         unsigned sourceLayerSize = sourceLayerEntry.second;
         const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerIndex );
-        const double *weights = _layerToWeights[sourceLayerIndex];
 
+        if ( _layerToSparseWeights.exists( sourceLayerIndex ) )
+        {
+            // Go over the non-zero weights only, one source neuron at a time
+            const SparseWeightMatrix *sparseWeights = _layerToSparseWeights[sourceLayerIndex].get();
+            const unsigned *rowStarts = sparseWeights->getRowStarts();
+            const unsigned *columnIndices = sparseWeights->getColumnIndices();
+            const double *values = sparseWeights->getValues();
+
+            for ( unsigned j = 0; j < sourceLayerSize; ++j )
+            {
+                double previousLb = sourceLayer->getLb( j );
+                double previousUb = sourceLayer->getUb( j );
+                for ( unsigned k = rowStarts[j]; k < rowStarts[j + 1]; ++k )
+                {
+                    unsigned i = columnIndices[k];
+                    double weight = values[k];
+
+                    if ( weight > 0 )
+                    {
+                        newLb[i] += weight * previousLb;
+                        newUb[i] += weight * previousUb;
+                    }
+                    else
+                    {
+                        newLb[i] += weight * previousUb;
+                        newUb[i] += weight * previousLb;
+                    }
+                }
+            }
+            continue;
+        }
+
+        if ( _layerToConvolution.exists( sourceLayerIndex ) )
+        {
+            // newLb = lb * posWeights + ub * negWeights, and vice versa
+            const Convolution *convolution = _layerToConvolution[sourceLayerIndex].get();
+            convolution->multiplyFromLeft(
+                sourceLayer->getLbs(), newLb, 1, SparseWeightMatrix::POSITIVE_ENTRIES );
+            convolution->multiplyFromLeft(
+                sourceLayer->getUbs(), newLb, 1, SparseWeightMatrix::NEGATIVE_ENTRIES );
+            convolution->multiplyFromLeft(
+                sourceLayer->getUbs(), newUb, 1, SparseWeightMatrix::POSITIVE_ENTRIES );
+            convolution->multiplyFromLeft(
+                sourceLayer->getLbs(), newUb, 1, SparseWeightMatrix::NEGATIVE_ENTRIES );
+            continue;
+        }
+
+        const double *weights = _layerToWeights[sourceLayerIndex].get();
         for ( unsigned i = 0; i < _size; ++i )
         {
             for ( unsigned j = 0; j < sourceLayerSize; ++j )
@@ -867,6 +1141,8 @@ void Layer::computeIntervalArithmeticBoundsForSign()
 
 void Layer::computeSymbolicBounds()
 {
+    allocateSymbolicBounds();
+
     switch ( _type )
     {
     case INPUT:
@@ -874,6 +1150,7 @@ void Layer::computeSymbolicBounds()
         break;
 
     case WEIGHTED_SUM:
+    case CONV:
         computeSymbolicBoundsForWeightedSum();
         break;
 
@@ -1489,30 +1766,73 @@ void Layer::computeSymbolicBoundsForWeightedSum()
           newLB = oldUB * negWeights + oldLB * posWeights
         */
 
-        matrixMultiplication( sourceLayer->getSymbolicUb(),
-                              _layerToPositiveWeights[sourceLayerIndex],
-                              _symbolicUb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(),
-                              _layerToNegativeWeights[sourceLayerIndex],
-                              _symbolicUb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(),
-                              _layerToPositiveWeights[sourceLayerIndex],
-                              _symbolicLb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        matrixMultiplication( sourceLayer->getSymbolicUb(),
-                              _layerToNegativeWeights[sourceLayerIndex],
-                              _symbolicLb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
+        if ( _layerToSparseWeights.exists( sourceLayerIndex ) )
+        {
+            const SparseWeightMatrix *sparseWeights = _layerToSparseWeights[sourceLayerIndex].get();
+            sparseWeights->multiplyFromLeft( sourceLayer->getSymbolicUb(),
+                                             _symbolicUb,
+                                             _inputLayerSize,
+                                             SparseWeightMatrix::POSITIVE_ENTRIES );
+            sparseWeights->multiplyFromLeft( sourceLayer->getSymbolicLb(),
+                                             _symbolicUb,
+                                             _inputLayerSize,
+                                             SparseWeightMatrix::NEGATIVE_ENTRIES );
+            sparseWeights->multiplyFromLeft( sourceLayer->getSymbolicLb(),
+                                             _symbolicLb,
+                                             _inputLayerSize,
+                                             SparseWeightMatrix::POSITIVE_ENTRIES );
+            sparseWeights->multiplyFromLeft( sourceLayer->getSymbolicUb(),
+                                             _symbolicLb,
+                                             _inputLayerSize,
+                                             SparseWeightMatrix::NEGATIVE_ENTRIES );
+        }
+        else if ( _layerToConvolution.exists( sourceLayerIndex ) )
+        {
+            const Convolution *convolution = _layerToConvolution[sourceLayerIndex].get();
+            convolution->multiplyFromLeft( sourceLayer->getSymbolicUb(),
+                                           _symbolicUb,
+                                           _inputLayerSize,
+                                           SparseWeightMatrix::POSITIVE_ENTRIES );
+            convolution->multiplyFromLeft( sourceLayer->getSymbolicLb(),
+                                           _symbolicUb,
+                                           _inputLayerSize,
+                                           SparseWeightMatrix::NEGATIVE_ENTRIES );
+            convolution->multiplyFromLeft( sourceLayer->getSymbolicLb(),
+                                           _symbolicLb,
+                                           _inputLayerSize,
+                                           SparseWeightMatrix::POSITIVE_ENTRIES );
+            convolution->multiplyFromLeft( sourceLayer->getSymbolicUb(),
+                                           _symbolicLb,
+                                           _inputLayerSize,
+                                           SparseWeightMatrix::NEGATIVE_ENTRIES );
+        }
+        else
+        {
+            matrixMultiplication( sourceLayer->getSymbolicUb(),
+                                  _layerToPositiveWeights[sourceLayerIndex].get(),
+                                  _symbolicUb,
+                                  _inputLayerSize,
+                                  sourceLayerSize,
+                                  _size );
+            matrixMultiplication( sourceLayer->getSymbolicLb(),
+                                  _layerToNegativeWeights[sourceLayerIndex].get(),
+                                  _symbolicUb,
+                                  _inputLayerSize,
+                                  sourceLayerSize,
+                                  _size );
+            matrixMultiplication( sourceLayer->getSymbolicLb(),
+                                  _layerToPositiveWeights[sourceLayerIndex].get(),
+                                  _symbolicLb,
+                                  _inputLayerSize,
+                                  sourceLayerSize,
+                                  _size );
+            matrixMultiplication( sourceLayer->getSymbolicUb(),
+                                  _layerToNegativeWeights[sourceLayerIndex].get(),
+                                  _symbolicLb,
+                                  _inputLayerSize,
+                                  sourceLayerSize,
+                                  _size );
+        }
 
         // Restore the zero bound on eliminated neurons
         unsigned index;
@@ -1529,6 +1849,66 @@ void Layer::computeSymbolicBoundsForWeightedSum()
         /*
           Compute the biases for the new layer
         */
+        if ( _layerToSparseWeights.exists( sourceLayerIndex ) )
+        {
+            const SparseWeightMatrix *sparseWeights = _layerToSparseWeights[sourceLayerIndex].get();
+            const unsigned *rowStarts = sparseWeights->getRowStarts();
+            const unsigned *columnIndices = sparseWeights->getColumnIndices();
+            const double *values = sparseWeights->getValues();
+
+            for ( unsigned k = 0; k < sourceLayerSize; ++k )
+            {
+                for ( unsigned index = rowStarts[k]; index < rowStarts[k + 1]; ++index )
+                {
+                    unsigned j = columnIndices[index];
+                    double weight = values[index];
+                    if ( _eliminatedNeurons.exists( j ) )
+                        continue;
+
+                    if ( weight > 0 )
+                    {
+                        _symbolicLowerBias[j] += sourceLayer->getSymbolicLowerBias()[k] * weight;
+                        _symbolicUpperBias[j] += sourceLayer->getSymbolicUpperBias()[k] * weight;
+                    }
+                    else
+                    {
+                        _symbolicLowerBias[j] += sourceLayer->getSymbolicUpperBias()[k] * weight;
+                        _symbolicUpperBias[j] += sourceLayer->getSymbolicLowerBias()[k] * weight;
+                    }
+                }
+            }
+            continue;
+        }
+
+        if ( _layerToConvolution.exists( sourceLayerIndex ) )
+        {
+            const Convolution *convolution = _layerToConvolution[sourceLayerIndex].get();
+            convolution->multiplyFromLeft( sourceLayer->getSymbolicLowerBias(),
+                                           _symbolicLowerBias,
+                                           1,
+                                           SparseWeightMatrix::POSITIVE_ENTRIES );
+            convolution->multiplyFromLeft( sourceLayer->getSymbolicUpperBias(),
+                                           _symbolicLowerBias,
+                                           1,
+                                           SparseWeightMatrix::NEGATIVE_ENTRIES );
+            convolution->multiplyFromLeft( sourceLayer->getSymbolicUpperBias(),
+                                           _symbolicUpperBias,
+                                           1,
+                                           SparseWeightMatrix::POSITIVE_ENTRIES );
+            convolution->multiplyFromLeft( sourceLayer->getSymbolicLowerBias(),
+                                           _symbolicUpperBias,
+                                           1,
+                                           SparseWeightMatrix::NEGATIVE_ENTRIES );
+
+            // The eliminated neurons keep their fixed values
+            for ( const auto &eliminated : _eliminatedNeurons )
+            {
+                _symbolicLowerBias[eliminated.first] = eliminated.second;
+                _symbolicUpperBias[eliminated.first] = eliminated.second;
+            }
+            continue;
+        }
+
         for ( unsigned j = 0; j < _size; ++j )
         {
             if ( _eliminatedNeurons.exists( j ) )
@@ -1631,11 +2011,19 @@ void Layer::eliminateVariable( unsigned variable, double value )
     ASSERT( _type != INPUT );
 
     unsigned neuron = _variableToNeuron[variable];
+    _neuronToVariable.erase( neuron );
+    _variableToNeuron.erase( variable );
+    eliminateNeuron( neuron, value );
+}
+
+void Layer::eliminateNeuron( unsigned neuron, double value )
+{
+    ASSERT( _type != INPUT );
+    ASSERT( !_neuronToVariable.exists( neuron ) );
+
     _eliminatedNeurons[neuron] = value;
     _lb[neuron] = value;
     _ub[neuron] = value;
-    _neuronToVariable.erase( _variableToNeuron[variable] );
-    _variableToNeuron.erase( variable );
 }
 
 void Layer::updateVariableIndices( const Map<unsigned, unsigned> &oldIndexToNewIndex,
@@ -1690,8 +2078,9 @@ unsigned Layer::getLayerIndex() const
 }
 
 Layer::Layer( const Layer *other )
-    : _bias( NULL )
+    : _bias( nullptr )
     , _assignment( NULL )
+    , _numberOfSimulations( 0 )
     , _lb( NULL )
     , _ub( NULL )
     , _inputLayerSize( 0 )
@@ -1712,30 +2101,19 @@ Layer::Layer( const Layer *other )
 
     allocateMemory();
 
-    for ( auto &sourceLayerEntry : other->_sourceLayers )
-    {
-        addSourceLayer( sourceLayerEntry.first, sourceLayerEntry.second );
-
-        if ( other->_layerToWeights.exists( sourceLayerEntry.first ) )
-            memcpy( _layerToWeights[sourceLayerEntry.first],
-                    other->_layerToWeights[sourceLayerEntry.first],
-                    sizeof( double ) * sourceLayerEntry.second * _size );
-
-        if ( other->_layerToPositiveWeights.exists( sourceLayerEntry.first ) )
-            memcpy( _layerToPositiveWeights[sourceLayerEntry.first],
-                    other->_layerToPositiveWeights[sourceLayerEntry.first],
-                    sizeof( double ) * sourceLayerEntry.second * _size );
-
-        if ( other->_layerToNegativeWeights.exists( sourceLayerEntry.first ) )
-            memcpy( _layerToNegativeWeights[sourceLayerEntry.first],
-                    other->_layerToNegativeWeights[sourceLayerEntry.first],
-                    sizeof( double ) * sourceLayerEntry.second * _size );
-    }
+    // The weights and biases are shared with the other layer, and are
+    // only duplicated if one of the layers modifies them
+    _sourceLayers = other->_sourceLayers;
+    _layerToWeights = other->_layerToWeights;
+    _layerToPositiveWeights = other->_layerToPositiveWeights;
+    _layerToNegativeWeights = other->_layerToNegativeWeights;
+    _layerToSparseWeights = other->_layerToSparseWeights;
+    _layerToConvolution = other->_layerToConvolution;
 
     _successorLayers = other->_successorLayers;
 
     if ( other->_bias )
-        memcpy( _bias, other->_bias, sizeof( double ) * _size );
+        _bias = other->_bias;
 
     _neuronToActivationSources = other->_neuronToActivationSources;
 
@@ -1788,23 +2166,12 @@ double Layer::getSymbolicUbOfUb( unsigned neuron ) const
 
 void Layer::freeMemoryIfNeeded()
 {
-    for ( const auto &weights : _layerToWeights )
-        delete[] weights.second;
     _layerToWeights.clear();
-
-    for ( const auto &weights : _layerToPositiveWeights )
-        delete[] weights.second;
     _layerToPositiveWeights.clear();
-
-    for ( const auto &weights : _layerToNegativeWeights )
-        delete[] weights.second;
     _layerToNegativeWeights.clear();
-
-    if ( _bias )
-    {
-        delete[] _bias;
-        _bias = NULL;
-    }
+    _layerToSparseWeights.clear();
+    _layerToConvolution.clear();
+    _bias = nullptr;
 
     if ( _assignment )
     {
@@ -1824,17 +2191,7 @@ void Layer::freeMemoryIfNeeded()
         _ub = NULL;
     }
 
-    if ( _symbolicLb )
-    {
-        delete[] _symbolicLb;
-        _symbolicLb = NULL;
-    }
-
-    if ( _symbolicUb )
-    {
-        delete[] _symbolicUb;
-        _symbolicUb = NULL;
-    }
+    freeSymbolicBounds();
 
     if ( _symbolicLowerBias )
     {
@@ -1885,6 +2242,10 @@ String Layer::typeToString( Type type )
         return "WEIGHTED_SUM";
         break;
 
+    case CONV:
+        return "CONV";
+        break;
+
     case RELU:
         return "RELU";
         break;
@@ -1944,6 +2305,7 @@ void Layer::dump() const
         break;
 
     case WEIGHTED_SUM:
+    case CONV:
 
         for ( unsigned i = 0; i < _size; ++i )
         {
@@ -1959,7 +2321,7 @@ void Layer::dump() const
                 const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
                 for ( unsigned j = 0; j < sourceLayer->getSize(); ++j )
                 {
-                    double weight = _layerToWeights[sourceLayerEntry.first][j * _size + i];
+                    double weight = getWeight( sourceLayerEntry.first, j, i );
                     if ( !FloatUtils::isZero( weight ) )
                     {
                         if ( sourceLayer->_neuronToVariable.exists( j ) )
@@ -2056,6 +2418,8 @@ void Layer::reduceIndexFromAllMaps( unsigned startIndex )
     adjustWeightMapIndexing( _layerToWeights, startIndex );
     adjustWeightMapIndexing( _layerToPositiveWeights, startIndex );
     adjustWeightMapIndexing( _layerToNegativeWeights, startIndex );
+    adjustWeightMapIndexing( _layerToSparseWeights, startIndex );
+    adjustWeightMapIndexing( _layerToConvolution, startIndex );
 
     // Adjust the neuron activations
     for ( auto &neuronToSources : _neuronToActivationSources )
@@ -2068,9 +2432,10 @@ void Layer::reduceIndexFromAllMaps( unsigned startIndex )
     }
 }
 
-void Layer::adjustWeightMapIndexing( Map<unsigned, double *> &map, unsigned startIndex )
+template <typename T>
+void Layer::adjustWeightMapIndexing( Map<unsigned, T> &map, unsigned startIndex )
 {
-    Map<unsigned, double *> copyOfWeights = map;
+    Map<unsigned, T> copyOfWeights = map;
     map.clear();
     for ( const auto &pair : copyOfWeights )
         map[pair.first >= startIndex ? pair.first - 1 : pair.first] = pair.second;
@@ -2101,7 +2466,7 @@ bool Layer::operator==( const Layer &layer ) const
 
     if ( _bias && layer._bias )
     {
-        if ( std::memcmp( _bias, layer._bias, _size * sizeof( double ) ) != 0 )
+        if ( std::memcmp( _bias.get(), layer._bias.get(), _size * sizeof( double ) ) != 0 )
             return false;
     }
 
@@ -2117,11 +2482,17 @@ bool Layer::operator==( const Layer &layer ) const
     if ( !compareWeights( _layerToNegativeWeights, layer._layerToNegativeWeights ) )
         return false;
 
+    if ( !compareSparseWeights( _layerToSparseWeights, layer._layerToSparseWeights ) )
+        return false;
+
+    if ( !compareConvolutions( _layerToConvolution, layer._layerToConvolution ) )
+        return false;
+
     return true;
 }
 
-bool Layer::compareWeights( const Map<unsigned, double *> &map,
-                            const Map<unsigned, double *> &mapOfOtherLayer ) const
+bool Layer::compareWeights( const Map<unsigned, std::shared_ptr<double[]>> &map,
+                            const Map<unsigned, std::shared_ptr<double[]>> &mapOfOtherLayer ) const
 {
     if ( map.size() != mapOfOtherLayer.size() )
         return false;
@@ -2129,13 +2500,14 @@ bool Layer::compareWeights( const Map<unsigned, double *> &map,
     for ( const auto &pair : map )
     {
         unsigned key = pair.first;
-        double *value = pair.second;
+        const double *value = pair.second.get();
 
         if ( !mapOfOtherLayer.exists( key ) )
             return false;
 
-        if ( std::memcmp(
-                 value, mapOfOtherLayer[key], _size * _sourceLayers[key] * sizeof( double ) ) != 0 )
+        if ( std::memcmp( value,
+                          mapOfOtherLayer[key].get(),
+                          _size * _sourceLayers[key] * sizeof( double ) ) != 0 )
         {
             return false;
         }
@@ -2144,6 +2516,62 @@ bool Layer::compareWeights( const Map<unsigned, double *> &map,
     return true;
 }
 
+bool Layer::compareSparseWeights(
+    const Map<unsigned, std::shared_ptr<const SparseWeightMatrix>> &map,
+    const Map<unsigned, std::shared_ptr<const SparseWeightMatrix>> &mapOfOtherLayer ) const
+{
+    if ( map.size() != mapOfOtherLayer.size() )
+        return false;
+
+    for ( const auto &pair : map )
+    {
+        if ( !mapOfOtherLayer.exists( pair.first ) )
+            return false;
+
+        if ( !( *pair.second == *mapOfOtherLayer[pair.first] ) )
+            return false;
+    }
+
+    return true;
+}
+
+bool Layer::compareConvolutions(
+    const Map<unsigned, std::shared_ptr<const Convolution>> &map,
+    const Map<unsigned, std::shared_ptr<const Convolution>> &mapOfOtherLayer ) const
+{
+    if ( map.size() != mapOfOtherLayer.size() )
+        return false;
+
+    for ( const auto &pair : map )
+    {
+        if ( !mapOfOtherLayer.exists( pair.first ) )
+            return false;
+
+        if ( !( *pair.second == *mapOfOtherLayer[pair.first] ) )
+            return false;
+    }
+
+    return true;
+}
+
+std::shared_ptr<double[]> Layer::allocateSharedArray( unsigned size )
+{
+    std::shared_ptr<double[]> array( new double[size] );
+    if ( !array )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Layer::allocateSharedArray" );
+    return array;
+}
+
+void Layer::detachSharedArray( std::shared_ptr<double[]> &array, unsigned size )
+{
+    if ( array.use_count() <= 1 )
+        return;
+
+    std::shared_ptr<double[]> copy = allocateSharedArray( size );
+    memcpy( copy.get(), array.get(), sizeof( double ) * size );
+    array = copy;
+}
+
 unsigned Layer::getMaxVariable() const
 {
     unsigned result = 0;
@@ -17,6 +17,7 @@
 #define __Layer_h__
 
 #include "AbsoluteValueConstraint.h"
+#include "Convolution.h"
 #include "Debug.h"
 #include "FloatUtils.h"
 #include "LayerOwner.h"
@@ -27,8 +28,11 @@
 #include "ReluConstraint.h"
 #include "SigmoidConstraint.h"
 #include "SignConstraint.h"
+#include "SparseWeightMatrix.h"
 #include "Vector.h"
 
+#include <memory>
+
 namespace NLR {
 
 class Layer
@@ -38,6 +42,7 @@ public:
         // Linear layers
         INPUT = 0,
         WEIGHTED_SUM,
+        CONV,
 
         // Activation functions
         RELU,
@@ -81,6 +86,27 @@ public:
     double *getPositiveWeights( unsigned sourceLayerIndex ) const;
     double *getNegativeWeights( unsigned sourceLayerIndex ) const;
 
+    /*
+      Store the weights from each source layer with at most the given
+      fraction of non-zero weights as a sparse matrix, and release the
+      dense matrices. The dense accessors above (and getWeightMatrix) are
+      then unavailable for that source layer; setWeight restores the dense
+      matrices.
+    */
+    void sparsifyWeights( double maximumDensity );
+    bool hasSparseWeights( unsigned sourceLayerIndex ) const;
+    const SparseWeightMatrix *getSparseWeights( unsigned sourceLayerIndex ) const;
+
+    /*
+      A convolutional layer has a single source layer, and computes a
+      weighted sum of it given by a convolution rather than by a weight
+      matrix. getWeight is still available, and is computed from the
+      kernel.
+    */
+    void setConvolution( unsigned sourceLayer, std::shared_ptr<const Convolution> convolution );
+    bool hasConvolution( unsigned sourceLayerIndex ) const;
+    const Convolution *getConvolution( unsigned sourceLayerIndex ) const;
+
     void setBias( unsigned neuron, double bias );
     double getBias( unsigned neuron ) const;
     double *getBiases() const;
@@ -107,11 +133,25 @@ public:
     void computeAssignment();
 
     /*
-      Set/get the simulations, or compute it from source layers
+      Set/get the simulations, or compute them from source layers. The
+      simulations are stored contiguously, with one row of getSize()
+      values per sample.
     */
-    void setSimulations( const Vector<Vector<double>> *values );
+    void setSimulations( const double *values, unsigned numberOfSamples );
     void computeSimulations();
-    const Vector<Vector<double>> *getSimulations() const;
+    const double *getSimulations() const;
+    double getSimulation( unsigned neuron, unsigned sample ) const;
+    unsigned getNumberOfSimulations() const;
+
+    /*
+      Compute the values of the neurons for a batch of samples, from the
+      values of the source layers. The values of each layer are stored
+      contiguously, one row per sample. Does not modify the layer, so
+      separate batches can be computed concurrently.
+    */
+    void computeBatch( const Map<unsigned, const double *> &layerValues,
+                       unsigned numberOfSamples,
+                       double *values ) const;
 
     /*
       Bound related functionality: grab the current bounds from the
@@ -139,10 +179,20 @@ public:
     void computeSymbolicBounds();
     void computeIntervalArithmeticBounds();
 
+    /*
+      The symbolic bounds of the layer in terms of the input layer, which
+      symbolic bound tightening allocates before computing them and frees
+      once no later layer needs them. The memory is in bytes.
+    */
+    void allocateSymbolicBounds();
+    void freeSymbolicBounds();
+    unsigned long long getSymbolicBoundsMemory() const;
+
     /*
       Preprocessing functionality: variable elimination and reindexing
     */
     void eliminateVariable( unsigned variable, double value );
+    void eliminateNeuron( unsigned neuron, double value );
     void updateVariableIndices( const Map<unsigned, unsigned> &oldIndexToNewIndex,
                                 const Map<unsigned, unsigned> &mergedVariables );
     bool neuronEliminated( unsigned neuron ) const;
@@ -160,8 +210,14 @@ public:
     void dump() const;
     static String typeToString( Type type );
     bool operator==( const Layer &layer ) const;
-    bool compareWeights( const Map<unsigned, double *> &map,
-                         const Map<unsigned, double *> &mapOfOtherLayer ) const;
+    bool compareWeights( const Map<unsigned, std::shared_ptr<double[]>> &map,
+                         const Map<unsigned, std::shared_ptr<double[]>> &mapOfOtherLayer ) const;
+    bool compareSparseWeights(
+        const Map<unsigned, std::shared_ptr<const SparseWeightMatrix>> &map,
+        const Map<unsigned, std::shared_ptr<const SparseWeightMatrix>> &mapOfOtherLayer ) const;
+    bool compareConvolutions(
+        const Map<unsigned, std::shared_ptr<const Convolution>> &map,
+        const Map<unsigned, std::shared_ptr<const Convolution>> &mapOfOtherLayer ) const;
 
 private:
     unsigned _layerIndex;
@@ -172,14 +228,32 @@ private:
     Map<unsigned, unsigned> _sourceLayers;
     Set<unsigned> _successorLayers;
 
-    Map<unsigned, double *> _layerToWeights;
-    Map<unsigned, double *> _layerToPositiveWeights;
-    Map<unsigned, double *> _layerToNegativeWeights;
-    double *_bias;
+    /*
+      The weights and biases are shared between copies of the layer
+      (e.g., the copies held by the different DnC workers), and a
+      private copy is only made when a shared array is modified.
+    */
+    Map<unsigned, std::shared_ptr<double[]>> _layerToWeights;
+    Map<unsigned, std::shared_ptr<double[]>> _layerToPositiveWeights;
+    Map<unsigned, std::shared_ptr<double[]>> _layerToNegativeWeights;
+    std::shared_ptr<double[]> _bias;
+
+    /*
+      Source layers whose weights are stored sparsely, instead of in the
+      three maps above. A sparse matrix is never modified once built.
+    */
+    Map<unsigned, std::shared_ptr<const SparseWeightMatrix>> _layerToSparseWeights;
+
+    /*
+      The convolution from the source layer of a convolutional layer,
+      which has no weight matrices. Shared between copies of the layer.
+    */
+    Map<unsigned, std::shared_ptr<const Convolution>> _layerToConvolution;
 
     double *_assignment;
 
-    Vector<Vector<double>> _simulations;
+    Vector<double> _simulations;
+    unsigned _numberOfSimulations;
 
     double *_lb;
     double *_ub;
@@ -208,6 +282,16 @@ private:
     void allocateMemory();
     void freeMemoryIfNeeded();
 
+    /*
+      Make room for the simulations of the given number of samples
+    */
+    void resizeSimulations( unsigned numberOfSamples );
+
+    /*
+      Restore the dense weight matrices of a sparsely stored source layer
+    */
+    void densifyWeights( unsigned sourceLayer );
+
     /*
       Helper functions for symbolic bound tightening
     */
@@ -235,7 +319,14 @@ private:
     double getSymbolicLbOfUb( unsigned neuron ) const;
     double getSymbolicUbOfUb( unsigned neuron ) const;
 
-    void adjustWeightMapIndexing( Map<unsigned, double *> &map, unsigned indexToStart );
+    template <typename T>
+    static void adjustWeightMapIndexing( Map<unsigned, T> &map, unsigned indexToStart );
+
+    /*
+      Helpers for the copy-on-write weight and bias arrays
+    */
+    static std::shared_ptr<double[]> allocateSharedArray( unsigned size );
+    static void detachSharedArray( std::shared_ptr<double[]> &array, unsigned size );
 };
 
 } // namespace NLR
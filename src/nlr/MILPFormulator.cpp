@@ -308,8 +308,8 @@ void MILPFormulator::optimizeBoundsOfNeuronsWithMILPEncoding( ThreadArgument &ar
 
     // declare simulations as local var to avoid a problem which can happen due to multi thread
     // process.
-    const Vector<Vector<double>> *simulations =
-        _layerOwner->getLayer( targetIndex )->getSimulations();
+    const double *simulations = _layerOwner->getLayer( targetIndex )->getSimulations();
+    unsigned numberOfSimulations = _layerOwner->getLayer( targetIndex )->getNumberOfSimulations();
 
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
@@ -326,8 +326,9 @@ void MILPFormulator::optimizeBoundsOfNeuronsWithMILPEncoding( ThreadArgument &ar
         skipTightenUb = false;
 
         // Loop for simulation
-        for ( const auto &simValue : ( *simulations ).get( i ) )
+        for ( unsigned j = 0; j < numberOfSimulations; ++j )
         {
+            double simValue = simulations[j * layer->getSize() + i];
             if ( _cutoffInUse && _cutoffValue < simValue ) // If x_lower < 0 < x_sim, do not try to
                                                            // call tightning upper bound.
                 skipTightenUb = true;
@@ -614,6 +615,7 @@ void MILPFormulator::addLayerToModel( GurobiWrapper &gurobi,
     {
     case Layer::INPUT:
     case Layer::WEIGHTED_SUM:
+    case Layer::CONV:
         break;
 
     case Layer::RELU:
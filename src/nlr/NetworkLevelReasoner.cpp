@@ -18,6 +18,7 @@
 #include "AbsoluteValueConstraint.h"
 #include "Debug.h"
 #include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 #include "InfeasibleQueryException.h"
 #include "InputQuery.h"
 #include "IterativePropagator.h"
@@ -32,7 +33,11 @@
 #include "ReluConstraint.h"
 #include "SignConstraint.h"
 
+#include <algorithm>
 #include <cstring>
+#include <exception>
+#include <thread>
+#include <vector>
 
 #define NLR_LOG( x, ... ) LOG( GlobalConfiguration::NETWORK_LEVEL_REASONER_LOGGING, "NLR: %s\n", x )
 
@@ -41,6 +46,7 @@ namespace NLR {
 NetworkLevelReasoner::NetworkLevelReasoner()
     : _tableau( NULL )
     , _deepPolyAnalysis( nullptr )
+    , _peakSymbolicBoundMemory( 0 )
 {
 }
 
@@ -86,6 +92,12 @@ void NetworkLevelReasoner::computeSuccessorLayers()
     }
 }
 
+void NetworkLevelReasoner::sparsifyWeights( double maximumDensity )
+{
+    for ( const auto &pair : _layerIndexToLayer )
+        pair.second->sparsifyWeights( maximumDensity );
+}
+
 void NetworkLevelReasoner::setWeight( unsigned sourceLayer,
                                       unsigned sourceNeuron,
                                       unsigned targetLayer,
@@ -128,6 +140,74 @@ void NetworkLevelReasoner::evaluate( double *input, double *output )
     memcpy( output, outputLayer->getAssignment(), sizeof( double ) * outputLayer->getSize() );
 }
 
+void NetworkLevelReasoner::evaluateBatch( const double *inputs,
+                                          double *outputs,
+                                          unsigned numberOfSamples,
+                                          unsigned numberOfThreads ) const
+{
+    unsigned numberOfLayers = _layerIndexToLayer.size();
+    unsigned inputSize = _layerIndexToLayer[0]->getSize();
+    unsigned outputSize = _layerIndexToLayer[numberOfLayers - 1]->getSize();
+
+    // Evaluate the given range of samples, at most
+    // NLR_BATCH_EVALUATION_SIZE samples at a time, with buffers of its own
+    auto evaluateRange = [&]( unsigned start, unsigned end ) {
+        Vector<Vector<double>> values( numberOfLayers );
+        Map<unsigned, const double *> layerValues;
+        while ( start < end )
+        {
+            unsigned numberOfSamplesInBatch =
+                std::min( end - start, GlobalConfiguration::NLR_BATCH_EVALUATION_SIZE );
+            layerValues[0] = inputs + (size_t)start * inputSize;
+            for ( unsigned i = 1; i < numberOfLayers; ++i )
+            {
+                const Layer *layer = _layerIndexToLayer[i];
+                values[i].assign( numberOfSamplesInBatch * layer->getSize(), 0 );
+                layer->computeBatch( layerValues, numberOfSamplesInBatch, values[i].data() );
+                layerValues[i] = values[i].data();
+            }
+
+            memcpy( outputs + (size_t)start * outputSize,
+                    layerValues[numberOfLayers - 1],
+                    sizeof( double ) * numberOfSamplesInBatch * outputSize );
+            start += numberOfSamplesInBatch;
+        }
+    };
+
+    numberOfThreads = std::max( 1u, std::min( numberOfThreads, numberOfSamples ) );
+    if ( numberOfThreads == 1 )
+    {
+        evaluateRange( 0, numberOfSamples );
+        return;
+    }
+
+    // Each thread evaluates a contiguous range of samples. Errors are
+    // passed on to the calling thread.
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors( numberOfThreads );
+    unsigned samplesPerThread = ( numberOfSamples + numberOfThreads - 1 ) / numberOfThreads;
+    for ( unsigned i = 0; i * samplesPerThread < numberOfSamples; ++i )
+    {
+        threads.push_back( std::thread( [&, i]() {
+            try
+            {
+                evaluateRange( i * samplesPerThread,
+                               std::min( ( i + 1 ) * samplesPerThread, numberOfSamples ) );
+            }
+            catch ( ... )
+            {
+                errors[i] = std::current_exception();
+            }
+        } ) );
+    }
+    for ( auto &thread : threads )
+        thread.join();
+
+    for ( const auto &error : errors )
+        if ( error )
+            std::rethrow_exception( error );
+}
+
 void NetworkLevelReasoner::concretizeInputAssignment( Map<unsigned, double> &assignment )
 {
     Layer *inputLayer = _layerIndexToLayer[0];
@@ -170,9 +250,9 @@ void NetworkLevelReasoner::concretizeInputAssignment( Map<unsigned, double> &ass
     delete[] input;
 }
 
-void NetworkLevelReasoner::simulate( Vector<Vector<double>> *input )
+void NetworkLevelReasoner::simulate( const double *input, unsigned numberOfSamples )
 {
-    _layerIndexToLayer[0]->setSimulations( input );
+    _layerIndexToLayer[0]->setSimulations( input, numberOfSamples );
     for ( unsigned i = 1; i < _layerIndexToLayer.size(); ++i )
         _layerIndexToLayer[i]->computeSimulations();
 }
@@ -200,8 +280,44 @@ void NetworkLevelReasoner::clearConstraintTightenings()
 
 void NetworkLevelReasoner::symbolicBoundPropagation()
 {
-    for ( unsigned i = 0; i < _layerIndexToLayer.size(); ++i )
-        _layerIndexToLayer[i]->computeSymbolicBounds();
+    /*
+      The symbolic bounds of a layer are only needed until its last
+      successor has been processed, so only the layers between a layer and
+      its last successor are kept in memory.
+    */
+    unsigned numberOfLayers = _layerIndexToLayer.size();
+    Vector<unsigned> lastSuccessor( numberOfLayers );
+    for ( unsigned i = 0; i < numberOfLayers; ++i )
+    {
+        lastSuccessor[i] = i;
+        for ( const auto &sourceLayer : _layerIndexToLayer[i]->getSourceLayers() )
+            lastSuccessor[sourceLayer.first] = i;
+    }
+
+    unsigned long long memory = 0;
+    _peakSymbolicBoundMemory = 0;
+    for ( unsigned i = 0; i < numberOfLayers; ++i )
+    {
+        Layer *layer = _layerIndexToLayer[i];
+        layer->computeSymbolicBounds();
+        memory += layer->getSymbolicBoundsMemory();
+        if ( memory > _peakSymbolicBoundMemory )
+            _peakSymbolicBoundMemory = memory;
+
+        for ( unsigned j = 0; j <= i; ++j )
+        {
+            if ( lastSuccessor[j] <= i && _layerIndexToLayer[j]->getSymbolicBoundsMemory() > 0 )
+            {
+                memory -= _layerIndexToLayer[j]->getSymbolicBoundsMemory();
+                _layerIndexToLayer[j]->freeSymbolicBounds();
+            }
+        }
+    }
+}
+
+unsigned long long NetworkLevelReasoner::getPeakSymbolicBoundMemory() const
+{
+    return _peakSymbolicBoundMemory;
 }
 
 void NetworkLevelReasoner::deepPolyPropagation()
@@ -383,7 +499,8 @@ void NetworkLevelReasoner::removeConstraintFromTopologicalOrder(
 void NetworkLevelReasoner::encodeAffineLayers( InputQuery &inputQuery )
 {
     for ( const auto &pair : _layerIndexToLayer )
-        if ( pair.second->getLayerType() == Layer::WEIGHTED_SUM )
+        if ( pair.second->getLayerType() == Layer::WEIGHTED_SUM ||
+             pair.second->getLayerType() == Layer::CONV )
             generateInputQueryForWeightedSumLayer( inputQuery, pair.second );
 }
 
@@ -452,6 +569,7 @@ void NetworkLevelReasoner::generateInputQueryForLayer( InputQuery &inputQuery, c
         break;
 
     case Layer::WEIGHTED_SUM:
+    case Layer::CONV:
         generateInputQueryForWeightedSumLayer( inputQuery, layer );
         break;
 
@@ -61,6 +61,13 @@ public:
                               unsigned targetLeyer,
                               unsigned targetNeuron );
 
+    /*
+      Once the network is populated, store the weight matrices with at most
+      the given fraction of non-zero weights (e.g., those of convolutions)
+      in sparse form. See Layer::sparsifyWeights.
+    */
+    void sparsifyWeights( double maximumDensity );
+
     unsigned getNumberOfLayers() const;
     const Layer *getLayer( unsigned index ) const;
     Layer *getLayer( unsigned index );
@@ -75,6 +82,17 @@ public:
     */
     void evaluate( double *input, double *output );
 
+    /*
+      Evaluate the network on a batch of inputs. The inputs hold one row
+      of input values per sample, and the values of the output layer are
+      stored in the outputs in the same way. The samples are split among
+      the given number of threads.
+    */
+    void evaluateBatch( const double *inputs,
+                        double *outputs,
+                        unsigned numberOfSamples,
+                        unsigned numberOfThreads = 1 ) const;
+
     /*
       Perform an evaluation of the network for the current input variable
       assignment and store the resulting variable assignment in the assignment.
@@ -82,9 +100,10 @@ public:
     void concretizeInputAssignment( Map<unsigned, double> &assignment );
 
     /*
-      Perform a simulation of the network for a specific input
+      Perform a simulation of the network for a batch of inputs. The input
+      holds one row of input values per sample.
     */
-    void simulate( Vector<Vector<double>> *input );
+    void simulate( const double *input, unsigned numberOfSamples );
 
     /*
       Bound propagation methods:
@@ -194,6 +213,12 @@ public:
 
     const Map<unsigned, Layer *> &getLayerIndexToLayer() const;
 
+    /*
+      The peak memory, in bytes, of the symbolic bounds kept by the last
+      run of symbolic bound tightening
+    */
+    unsigned long long getPeakSymbolicBoundMemory() const;
+
 private:
     Map<unsigned, Layer *> _layerIndexToLayer;
     const ITableau *_tableau;
@@ -204,6 +229,10 @@ private:
 
     std::unique_ptr<DeepPolyAnalysis> _deepPolyAnalysis;
 
+    // The peak memory of the symbolic bounds, in bytes, in the last run of
+    // symbolic bound tightening
+    unsigned long long _peakSymbolicBoundMemory;
+
     void freeMemoryIfNeeded();
 
     List<PiecewiseLinearConstraint *> _constraintsInTopologicalOrder;
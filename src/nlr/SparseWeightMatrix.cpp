@@ -0,0 +1,180 @@
+/*********************                                                        */
+/*! \file SparseWeightMatrix.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "SparseWeightMatrix.h"
+
+#include "Debug.h"
+
+#include <algorithm>
+
+namespace NLR {
+
+SparseWeightMatrix::SparseWeightMatrix( const double *weights, unsigned rows, unsigned columns )
+    : _rows( rows )
+    , _columns( columns )
+{
+    // Count the non-zeros first, so that the arrays are allocated only once
+    unsigned nnz = 0;
+    for ( unsigned i = 0; i < rows * columns; ++i )
+        if ( weights[i] != 0 )
+            ++nnz;
+
+    _rowStarts.assign( rows + 1, 0 );
+    _columnIndices.assign( nnz, 0 );
+    _values.assign( nnz, 0 );
+
+    unsigned index = 0;
+    for ( unsigned i = 0; i < rows; ++i )
+    {
+        _rowStarts[i] = index;
+        for ( unsigned j = 0; j < columns; ++j )
+        {
+            double weight = weights[i * columns + j];
+            if ( weight != 0 )
+            {
+                _columnIndices[index] = j;
+                _values[index] = weight;
+                ++index;
+            }
+        }
+    }
+    _rowStarts[rows] = index;
+}
+
+double SparseWeightMatrix::density( const double *weights, unsigned rows, unsigned columns )
+{
+    if ( rows == 0 || columns == 0 )
+        return 0;
+
+    unsigned nnz = 0;
+    for ( unsigned i = 0; i < rows * columns; ++i )
+        if ( weights[i] != 0 )
+            ++nnz;
+
+    return (double)nnz / ( (double)rows * columns );
+}
+
+unsigned SparseWeightMatrix::getNumberOfRows() const
+{
+    return _rows;
+}
+
+unsigned SparseWeightMatrix::getNumberOfColumns() const
+{
+    return _columns;
+}
+
+unsigned SparseWeightMatrix::getNnz() const
+{
+    return _values.size();
+}
+
+double SparseWeightMatrix::get( unsigned row, unsigned column ) const
+{
+    ASSERT( row < _rows && column < _columns );
+
+    const unsigned *begin = _columnIndices.data() + _rowStarts[row];
+    const unsigned *end = _columnIndices.data() + _rowStarts[row + 1];
+    const unsigned *position = std::lower_bound( begin, end, column );
+    if ( position == end || *position != column )
+        return 0;
+
+    return _values[position - _columnIndices.data()];
+}
+
+const unsigned *SparseWeightMatrix::getRowStarts() const
+{
+    return _rowStarts.data();
+}
+
+const unsigned *SparseWeightMatrix::getColumnIndices() const
+{
+    return _columnIndices.data();
+}
+
+const double *SparseWeightMatrix::getValues() const
+{
+    return _values.data();
+}
+
+void SparseWeightMatrix::toDense( double *result ) const
+{
+    std::fill_n( result, _rows * _columns, 0 );
+    for ( unsigned i = 0; i < _rows; ++i )
+        for ( unsigned k = _rowStarts[i]; k < _rowStarts[i + 1]; ++k )
+            result[i * _columns + _columnIndices[k]] = _values[k];
+}
+
+void SparseWeightMatrix::multiplyFromLeft( const double *left,
+                                           double *result,
+                                           unsigned rowsOfLeft,
+                                           Entries entries ) const
+{
+    for ( unsigned r = 0; r < rowsOfLeft; ++r )
+    {
+        const double *leftRow = left + r * _rows;
+        double *resultRow = result + r * _columns;
+        for ( unsigned i = 0; i < _rows; ++i )
+        {
+            double coefficient = leftRow[i];
+            if ( coefficient == 0 )
+                continue;
+
+            for ( unsigned k = _rowStarts[i]; k < _rowStarts[i + 1]; ++k )
+            {
+                double weight = _values[k];
+                if ( ( entries == POSITIVE_ENTRIES && weight < 0 ) ||
+                     ( entries == NEGATIVE_ENTRIES && weight > 0 ) )
+                    continue;
+
+                resultRow[_columnIndices[k]] += coefficient * weight;
+            }
+        }
+    }
+}
+
+void SparseWeightMatrix::multiplyFromRight( const double *right,
+                                            double *result,
+                                            unsigned columnsOfRight ) const
+{
+    for ( unsigned i = 0; i < _rows; ++i )
+    {
+        double *resultRow = result + i * columnsOfRight;
+        for ( unsigned k = _rowStarts[i]; k < _rowStarts[i + 1]; ++k )
+        {
+            double weight = _values[k];
+            const double *rightRow = right + _columnIndices[k] * columnsOfRight;
+            for ( unsigned j = 0; j < columnsOfRight; ++j )
+                resultRow[j] += weight * rightRow[j];
+        }
+    }
+}
+
+bool SparseWeightMatrix::operator==( const SparseWeightMatrix &other ) const
+{
+    return _rows == other._rows && _columns == other._columns &&
+           _rowStarts == other._rowStarts && _columnIndices == other._columnIndices &&
+           _values == other._values;
+}
+
+} // namespace NLR
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,106 @@
+/*********************                                                        */
+/*! \file SparseWeightMatrix.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __SparseWeightMatrix_h__
+#define __SparseWeightMatrix_h__
+
+#include "Vector.h"
+
+namespace NLR {
+
+/*
+  The weights between a source layer and a weighted sum layer in
+  Compressed Sparse Row (CSR) format. As in the dense weight matrices of
+  Layer, row i holds the weights from source neuron i, and column j the
+  weights into target neuron j. Every non-zero weight is stored exactly,
+  so computations with the sparse matrix give the same results as with
+  the dense one.
+
+  The non-zero weights of row i are _values[k] for k in
+  [_rowStarts[i], _rowStarts[i + 1]), and are in the columns
+  _columnIndices[k], in increasing order.
+*/
+class SparseWeightMatrix
+{
+public:
+    enum Entries {
+        ALL_ENTRIES = 0,
+        POSITIVE_ENTRIES = 1,
+        NEGATIVE_ENTRIES = 2,
+    };
+
+    /*
+      Compress a dense, row-major rows x columns matrix
+    */
+    SparseWeightMatrix( const double *weights, unsigned rows, unsigned columns );
+
+    /*
+      The fraction of non-zero entries of a dense matrix
+    */
+    static double density( const double *weights, unsigned rows, unsigned columns );
+
+    unsigned getNumberOfRows() const;
+    unsigned getNumberOfColumns() const;
+    unsigned getNnz() const;
+
+    double get( unsigned row, unsigned column ) const;
+    const unsigned *getRowStarts() const;
+    const unsigned *getColumnIndices() const;
+    const double *getValues() const;
+
+    /*
+      Store the matrix in dense, row-major form
+    */
+    void toDense( double *result ) const;
+
+    /*
+      result += left * M, where left is a dense (rowsOfLeft x rows) matrix
+      and result a dense (rowsOfLeft x columns) matrix, both row-major.
+      Only the entries of M of the given sign are used, if requested.
+    */
+    void multiplyFromLeft( const double *left,
+                           double *result,
+                           unsigned rowsOfLeft,
+                           Entries entries = ALL_ENTRIES ) const;
+
+    /*
+      result += M * right, where right is a dense (columns x columnsOfRight)
+      matrix and result a dense (rows x columnsOfRight) matrix, both
+      row-major.
+    */
+    void multiplyFromRight( const double *right, double *result, unsigned columnsOfRight ) const;
+
+    bool operator==( const SparseWeightMatrix &other ) const;
+
+private:
+    unsigned _rows;
+    unsigned _columns;
+
+    Vector<unsigned> _rowStarts;
+    Vector<unsigned> _columnIndices;
+    Vector<double> _values;
+};
+
+} // namespace NLR
+
+#endif // __SparseWeightMatrix_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -14,12 +14,16 @@
 **/
 
 #include "../../engine/tests/MockTableau.h"
+#include "DeepPolyInputElement.h"
+#include "DeepPolyReLUElement.h"
 #include "DeepPolySoftmaxElement.h"
+#include "DeepPolyWeightedSumElement.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
 #include "Layer.h"
 #include "NetworkLevelReasoner.h"
 #include "Options.h"
+#include "ThreadPool.h"
 #include "Tightening.h"
 
 #include <cxxtest/TestSuite.h>
@@ -327,6 +331,692 @@ public:
             TS_ASSERT( existsBound( bounds, bound ) );
     }
 
+    void test_deeppoly_sparse_weights()
+    {
+        // DeepPoly should give the same bounds with the weights stored sparsely,
+        // including for the residual connections
+        for ( unsigned network = 0; network < 2; ++network )
+        {
+            List<Tightening> denseBounds;
+            List<Tightening> sparseBounds;
+
+            for ( bool sparse : { false, true } )
+            {
+                NLR::NetworkLevelReasoner nlr;
+                MockTableau tableau;
+                nlr.setTableau( &tableau );
+                if ( network == 0 )
+                {
+                    populateNetwork( nlr, tableau );
+                    tableau.setLowerBound( 1, -1 );
+                    tableau.setUpperBound( 1, 1 );
+                }
+                else
+                    populateResidualNetwork1( nlr, tableau );
+
+                tableau.setLowerBound( 0, -1 );
+                tableau.setUpperBound( 0, 1 );
+
+                if ( sparse )
+                {
+                    nlr.sparsifyWeights( 1 );
+                    TS_ASSERT( nlr.getLayer( 1 )->hasSparseWeights( 0 ) );
+                }
+
+                TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+                TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+                TS_ASSERT_THROWS_NOTHING(
+                    nlr.getConstraintTightenings( sparse ? sparseBounds : denseBounds ) );
+            }
+
+            TS_ASSERT( !denseBounds.empty() );
+            TS_ASSERT_EQUALS( denseBounds.size(), sparseBounds.size() );
+            for ( const auto &bound : denseBounds )
+                TS_ASSERT( existsBound( sparseBounds, bound ) );
+        }
+    }
+
+    void populateConvolutionalNetwork( NLR::NetworkLevelReasoner &nlr,
+                                       MockTableau &tableau,
+                                       bool convolutional )
+    {
+        /*
+          A 1 x 3 x 3 input, convolved with two 2 x 2 filters with stride 2
+          and padding 1, followed by ReLUs and a weighted sum layer with two
+          outputs. Unless convolutional is set, layer 1 is a weighted sum
+          layer with the weights of the convolution.
+        */
+        nlr.addLayer( 0, NLR::Layer::INPUT, 9 );
+        nlr.addLayer( 1, convolutional ? NLR::Layer::CONV : NLR::Layer::WEIGHTED_SUM, 8 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 8 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 2 );
+
+        for ( unsigned i = 1; i <= 3; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        NLR::Convolution::Shape shape = { 1, 3, 3, 2, 2, 2, 2, 2, 2, 2, 1, 1 };
+        Vector<double> kernel = { 1, -2, 0, 3, -1, 2, 1, 0 };
+        Vector<unsigned> inputNeurons = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+        auto convolution =
+            std::make_shared<const NLR::Convolution>( shape, kernel, inputNeurons, 9 );
+
+        if ( convolutional )
+            nlr.getLayer( 1 )->setConvolution( 0, convolution );
+        else
+        {
+            double weights[9 * 8];
+            convolution->toDense( weights );
+            for ( unsigned i = 0; i < 9; ++i )
+                for ( unsigned j = 0; j < 8; ++j )
+                    nlr.setWeight( 0, i, 1, j, weights[i * 8 + j] );
+        }
+
+        for ( unsigned i = 0; i < 8; ++i )
+        {
+            nlr.setBias( 1, i, 0.25 * i - 1 );
+            nlr.addActivationSource( 1, i, 2, i );
+            nlr.setWeight( 2, i, 3, 0, i % 2 ? 1 : -1 );
+            nlr.setWeight( 2, i, 3, 1, 0.5 * i - 1 );
+        }
+        nlr.setBias( 3, 0, 1 );
+
+        // Variable indexing, with very loose bounds for neurons except inputs
+        tableau.getBoundManager().initialize( 27 );
+        unsigned variable = 0;
+        for ( unsigned layer = 0; layer <= 3; ++layer )
+        {
+            for ( unsigned i = 0; i < nlr.getLayer( layer )->getSize(); ++i )
+            {
+                nlr.setNeuronVariable( NLR::NeuronIndex( layer, i ), variable );
+                tableau.setLowerBound( variable, layer == 0 ? -1 + 0.1 * i : -1000000 );
+                tableau.setUpperBound( variable, layer == 0 ? 1 : 1000000 );
+                ++variable;
+            }
+        }
+    }
+
+    void test_deeppoly_convolution()
+    {
+        // Back-substitution through the transposed convolution should give
+        // the same bounds as through the equivalent weight matrix
+        List<Tightening> denseBounds;
+        List<Tightening> convBounds;
+
+        for ( bool convolutional : { false, true } )
+        {
+            NLR::NetworkLevelReasoner nlr;
+            MockTableau tableau;
+            nlr.setTableau( &tableau );
+            populateConvolutionalNetwork( nlr, tableau, convolutional );
+
+            TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+            TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+            TS_ASSERT_THROWS_NOTHING(
+                nlr.getConstraintTightenings( convolutional ? convBounds : denseBounds ) );
+        }
+
+        TS_ASSERT( !denseBounds.empty() );
+        TS_ASSERT_EQUALS( denseBounds.size(), convBounds.size() );
+        for ( const auto &bound : denseBounds )
+            TS_ASSERT( existsBound( convBounds, bound ) );
+    }
+
+    void test_deeppoly_optimized_slopes()
+    {
+        // Optimizing the lower relaxation slopes of the ReLUs should only
+        // tighten the bounds, and the bounds should hold for every input
+        Map<unsigned, double> heuristicLbs;
+        Map<unsigned, double> heuristicUbs;
+        Map<unsigned, double> optimizedLbs;
+        Map<unsigned, double> optimizedUbs;
+
+        for ( bool optimize : { false, true } )
+        {
+            Options::get()->setBool( Options::DEEP_POLY_OPTIMIZE_SLOPES, optimize );
+
+            NLR::NetworkLevelReasoner nlr;
+            MockTableau tableau;
+            nlr.setTableau( &tableau );
+            populateNetwork( nlr, tableau );
+
+            tableau.setLowerBound( 0, -1 );
+            tableau.setUpperBound( 0, 1 );
+            tableau.setLowerBound( 1, -1 );
+            tableau.setUpperBound( 1, 1.5 );
+
+            // The second propagation starts from the cached slopes
+            for ( unsigned run = 0; run < 2; ++run )
+            {
+                TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+                TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+            }
+
+            List<Tightening> bounds;
+            TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+            Map<unsigned, double> &lbs = optimize ? optimizedLbs : heuristicLbs;
+            Map<unsigned, double> &ubs = optimize ? optimizedUbs : heuristicUbs;
+            for ( const auto &bound : bounds )
+            {
+                if ( bound._type == Tightening::LB &&
+                     ( !lbs.exists( bound._variable ) || lbs[bound._variable] < bound._value ) )
+                    lbs[bound._variable] = bound._value;
+                if ( bound._type == Tightening::UB &&
+                     ( !ubs.exists( bound._variable ) || ubs[bound._variable] > bound._value ) )
+                    ubs[bound._variable] = bound._value;
+            }
+
+            if ( optimize )
+            {
+                // Check the bounds of the outputs on a grid of inputs
+                for ( unsigned i = 0; i <= 10; ++i )
+                {
+                    for ( unsigned j = 0; j <= 10; ++j )
+                    {
+                        double input[2] = { -1 + 0.2 * i, -1 + 0.25 * j };
+                        double output[2];
+                        TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+                        TS_ASSERT( FloatUtils::gte( output[0], optimizedLbs[10] ) );
+                        TS_ASSERT( FloatUtils::lte( output[0], optimizedUbs[10] ) );
+                        TS_ASSERT( FloatUtils::gte( output[1], optimizedLbs[11] ) );
+                        TS_ASSERT( FloatUtils::lte( output[1], optimizedUbs[11] ) );
+                    }
+                }
+            }
+        }
+        Options::get()->setBool( Options::DEEP_POLY_OPTIMIZE_SLOPES, false );
+
+        for ( const auto &pair : heuristicLbs )
+            TS_ASSERT( FloatUtils::gte( optimizedLbs[pair.first], pair.second ) );
+        for ( const auto &pair : heuristicUbs )
+            TS_ASSERT( FloatUtils::lte( optimizedUbs[pair.first], pair.second ) );
+
+        // The heuristic slope of x4 is 1, which gives x10 >= -1. Optimizing
+        // it gives the exact lower bound, x10 >= 1.
+        TS_ASSERT( FloatUtils::areEqual( heuristicLbs[10], -1 ) );
+        TS_ASSERT( FloatUtils::areEqual( optimizedLbs[10], 1 ) );
+        TS_ASSERT( FloatUtils::lt( optimizedUbs[10], heuristicUbs[10] ) );
+    }
+
+    void populateWideNetwork( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
+    {
+        /*
+          x0 -> 40 -> ReLU -> 40 -> ReLU -> 20, with a residual connection
+          from the input to the second weighted sum layer, and weights and
+          biases in [-1, 1]
+        */
+        unsigned sizes[] = { 3, 40, 40, 40, 40, 20 };
+        nlr.addLayer( 0, NLR::Layer::INPUT, sizes[0] );
+        for ( unsigned i = 1; i <= 5; ++i )
+        {
+            nlr.addLayer(
+                i, i % 2 == 1 ? NLR::Layer::WEIGHTED_SUM : NLR::Layer::RELU, sizes[i] );
+            nlr.addLayerDependency( i - 1, i );
+        }
+        nlr.addLayerDependency( 0, 3 );
+
+        for ( unsigned i : { 1, 3, 5 } )
+        {
+            for ( unsigned target = 0; target < sizes[i]; ++target )
+            {
+                for ( unsigned source = 0; source < sizes[i - 1]; ++source )
+                {
+                    double weight = ( ( source * 7 + target * 13 + i ) % 11 ) / 5.0 - 1;
+                    nlr.setWeight( i - 1, source, i, target, weight );
+                }
+                nlr.setBias( i, target, ( ( target * 3 + i ) % 5 ) / 2.0 - 1 );
+            }
+        }
+        for ( unsigned target = 0; target < sizes[3]; ++target )
+        {
+            for ( unsigned source = 0; source < sizes[0]; ++source )
+                nlr.setWeight( 0, source, 3, target, ( ( source + target ) % 3 ) / 2.0 - 0.5 );
+        }
+
+        for ( unsigned i : { 2, 4 } )
+        {
+            for ( unsigned neuron = 0; neuron < sizes[i]; ++neuron )
+                nlr.addActivationSource( i - 1, neuron, i, neuron );
+        }
+
+        unsigned variable = 0;
+        for ( unsigned i = 0; i <= 5; ++i )
+        {
+            for ( unsigned neuron = 0; neuron < sizes[i]; ++neuron )
+                nlr.setNeuronVariable( NLR::NeuronIndex( i, neuron ), variable++ );
+        }
+
+        tableau.getBoundManager().initialize( variable );
+        for ( unsigned i = 0; i < variable; ++i )
+        {
+            tableau.setLowerBound( i, i < sizes[0] ? -1 : -1000000 );
+            tableau.setUpperBound( i, i < sizes[0] ? 1 : 1000000 );
+        }
+    }
+
+    void test_parallel_back_substitution()
+    {
+        // Back-substituting blocks of neurons on several threads should give
+        // the same bounds as back-substituting all neurons at once
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateWideNetwork( nlr, tableau );
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+
+        unsigned maxLayerSize = 40;
+        Vector<double> memory( 4 * maxLayerSize * maxLayerSize + 2 * maxLayerSize );
+        double *work = memory.data();
+
+        Map<unsigned, double> serialLbs;
+        Map<unsigned, double> serialUbs;
+        for ( unsigned numberOfThreads : { 1, 2, 4 } )
+        {
+            ThreadPool threadPool( numberOfThreads );
+            Map<unsigned, NLR::DeepPolyElement *> elements;
+            for ( const auto &pair : nlr.getLayerIndexToLayer() )
+            {
+                NLR::Layer *layer = pair.second;
+                if ( layer->getLayerType() == NLR::Layer::INPUT )
+                    elements[pair.first] = new NLR::DeepPolyInputElement( layer );
+                else if ( layer->getLayerType() == NLR::Layer::RELU )
+                    elements[pair.first] = new NLR::DeepPolyReLUElement( layer );
+                else
+                {
+                    NLR::DeepPolyWeightedSumElement *element =
+                        new NLR::DeepPolyWeightedSumElement( layer );
+                    unsigned matrixSize = maxLayerSize * maxLayerSize;
+                    element->setWorkingMemory( work,
+                                               work + matrixSize,
+                                               work + 2 * matrixSize,
+                                               work + 3 * matrixSize,
+                                               work + 4 * matrixSize,
+                                               work + 4 * matrixSize + maxLayerSize );
+                    if ( numberOfThreads > 1 )
+                        element->setThreadPool( &threadPool );
+                    elements[pair.first] = element;
+                }
+                elements[pair.first]->execute( elements );
+            }
+
+            unsigned variable = 0;
+            for ( const auto &pair : elements )
+            {
+                for ( unsigned i = 0; i < pair.second->getSize(); ++i, ++variable )
+                {
+                    if ( numberOfThreads == 1 )
+                    {
+                        serialLbs[variable] = pair.second->getLowerBound( i );
+                        serialUbs[variable] = pair.second->getUpperBound( i );
+                    }
+                    else
+                    {
+                        TS_ASSERT( FloatUtils::areEqual( pair.second->getLowerBound( i ),
+                                                         serialLbs[variable] ) );
+                        TS_ASSERT( FloatUtils::areEqual( pair.second->getUpperBound( i ),
+                                                         serialUbs[variable] ) );
+                    }
+                }
+                delete pair.second;
+            }
+        }
+
+        // The bounds of the output layer are finite and non-trivial
+        TS_ASSERT( FloatUtils::isFinite( serialLbs[182] ) );
+        TS_ASSERT( FloatUtils::lt( serialLbs[182], serialUbs[182] ) );
+    }
+
+    void getDeepPolyBounds( NLR::NetworkLevelReasoner &nlr,
+                            Map<unsigned, double> &lbs,
+                            Map<unsigned, double> &ubs )
+    {
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        for ( const auto &bound : bounds )
+        {
+            if ( bound._type == Tightening::LB )
+                lbs[bound._variable] = bound._value;
+            else
+                ubs[bound._variable] = bound._value;
+        }
+    }
+
+    void test_single_precision_soundness()
+    {
+        // The bounds computed in single precision should be slightly looser
+        // than the bounds computed in double precision
+        Map<unsigned, double> doubleLbs;
+        Map<unsigned, double> doubleUbs;
+        Map<unsigned, double> singleLbs;
+        Map<unsigned, double> singleUbs;
+
+        for ( bool singlePrecision : { false, true } )
+        {
+            Options::get()->setBool( Options::DEEP_POLY_SINGLE_PRECISION, singlePrecision );
+
+            NLR::NetworkLevelReasoner nlr;
+            MockTableau tableau;
+            nlr.setTableau( &tableau );
+            populateWideNetwork( nlr, tableau );
+            getDeepPolyBounds( nlr,
+                               singlePrecision ? singleLbs : doubleLbs,
+                               singlePrecision ? singleUbs : doubleUbs );
+
+            if ( !singlePrecision )
+                continue;
+
+            // The outputs on a grid of inputs are within the bounds
+            double input[3];
+            double output[20];
+            for ( unsigned i = 0; i < 125; ++i )
+            {
+                input[0] = ( i % 5 ) / 2.0 - 1;
+                input[1] = ( ( i / 5 ) % 5 ) / 2.0 - 1;
+                input[2] = ( i / 25 ) / 2.0 - 1;
+                TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+                for ( unsigned j = 0; j < 20; ++j )
+                {
+                    TS_ASSERT_LESS_THAN_EQUALS( singleLbs[163 + j], output[j] );
+                    TS_ASSERT_LESS_THAN_EQUALS( output[j], singleUbs[163 + j] );
+                }
+            }
+        }
+        Options::get()->setBool( Options::DEEP_POLY_SINGLE_PRECISION, false );
+
+        TS_ASSERT_EQUALS( singleLbs.size(), doubleLbs.size() );
+        for ( const auto &pair : doubleLbs )
+        {
+            double tolerance = 0.001 * ( 1 + FloatUtils::abs( pair.second ) );
+            TS_ASSERT_LESS_THAN_EQUALS( singleLbs[pair.first], pair.second + 1e-9 );
+            TS_ASSERT_LESS_THAN_EQUALS( pair.second - tolerance, singleLbs[pair.first] );
+        }
+        for ( const auto &pair : doubleUbs )
+        {
+            double tolerance = 0.001 * ( 1 + FloatUtils::abs( pair.second ) );
+            TS_ASSERT_LESS_THAN_EQUALS( pair.second - 1e-9, singleUbs[pair.first] );
+            TS_ASSERT_LESS_THAN_EQUALS( singleUbs[pair.first], pair.second + tolerance );
+        }
+    }
+
+    void test_single_precision_cancellation()
+    {
+        /*
+                 1
+          x0 ------- x1
+            \         \ 1e8 + 1
+             \         x3
+              \       /
+               ----- x2  -1e8
+                 1
+
+          x3 = x0, but 1e8 + 1 rounds to 1e8 in single precision, so the
+          coefficient of x0 cancels out
+        */
+        for ( bool singlePrecision : { false, true } )
+        {
+            Options::get()->setBool( Options::DEEP_POLY_SINGLE_PRECISION, singlePrecision );
+
+            NLR::NetworkLevelReasoner nlr;
+            MockTableau tableau;
+            nlr.setTableau( &tableau );
+
+            nlr.addLayer( 0, NLR::Layer::INPUT, 1 );
+            nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 2 );
+            nlr.addLayer( 2, NLR::Layer::WEIGHTED_SUM, 1 );
+            nlr.addLayerDependency( 0, 1 );
+            nlr.addLayerDependency( 1, 2 );
+
+            nlr.setWeight( 0, 0, 1, 0, 1 );
+            nlr.setWeight( 0, 0, 1, 1, 1 );
+            nlr.setWeight( 1, 0, 2, 0, 100000001 );
+            nlr.setWeight( 1, 1, 2, 0, -100000000 );
+
+            nlr.setNeuronVariable( NLR::NeuronIndex( 0, 0 ), 0 );
+            nlr.setNeuronVariable( NLR::NeuronIndex( 1, 0 ), 1 );
+            nlr.setNeuronVariable( NLR::NeuronIndex( 1, 1 ), 2 );
+            nlr.setNeuronVariable( NLR::NeuronIndex( 2, 0 ), 3 );
+
+            tableau.getBoundManager().initialize( 4 );
+            tableau.setLowerBound( 0, 0 );
+            tableau.setUpperBound( 0, 1 );
+            for ( unsigned i = 1; i < 4; ++i )
+            {
+                tableau.setLowerBound( i, -1000000000 );
+                tableau.setUpperBound( i, 1000000000 );
+            }
+
+            Map<unsigned, double> lbs;
+            Map<unsigned, double> ubs;
+            getDeepPolyBounds( nlr, lbs, ubs );
+
+            if ( singlePrecision )
+            {
+                // The bounds are looser than [0, 1] by the rounding error
+                TS_ASSERT_LESS_THAN( lbs[3], 0 );
+                TS_ASSERT_LESS_THAN( 1, ubs[3] );
+                TS_ASSERT( FloatUtils::isFinite( lbs[3] ) );
+                TS_ASSERT( FloatUtils::isFinite( ubs[3] ) );
+            }
+            else
+            {
+                TS_ASSERT( FloatUtils::areEqual( lbs[3], 0 ) );
+                TS_ASSERT( FloatUtils::areEqual( ubs[3], 1 ) );
+            }
+        }
+        Options::get()->setBool( Options::DEEP_POLY_SINGLE_PRECISION, false );
+    }
+
+    void propagateAndTighten( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
+    {
+        // Run DeepPoly and store the tighter bounds in the tableau, as the
+        // engine does
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        for ( const auto &bound : bounds )
+        {
+            if ( bound._type == Tightening::LB &&
+                 bound._value > tableau.getLowerBound( bound._variable ) )
+                tableau.setLowerBound( bound._variable, bound._value );
+            if ( bound._type == Tightening::UB &&
+                 bound._value < tableau.getUpperBound( bound._variable ) )
+                tableau.setUpperBound( bound._variable, bound._value );
+        }
+    }
+
+    void test_deeppoly_incremental_after_split()
+    {
+        // Running DeepPoly again after a split only executes the layers
+        // from the split onwards, and should give the same bounds as
+        // running it from scratch
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetwork( nlr, tableau );
+
+        tableau.setLowerBound( 0, -1 );
+        tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, -1 );
+        tableau.setUpperBound( 1, 1 );
+
+        propagateAndTighten( nlr, tableau );
+
+        // Nothing changed, so no layer is executed and no bound changes
+        Map<unsigned, double> lbs;
+        Map<unsigned, double> ubs;
+        for ( unsigned i = 0; i < 12; ++i )
+        {
+            lbs[i] = tableau.getLowerBound( i );
+            ubs[i] = tableau.getUpperBound( i );
+        }
+        propagateAndTighten( nlr, tableau );
+        for ( unsigned i = 0; i < 12; ++i )
+        {
+            TS_ASSERT_EQUALS( tableau.getLowerBound( i ), lbs[i] );
+            TS_ASSERT_EQUALS( tableau.getUpperBound( i ), ubs[i] );
+        }
+
+        // Split x2 on its active phase, and then x7 on its active phase
+        for ( unsigned split = 0; split < 2; ++split )
+        {
+            if ( split == 0 )
+                tableau.setLowerBound( 2, 0 );
+            else
+                tableau.setLowerBound( 7, 0 );
+            propagateAndTighten( nlr, tableau );
+
+            NLR::NetworkLevelReasoner freshNlr;
+            MockTableau freshTableau;
+            freshNlr.setTableau( &freshTableau );
+            populateNetwork( freshNlr, freshTableau );
+            for ( unsigned i = 0; i < 12; ++i )
+            {
+                freshTableau.setLowerBound( i, tableau.getLowerBound( i ) );
+                freshTableau.setUpperBound( i, tableau.getUpperBound( i ) );
+            }
+            propagateAndTighten( freshNlr, freshTableau );
+
+            for ( unsigned i = 0; i < 12; ++i )
+            {
+                TS_ASSERT( FloatUtils::areEqual( freshTableau.getLowerBound( i ),
+                                                 tableau.getLowerBound( i ) ) );
+                TS_ASSERT( FloatUtils::areEqual( freshTableau.getUpperBound( i ),
+                                                 tableau.getUpperBound( i ) ) );
+            }
+        }
+    }
+
+    void populateSplitNetwork( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
+    {
+        /*
+
+              1      R
+          x0 --- x2 ---> x4
+            \    /        \ 1
+           1 \  /          \
+              \/            x6
+              /\            /
+           1 /  \  R       / -1
+            /    \        /
+          x1 --- x3 ---> x5
+              1
+
+          x3 has a bias of 1
+        */
+
+        // Create the layers
+        nlr.addLayer( 0, NLR::Layer::INPUT, 2 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 2 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 2 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 1 );
+
+        // Mark layer dependencies
+        for ( unsigned i = 1; i <= 3; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        // Set the weights and biases for the weighted sum layers
+        nlr.setWeight( 0, 0, 1, 0, 1 );
+        nlr.setWeight( 0, 0, 1, 1, 1 );
+        nlr.setWeight( 0, 1, 1, 0, 1 );
+        nlr.setWeight( 0, 1, 1, 1, 1 );
+
+        nlr.setWeight( 2, 0, 3, 0, 1 );
+        nlr.setWeight( 2, 1, 3, 0, -1 );
+
+        nlr.setBias( 1, 1, 1 );
+
+        // Mark the ReLU sources
+        nlr.addActivationSource( 1, 0, 2, 0 );
+        nlr.addActivationSource( 1, 1, 2, 1 );
+
+        // Variable indexing
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 0 ), 0 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 1 ), 1 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 0 ), 2 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 1 ), 3 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 0 ), 4 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 1 ), 5 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 3, 0 ), 6 );
+
+        // Very loose bounds for neurons except inputs
+        double large = 1000000;
+
+        tableau.getBoundManager().initialize( 7 );
+        for ( unsigned i = 2; i < 7; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+    }
+
+    void test_deeppoly_split_multipliers()
+    {
+        // After splitting x2 on its active phase, x6 = x2 - relu( x2 + 1 ) is
+        // always -1. Adding x2 >= 0 to the back-substitution of x6 with an
+        // optimized multiplier should tighten its lower bound, which the
+        // bounds of the intermediate layers alone do not imply.
+        Map<unsigned, double> plainLbs;
+        Map<unsigned, double> plainUbs;
+        Map<unsigned, double> splitLbs;
+        Map<unsigned, double> splitUbs;
+
+        for ( bool optimize : { false, true } )
+        {
+            Options::get()->setBool( Options::DEEP_POLY_OPTIMIZE_SPLIT_MULTIPLIERS, optimize );
+
+            NLR::NetworkLevelReasoner nlr;
+            MockTableau tableau;
+            nlr.setTableau( &tableau );
+            populateSplitNetwork( nlr, tableau );
+
+            tableau.setLowerBound( 0, -1 );
+            tableau.setUpperBound( 0, 1 );
+            tableau.setLowerBound( 1, -1 );
+            tableau.setUpperBound( 1, 1 );
+            tableau.setLowerBound( 2, 0 );
+
+            // The second propagation starts from the cached multipliers
+            for ( unsigned run = 0; run < 2; ++run )
+            {
+                TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+                TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+            }
+
+            List<Tightening> bounds;
+            TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+            Map<unsigned, double> &lbs = optimize ? splitLbs : plainLbs;
+            Map<unsigned, double> &ubs = optimize ? splitUbs : plainUbs;
+            for ( const auto &bound : bounds )
+            {
+                if ( bound._type == Tightening::LB &&
+                     ( !lbs.exists( bound._variable ) || lbs[bound._variable] < bound._value ) )
+                    lbs[bound._variable] = bound._value;
+                if ( bound._type == Tightening::UB &&
+                     ( !ubs.exists( bound._variable ) || ubs[bound._variable] > bound._value ) )
+                    ubs[bound._variable] = bound._value;
+            }
+        }
+        Options::get()->setBool( Options::DEEP_POLY_OPTIMIZE_SPLIT_MULTIPLIERS, false );
+
+        for ( const auto &pair : plainLbs )
+            TS_ASSERT( FloatUtils::gte( splitLbs[pair.first], pair.second ) );
+        for ( const auto &pair : plainUbs )
+            TS_ASSERT( FloatUtils::lte( splitUbs[pair.first], pair.second ) );
+
+        // Without the multiplier, x6 >= 0.25 * ( x0 + x1 ) - 1.5 >= -2
+        TS_ASSERT( FloatUtils::areEqual( plainLbs[6], -2 ) );
+        TS_ASSERT( FloatUtils::gt( splitLbs[6], -2 ) );
+        TS_ASSERT( FloatUtils::lte( splitLbs[6], -1 ) );
+        TS_ASSERT( FloatUtils::gte( splitUbs[6], -1 ) );
+    }
+
     void populateResidualNetwork2( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
     {
         /*
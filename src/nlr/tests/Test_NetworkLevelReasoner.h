@@ -15,6 +15,7 @@
 
 #include "../../engine/tests/MockTableau.h" // TODO: fix this
 #include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 #include "InputQuery.h"
 #include "Layer.h"
 #include "NetworkLevelReasoner.h"
@@ -44,6 +45,18 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete mock );
     }
 
+    // Lay out the values of each input neuron as one row per sample
+    Vector<double> toBatch( const Vector<Vector<double>> &valuesPerNeuron )
+    {
+        unsigned numberOfNeurons = valuesPerNeuron.size();
+        unsigned numberOfSamples = valuesPerNeuron[0].size();
+        Vector<double> batch( numberOfNeurons * numberOfSamples );
+        for ( unsigned i = 0; i < numberOfNeurons; ++i )
+            for ( unsigned j = 0; j < numberOfSamples; ++j )
+                batch[j * numberOfNeurons + i] = valuesPerNeuron[i][j];
+        return batch;
+    }
+
     void populateNetwork( NLR::NetworkLevelReasoner &nlr )
     {
         /*
@@ -395,6 +408,288 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output[1], 4 ) );
     }
 
+    void test_evaluate_batch()
+    {
+        NLR::NetworkLevelReasoner relus;
+        NLR::NetworkLevelReasoner sigmoids;
+
+        populateNetwork( relus );
+        populateNetworkWithSigmoids( sigmoids );
+
+        // More samples than fit in one chunk of the batch evaluation
+        unsigned numberOfSamples = 2 * GlobalConfiguration::NLR_BATCH_EVALUATION_SIZE + 5;
+        Vector<double> inputs( 2 * numberOfSamples );
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
+        {
+            inputs[2 * j] = -3.0 + 0.01 * j;
+            inputs[2 * j + 1] = 2.5 - 0.02 * j;
+        }
+
+        for ( NLR::NetworkLevelReasoner *nlr : { &relus, &sigmoids } )
+        {
+            for ( unsigned numberOfThreads : { 1, 3 } )
+            {
+                Vector<double> outputs( 2 * numberOfSamples, 0 );
+                TS_ASSERT_THROWS_NOTHING( nlr->evaluateBatch(
+                    inputs.data(), outputs.data(), numberOfSamples, numberOfThreads ) );
+
+                for ( unsigned j = 0; j < numberOfSamples; ++j )
+                {
+                    double output[2];
+                    TS_ASSERT_THROWS_NOTHING( nlr->evaluate( inputs.data() + 2 * j, output ) );
+                    TS_ASSERT( FloatUtils::areEqual( outputs[2 * j], output[0] ) );
+                    TS_ASSERT( FloatUtils::areEqual( outputs[2 * j + 1], output[1] ) );
+                }
+            }
+        }
+    }
+
+    void test_sparse_weights()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
+
+        NLR::NetworkLevelReasoner dense;
+        NLR::NetworkLevelReasoner sparse;
+        populateNetwork( dense );
+        populateNetwork( sparse );
+
+        // Layer 1 has 4 non-zero weights out of 6, layer 3 has 6 out of 6
+        sparse.sparsifyWeights( 0.7 );
+        TS_ASSERT( sparse.getLayer( 1 )->hasSparseWeights( 0 ) );
+        TS_ASSERT( !sparse.getLayer( 3 )->hasSparseWeights( 2 ) );
+        TS_ASSERT_EQUALS( sparse.getLayer( 1 )->getSparseWeights( 0 )->getNnz(), 4U );
+
+        sparse.sparsifyWeights( 1 );
+        for ( unsigned layer : { 1, 3, 5 } )
+        {
+            TS_ASSERT( sparse.getLayer( layer )->hasSparseWeights( layer - 1 ) );
+            for ( unsigned i = 0; i < dense.getLayer( layer - 1 )->getSize(); ++i )
+                for ( unsigned j = 0; j < dense.getLayer( layer )->getSize(); ++j )
+                    TS_ASSERT_EQUALS( sparse.getLayer( layer )->getWeight( layer - 1, i, j ),
+                                      dense.getLayer( layer )->getWeight( layer - 1, i, j ) );
+        }
+
+        // Evaluation
+        unsigned numberOfSamples = 5;
+        Vector<double> inputs( 2 * numberOfSamples );
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
+        {
+            inputs[2 * j] = -2.0 + j;
+            inputs[2 * j + 1] = 1.5 - 0.5 * j;
+        }
+
+        Vector<double> denseOutputs( 2 * numberOfSamples, 0 );
+        Vector<double> sparseOutputs( 2 * numberOfSamples, 0 );
+        dense.evaluateBatch( inputs.data(), denseOutputs.data(), numberOfSamples );
+        sparse.evaluateBatch( inputs.data(), sparseOutputs.data(), numberOfSamples );
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
+        {
+            double output[2];
+            TS_ASSERT_THROWS_NOTHING( sparse.evaluate( inputs.data() + 2 * j, output ) );
+            TS_ASSERT( FloatUtils::areEqual( output[0], denseOutputs[2 * j] ) );
+            TS_ASSERT( FloatUtils::areEqual( output[1], denseOutputs[2 * j + 1] ) );
+            TS_ASSERT( FloatUtils::areEqual( sparseOutputs[2 * j], denseOutputs[2 * j] ) );
+            TS_ASSERT(
+                FloatUtils::areEqual( sparseOutputs[2 * j + 1], denseOutputs[2 * j + 1] ) );
+        }
+
+        // Interval arithmetic and symbolic bound tightening
+        for ( bool symbolic : { false, true } )
+        {
+            List<Tightening> denseBounds;
+            List<Tightening> sparseBounds;
+            for ( NLR::NetworkLevelReasoner *nlr : { &dense, &sparse } )
+            {
+                MockTableau tableau;
+                tableau.getBoundManager().initialize( 14 );
+                for ( unsigned i = 0; i < 14; ++i )
+                {
+                    tableau.setLowerBound( i, i < 2 ? -1 : -1000 );
+                    tableau.setUpperBound( i, i < 2 ? 1 : 1000 );
+                }
+                nlr->setTableau( &tableau );
+                nlr->clearConstraintTightenings();
+
+                TS_ASSERT_THROWS_NOTHING( nlr->obtainCurrentBounds() );
+                if ( symbolic )
+                {
+                    TS_ASSERT_THROWS_NOTHING( nlr->symbolicBoundPropagation() );
+                }
+                else
+                {
+                    TS_ASSERT_THROWS_NOTHING( nlr->intervalArithmeticBoundPropagation() );
+                }
+                nlr->getConstraintTightenings( nlr == &dense ? denseBounds : sparseBounds );
+            }
+
+            TS_ASSERT( !denseBounds.empty() );
+            TS_ASSERT_EQUALS( denseBounds.size(), sparseBounds.size() );
+            auto sparseBound = sparseBounds.begin();
+            for ( const auto &denseBound : denseBounds )
+            {
+                TS_ASSERT_EQUALS( denseBound._variable, sparseBound->_variable );
+                TS_ASSERT_EQUALS( denseBound._type, sparseBound->_type );
+                TS_ASSERT( FloatUtils::areEqual( denseBound._value, sparseBound->_value ) );
+                ++sparseBound;
+            }
+        }
+
+        // Modifying a weight restores the dense matrices
+        sparse.setWeight( 0, 1, 1, 0, 5 );
+        TS_ASSERT( !sparse.getLayer( 1 )->hasSparseWeights( 0 ) );
+        TS_ASSERT_EQUALS( sparse.getLayer( 1 )->getWeight( 0, 1, 0 ), 5 );
+        TS_ASSERT_EQUALS( sparse.getLayer( 1 )->getWeight( 0, 0, 1 ), 2 );
+        TS_ASSERT_EQUALS( sparse.getLayer( 1 )->getPositiveWeights( 0 )[1], 2 );
+        TS_ASSERT_EQUALS( sparse.getLayer( 1 )->getNegativeWeights( 0 )[4], -3 );
+    }
+
+    void populateConvolutionalNetwork( NLR::NetworkLevelReasoner &nlr, bool convolutional )
+    {
+        /*
+          A 1 x 3 x 3 input, convolved with two 2 x 2 filters with stride 2
+          and padding 1, followed by ReLUs and a weighted sum layer with two
+          outputs. The input neurons are in reverse tensor order. Unless
+          convolutional is set, layer 1 is a weighted sum layer with the
+          weights of the convolution.
+        */
+        nlr.addLayer( 0, NLR::Layer::INPUT, 9 );
+        nlr.addLayer( 1, convolutional ? NLR::Layer::CONV : NLR::Layer::WEIGHTED_SUM, 8 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 8 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 2 );
+
+        for ( unsigned i = 1; i <= 3; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        NLR::Convolution::Shape shape = { 1, 3, 3, 2, 2, 2, 2, 2, 2, 2, 1, 1 };
+        Vector<double> kernel = { 1, -2, 0, 3, -1, 2, 1, 0 };
+        Vector<unsigned> inputNeurons;
+        for ( unsigned i = 0; i < 9; ++i )
+            inputNeurons.append( 8 - i );
+        auto convolution =
+            std::make_shared<const NLR::Convolution>( shape, kernel, inputNeurons, 9 );
+
+        if ( convolutional )
+            nlr.getLayer( 1 )->setConvolution( 0, convolution );
+        else
+        {
+            double weights[9 * 8];
+            convolution->toDense( weights );
+            for ( unsigned i = 0; i < 9; ++i )
+                for ( unsigned j = 0; j < 8; ++j )
+                    nlr.setWeight( 0, i, 1, j, weights[i * 8 + j] );
+        }
+
+        for ( unsigned i = 0; i < 8; ++i )
+        {
+            nlr.setBias( 1, i, 0.25 * i - 1 );
+            nlr.addActivationSource( 1, i, 2, i );
+            nlr.setWeight( 2, i, 3, 0, i % 2 ? 1 : -1 );
+            nlr.setWeight( 2, i, 3, 1, 0.5 * i - 1 );
+        }
+        nlr.setBias( 3, 0, 1 );
+
+        // Variable indexing
+        unsigned variable = 0;
+        for ( unsigned layer = 0; layer <= 3; ++layer )
+            for ( unsigned i = 0; i < nlr.getLayer( layer )->getSize(); ++i )
+                nlr.setNeuronVariable( NLR::NeuronIndex( layer, i ), variable++ );
+    }
+
+    void test_convolution_layer()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
+
+        NLR::NetworkLevelReasoner dense;
+        NLR::NetworkLevelReasoner conv;
+        populateConvolutionalNetwork( dense, false );
+        populateConvolutionalNetwork( conv, true );
+
+        TS_ASSERT_EQUALS( conv.getLayer( 1 )->getLayerType(), NLR::Layer::CONV );
+        TS_ASSERT( conv.getLayer( 1 )->hasConvolution( 0 ) );
+        TS_ASSERT_EQUALS( conv.getLayer( 1 )->getConvolution( 0 )->getNnz(), 12U );
+        for ( unsigned i = 0; i < 9; ++i )
+            for ( unsigned j = 0; j < 8; ++j )
+                TS_ASSERT_EQUALS( conv.getLayer( 1 )->getWeight( 0, i, j ),
+                                  dense.getLayer( 1 )->getWeight( 0, i, j ) );
+
+        // The top-left output of the first filter only sees the first input,
+        // which is neuron 8, through the last kernel entry
+        TS_ASSERT_EQUALS( conv.getLayer( 1 )->getWeight( 0, 8, 0 ), 3 );
+        TS_ASSERT_EQUALS( conv.getLayer( 1 )->getWeight( 0, 7, 0 ), 0 );
+
+        // Evaluation
+        unsigned numberOfSamples = 4;
+        Vector<double> inputs( 9 * numberOfSamples );
+        for ( unsigned i = 0; i < inputs.size(); ++i )
+            inputs[i] = ( i % 7 ) * 0.5 - 1.5;
+
+        Vector<double> denseOutputs( 2 * numberOfSamples, 0 );
+        Vector<double> convOutputs( 2 * numberOfSamples, 0 );
+        dense.evaluateBatch( inputs.data(), denseOutputs.data(), numberOfSamples );
+        conv.evaluateBatch( inputs.data(), convOutputs.data(), numberOfSamples );
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
+        {
+            double output[2];
+            TS_ASSERT_THROWS_NOTHING( conv.evaluate( inputs.data() + 9 * j, output ) );
+            for ( unsigned i = 0; i < 2; ++i )
+            {
+                TS_ASSERT( FloatUtils::areEqual( output[i], denseOutputs[2 * j + i] ) );
+                TS_ASSERT(
+                    FloatUtils::areEqual( convOutputs[2 * j + i], denseOutputs[2 * j + i] ) );
+            }
+        }
+
+        // Interval arithmetic and symbolic bound tightening
+        for ( bool symbolic : { false, true } )
+        {
+            List<Tightening> denseBounds;
+            List<Tightening> convBounds;
+            for ( NLR::NetworkLevelReasoner *nlr : { &dense, &conv } )
+            {
+                MockTableau tableau;
+                tableau.getBoundManager().initialize( 27 );
+                for ( unsigned i = 0; i < 27; ++i )
+                {
+                    tableau.setLowerBound( i, i < 9 ? -1 - 0.1 * i : -1000 );
+                    tableau.setUpperBound( i, i < 9 ? 1 : 1000 );
+                }
+                nlr->setTableau( &tableau );
+                nlr->clearConstraintTightenings();
+
+                TS_ASSERT_THROWS_NOTHING( nlr->obtainCurrentBounds() );
+                if ( symbolic )
+                {
+                    TS_ASSERT_THROWS_NOTHING( nlr->symbolicBoundPropagation() );
+                }
+                else
+                {
+                    TS_ASSERT_THROWS_NOTHING( nlr->intervalArithmeticBoundPropagation() );
+                }
+                nlr->getConstraintTightenings( nlr == &dense ? denseBounds : convBounds );
+            }
+
+            TS_ASSERT( !denseBounds.empty() );
+            TS_ASSERT_EQUALS( denseBounds.size(), convBounds.size() );
+            auto convBound = convBounds.begin();
+            for ( const auto &denseBound : denseBounds )
+            {
+                TS_ASSERT_EQUALS( denseBound._variable, convBound->_variable );
+                TS_ASSERT_EQUALS( denseBound._type, convBound->_type );
+                TS_ASSERT( FloatUtils::areEqual( denseBound._value, convBound->_value ) );
+                ++convBound;
+            }
+        }
+
+        // The layer is encoded as equations, and copied along with the NLR
+        TS_ASSERT_EQUALS( conv.generateInputQuery().getEquations().size(),
+                          dense.generateInputQuery().getEquations().size() );
+
+        NLR::NetworkLevelReasoner copy;
+        conv.storeIntoOther( copy );
+        TS_ASSERT( *copy.getLayer( 1 ) == *conv.getLayer( 1 ) );
+        TS_ASSERT( !( *copy.getLayer( 1 ) == *dense.getLayer( 1 ) ) );
+    }
+
     void test_store_into_other()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -477,6 +772,37 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output1[1], output2[1] ) );
     }
 
+    void test_store_into_other_shares_weights_until_modified()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+
+        NLR::NetworkLevelReasoner nlr2;
+
+        TS_ASSERT_THROWS_NOTHING( nlr.storeIntoOther( nlr2 ) );
+
+        // The copy shares the weights and biases of the original
+        TS_ASSERT_EQUALS( nlr.getLayer( 1 )->getWeights( 0 ), nlr2.getLayer( 1 )->getWeights( 0 ) );
+        TS_ASSERT_EQUALS( nlr.getLayer( 3 )->getBiases(), nlr2.getLayer( 3 )->getBiases() );
+
+        // Modifying the copy detaches it, and leaves the original intact
+        TS_ASSERT_THROWS_NOTHING( nlr2.setWeight( 0, 0, 1, 0, 5 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr2.setBias( 3, 1, 7 ) );
+
+        TS_ASSERT_DIFFERS( nlr.getLayer( 1 )->getWeights( 0 ),
+                           nlr2.getLayer( 1 )->getWeights( 0 ) );
+        TS_ASSERT_DIFFERS( nlr.getLayer( 3 )->getBiases(), nlr2.getLayer( 3 )->getBiases() );
+
+        TS_ASSERT_EQUALS( nlr.getLayer( 1 )->getWeight( 0, 0, 0 ), 1 );
+        TS_ASSERT_EQUALS( nlr2.getLayer( 1 )->getWeight( 0, 0, 0 ), 5 );
+        TS_ASSERT_EQUALS( nlr.getLayer( 3 )->getBias( 1 ), 2 );
+        TS_ASSERT_EQUALS( nlr2.getLayer( 3 )->getBias( 1 ), 7 );
+
+        // Layers that were not modified remain shared
+        TS_ASSERT_EQUALS( nlr.getLayer( 5 )->getWeights( 4 ), nlr2.getLayer( 5 )->getWeights( 4 ) );
+    }
+
     void test_interval_arithmetic_bound_propagation_relu_constraints()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -954,6 +1280,43 @@ public:
             TS_ASSERT( bounds.exists( bound ) );
     }
 
+    void test_sbt_memory()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetworkSBT( nlr, tableau );
+
+        tableau.setLowerBound( 0, 4 );
+        tableau.setUpperBound( 0, 6 );
+        tableau.setLowerBound( 1, 1 );
+        tableau.setUpperBound( 1, 5 );
+
+        TS_ASSERT_EQUALS( nlr.getPeakSymbolicBoundMemory(), 0U );
+
+        /*
+          Each layer keeps its symbolic bounds, with one lower and one upper
+          coefficient per input neuron, only until its successor has been
+          processed. The peak is reached with two layers of size 2.
+        */
+        for ( unsigned run = 0; run < 2; ++run )
+        {
+            TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+            TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+            TS_ASSERT_EQUALS( nlr.getPeakSymbolicBoundMemory(), 2 * 2 * 2 * 2 * sizeof( double ) );
+
+            for ( unsigned i = 0; i < 4; ++i )
+                TS_ASSERT_EQUALS( nlr.getLayer( i )->getSymbolicBoundsMemory(), 0U );
+        }
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT( bounds.exists( Tightening( 6, 6, Tightening::LB ) ) );
+        TS_ASSERT( bounds.exists( Tightening( 6, 16, Tightening::UB ) ) );
+    }
+
     void test_sbt_relus_active_and_inactive()
     {
         Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
@@ -1769,6 +2132,35 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output[1], 4 ) );
     }
 
+    void test_simulate_batch_matches_evaluate()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+
+        // Every sample of the batch should be simulated as if evaluated
+        // on its own
+        unsigned numberOfSamples = 7;
+        Vector<double> batch( 2 * numberOfSamples );
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
+        {
+            batch[2 * j] = -3.0 + j;
+            batch[2 * j + 1] = 2.5 - 0.75 * j;
+        }
+
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( batch.data(), numberOfSamples ) );
+
+        const NLR::Layer *outputLayer = nlr.getLayer( nlr.getNumberOfLayers() - 1 );
+        TS_ASSERT_EQUALS( outputLayer->getNumberOfSimulations(), numberOfSamples );
+        for ( unsigned j = 0; j < numberOfSamples; ++j )
+        {
+            double output[2];
+            TS_ASSERT_THROWS_NOTHING( nlr.evaluate( batch.data() + 2 * j, output ) );
+            TS_ASSERT( FloatUtils::areEqual( outputLayer->getSimulation( 0, j ), output[0] ) );
+            TS_ASSERT( FloatUtils::areEqual( outputLayer->getSimulation( 1, j ), output[1] ) );
+        }
+    }
+
     void test_simulate_relus()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -1782,20 +2174,14 @@ public:
         simulations1.append( Vector<double>( simulationSize, 0 ) );
         simulations1.append( Vector<double>( simulationSize, 0 ) );
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations1 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( toBatch( simulations1 ).data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                1 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 0, i ), 1 ) );
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                4 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 1, i ), 4 ) );
         }
 
         // With ReLUs, case 1
@@ -1803,20 +2189,14 @@ public:
         simulations2.append( Vector<double>( simulationSize, 1 ) );
         simulations2.append( Vector<double>( simulationSize, 1 ) );
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations2 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( toBatch( simulations2 ).data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                1 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 0, i ), 1 ) );
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                1 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 1, i ), 1 ) );
         }
 
         // With ReLUs, case 1 and 2
@@ -1824,20 +2204,14 @@ public:
         simulations3.append( Vector<double>( simulationSize, 1 ) );
         simulations3.append( Vector<double>( simulationSize, 2 ) );
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations3 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( toBatch( simulations3 ).data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                0 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 0, i ), 0 ) );
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                0 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 1, i ), 0 ) );
         }
     }
 
@@ -1854,20 +2228,16 @@ public:
         simulations1.append( Vector<double>( simulationSize, 0 ) );
         simulations1.append( Vector<double>( simulationSize, 0 ) );
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations1 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( toBatch( simulations1 ).data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 0, i ),
                 0.6750,
                 0.0001 ) );
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 1, i ),
                 3.0167,
                 0.0001 ) );
         }
@@ -1877,20 +2247,16 @@ public:
         simulations2.append( Vector<double>( simulationSize, 1 ) );
         simulations2.append( Vector<double>( simulationSize, 1 ) );
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations2 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( toBatch( simulations2 ).data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 0, i ),
                 0.6032,
                 0.0001 ) );
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 1, i ),
                 2.5790,
                 0.0001 ) );
         }
@@ -1900,20 +2266,16 @@ public:
         simulations3.append( Vector<double>( simulationSize, 1 ) );
         simulations3.append( Vector<double>( simulationSize, 2 ) );
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations3 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( toBatch( simulations3 ).data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 0, i ),
                 0.5045,
                 0.0001 ) );
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 1, i ),
                 2.1957,
                 0.0001 ) );
         }
@@ -1970,28 +2332,22 @@ public:
         simulations1.append( Vector<double>( simulationSize, 1 ) );
         simulations1.append( Vector<double>( simulationSize, 1 ) );
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations1 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( toBatch( simulations1 ).data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                2 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 0, i ), 2 ) );
 
         // Simulate2
         Vector<Vector<double>> simulations2;
         simulations2.append( Vector<double>( simulationSize, -1 ) );
         simulations2.append( Vector<double>( simulationSize, 2 ) );
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations2 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( toBatch( simulations2 ).data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                0 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 0, i ), 0 ) );
     }
 
     void test_simulate_relus_and_abs()
@@ -2045,20 +2401,14 @@ public:
         simulations1.append( Vector<double>( simulationSize, 1 ) );
         simulations1.append( Vector<double>( simulationSize, 1 ) );
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations1 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( toBatch( simulations1 ).data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                2 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 0, i ), 2 ) );
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                2 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 1, i ), 2 ) );
         }
 
         // Simulate2
@@ -2066,20 +2416,14 @@ public:
         simulations2.append( Vector<double>( simulationSize, 1 ) );
         simulations2.append( Vector<double>( simulationSize, 2 ) );
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations2 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( toBatch( simulations2 ).data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                4 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 0, i ), 4 ) );
             TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                4 ) );
+                nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulation( 1, i ), 4 ) );
         }
     }
 
@@ -0,0 +1,156 @@
+/*********************                                                        */
+/*! \file BinaryQueryFormat.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The layout of the binary input query format, written by
+ ** InputQuery::saveBinaryQuery and read by QueryLoader.
+ **
+ ** A file consists of a fixed-size header followed by a sequence of arrays
+ ** (the sections), each starting at an 8-byte aligned offset. The number of
+ ** entries of every section is determined by the header, so a reader can
+ ** map the file into memory and access the sections in place. Equations are
+ ** stored in compressed sparse row form, and the piecewise-linear and
+ ** nonlinear constraints by their serialized strings. Values are stored in
+ ** the byte order of the machine that wrote the file, which is recorded in
+ ** the header.
+ **/
+
+#ifndef __BinaryQueryFormat_h__
+#define __BinaryQueryFormat_h__
+
+#include <cstdint>
+#include <cstring>
+
+namespace BinaryQueryFormat {
+
+const char MAGIC[8] = { 'M', 'A', 'R', 'A', 'B', 'O', 'U', 'Q' };
+
+enum {
+    // Incremented whenever the layout changes
+    VERSION = 1,
+
+    // Reads as a different value on a machine of the other byte order
+    BYTE_ORDER_MARK = 0x01020304,
+
+    ALIGNMENT = 8,
+};
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint64_t numberOfVariables;
+    uint64_t numberOfInputVariables;
+    uint64_t numberOfOutputVariables;
+    uint64_t numberOfLowerBounds;
+    uint64_t numberOfUpperBounds;
+    uint64_t numberOfEquations;
+    uint64_t numberOfAddends;
+    uint64_t numberOfPiecewiseLinearConstraints;
+    uint64_t numberOfNonlinearConstraints;
+    uint64_t numberOfConstraintCharacters;
+};
+
+enum Section {
+    // uint32_t pairs of (input index, variable)
+    INPUT_VARIABLES = 0,
+    // uint32_t pairs of (output index, variable)
+    OUTPUT_VARIABLES,
+    // uint32_t variables and double values, one per bound
+    LOWER_BOUND_VARIABLES,
+    LOWER_BOUND_VALUES,
+    UPPER_BOUND_VARIABLES,
+    UPPER_BOUND_VALUES,
+    // uint32_t Equation::EquationType and double scalar, one per equation
+    EQUATION_TYPES,
+    EQUATION_SCALARS,
+    // uint64_t offsets of the first addend of each equation, followed by the
+    // total number of addends
+    EQUATION_OFFSETS,
+    // uint32_t variable and double coefficient, one per addend
+    ADDEND_VARIABLES,
+    ADDEND_COEFFICIENTS,
+    // uint64_t offsets of the first character of each serialized
+    // constraint, piecewise-linear constraints first, followed by the total
+    // number of characters
+    CONSTRAINT_OFFSETS,
+    // The serialized constraints, not null-terminated
+    CONSTRAINT_CHARACTERS,
+
+    NUMBER_OF_SECTIONS,
+};
+
+struct Layout
+{
+    uint64_t offsets[NUMBER_OF_SECTIONS];
+    uint64_t sizes[NUMBER_OF_SECTIONS];
+    uint64_t fileSize;
+};
+
+inline uint64_t align( uint64_t offset )
+{
+    return ( offset + ALIGNMENT - 1 ) / ALIGNMENT * ALIGNMENT;
+}
+
+inline void initializeHeader( Header &header )
+{
+    memset( &header, 0, sizeof( Header ) );
+    memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+    header.version = VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+}
+
+/*
+  Compute the offsets and sizes of the sections. The counts in the header
+  must have been checked not to overflow the computation.
+*/
+inline Layout computeLayout( const Header &header )
+{
+    uint64_t numberOfConstraints =
+        header.numberOfPiecewiseLinearConstraints + header.numberOfNonlinearConstraints;
+
+    Layout layout;
+    layout.sizes[INPUT_VARIABLES] = 2 * header.numberOfInputVariables * sizeof( uint32_t );
+    layout.sizes[OUTPUT_VARIABLES] = 2 * header.numberOfOutputVariables * sizeof( uint32_t );
+    layout.sizes[LOWER_BOUND_VARIABLES] = header.numberOfLowerBounds * sizeof( uint32_t );
+    layout.sizes[LOWER_BOUND_VALUES] = header.numberOfLowerBounds * sizeof( double );
+    layout.sizes[UPPER_BOUND_VARIABLES] = header.numberOfUpperBounds * sizeof( uint32_t );
+    layout.sizes[UPPER_BOUND_VALUES] = header.numberOfUpperBounds * sizeof( double );
+    layout.sizes[EQUATION_TYPES] = header.numberOfEquations * sizeof( uint32_t );
+    layout.sizes[EQUATION_SCALARS] = header.numberOfEquations * sizeof( double );
+    layout.sizes[EQUATION_OFFSETS] = ( header.numberOfEquations + 1 ) * sizeof( uint64_t );
+    layout.sizes[ADDEND_VARIABLES] = header.numberOfAddends * sizeof( uint32_t );
+    layout.sizes[ADDEND_COEFFICIENTS] = header.numberOfAddends * sizeof( double );
+    layout.sizes[CONSTRAINT_OFFSETS] = ( numberOfConstraints + 1 ) * sizeof( uint64_t );
+    layout.sizes[CONSTRAINT_CHARACTERS] = header.numberOfConstraintCharacters;
+
+    uint64_t offset = align( sizeof( Header ) );
+    for ( unsigned i = 0; i < NUMBER_OF_SECTIONS; ++i )
+    {
+        layout.offsets[i] = offset;
+        offset = align( offset + layout.sizes[i] );
+    }
+    layout.fileSize = offset;
+
+    return layout;
+}
+
+} // namespace BinaryQueryFormat
+
+#endif // __BinaryQueryFormat_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -18,6 +18,7 @@
 
 #include "AutoFile.h"
 #include "BilinearConstraint.h"
+#include "BinaryQueryFormat.h"
 #include "Debug.h"
 #include "DisjunctionConstraint.h"
 #include "Equation.h"
@@ -32,6 +33,77 @@
 #include "SignConstraint.h"
 #include "SoftmaxConstraint.h"
 
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+  Add a piecewise-linear or nonlinear constraint, given by its type and its
+  serialization (which starts with the type), to the query
+*/
+static void addConstraint( InputQuery &inputQuery,
+                           const String &coType,
+                           const String &serializeConstraint )
+{
+    if ( coType == "relu" )
+    {
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( serializeConstraint ) );
+    }
+    else if ( coType == "leaky_relu" )
+    {
+        inputQuery.addPiecewiseLinearConstraint( new LeakyReluConstraint( serializeConstraint ) );
+    }
+    else if ( coType == "max" )
+    {
+        inputQuery.addPiecewiseLinearConstraint( new MaxConstraint( serializeConstraint ) );
+    }
+    else if ( coType == "absoluteValue" )
+    {
+        inputQuery.addPiecewiseLinearConstraint(
+            new AbsoluteValueConstraint( serializeConstraint ) );
+    }
+    else if ( coType == "sign" )
+    {
+        inputQuery.addPiecewiseLinearConstraint( new SignConstraint( serializeConstraint ) );
+    }
+    else if ( coType == "disj" )
+    {
+        inputQuery.addPiecewiseLinearConstraint( new DisjunctionConstraint( serializeConstraint ) );
+    }
+    else if ( coType == "sigmoid" )
+    {
+        inputQuery.addNonlinearConstraint( new SigmoidConstraint( serializeConstraint ) );
+    }
+    else if ( coType == "softmax" )
+    {
+        SoftmaxConstraint *softmax = new SoftmaxConstraint( serializeConstraint );
+        inputQuery.addNonlinearConstraint( softmax );
+        Equation eq;
+        for ( const auto &output : softmax->getOutputs() )
+            eq.addAddend( 1, output );
+        eq.setScalar( 1 );
+        inputQuery.addEquation( eq );
+    }
+    else if ( coType == "bilinear" )
+    {
+        BilinearConstraint *bilinear = new BilinearConstraint( serializeConstraint );
+        inputQuery.addNonlinearConstraint( bilinear );
+    }
+    else if ( coType == "round" )
+    {
+        inputQuery.addNonlinearConstraint( new RoundConstraint( serializeConstraint ) );
+    }
+    else
+    {
+        throw MarabouError(
+            MarabouError::UNSUPPORTED_NON_LINEAR_CONSTRAINT,
+            Stringf( "Unsupported non-linear constraint: %s\n", coType.ascii() ).ascii() );
+    }
+}
+
 InputQuery QueryLoader::loadQuery( const String &fileName )
 {
     if ( !IFile::exists( fileName ) )
@@ -40,6 +112,9 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
                             Stringf( "File %s not found.\n", fileName.ascii() ).ascii() );
     }
 
+    if ( isBinaryQuery( fileName ) )
+        return loadBinaryQuery( fileName );
+
     InputQuery inputQuery;
     AutoFile input( fileName );
     input->open( IFile::MODE_READ );
@@ -210,62 +285,240 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
 
         QL_LOG( Stringf( "Non-Linear Constraint: %u, Type: %s \n", i, coType.ascii() ).ascii() );
         QL_LOG( Stringf( "\tserialized:\t%s \n", serializeConstraint.ascii() ).ascii() );
-        if ( coType == "relu" )
-        {
-            inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( serializeConstraint ) );
-        }
-        else if ( coType == "leaky_relu" )
-        {
-            inputQuery.addPiecewiseLinearConstraint(
-                new LeakyReluConstraint( serializeConstraint ) );
-        }
-        else if ( coType == "max" )
-        {
-            inputQuery.addPiecewiseLinearConstraint( new MaxConstraint( serializeConstraint ) );
-        }
-        else if ( coType == "absoluteValue" )
-        {
-            inputQuery.addPiecewiseLinearConstraint(
-                new AbsoluteValueConstraint( serializeConstraint ) );
-        }
-        else if ( coType == "sign" )
-        {
-            inputQuery.addPiecewiseLinearConstraint( new SignConstraint( serializeConstraint ) );
-        }
-        else if ( coType == "disj" )
-        {
-            inputQuery.addPiecewiseLinearConstraint(
-                new DisjunctionConstraint( serializeConstraint ) );
-        }
-        else if ( coType == "sigmoid" )
-        {
-            inputQuery.addNonlinearConstraint( new SigmoidConstraint( serializeConstraint ) );
-        }
-        else if ( coType == "softmax" )
+        addConstraint( inputQuery, coType, serializeConstraint );
+    }
+
+    return inputQuery;
+}
+
+/*
+  A read-only mapping of a whole file into memory
+*/
+class MappedFile
+{
+public:
+    MappedFile( const String &fileName )
+        : _data( NULL )
+        , _size( 0 )
+    {
+        int descriptor = open( fileName.ascii(), O_RDONLY );
+        if ( descriptor == -1 )
+            throw MarabouError( MarabouError::FILE_DOES_NOT_EXIST,
+                                Stringf( "File %s not found.\n", fileName.ascii() ).ascii() );
+
+        struct stat fileStatus;
+        if ( fstat( descriptor, &fileStatus ) != 0 )
         {
-            SoftmaxConstraint *softmax = new SoftmaxConstraint( serializeConstraint );
-            inputQuery.addNonlinearConstraint( softmax );
-            Equation eq;
-            for ( const auto &output : softmax->getOutputs() )
-                eq.addAddend( 1, output );
-            eq.setScalar( 1 );
-            inputQuery.addEquation( eq );
+            close( descriptor );
+            throw MarabouError( MarabouError::INVALID_QUERY_FILE,
+                                Stringf( "Cannot read %s\n", fileName.ascii() ).ascii() );
         }
-        else if ( coType == "bilinear" )
+
+        _size = fileStatus.st_size;
+        if ( _size > 0 )
         {
-            BilinearConstraint *bilinear = new BilinearConstraint( serializeConstraint );
-            inputQuery.addNonlinearConstraint( bilinear );
+            void *data = mmap( NULL, _size, PROT_READ, MAP_PRIVATE, descriptor, 0 );
+            if ( data == MAP_FAILED )
+            {
+                close( descriptor );
+                throw MarabouError( MarabouError::INVALID_QUERY_FILE,
+                                    Stringf( "Cannot map %s\n", fileName.ascii() ).ascii() );
+            }
+            _data = (const char *)data;
         }
-        else if ( coType == "round" )
+
+        // The mapping remains valid after the descriptor is closed
+        close( descriptor );
+    }
+
+    ~MappedFile()
+    {
+        if ( _data )
+            munmap( (void *)_data, _size );
+    }
+
+    const char *data() const
+    {
+        return _data;
+    }
+
+    unsigned long long size() const
+    {
+        return _size;
+    }
+
+private:
+    const char *_data;
+    unsigned long long _size;
+};
+
+bool QueryLoader::isBinaryQuery( const String &fileName )
+{
+    int descriptor = open( fileName.ascii(), O_RDONLY );
+    if ( descriptor == -1 )
+        return false;
+
+    char magic[sizeof( BinaryQueryFormat::MAGIC )];
+    bool result = read( descriptor, magic, sizeof( magic ) ) == (ssize_t)sizeof( magic ) &&
+                  memcmp( magic, BinaryQueryFormat::MAGIC, sizeof( magic ) ) == 0;
+    close( descriptor );
+    return result;
+}
+
+InputQuery QueryLoader::loadBinaryQuery( const String &fileName )
+{
+    MappedFile file( fileName );
+    return loadBinaryQuery( file.data(), file.size() );
+}
+
+static void invalidBinaryQuery( const char *reason )
+{
+    throw MarabouError( MarabouError::INVALID_QUERY_FILE,
+                        Stringf( "Invalid binary query: %s\n", reason ).ascii() );
+}
+
+static void checkVariable( uint32_t variable, uint64_t numberOfVariables )
+{
+    if ( variable >= numberOfVariables )
+        invalidBinaryQuery( "variable out of range" );
+}
+
+/*
+  Check that the offsets start at zero, do not decrease and end at the
+  total number of entries
+*/
+static void checkOffsets( const uint64_t *offsets, uint64_t count, uint64_t total )
+{
+    if ( offsets[0] != 0 || offsets[count] != total )
+        invalidBinaryQuery( "offsets do not cover the entries" );
+    for ( uint64_t i = 0; i < count; ++i )
+    {
+        if ( offsets[i] > offsets[i + 1] )
+            invalidBinaryQuery( "decreasing offsets" );
+    }
+}
+
+InputQuery QueryLoader::loadBinaryQuery( const char *data, unsigned long long size )
+{
+    using namespace BinaryQueryFormat;
+
+    if ( size < sizeof( Header ) )
+        invalidBinaryQuery( "file too short" );
+    if ( (uintptr_t)data % ALIGNMENT != 0 )
+        invalidBinaryQuery( "misaligned buffer" );
+
+    const Header &header = *(const Header *)data;
+    if ( memcmp( header.magic, MAGIC, sizeof( MAGIC ) ) != 0 )
+        invalidBinaryQuery( "bad magic number" );
+    if ( header.byteOrderMark != BYTE_ORDER_MARK )
+        invalidBinaryQuery( "written on a machine of a different byte order" );
+    if ( header.version != VERSION )
+        invalidBinaryQuery( Stringf( "unsupported version %u", header.version ).ascii() );
+
+    // Every section holds at least one byte per entry, so bounding the
+    // counts by the size of the file keeps the layout from overflowing
+    const uint64_t counts[] = { header.numberOfInputVariables,
+                                header.numberOfOutputVariables,
+                                header.numberOfLowerBounds,
+                                header.numberOfUpperBounds,
+                                header.numberOfEquations,
+                                header.numberOfAddends,
+                                header.numberOfPiecewiseLinearConstraints,
+                                header.numberOfNonlinearConstraints,
+                                header.numberOfConstraintCharacters };
+    for ( uint64_t count : counts )
+    {
+        if ( count > size )
+            invalidBinaryQuery( "file too short" );
+    }
+    if ( header.numberOfVariables > UINT_MAX )
+        invalidBinaryQuery( "too many variables" );
+
+    Layout layout = computeLayout( header );
+    if ( layout.fileSize != size )
+        invalidBinaryQuery( "size does not match the header" );
+
+    QL_LOG( Stringf( "Number of variables: %llu\n", (unsigned long long)header.numberOfVariables )
+                .ascii() );
+    QL_LOG( Stringf( "Number of equations: %llu\n", (unsigned long long)header.numberOfEquations )
+                .ascii() );
+
+    const uint64_t numberOfVariables = header.numberOfVariables;
+    const uint64_t numberOfConstraints =
+        header.numberOfPiecewiseLinearConstraints + header.numberOfNonlinearConstraints;
+    const uint64_t *equationOffsets = (const uint64_t *)( data + layout.offsets[EQUATION_OFFSETS] );
+    const uint64_t *constraintOffsets =
+        (const uint64_t *)( data + layout.offsets[CONSTRAINT_OFFSETS] );
+    checkOffsets( equationOffsets, header.numberOfEquations, header.numberOfAddends );
+    checkOffsets( constraintOffsets, numberOfConstraints, header.numberOfConstraintCharacters );
+
+    InputQuery inputQuery;
+    inputQuery.setNumberOfVariables( numberOfVariables );
+
+    const uint32_t *inputVariables = (const uint32_t *)( data + layout.offsets[INPUT_VARIABLES] );
+    for ( uint64_t i = 0; i < header.numberOfInputVariables; ++i )
+    {
+        checkVariable( inputVariables[2 * i + 1], numberOfVariables );
+        inputQuery.markInputVariable( inputVariables[2 * i + 1], inputVariables[2 * i] );
+    }
+
+    const uint32_t *outputVariables = (const uint32_t *)( data + layout.offsets[OUTPUT_VARIABLES] );
+    for ( uint64_t i = 0; i < header.numberOfOutputVariables; ++i )
+    {
+        checkVariable( outputVariables[2 * i + 1], numberOfVariables );
+        inputQuery.markOutputVariable( outputVariables[2 * i + 1], outputVariables[2 * i] );
+    }
+
+    const uint32_t *lowerBoundVariables =
+        (const uint32_t *)( data + layout.offsets[LOWER_BOUND_VARIABLES] );
+    const double *lowerBoundValues = (const double *)( data + layout.offsets[LOWER_BOUND_VALUES] );
+    for ( uint64_t i = 0; i < header.numberOfLowerBounds; ++i )
+    {
+        checkVariable( lowerBoundVariables[i], numberOfVariables );
+        inputQuery.setLowerBound( lowerBoundVariables[i], lowerBoundValues[i] );
+    }
+
+    const uint32_t *upperBoundVariables =
+        (const uint32_t *)( data + layout.offsets[UPPER_BOUND_VARIABLES] );
+    const double *upperBoundValues = (const double *)( data + layout.offsets[UPPER_BOUND_VALUES] );
+    for ( uint64_t i = 0; i < header.numberOfUpperBounds; ++i )
+    {
+        checkVariable( upperBoundVariables[i], numberOfVariables );
+        inputQuery.setUpperBound( upperBoundVariables[i], upperBoundValues[i] );
+    }
+
+    const uint32_t *equationTypes = (const uint32_t *)( data + layout.offsets[EQUATION_TYPES] );
+    const double *equationScalars = (const double *)( data + layout.offsets[EQUATION_SCALARS] );
+    const uint32_t *addendVariables = (const uint32_t *)( data + layout.offsets[ADDEND_VARIABLES] );
+    const double *addendCoefficients =
+        (const double *)( data + layout.offsets[ADDEND_COEFFICIENTS] );
+    for ( uint64_t i = 0; i < header.numberOfEquations; ++i )
+    {
+        if ( equationTypes[i] != Equation::EQ && equationTypes[i] != Equation::GE &&
+             equationTypes[i] != Equation::LE )
         {
-            inputQuery.addNonlinearConstraint( new RoundConstraint( serializeConstraint ) );
+            throw MarabouError( MarabouError::INVALID_EQUATION_TYPE,
+                                Stringf( "Invalid Equation Type\n" ).ascii() );
         }
-        else
+
+        Equation equation( (Equation::EquationType)equationTypes[i] );
+        equation.setScalar( equationScalars[i] );
+        for ( uint64_t j = equationOffsets[i]; j < equationOffsets[i + 1]; ++j )
         {
-            throw MarabouError(
-                MarabouError::UNSUPPORTED_NON_LINEAR_CONSTRAINT,
-                Stringf( "Unsupported non-linear constraint: %s\n", coType.ascii() ).ascii() );
+            checkVariable( addendVariables[j], numberOfVariables );
+            equation.addAddend( addendCoefficients[j], addendVariables[j] );
         }
+        inputQuery.addEquation( equation );
+    }
+
+    const char *constraintCharacters = data + layout.offsets[CONSTRAINT_CHARACTERS];
+    for ( uint64_t i = 0; i < numberOfConstraints; ++i )
+    {
+        String serializeConstraint( constraintCharacters + constraintOffsets[i],
+                                    constraintOffsets[i + 1] - constraintOffsets[i] );
+        size_t separator = serializeConstraint.find( "," );
+        String coType = serializeConstraint.substring( 0, separator );
+        addConstraint( inputQuery, coType, serializeConstraint );
     }
 
     return inputQuery;
@@ -32,6 +32,20 @@ public:
       Parse a serialized query and return it in InputQuery form
     */
     static InputQuery loadQuery( const String &fileName );
+
+    /*
+      Load a query saved by InputQuery::saveBinaryQuery, either from a file,
+      which is mapped into memory, or from a buffer holding the contents of
+      such a file. The buffer must be aligned to 8 bytes. loadQuery
+      recognizes binary query files and calls loadBinaryQuery on them.
+    */
+    static InputQuery loadBinaryQuery( const String &fileName );
+    static InputQuery loadBinaryQuery( const char *data, unsigned long long size );
+
+    /*
+      Whether the file starts with the header of the binary query format
+    */
+    static bool isBinaryQuery( const String &fileName );
 };
 
 #endif // __QueryLoader_h__
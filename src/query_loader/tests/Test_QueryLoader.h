@@ -14,19 +14,27 @@
 **/
 
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
 #include "Equation.h"
 #include "InputQuery.h"
+#include "MarabouError.h"
+#include "MockErrno.h"
 #include "MockFileFactory.h"
 #include "QueryLoader.h"
 #include "ReluConstraint.h"
 #include "T/unistd.h"
 
+#include <cstdio>
 #include <cxxtest/TestSuite.h>
+#include <fstream>
+#include <vector>
 
 const String QUERY_TEST_FILE( "QueryTest.txt" );
+const String BINARY_QUERY_TEST_FILE( "QueryTest.ipqb" );
 
 class MockForQueryLoader
     : public MockFileFactory
+    , public MockErrno
     , public T::Base_stat
 {
 public:
@@ -52,10 +60,11 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete mock );
     }
 
-    void test_load_query()
+    /*
+      A small network with two ReLU and two Sigmoid neurons
+    */
+    void buildQuery( InputQuery &inputQuery )
     {
-        // Set up simple query as a test
-        InputQuery inputQuery;
         inputQuery.setNumberOfVariables( 10 );
 
         // Input layer with one variable
@@ -121,6 +130,13 @@ public:
         equation4.addAddend( 1.0, 8 );  // Weighted equation input
         equation4.setScalar( 0.5 );     // Equation bias
         inputQuery.addEquation( equation4 );
+    }
+
+    void test_load_query()
+    {
+        // Set up simple query as a test
+        InputQuery inputQuery;
+        buildQuery( inputQuery );
 
         // Save the query and then reload the query
         inputQuery.saveQuery( QUERY_TEST_FILE );
@@ -178,6 +194,173 @@ public:
         nlConstraint2 = (SigmoidConstraint *)*tsIt2;
         TS_ASSERT( nlConstraint->serializeToString() == nlConstraint2->serializeToString() );
     }
+
+    void checkSameQuery( const InputQuery &inputQuery, const InputQuery &inputQuery2 )
+    {
+        TS_ASSERT_EQUALS( inputQuery.getNumberOfVariables(), inputQuery2.getNumberOfVariables() );
+        TS_ASSERT( inputQuery.getInputVariables() == inputQuery2.getInputVariables() );
+        TS_ASSERT( inputQuery.getOutputVariables() == inputQuery2.getOutputVariables() );
+        TS_ASSERT( inputQuery.getLowerBounds() == inputQuery2.getLowerBounds() );
+        TS_ASSERT( inputQuery.getUpperBounds() == inputQuery2.getUpperBounds() );
+        TS_ASSERT( inputQuery.getEquations() == inputQuery2.getEquations() );
+
+        List<String> constraints;
+        for ( const auto &constraint : inputQuery.getPiecewiseLinearConstraints() )
+            constraints.append( constraint->serializeToString() );
+        for ( const auto &constraint : inputQuery.getNonlinearConstraints() )
+            constraints.append( constraint->serializeToString() );
+
+        List<String> constraints2;
+        for ( const auto &constraint : inputQuery2.getPiecewiseLinearConstraints() )
+            constraints2.append( constraint->serializeToString() );
+        for ( const auto &constraint : inputQuery2.getNonlinearConstraints() )
+            constraints2.append( constraint->serializeToString() );
+
+        TS_ASSERT( constraints == constraints2 );
+    }
+
+    /*
+      Save the query in the binary format to the mock file, and copy the
+      contents of the file to an aligned buffer
+    */
+    void saveBinaryQuery( InputQuery &inputQuery,
+                          std::vector<uint64_t> &buffer,
+                          unsigned long long &size )
+    {
+        mock->mockFile.wasCreated = false;
+        mock->mockFile.wasDiscarded = false;
+        mock->mockFile.writtenLines = "";
+
+        inputQuery.saveBinaryQuery( BINARY_QUERY_TEST_FILE );
+
+        size = mock->mockFile.writtenLines.length();
+        buffer.assign( ( size + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t ), 0 );
+        memcpy( buffer.data(), mock->mockFile.writtenLines.ascii(), size );
+    }
+
+    void test_binary_query_round_trip()
+    {
+        InputQuery inputQuery;
+        buildQuery( inputQuery );
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 7, 8 ) );
+
+        inputQuery.saveQuery( QUERY_TEST_FILE );
+        mock->mockFile.wasCreated = false;
+        mock->mockFile.wasDiscarded = false;
+        InputQuery textQuery = QueryLoader::loadQuery( QUERY_TEST_FILE );
+        checkSameQuery( inputQuery, textQuery );
+
+        std::vector<uint64_t> buffer;
+        unsigned long long size;
+        saveBinaryQuery( inputQuery, buffer, size );
+        const char *data = (const char *)buffer.data();
+        InputQuery binaryQuery = QueryLoader::loadBinaryQuery( data, size );
+        checkSameQuery( textQuery, binaryQuery );
+
+        // Saving the loaded query reproduces the file
+        std::vector<uint64_t> buffer2;
+        unsigned long long size2;
+        saveBinaryQuery( binaryQuery, buffer2, size2 );
+        TS_ASSERT_EQUALS( size, size2 );
+        TS_ASSERT( buffer == buffer2 );
+
+        // Loading from a file maps it, and loadQuery recognizes the format
+        std::ofstream( BINARY_QUERY_TEST_FILE.ascii(), std::ios::binary ).write( data, size );
+        TS_ASSERT( QueryLoader::isBinaryQuery( BINARY_QUERY_TEST_FILE ) );
+        InputQuery mappedQuery = QueryLoader::loadBinaryQuery( BINARY_QUERY_TEST_FILE );
+        InputQuery detectedQuery = QueryLoader::loadQuery( BINARY_QUERY_TEST_FILE );
+        checkSameQuery( inputQuery, mappedQuery );
+        checkSameQuery( inputQuery, detectedQuery );
+        std::remove( BINARY_QUERY_TEST_FILE.ascii() );
+    }
+
+    void test_binary_query_keeps_exact_values()
+    {
+        // The text format rounds values to ten decimal places
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 2 );
+        inputQuery.setLowerBound( 0, 1.0 / 3 );
+        inputQuery.setUpperBound( 1, 1e-12 );
+        Equation equation( Equation::GE );
+        equation.addAddend( 2.0 / 3, 0 );
+        equation.addAddend( -1e-15, 1 );
+        equation.setScalar( 1.0 / 7 );
+        inputQuery.addEquation( equation );
+
+        std::vector<uint64_t> buffer;
+        unsigned long long size;
+        saveBinaryQuery( inputQuery, buffer, size );
+        InputQuery binaryQuery = QueryLoader::loadBinaryQuery( (const char *)buffer.data(), size );
+        checkSameQuery( inputQuery, binaryQuery );
+        TS_ASSERT_EQUALS( binaryQuery.getLowerBound( 0 ), 1.0 / 3 );
+        TS_ASSERT_EQUALS( binaryQuery.getUpperBound( 1 ), 1e-12 );
+        TS_ASSERT_EQUALS( binaryQuery.getEquations().begin()->_type, Equation::GE );
+    }
+
+    void test_binary_query_rejects_invalid_files()
+    {
+        using namespace BinaryQueryFormat;
+
+        InputQuery inputQuery;
+        buildQuery( inputQuery );
+
+        std::vector<uint64_t> buffer;
+        unsigned long long size;
+        saveBinaryQuery( inputQuery, buffer, size );
+        char *data = (char *)buffer.data();
+        Header &header = *(Header *)data;
+
+        TS_ASSERT_THROWS_NOTHING( QueryLoader::loadBinaryQuery( data, size ) );
+
+        // Truncated files
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadBinaryQuery( data, size - 8 ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_QUERY_FILE );
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadBinaryQuery( data, sizeof( Header ) - 1 ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_QUERY_FILE );
+
+        // A future version
+        ++header.version;
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadBinaryQuery( data, size ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_QUERY_FILE );
+        --header.version;
+
+        // A count that does not match the size of the file
+        ++header.numberOfAddends;
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadBinaryQuery( data, size ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_QUERY_FILE );
+        --header.numberOfAddends;
+
+        // A variable out of range
+        Layout layout = computeLayout( header );
+        uint32_t *addendVariables = (uint32_t *)( data + layout.offsets[ADDEND_VARIABLES] );
+        uint32_t variable = addendVariables[0];
+        addendVariables[0] = 10;
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadBinaryQuery( data, size ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_QUERY_FILE );
+        addendVariables[0] = variable;
+
+        // Equation offsets that do not cover the addends
+        uint64_t *equationOffsets = (uint64_t *)( data + layout.offsets[EQUATION_OFFSETS] );
+        uint64_t offset = equationOffsets[1];
+        equationOffsets[1] = header.numberOfAddends + 1;
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadBinaryQuery( data, size ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_QUERY_FILE );
+        equationOffsets[1] = offset;
+
+        TS_ASSERT_THROWS_NOTHING( QueryLoader::loadBinaryQuery( data, size ) );
+    }
 };
 
 //
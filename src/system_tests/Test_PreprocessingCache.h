@@ -0,0 +1,222 @@
+/*********************                                                        */
+/*! \file Test_PreprocessingCache.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "AcasParser.h"
+#include "Engine.h"
+#include "FloatUtils.h"
+#include "InputQuery.h"
+#include "Layer.h"
+#include "MStringf.h"
+#include "NetworkLevelReasoner.h"
+#include "PiecewiseLinearConstraint.h"
+#include "PreprocessingCache.h"
+#include "QueryLoader.h"
+
+#include <cstdio>
+#include <cxxtest/TestSuite.h>
+#include <fstream>
+#include <unistd.h>
+
+class PreprocessingCacheTestSuite : public CxxTest::TestSuite
+{
+public:
+    String _directory;
+
+    void setUp()
+    {
+        _directory = Stringf( "/tmp/Test_PreprocessingCache.%u", (unsigned)getpid() );
+    }
+
+    void tearDown()
+    {
+        rmdir( _directory.ascii() );
+    }
+
+    void removeEntry( const String &key )
+    {
+        String path = _directory + "/" + key;
+        unlink( ( path + "/query.ipqb" ).ascii() );
+        unlink( ( path + "/preprocessed.ipqb" ).ascii() );
+        unlink( ( path + "/state" ).ascii() );
+        rmdir( path.ascii() );
+    }
+
+    void test_warm_start_with_fixed_input()
+    {
+        String networkPath = RESOURCES_DIR "/bnn_queries/smallBNN_original";
+        String key = PreprocessingCache::computeKey( { networkPath } );
+
+        InputQuery inputQuery = QueryLoader::loadQuery( networkPath );
+        for ( unsigned inputVariable = 0; inputVariable < 784; ++inputVariable )
+        {
+            inputQuery.setLowerBound( inputVariable, 0.5 );
+            inputQuery.setUpperBound( inputVariable, 0.5 );
+        }
+
+        // A cold run stores the processed query
+        PreprocessingCache coldCache( _directory );
+        Engine coldEngine;
+        TS_ASSERT( coldEngine.processInputQuery( inputQuery ) );
+        TS_ASSERT_THROWS_NOTHING( coldCache.store( key, inputQuery, coldEngine ) );
+        TS_ASSERT_THROWS_NOTHING( coldEngine.solve() );
+        coldEngine.extractSolution( inputQuery );
+
+        // A warm run starts from it
+        PreprocessingCache warmCache( _directory );
+        InputQuery cachedQuery;
+        PreprocessingCache::Entry entry;
+        TS_ASSERT( warmCache.load( key, cachedQuery, entry ) );
+        TS_ASSERT_EQUALS( warmCache.getNumberOfHits(), 1U );
+        TS_ASSERT_EQUALS( warmCache.getNumberOfMisses(), 0U );
+
+        Engine warmEngine;
+        TS_ASSERT( warmEngine.processCachedInputQuery( entry ) );
+        TS_ASSERT_THROWS_NOTHING( warmEngine.solve() );
+        warmEngine.extractSolution( cachedQuery );
+
+        TS_ASSERT_EQUALS( cachedQuery.getNumberOfVariables(), inputQuery.getNumberOfVariables() );
+        for ( unsigned i = 0; i < inputQuery.getNumberOfVariables(); ++i )
+            TS_ASSERT_DELTA(
+                cachedQuery.getSolutionValue( i ), inputQuery.getSolutionValue( i ), 0.0001 );
+
+        // The output vector is - [-2.0, -8.0, 10.0, 16.0, -18.0, 2.0, 6.0, 0.0, 2.0, 2.0]
+        TS_ASSERT_EQUALS( cachedQuery.getSolutionValue( 784 ), -2 );
+        TS_ASSERT_EQUALS( cachedQuery.getSolutionValue( 787 ), 16 );
+        TS_ASSERT_EQUALS( cachedQuery.getSolutionValue( 788 ), -18 );
+
+        removeEntry( key );
+    }
+
+    void test_warm_start_restores_the_processed_query()
+    {
+        String networkPath = RESOURCES_DIR "/nnet/acasxu/ACASXU_experimental_v2a_1_1.nnet";
+        String key = PreprocessingCache::computeKey( { networkPath } );
+
+        InputQuery inputQuery;
+        AcasParser acasParser( networkPath );
+        acasParser.generateQuery( inputQuery );
+
+        PreprocessingCache cache( _directory );
+        Engine coldEngine;
+        TS_ASSERT( coldEngine.processInputQuery( inputQuery ) );
+        cache.store( key, inputQuery, coldEngine );
+
+        InputQuery cachedQuery;
+        PreprocessingCache::Entry entry;
+        TS_ASSERT( cache.load( key, cachedQuery, entry ) );
+        Engine warmEngine;
+        TS_ASSERT( warmEngine.processCachedInputQuery( entry ) );
+
+        const InputQuery *cold = coldEngine.getInputQuery();
+        const InputQuery *warm = warmEngine.getInputQuery();
+        TS_ASSERT_EQUALS( warm->getNumberOfVariables(), cold->getNumberOfVariables() );
+        TS_ASSERT_EQUALS( warm->getEquations().size(), cold->getEquations().size() );
+        for ( unsigned i = 0; i < cold->getNumberOfVariables(); ++i )
+        {
+            TS_ASSERT_EQUALS( warm->getLowerBound( i ), cold->getLowerBound( i ) );
+            TS_ASSERT_EQUALS( warm->getUpperBound( i ), cold->getUpperBound( i ) );
+        }
+
+        List<String> coldConstraints;
+        for ( const auto &constraint : cold->getPiecewiseLinearConstraints() )
+            coldConstraints.append( constraint->serializeToString() );
+        List<String> warmConstraints;
+        for ( const auto &constraint : warm->getPiecewiseLinearConstraints() )
+            warmConstraints.append( constraint->serializeToString() );
+        TS_ASSERT_EQUALS( warmConstraints, coldConstraints );
+
+        NLR::NetworkLevelReasoner *coldNetwork = cold->getNetworkLevelReasoner();
+        NLR::NetworkLevelReasoner *warmNetwork = warm->getNetworkLevelReasoner();
+        TS_ASSERT( coldNetwork );
+        TS_ASSERT( warmNetwork );
+        TS_ASSERT_EQUALS( warmNetwork->getNumberOfLayers(), coldNetwork->getNumberOfLayers() );
+        for ( unsigned i = 0; i < coldNetwork->getNumberOfLayers(); ++i )
+            TS_ASSERT( *warmNetwork->getLayer( i ) == *coldNetwork->getLayer( i ) );
+
+        // The warm run solves the original query
+        TS_ASSERT_THROWS_NOTHING( warmEngine.solve() );
+        warmEngine.extractSolution( cachedQuery );
+
+        Vector<double> inputs;
+        for ( unsigned i = 0; i < 5; ++i )
+            inputs.append( cachedQuery.getSolutionValue( acasParser.getInputVariable( i ) ) );
+
+        Vector<double> outputs;
+        acasParser.evaluate( inputs, outputs );
+        for ( unsigned i = 0; i < 5; ++i )
+            TS_ASSERT_DELTA(
+                cachedQuery.getSolutionValue( acasParser.getOutputVariable( i ) ),
+                outputs[i],
+                0.00001 );
+
+        removeEntry( key );
+    }
+
+    void test_misses()
+    {
+        String networkPath = RESOURCES_DIR "/bnn_queries/smallBNN_parsed";
+        String key = PreprocessingCache::computeKey( { networkPath } );
+
+        PreprocessingCache cache( _directory );
+        InputQuery cachedQuery;
+        PreprocessingCache::Entry entry;
+        TS_ASSERT( !cache.load( key, cachedQuery, entry ) );
+        TS_ASSERT_EQUALS( cache.getNumberOfMisses(), 1U );
+
+        InputQuery inputQuery = QueryLoader::loadQuery( networkPath );
+        Engine engine;
+        TS_ASSERT( engine.processInputQuery( inputQuery ) );
+        cache.store( key, inputQuery, engine );
+
+        // A damaged entry is a miss, not an error
+        String statePath = _directory + "/" + key + "/state";
+        TS_ASSERT_EQUALS( truncate( statePath.ascii(), 20 ), 0 );
+        TS_ASSERT( !cache.load( key, cachedQuery, entry ) );
+        TS_ASSERT( !entry._preprocessedQuery );
+        TS_ASSERT_EQUALS( cache.getNumberOfHits(), 0U );
+        TS_ASSERT_EQUALS( cache.getNumberOfMisses(), 2U );
+
+        removeEntry( key );
+    }
+
+    void test_key()
+    {
+        String path = Stringf( "/tmp/Test_PreprocessingCache.%u.txt", (unsigned)getpid() );
+        {
+            std::ofstream file( path.ascii() );
+            file << "x0 <= 1";
+        }
+        String key = PreprocessingCache::computeKey( { path } );
+        TS_ASSERT_EQUALS( key.length(), 16U );
+        TS_ASSERT_EQUALS( PreprocessingCache::computeKey( { path } ), key );
+
+        {
+            std::ofstream file( path.ascii() );
+            file << "x0 <= 2";
+        }
+        TS_ASSERT_DIFFERS( PreprocessingCache::computeKey( { path } ), key );
+        unlink( path.ascii() );
+
+        TS_ASSERT_THROWS_ANYTHING( PreprocessingCache::computeKey( { path } ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//